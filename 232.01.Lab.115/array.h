@@ -19,7 +19,10 @@
 
 #pragma once
 
-#include <stdexcept>
+#include <cassert>    // for assert
+#include <cstddef>    // for size_t
+#include <stdexcept>  // for std::out_of_range
+#include <string>     // for std::to_string
 
 class TestArray; // forward declaration for unit tests
 
@@ -28,9 +31,13 @@ namespace custom
 
 /************************************************
  * ARRAY
- * A class that holds stuff
+ * A class that holds stuff. Everything but at()
+ * is constexpr, and the subscript operator is not
+ * range-checked outside of debug builds so loops
+ * over an array compile down to plain pointer
+ * arithmetic the optimizer can vectorize.
  ***********************************************/
-template <typename T, int N>
+template <typename T, size_t N>
 struct array{    
 public:
     T __elems_[N];
@@ -46,6 +53,12 @@ public:
 
    // No assignment operators needed here
 
+   constexpr void fill(const T & t)
+   {
+      for (size_t i = 0; i < N; i++)
+         __elems_[i] = t;
+   }
+
    //
    // Iterator
    //
@@ -54,74 +67,48 @@ public:
    class iterator;
 
    // Begin and end methods
-   iterator begin() 
-   { 
-      /* your code goes here; it should return an iterator referring to the first element in the array */
-      return iterator(__elems_); 
-   }
-   iterator end()   
-   { 
-      /* your code goes here; it should return an iterator referring to the first element off the end of the array */
-      return iterator(__elems_ + N); 
-   }
+   constexpr iterator begin() { return iterator(__elems_);     }
+   constexpr iterator end()   { return iterator(__elems_ + N); }
 
    // 
    // Access
    //
 
-   // Subscript
-   T& operator [] (size_t index){ 
-        /* your code goes here; it should return the i-th element in the array */
-        return at(index); 
+   // Subscript: checked only by assert
+   constexpr T& operator [] (size_t index)
+   { 
+      assert(index < N);
+      return __elems_[index]; 
    }
-   const T& operator [] (size_t index) const { 
-        /* your code goes here; it should return the i-th element in the array */
-        return at(index); 
+   constexpr const T& operator [] (size_t index) const
+   { 
+      assert(index < N);
+      return __elems_[index]; 
    }
 
-   // At
-   T& at(size_t index){ 
-        if (index >= N) {
-            std::string errorMsg = "Given index `" + std::to_string(index) +
-                "` is out of range. Maximum Index: `" + std::to_string(N) + "`.";
-            throw std::out_of_range(errorMsg);
-        }
-        /* your code goes here; it should return the i-th element in the array */
-        return __elems_[index];
+   // At: always checked
+   constexpr T& at(size_t index)
+   { 
+      if (index >= N)
+         throwOutOfRange(index);
+      return __elems_[index];
    }
-   const T& at(size_t index) const { 
-       if (index >= N) {
-           std::string errorMsg = "Given index `" + std::to_string(index) +
-               "` is out of range. Maximum Index: `" + std::to_string(N) + "`.";
-           throw std::out_of_range(errorMsg);
-       }
-       /* your code goes here; it should return the i-th element in the array */
-       return __elems_[index];
+   constexpr const T& at(size_t index) const
+   { 
+      if (index >= N)
+         throwOutOfRange(index);
+      return __elems_[index];
    }
 
    // Front and Back
-   T& front(){ 
-      /* your code goes here; it should return the first element in the array */
-      return at(0); 
-   }
+   constexpr       T& front()       { return __elems_[0];     }
+   constexpr       T& back()        { return __elems_[N - 1]; }
+   constexpr const T& front() const { return __elems_[0];     }
+   constexpr const T& back()  const { return __elems_[N - 1]; }
 
-   T& back(){ 
-        /* your code goes here; it should return the last element in the array */
-        const int lastIndex = N - 1;
-        return at(lastIndex); 
-   }
-
-   const T& front() const { 
-      /* your code goes here; it should return the first element in the array */
-      return at(0); 
-   }
-
-   const T& back()  const{ 
-        /* your code goes here; it should return the last element in the array */
-        const int lastIndex = N - 1;
-        
-        return at(lastIndex); 
-   }
+   // the raw elements
+   constexpr       T* data()       { return __elems_; }
+   constexpr const T* data() const { return __elems_; }
 
    //
    // Remove
@@ -133,92 +120,92 @@ public:
    //
 
    // number of elements in the array
-   size_t size()  const { 
-        /* your code goes here, this should not always return 999 */
-        return N;           
-   }
-   bool empty() const 
-   { 
-        /* your code goes here; this should not always return TRUE */
-       bool isEmpty = false;
-       if (N == 0) {
-           isEmpty = true;
-       }
-       return isEmpty;
+   constexpr size_t size()  const { return N;      }
+   constexpr bool   empty() const { return N == 0; }
+
+private:
+
+   // kept out of line so at() stays constexpr and the message is only built on failure
+   static void throwOutOfRange(size_t index)
+   {
+      std::string errorMsg = "Given index `" + std::to_string(index) +
+         "` is out of range. Maximum Index: `" + std::to_string(N) + "`.";
+      throw std::out_of_range(errorMsg);
    }
-   
-   //
-   // Member Variable
-   //
 };
 
+/************************************************
+ * ARRAY :: COMPARISONS
+ * Element by element, the way std::array does
+ ***********************************************/
+template <typename T, size_t N>
+constexpr bool operator == (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   for (size_t i = 0; i < N; i++)
+      if (!(lhs.__elems_[i] == rhs.__elems_[i]))
+         return false;
+   return true;
+}
+
+template <typename T, size_t N>
+constexpr bool operator != (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   return !(lhs == rhs);
+}
+
+template <typename T, size_t N>
+constexpr bool operator < (const array <T, N> & lhs, const array <T, N> & rhs)
+{
+   for (size_t i = 0; i < N; i++)
+   {
+      if (lhs.__elems_[i] < rhs.__elems_[i])
+         return true;
+      if (rhs.__elems_[i] < lhs.__elems_[i])
+         return false;
+   }
+   return false;
+}
+
 /**************************************************
  * ARRAY ITERATOR
  * An iterator through array
  *************************************************/
-template <typename T, int N>
+template <typename T, size_t N>
 class array <T, N> :: iterator
 {
    friend class ::TestArray; // give unit tests access to the privates
 public:
    // constructors, destructors, and assignment operator
-   iterator(){ 
-      /* your code goes here; it should initialize an iterator */
-       p = nullptr;
-   }
-
-   iterator(T * pInput){
-      /* your code goes here; it should point to an element in the array */
-       p = pInput;
-   }
-
-   iterator(const iterator & rhs){
-      /* your code goes here; it should copy an iterator */
-       p = rhs.p;
-   }
-
-   iterator & operator = (const iterator & rhs){
-      /* your code goes here; it should copy an iterator */
+   constexpr iterator()                      : p(nullptr) { }
+   constexpr iterator(T * pInput)            : p(pInput)  { }
+   constexpr iterator(const iterator & rhs)  : p(rhs.p)   { }
+   constexpr iterator & operator = (const iterator & rhs)
+   {
       p = rhs.p;
       return *this;
    }
    
    // equals, not equals operator
-   bool operator != (const iterator & rhs) const { 
-      /* your code goes here; it should not always return TRUE */
-      return !(*this == rhs); 
-   }
-
-   bool operator == (const iterator & rhs) const 
-   { 
-      /* your code goes here; it should not always return TRUE */
-      return p == rhs.p; 
-   }
+   constexpr bool operator != (const iterator & rhs) const { return p != rhs.p; }
+   constexpr bool operator == (const iterator & rhs) const { return p == rhs.p; }
    
    // dereference operator
-   T & operator * () { 
-      /* your code goes here; it should fetch the element referred to by p */
-      return *p; 
-   }
-
-   const T & operator * () const{ 
-      /* your code goes here; it should fetch the element referred to by p */
-      return *p; 
-   }
+   constexpr       T & operator * ()       { return *p; }
+   constexpr const T & operator * () const { return *p; }
    
    // prefix increment
-   iterator & operator ++ (){
-      /* your code goes here; it should advance the iterator by one */
-       ++p;
+   constexpr iterator & operator ++ ()
+   {
+      ++p;
       return *this;
    }
    
    // postfix increment
-   iterator operator ++ (int postfix){
-      /* your code goes here; it should advance the iterator by one */
-       iterator temp = *this;
-       ++p;
-       return temp;
+   constexpr iterator operator ++ (int postfix)
+   {
+      iterator temp = *this;
+      ++p;
+      return temp;
    }
    
 private:
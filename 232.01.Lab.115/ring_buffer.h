@@ -0,0 +1,410 @@
+/***********************************************************************
+ * Header:
+ *    Ring Buffer
+ * Summary:
+ *    Bounded lock-free queues built on top of custom::array
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *       ring_buffer       : many producers, many consumers
+ *       spsc_ring_buffer  : one producer, one consumer
+ * Author
+ *    Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for size_t
+#include <new>      // for placement new
+#include <utility>  // for std::move, std::forward
+#include "array.h"
+
+class TestRingBuffer; // forward declaration for unit tests
+
+namespace custom
+{
+
+// keep things two threads write to on separate cache lines
+static const size_t cacheLineSize = 64;
+
+/************************************************
+ * RING BUFFER
+ * A fixed-size FIFO queue that any number of threads
+ * may push onto and pop from without a lock.
+ *
+ * Each slot carries a sequence number telling whose
+ * turn it is: slot i is ready for the producer of
+ * position pos when sequence == pos, and ready for the
+ * consumer of pos when sequence == pos + 1. Producers
+ * and consumers only fight over their own counter, and
+ * the slots are cache-line padded so neighbors do not
+ * share a line. N must be a power of two.
+ ***********************************************/
+template <typename T, size_t N>
+class ring_buffer
+{
+   friend class ::TestRingBuffer; // give unit tests access to the privates
+   static_assert(N > 0 && (N & (N - 1)) == 0, "ring_buffer size must be a power of two");
+public:
+
+   //
+   // Construct
+   //
+
+   ring_buffer() : enqueuePos(0), dequeuePos(0)
+   {
+      for (size_t i = 0; i < N; i++)
+         slots[i].sequence.store(i, std::memory_order_relaxed);
+   }
+   ring_buffer(const ring_buffer &) = delete;
+   ring_buffer & operator = (const ring_buffer &) = delete;
+  ~ring_buffer()
+   {
+      for (size_t pos = dequeuePos.load(); pos != enqueuePos.load(); pos++)
+         slots[pos & mask].data().~T();
+   }
+
+   //
+   // Insert
+   //
+
+   bool try_push(const T &  t) { return try_emplace(t);            }
+   bool try_push(      T && t) { return try_emplace(std::move(t)); }
+   template <class ... Args>
+   bool try_emplace(Args && ... args);
+   size_t push_n(const T * pSource, size_t count);
+
+   //
+   // Remove
+   //
+
+   bool try_pop(T & t);
+   size_t pop_n(T * pDest, size_t count);
+
+   //
+   // Status
+   //
+
+   // only a snapshot: other threads may change it right away
+   size_t size() const
+   {
+      size_t tail = enqueuePos.load(std::memory_order_acquire);
+      size_t head = dequeuePos.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+   }
+   bool   empty()    const { return size() == 0; }
+   size_t capacity() const { return N;           }
+
+private:
+
+   struct alignas(cacheLineSize) Slot
+   {
+      std::atomic<size_t> sequence;                  // whose turn it is
+      alignas(T) unsigned char storage[sizeof(T)];   // the user's data
+      T & data() { return *reinterpret_cast<T *>(storage); }
+   };
+
+   // how many slots starting at pos are ready for this side, up to count
+   size_t claimable(size_t pos, size_t count, size_t lag);
+
+   static const size_t mask = N - 1;
+
+   array <Slot, N> slots;
+   alignas(cacheLineSize) std::atomic<size_t> enqueuePos;  // next position to fill
+   alignas(cacheLineSize) std::atomic<size_t> dequeuePos;  // next position to empty
+};
+
+/************************************************
+ * RING BUFFER :: TRY EMPLACE
+ * Claim the next position and build the element
+ * there. Returns false when the buffer is full.
+ ***********************************************/
+template <typename T, size_t N>
+template <class ... Args>
+bool ring_buffer <T, N> :: try_emplace(Args && ... args)
+{
+   size_t pos = enqueuePos.load(std::memory_order_relaxed);
+   for (;;)
+   {
+      Slot & slot = slots[pos & mask];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+      if (diff == 0)
+      {
+         if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            new (slot.storage) T(std::forward<Args>(args)...);
+            slot.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (diff < 0)
+         return false;  // a full lap behind: the buffer is full
+      else
+         pos = enqueuePos.load(std::memory_order_relaxed);
+   }
+}
+
+/************************************************
+ * RING BUFFER :: TRY POP
+ * Take the oldest element. Returns false, leaving
+ * t alone, when the buffer is empty.
+ ***********************************************/
+template <typename T, size_t N>
+bool ring_buffer <T, N> :: try_pop(T & t)
+{
+   size_t pos = dequeuePos.load(std::memory_order_relaxed);
+   for (;;)
+   {
+      Slot & slot = slots[pos & mask];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+      if (diff == 0)
+      {
+         if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            t = std::move(slot.data());
+            slot.data().~T();
+            slot.sequence.store(pos + N, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (diff < 0)
+         return false;  // the producer has not filled it yet: empty
+      else
+         pos = dequeuePos.load(std::memory_order_relaxed);
+   }
+}
+
+/************************************************
+ * RING BUFFER :: CLAIMABLE
+ * Count the run of slots from pos whose sequence
+ * says it is our turn. A producer wants sequence ==
+ * pos (lag 0), a consumer wants pos + 1 (lag 1).
+ ***********************************************/
+template <typename T, size_t N>
+size_t ring_buffer <T, N> :: claimable(size_t pos, size_t count, size_t lag)
+{
+   size_t num = 0;
+   while (num < count && num < N &&
+          slots[(pos + num) & mask].sequence.load(std::memory_order_acquire) == pos + num + lag)
+      num++;
+   return num;
+}
+
+/************************************************
+ * RING BUFFER :: PUSH N
+ * Copy up to count elements in with one claim on
+ * the shared counter. Returns how many went in,
+ * which is fewer than count when the buffer fills.
+ ***********************************************/
+template <typename T, size_t N>
+size_t ring_buffer <T, N> :: push_n(const T * pSource, size_t count)
+{
+   if (count == 0)
+      return 0;
+   size_t pos = enqueuePos.load(std::memory_order_relaxed);
+   size_t num;
+   for (;;)
+   {
+      num = claimable(pos, count, 0);
+      if (num == 0)
+      {
+         // either full or another producer got here first
+         size_t seq = slots[pos & mask].sequence.load(std::memory_order_acquire);
+         if ((ptrdiff_t)seq - (ptrdiff_t)pos < 0)
+            return 0;
+         pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+      else if (enqueuePos.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed))
+         break;
+   }
+
+   for (size_t i = 0; i < num; i++)
+   {
+      Slot & slot = slots[(pos + i) & mask];
+      new (slot.storage) T(pSource[i]);
+      slot.sequence.store(pos + i + 1, std::memory_order_release);
+   }
+   return num;
+}
+
+/************************************************
+ * RING BUFFER :: POP N
+ * Move up to count of the oldest elements out with
+ * one claim on the shared counter. Returns how many
+ * came out.
+ ***********************************************/
+template <typename T, size_t N>
+size_t ring_buffer <T, N> :: pop_n(T * pDest, size_t count)
+{
+   if (count == 0)
+      return 0;
+   size_t pos = dequeuePos.load(std::memory_order_relaxed);
+   size_t num;
+   for (;;)
+   {
+      num = claimable(pos, count, 1);
+      if (num == 0)
+      {
+         // either empty or another consumer got here first
+         size_t seq = slots[pos & mask].sequence.load(std::memory_order_acquire);
+         if ((ptrdiff_t)seq - (ptrdiff_t)(pos + 1) < 0)
+            return 0;
+         pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+      else if (dequeuePos.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed))
+         break;
+   }
+
+   for (size_t i = 0; i < num; i++)
+   {
+      Slot & slot = slots[(pos + i) & mask];
+      pDest[i] = std::move(slot.data());
+      slot.data().~T();
+      slot.sequence.store(pos + i + N, std::memory_order_release);
+   }
+   return num;
+}
+
+/************************************************
+ * SPSC RING BUFFER
+ * The same FIFO queue when there is exactly one
+ * producer thread and one consumer thread. Each side
+ * owns its own counter, so no compare-exchange and no
+ * per-slot sequence is needed; each side also keeps a
+ * cached copy of the other's counter and only rereads
+ * it when the cache says full or empty. N must be a
+ * power of two.
+ ***********************************************/
+template <typename T, size_t N>
+class spsc_ring_buffer
+{
+   friend class ::TestRingBuffer; // give unit tests access to the privates
+   static_assert(N > 0 && (N & (N - 1)) == 0, "spsc_ring_buffer size must be a power of two");
+public:
+
+   //
+   // Construct
+   //
+
+   spsc_ring_buffer() : tail(0), headCache(0), head(0), tailCache(0) { }
+   spsc_ring_buffer(const spsc_ring_buffer &) = delete;
+   spsc_ring_buffer & operator = (const spsc_ring_buffer &) = delete;
+  ~spsc_ring_buffer()
+   {
+      for (size_t pos = head.load(); pos != tail.load(); pos++)
+         slots[pos & mask].data().~T();
+   }
+
+   //
+   // Insert: producer thread only
+   //
+
+   bool try_push(const T &  t) { return try_emplace(t);            }
+   bool try_push(      T && t) { return try_emplace(std::move(t)); }
+   template <class ... Args>
+   bool try_emplace(Args && ... args)
+   {
+      size_t pos = tail.load(std::memory_order_relaxed);
+      if (room(pos, 1) == 0)
+         return false;
+      new (slots[pos & mask].storage) T(std::forward<Args>(args)...);
+      tail.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+   size_t push_n(const T * pSource, size_t count)
+   {
+      size_t pos = tail.load(std::memory_order_relaxed);
+      size_t num = room(pos, count);
+      if (num > count)
+         num = count;
+      for (size_t i = 0; i < num; i++)
+         new (slots[(pos + i) & mask].storage) T(pSource[i]);
+      tail.store(pos + num, std::memory_order_release);
+      return num;
+   }
+
+   //
+   // Remove: consumer thread only
+   //
+
+   bool try_pop(T & t)
+   {
+      size_t pos = head.load(std::memory_order_relaxed);
+      if (waiting(pos, 1) == 0)
+         return false;
+      t = std::move(slots[pos & mask].data());
+      slots[pos & mask].data().~T();
+      head.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+   size_t pop_n(T * pDest, size_t count)
+   {
+      size_t pos = head.load(std::memory_order_relaxed);
+      size_t num = waiting(pos, count);
+      if (num > count)
+         num = count;
+      for (size_t i = 0; i < num; i++)
+      {
+         pDest[i] = std::move(slots[(pos + i) & mask].data());
+         slots[(pos + i) & mask].data().~T();
+      }
+      head.store(pos + num, std::memory_order_release);
+      return num;
+   }
+
+   //
+   // Status
+   //
+
+   // only a snapshot: the other thread may change it right away
+   size_t size() const
+   {
+      size_t first = head.load(std::memory_order_acquire);
+      return tail.load(std::memory_order_acquire) - first;
+   }
+   bool   empty()    const { return size() == 0; }
+   size_t capacity() const { return N;           }
+
+private:
+
+   struct Slot
+   {
+      alignas(T) unsigned char storage[sizeof(T)];   // the user's data
+      T & data() { return *reinterpret_cast<T *>(storage); }
+   };
+
+   // free slots the producer at pos can fill, rereading head only
+   // when the cached copy says there are fewer than it wants
+   size_t room(size_t pos, size_t want)
+   {
+      if (N - (pos - headCache) < want)
+         headCache = head.load(std::memory_order_acquire);
+      return N - (pos - headCache);
+   }
+
+   // filled slots the consumer at pos can take, likewise
+   size_t waiting(size_t pos, size_t want)
+   {
+      if (tailCache - pos < want)
+         tailCache = tail.load(std::memory_order_acquire);
+      return tailCache - pos;
+   }
+
+   static const size_t mask = N - 1;
+
+   array <Slot, N> slots;
+   alignas(cacheLineSize) std::atomic<size_t> tail;   // producer: next position to fill
+   size_t headCache;                                  // producer: last head it saw
+   alignas(cacheLineSize) std::atomic<size_t> head;   // consumer: next position to empty
+   size_t tailCache;                                  // consumer: last tail it saw
+};
+
+}; // namespace custom
@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Header:
+ *    TEST ALGO
+ * Summary:
+ *    Unit tests for the bulk algorithms on array
+ * Author
+ *    Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "algo.h"
+#include "array.h"
+#include "unitTest.h"
+
+#include <cmath>     // for nanf and isnan
+
+class TestAlgo : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+      custom::algo::isa best = custom::algo::level();
+
+      // Each kernel on an array
+      for (custom::algo::isa level : { custom::algo::isa::scalar,
+                                       custom::algo::isa::sse2,
+                                       custom::algo::isa::avx2 })
+         if (custom::algo::use(level) == level)
+         {
+            test_array_int();
+            test_array_float();
+            test_array_floatNaN();
+         }
+      custom::algo::use(best);
+
+      report("Algo");
+   }
+
+   /***************************************
+    * ARRAY
+    ***************************************/
+
+   // a big int array: 0, 1, 2, ... 4095
+   void test_array_int()
+   {  // setup
+      custom::array<int, 4096> a;
+      for (int i = 0; i < 4096; i++)
+         a[i] = i;
+      // exercise
+      // verify
+      assertUnit(custom::algo::sum(a) == 4095LL * 4096 / 2);
+      assertUnit(custom::algo::min(a) == 0);
+      assertUnit(custom::algo::max(a) == 4095);
+      assertUnit(custom::algo::find(a, 2049) == 2049);
+      assertUnit(custom::algo::find(a, -1) == 4096);
+      assertUnit(custom::algo::count_less(a, 1000) == 1000);
+   }  // teardown
+
+   // a small float array, with a tail that does not fill a register
+   void test_array_float()
+   {  // setup
+      //      0    1    2    3    4    5    6    7    8    9   10
+      //    +----+----+----+----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | .5 | -3 | 11 | 11 | 99 | 0  | 7  |
+      //    +----+----+----+----+----+----+----+----+----+----+----+
+      custom::array<float, 11> a = { { 26.0f, 49.0f, 67.0f, 89.0f, 0.5f, -3.0f,
+                                       11.0f, 11.0f, 99.0f, 0.0f, 7.0f } };
+      // exercise
+      // verify
+      assertUnit(custom::algo::sum(a) == 356.5f);
+      assertUnit(custom::algo::min(a) == -3.0f);
+      assertUnit(custom::algo::max(a) == 99.0f);
+      assertUnit(custom::algo::find(a, 11.0f) == 6);
+      assertUnit(custom::algo::find(a, 7.0f) == 10);
+      assertUnit(custom::algo::count_less(a, 11.0f) == 4);
+   }  // teardown
+
+   // a NaN is skipped unless it comes first, just as in the plain loop
+   void test_array_floatNaN()
+   {  // setup
+      //      0    1    2    3    4    5    6    7    8    9   10
+      //    +----+----+----+----+----+----+----+----+----+----+----+
+      //    | 26 |NaN | 67 | 89 | .5 | -3 | 11 | 11 | 99 |NaN | 7  |
+      //    +----+----+----+----+----+----+----+----+----+----+----+
+      float nan = std::nanf("");
+      custom::array<float, 11> a = { { 26.0f, nan, 67.0f, 89.0f, 0.5f, -3.0f,
+                                       11.0f, 11.0f, 99.0f, nan, 7.0f } };
+      // exercise
+      float smallest = custom::algo::min(a);
+      float largest  = custom::algo::max(a);
+      a[0] = nan;
+      // verify
+      assertUnit(smallest == custom::algo::kernel::minScalar(a.data() + 1, 10, 26.0f));
+      assertUnit(largest  == custom::algo::kernel::maxScalar(a.data() + 1, 10, 26.0f));
+      assertUnit(smallest == -3.0f);
+      assertUnit(largest  == 99.0f);
+      assertUnit(std::isnan(custom::algo::min(a)));
+      assertUnit(std::isnan(custom::algo::max(a)));
+   }  // teardown
+};
+
+#endif // DEBUG
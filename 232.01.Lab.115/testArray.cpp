@@ -14,6 +14,8 @@
 
 #include "testSpy.h"       // for the spy unit tests
 #include "testArray.h"     // for the array unit tests
+#include "testRingBuffer.h" // for the ring buffer unit tests
+#include "testAlgo.h"      // for the bulk algorithm unit tests
 int Spy::counters[] = {};
 
 
@@ -28,6 +30,8 @@ int main()
    // unit tests
    TestSpy().run();
    TestArray().run();
+   TestRingBuffer().run();
+   TestAlgo().run();
 #endif // DEBUG
    
    return 0;
@@ -67,6 +67,13 @@ public:
       test_iterator_incrementPrefix();
       test_iterator_incrementPostfix();
 
+      // Fill, data, compare
+      test_fill_standard();
+      test_data_standard();
+      test_subscript_noThrow();
+      test_compare_standard();
+      test_constexpr();
+
       report("Array");
    }
    
@@ -1004,6 +1011,101 @@ public:
       assertStandardFixture(a);
    }  // teardown
 
+   /***************************************
+    * FILL, DATA, COMPARE
+    ***************************************/
+
+   // fill assigns every element
+   void test_fill_standard()
+   {  // setup
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      a.fill(s);
+      // verify
+      assertUnit(Spy::numAssign() == 4);   // assign [26,49,67,89] <- 99
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(a.__elems_[0] == Spy(99));
+      assertUnit(a.__elems_[3] == Spy(99));
+   }  // teardown
+
+   // data points at the first element
+   void test_data_standard()
+   {  // setup
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      const custom::array<Spy, 4> & aConst = a;
+      // exercise
+      Spy * p = a.data();
+      const Spy * pConst = aConst.data();
+      // verify
+      assertUnit(p == &a.__elems_[0]);
+      assertUnit(pConst == &a.__elems_[0]);
+      assertUnit(p[2] == Spy(67));
+   }  // teardown
+
+   // the subscript operator reaches every element without at()
+   void test_subscript_noThrow()
+   {  // setup
+      custom::array<Spy, 4> a;
+      setupStandardFixture(a);
+      Spy::reset();
+      // exercise
+      Spy & s = a[3];
+      // verify
+      assertUnit(&s == &a.__elems_[3]);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+   }  // teardown
+
+   // equality and ordering are element by element
+   void test_compare_standard()
+   {  // setup
+      custom::array<int, 4> a = { { 26, 49, 67, 89 } };
+      custom::array<int, 4> b = { { 26, 49, 67, 89 } };
+      custom::array<int, 4> c = { { 26, 49, 68, 0 } };
+      // exercise
+      // verify
+      assertUnit(a == b);
+      assertUnit(!(a != b));
+      assertUnit(a != c);
+      assertUnit(a < c);
+      assertUnit(!(c < a));
+      assertUnit(!(a < b));
+   }  // teardown
+
+   // size, front, back, iteration, fill and comparison all work at compile time
+   void test_constexpr()
+   {  // setup
+      constexpr custom::array<int, 4> a = { { 26, 49, 67, 89 } };
+      constexpr auto sum = [](custom::array<int, 4> a)
+      {
+         int total = 0;
+         for (auto it = a.begin(); it != a.end(); ++it)
+            total += *it;
+         return total;
+      };
+      constexpr auto filled = [](int value)
+      {
+         custom::array<int, 4> a = { };
+         a.fill(value);
+         return a;
+      };
+      // exercise
+      static_assert(a.size() == 4, "size is constexpr");
+      static_assert(!a.empty(), "empty is constexpr");
+      static_assert(a.front() == 26, "front is constexpr");
+      static_assert(a.back() == 89, "back is constexpr");
+      static_assert(a[2] == 67, "subscript is constexpr");
+      static_assert(sum(a) == 231, "iteration is constexpr");
+      static_assert(filled(7) == custom::array<int, 4>{ { 7, 7, 7, 7 } }, "fill is constexpr");
+      // verify
+      assertUnit(sum(a) == 231);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      0    1    2    3
@@ -0,0 +1,453 @@
+/***********************************************************************
+ * Header:
+ *    TEST RING BUFFER
+ * Summary:
+ *    Unit tests for ring_buffer and spsc_ring_buffer
+ * Author
+ *    Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "ring_buffer.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <thread>   // for std::thread
+#include <vector>   // for a team of threads
+
+class TestRingBuffer : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // MPMC
+      test_construct_default();
+      test_slot_padding();
+      test_tryPush_copy();
+      test_tryPush_move();
+      test_tryPush_full();
+      test_tryPop_empty();
+      test_tryPop_fifo();
+      test_tryPop_wrap();
+      test_pushN_partial();
+      test_popN_partial();
+      test_destructor_standard();
+      test_threads_mpmc();
+      test_threads_mpmcBatch();
+
+      // SPSC
+      test_spsc_fifo();
+      test_spsc_full();
+      test_spsc_batch();
+      test_spsc_destructor();
+      test_threads_spsc();
+
+      report("RingBuffer");
+   }
+
+   /***************************************
+    * MPMC
+    ***************************************/
+
+   // a new buffer is empty and holds nothing
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::ring_buffer<Spy, 4> rb;
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(rb.empty());
+      assertUnit(rb.size() == 0);
+      assertUnit(rb.capacity() == 4);
+      assertUnit(rb.slots[0].sequence == 0);
+      assertUnit(rb.slots[3].sequence == 3);
+   }  // teardown
+
+   // neighboring slots and the two counters never share a cache line
+   void test_slot_padding()
+   {  // setup
+      custom::ring_buffer<int, 4> rb;
+      // exercise
+      const char * p0 = (const char *)&rb.slots[0];
+      const char * p1 = (const char *)&rb.slots[1];
+      const char * pEnqueue = (const char *)&rb.enqueuePos;
+      const char * pDequeue = (const char *)&rb.dequeuePos;
+      // verify
+      assertUnit(p1 - p0 >= (ptrdiff_t)custom::cacheLineSize);
+      assertUnit(pDequeue - pEnqueue >= (ptrdiff_t)custom::cacheLineSize);
+   }  // teardown
+
+   // push a copy
+   void test_tryPush_copy()
+   {  // setup
+      custom::ring_buffer<Spy, 4> rb;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool pushed = rb.try_push(value);
+      // verify
+      assertUnit(pushed);
+      assertUnit(Spy::numCopy() == 1);     // copy     [99]
+      assertUnit(Spy::numAlloc() == 1);    // allocate [99]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(value == Spy(99));
+      assertUnit(rb.size() == 1);
+   }  // teardown
+
+   // push with move semantics
+   void test_tryPush_move()
+   {  // setup
+      custom::ring_buffer<Spy, 4> rb;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool pushed = rb.try_push(std::move(value));
+      // verify
+      assertUnit(pushed);
+      assertUnit(Spy::numCopyMove() == 1); // move [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value.empty());
+   }  // teardown
+
+   // a full buffer refuses more
+   void test_tryPush_full()
+   {  // setup
+      custom::ring_buffer<Spy, 4> rb;
+      setupStandardFixture(rb);
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool pushed = rb.try_push(value);
+      // verify
+      assertUnit(!pushed);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(rb.size() == 4);
+   }  // teardown
+
+   // an empty buffer leaves the destination alone
+   void test_tryPop_empty()
+   {  // setup
+      custom::ring_buffer<Spy, 4> rb;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool popped = rb.try_pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(value == Spy(99));
+   }  // teardown
+
+   // elements come out in the order they went in
+   void test_tryPop_fifo()
+   {  // setup
+      custom::ring_buffer<Spy, 4> rb;
+      setupStandardFixture(rb);
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped26 = rb.try_pop(value) && value == Spy(26);
+      bool popped49 = rb.try_pop(value) && value == Spy(49);
+      bool popped67 = rb.try_pop(value) && value == Spy(67);
+      bool popped89 = rb.try_pop(value) && value == Spy(89);
+      // verify
+      assertUnit(popped26);
+      assertUnit(popped49);
+      assertUnit(popped67);
+      assertUnit(popped89);
+      assertUnit(Spy::numAssignMove() == 4);  // move    [26,49,67,89]
+      assertUnit(Spy::numDestructor() >= 4);  // destroy [26,49,67,89]
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // positions keep counting past the end of the array
+   void test_tryPop_wrap()
+   {  // setup
+      custom::ring_buffer<int, 4> rb;
+      int value = 0;
+      bool inOrder = true;
+      // exercise
+      for (int i = 0; i < 100; i++)
+      {
+         rb.try_push(i);
+         rb.try_push(i + 1000);
+         inOrder = inOrder && rb.try_pop(value) && value == i;
+         inOrder = inOrder && rb.try_pop(value) && value == i + 1000;
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(rb.enqueuePos == 200);
+      assertUnit(rb.dequeuePos == 200);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // a batch larger than the room left only partially goes in
+   void test_pushN_partial()
+   {  // setup
+      custom::ring_buffer<int, 8> rb;
+      rb.try_push(1);
+      rb.try_push(2);
+      int batch[10] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+      // exercise
+      size_t num = rb.push_n(batch, 10);
+      // verify
+      assertUnit(num == 6);
+      assertUnit(rb.size() == 8);
+      assertUnit(rb.push_n(batch, 10) == 0);
+      int value = 0;
+      assertUnit(rb.try_pop(value) && value == 1);
+      assertUnit(rb.try_pop(value) && value == 2);
+      assertUnit(rb.try_pop(value) && value == 10);
+   }  // teardown
+
+   // a batch larger than what is waiting only partially comes out
+   void test_popN_partial()
+   {  // setup
+      custom::ring_buffer<int, 8> rb;
+      int batch[5] = { 26, 49, 67, 89, 99 };
+      rb.push_n(batch, 5);
+      int out[8] = { };
+      // exercise
+      size_t num = rb.pop_n(out, 8);
+      // verify
+      assertUnit(num == 5);
+      assertUnit(out[0] == 26);
+      assertUnit(out[4] == 99);
+      assertUnit(out[5] == 0);
+      assertUnit(rb.empty());
+      assertUnit(rb.pop_n(out, 8) == 0);
+   }  // teardown
+
+   // whatever is left is destroyed with the buffer
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::ring_buffer<Spy, 8> rb;
+         setupStandardFixture(rb);
+         Spy value;
+         rb.try_pop(value);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy [49,67,89], value
+      assertUnit(Spy::numDelete() == 4);
+   }
+
+   // several producers and consumers: nothing lost, nothing duplicated
+   void test_threads_mpmc()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 20000;
+      custom::ring_buffer<int, 64> rb;
+      std::vector<std::thread> team;
+      std::vector<int> seen(numThreads * numEach, 0);
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&rb, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               while (!rb.try_push(t * numEach + i))
+                  std::this_thread::yield();
+         });
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&rb, &seen]()
+         {
+            int value;
+            for (int i = 0; i < numEach; i++)
+            {
+               while (!rb.try_pop(value))
+                  std::this_thread::yield();
+               seen[value]++;
+            }
+         });
+      for (auto & thread : team)
+         thread.join();
+      // verify
+      bool once = true;
+      for (int count : seen)
+         once = once && count == 1;
+      assertUnit(once);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // the same with producers and consumers moving batches
+   void test_threads_mpmcBatch()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 20000;
+      custom::ring_buffer<int, 64> rb;
+      std::vector<std::thread> team;
+      std::vector<int> seen(numThreads * numEach, 0);
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&rb, t]()
+         {
+            int batch[7];
+            for (int i = 0; i < numEach; i += 7)
+            {
+               size_t count = numEach - i < 7 ? numEach - i : 7;
+               for (size_t j = 0; j < count; j++)
+                  batch[j] = t * numEach + i + (int)j;
+               size_t done = 0;
+               while (done < count)
+                  done += rb.push_n(batch + done, count - done);
+            }
+         });
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&rb, &seen]()
+         {
+            int batch[5];
+            int received = 0;
+            while (received < numEach)
+            {
+               size_t want = numEach - received < 5 ? numEach - received : 5;
+               size_t num = rb.pop_n(batch, want);
+               for (size_t j = 0; j < num; j++)
+                  seen[batch[j]]++;
+               received += (int)num;
+               if (num == 0)
+                  std::this_thread::yield();
+            }
+         });
+      for (auto & thread : team)
+         thread.join();
+      // verify
+      bool once = true;
+      for (int count : seen)
+         once = once && count == 1;
+      assertUnit(once);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   /***************************************
+    * SPSC
+    ***************************************/
+
+   // elements come out in the order they went in
+   void test_spsc_fifo()
+   {  // setup
+      custom::spsc_ring_buffer<Spy, 4> rb;
+      Spy value;
+      // exercise
+      rb.try_push(Spy(26));
+      rb.try_push(Spy(49));
+      bool popped26 = rb.try_pop(value) && value == Spy(26);
+      rb.try_push(Spy(67));
+      bool popped49 = rb.try_pop(value) && value == Spy(49);
+      bool popped67 = rb.try_pop(value) && value == Spy(67);
+      // verify
+      assertUnit(popped26);
+      assertUnit(popped49);
+      assertUnit(popped67);
+      assertUnit(!rb.try_pop(value));
+      assertUnit(rb.empty());
+   }  // teardown
+
+   // a full buffer refuses more until the consumer makes room
+   void test_spsc_full()
+   {  // setup
+      custom::spsc_ring_buffer<int, 4> rb;
+      for (int i = 0; i < 4; i++)
+         rb.try_push(i);
+      int value = 0;
+      // exercise
+      bool pushedFull = rb.try_push(99);
+      rb.try_pop(value);
+      bool pushedRoom = rb.try_push(99);
+      // verify
+      assertUnit(!pushedFull);
+      assertUnit(pushedRoom);
+      assertUnit(value == 0);
+      assertUnit(rb.size() == 4);
+   }  // teardown
+
+   // batches stop at the room or elements available
+   void test_spsc_batch()
+   {  // setup
+      custom::spsc_ring_buffer<int, 8> rb;
+      int batch[10] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+      int out[10] = { };
+      // exercise
+      size_t numIn = rb.push_n(batch, 10);
+      size_t numOut = rb.pop_n(out, 3);
+      size_t numMore = rb.push_n(batch, 10);
+      // verify
+      assertUnit(numIn == 8);
+      assertUnit(numOut == 3);
+      assertUnit(numMore == 3);
+      assertUnit(out[0] == 10);
+      assertUnit(out[2] == 12);
+      assertUnit(rb.pop_n(out, 10) == 8);
+      assertUnit(out[0] == 13);
+      assertUnit(out[7] == 12);
+   }  // teardown
+
+   // whatever is left is destroyed with the buffer
+   void test_spsc_destructor()
+   {  // setup
+      {
+         custom::spsc_ring_buffer<Spy, 4> rb;
+         rb.try_push(Spy(26));
+         rb.try_push(Spy(49));
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 2); // destroy [26,49]
+   }
+
+   // one producer thread, one consumer thread
+   void test_threads_spsc()
+   {  // setup
+      const int num = 100000;
+      custom::spsc_ring_buffer<int, 16> rb;
+      bool inOrder = true;
+      // exercise
+      std::thread producer([&rb]()
+      {
+         for (int i = 0; i < num; i++)
+            while (!rb.try_push(i))
+               std::this_thread::yield();
+      });
+      std::thread consumer([&rb, &inOrder]()
+      {
+         int value;
+         for (int i = 0; i < num; i++)
+         {
+            while (!rb.try_pop(value))
+               std::this_thread::yield();
+            inOrder = inOrder && value == i;
+         }
+      });
+      producer.join();
+      consumer.join();
+      // verify
+      assertUnit(inOrder);
+      assertUnit(rb.empty());
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |
+    *    +----+----+----+----+
+    *************************************************************/
+   template <size_t N>
+   void setupStandardFixture(custom::ring_buffer<Spy, N>& rb)
+   {
+      rb.try_push(Spy(26));
+      rb.try_push(Spy(49));
+      rb.try_push(Spy(67));
+      rb.try_push(Spy(89));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,624 @@
+/***********************************************************************
+ * Header:
+ *    ALGO
+ * Summary:
+ *    Bulk algorithms over the raw data of our containers, with SSE2
+ *    and AVX2 kernels picked at run time
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the definition of:
+ *        algo::sum              : add up every element
+ *        algo::min, algo::max   : smallest and largest element
+ *        algo::find             : index of the first equal element
+ *        algo::count_less       : how many elements are less than a value
+ *    each for int and float, on a pointer and count or on any
+ *    container with data() and size()
+ * Authors
+ *    Emilio Guerrero
+ *    Austin Jesperson
+ *    Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CUSTOM_ALGO_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>   // for __cpuid and _xgetbv
+#endif
+#endif
+
+// GCC and Clang only let us use AVX2 intrinsics in functions marked for it;
+// MSVC lets any function use them
+#if defined(CUSTOM_ALGO_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CUSTOM_TARGET_SSE2 __attribute__((target("sse2")))
+#define CUSTOM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CUSTOM_TARGET_SSE2
+#define CUSTOM_TARGET_AVX2
+#endif
+
+class TestAlgo; // forward declaration for unit tests
+
+namespace custom
+{
+namespace algo
+{
+
+/*****************************************
+ * ISA
+ * The instruction sets we have kernels for,
+ * weakest to strongest
+ ****************************************/
+enum class isa { scalar, sse2, avx2 };
+
+/*****************************************
+ * DETECT
+ * The strongest instruction set this CPU and
+ * operating system will run
+ ****************************************/
+inline isa detect()
+{
+#if defined(CUSTOM_ALGO_X86) && defined(_MSC_VER)
+   int info[4];
+   __cpuid(info, 0);
+   int maxLeaf = info[0];
+   __cpuid(info, 1);
+   bool sse2    = (info[3] & (1 << 26)) != 0;
+   bool osxsave = (info[2] & (1 << 27)) != 0;
+   bool avx     = (info[2] & (1 << 28)) != 0;
+   bool avx2    = false;
+   if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+   {
+      __cpuidex(info, 7, 0);
+      avx2 = (info[1] & (1 << 5)) != 0;
+   }
+   return avx2 ? isa::avx2 : sse2 ? isa::sse2 : isa::scalar;
+#elif defined(CUSTOM_ALGO_X86)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return isa::avx2;
+   if (__builtin_cpu_supports("sse2"))
+      return isa::sse2;
+   return isa::scalar;
+#else
+   return isa::scalar;
+#endif
+}
+
+/*****************************************
+ * LEVEL
+ * The instruction set the algorithms use. Starts
+ * at detect(); use() can lower it, which is handy
+ * for testing and timing each kernel, but never
+ * raise it past what the CPU supports.
+ ****************************************/
+inline isa & currentLevel()
+{
+   static isa level = detect();
+   return level;
+}
+inline isa level() { return currentLevel(); }
+inline isa use(isa wanted)
+{
+   isa best = detect();
+   currentLevel() = wanted < best ? wanted : best;
+   return currentLevel();
+}
+
+namespace kernel
+{
+
+/*****************************************
+ * SCALAR KERNELS
+ * Plain loops: the reference answer, the tail
+ * after the wide loops, and everything off x86
+ ****************************************/
+template <typename T, typename S>
+S sumScalar(const T * p, size_t n, S total)
+{
+   for (size_t i = 0; i < n; i++)
+      total += p[i];
+   return total;
+}
+
+template <typename T>
+T minScalar(const T * p, size_t n, T best)
+{
+   for (size_t i = 0; i < n; i++)
+      if (p[i] < best)
+         best = p[i];
+   return best;
+}
+
+template <typename T>
+T maxScalar(const T * p, size_t n, T best)
+{
+   for (size_t i = 0; i < n; i++)
+      if (best < p[i])
+         best = p[i];
+   return best;
+}
+
+template <typename T>
+size_t findScalar(const T * p, size_t n, T value)
+{
+   for (size_t i = 0; i < n; i++)
+      if (p[i] == value)
+         return i;
+   return n;
+}
+
+template <typename T>
+size_t countLessScalar(const T * p, size_t n, T value)
+{
+   size_t count = 0;
+   for (size_t i = 0; i < n; i++)
+      count += p[i] < value ? 1 : 0;
+   return count;
+}
+
+#ifdef CUSTOM_ALGO_X86
+
+// lane counters are 32 bits, so empty them into a size_t this often
+static const size_t countBlock = (size_t)1 << 30;
+
+/*****************************************
+ * SSE2 KERNELS
+ * Four lanes at a time. SSE2 has no 32-bit
+ * integer min/max or sign extension, so those
+ * are built from compares and shuffles.
+ ****************************************/
+CUSTOM_TARGET_SSE2 inline long long sumSse2(const int * p, size_t n)
+{
+   __m128i total = _mm_setzero_si128();
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i v    = _mm_loadu_si128((const __m128i *)(p + i));
+      __m128i sign = _mm_srai_epi32(v, 31);
+      total = _mm_add_epi64(total, _mm_unpacklo_epi32(v, sign));
+      total = _mm_add_epi64(total, _mm_unpackhi_epi32(v, sign));
+   }
+   long long lanes[2];
+   _mm_storeu_si128((__m128i *)lanes, total);
+   return sumScalar(p + i, n - i, lanes[0] + lanes[1]);
+}
+
+CUSTOM_TARGET_SSE2 inline float sumSse2(const float * p, size_t n)
+{
+   __m128 total = _mm_setzero_ps();
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      total = _mm_add_ps(total, _mm_loadu_ps(p + i));
+   float lanes[4];
+   _mm_storeu_ps(lanes, total);
+   return sumScalar(p + i, n - i, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+CUSTOM_TARGET_SSE2 inline int minSse2(const int * p, size_t n)
+{
+   if (n < 4)
+      return minScalar(p + 1, n - 1, p[0]);
+   __m128i best = _mm_loadu_si128((const __m128i *)p);
+   size_t i = 4;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i v    = _mm_loadu_si128((const __m128i *)(p + i));
+      __m128i less = _mm_cmplt_epi32(v, best);
+      best = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, best));
+   }
+   int lanes[4];
+   _mm_storeu_si128((__m128i *)lanes, best);
+   return minScalar(p + i, n - i, minScalar(lanes + 1, 3, lanes[0]));
+}
+
+CUSTOM_TARGET_SSE2 inline int maxSse2(const int * p, size_t n)
+{
+   if (n < 4)
+      return maxScalar(p + 1, n - 1, p[0]);
+   __m128i best = _mm_loadu_si128((const __m128i *)p);
+   size_t i = 4;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i v    = _mm_loadu_si128((const __m128i *)(p + i));
+      __m128i more = _mm_cmpgt_epi32(v, best);
+      best = _mm_or_si128(_mm_and_si128(more, v), _mm_andnot_si128(more, best));
+   }
+   int lanes[4];
+   _mm_storeu_si128((__m128i *)lanes, best);
+   return maxScalar(p + i, n - i, maxScalar(lanes + 1, 3, lanes[0]));
+}
+
+CUSTOM_TARGET_SSE2 inline float minSse2(const float * p, size_t n)
+{
+   if (n < 4)
+      return minScalar(p + 1, n - 1, p[0]);
+   // _mm_min_ps(v, best) is v < best ? v : best, the plain loop's test, and
+   // every lane starts from p[0], so a NaN is skipped or wins just as there
+   __m128 best = _mm_set1_ps(p[0]);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      best = _mm_min_ps(_mm_loadu_ps(p + i), best);
+   float lanes[4];
+   _mm_storeu_ps(lanes, best);
+   return minScalar(p + i, n - i, minScalar(lanes + 1, 3, lanes[0]));
+}
+
+CUSTOM_TARGET_SSE2 inline float maxSse2(const float * p, size_t n)
+{
+   if (n < 4)
+      return maxScalar(p + 1, n - 1, p[0]);
+   __m128 best = _mm_set1_ps(p[0]);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      best = _mm_max_ps(_mm_loadu_ps(p + i), best);
+   float lanes[4];
+   _mm_storeu_ps(lanes, best);
+   return maxScalar(p + i, n - i, maxScalar(lanes + 1, 3, lanes[0]));
+}
+
+CUSTOM_TARGET_SSE2 inline size_t findSse2(const int * p, size_t n, int value)
+{
+   __m128i target = _mm_set1_epi32(value);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p + i)), target);
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+      if (mask)
+         return i + findScalar(p + i, 4, value);
+   }
+   return i + findScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_SSE2 inline size_t findSse2(const float * p, size_t n, float value)
+{
+   __m128 target = _mm_set1_ps(value);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), target)))
+         return i + findScalar(p + i, 4, value);
+   return i + findScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_SSE2 inline size_t countLessSse2(const int * p, size_t n, int value)
+{
+   __m128i target = _mm_set1_epi32(value);
+   size_t count = 0;
+   size_t i = 0;
+   while (i + 4 <= n)
+   {
+      // each true compare is -1, so subtracting counts up
+      __m128i lanes = _mm_setzero_si128();
+      size_t end = n - i > countBlock ? i + countBlock : n;
+      for (; i + 4 <= end; i += 4)
+         lanes = _mm_sub_epi32(lanes,
+            _mm_cmplt_epi32(_mm_loadu_si128((const __m128i *)(p + i)), target));
+      unsigned int out[4];
+      _mm_storeu_si128((__m128i *)out, lanes);
+      count += (size_t)out[0] + out[1] + out[2] + out[3];
+   }
+   return count + countLessScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_SSE2 inline size_t countLessSse2(const float * p, size_t n, float value)
+{
+   __m128 target = _mm_set1_ps(value);
+   size_t count = 0;
+   size_t i = 0;
+   while (i + 4 <= n)
+   {
+      __m128i lanes = _mm_setzero_si128();
+      size_t end = n - i > countBlock ? i + countBlock : n;
+      for (; i + 4 <= end; i += 4)
+         lanes = _mm_sub_epi32(lanes,
+            _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(p + i), target)));
+      unsigned int out[4];
+      _mm_storeu_si128((__m128i *)out, lanes);
+      count += (size_t)out[0] + out[1] + out[2] + out[3];
+   }
+   return count + countLessScalar(p + i, n - i, value);
+}
+
+/*****************************************
+ * AVX2 KERNELS
+ * Eight lanes at a time
+ ****************************************/
+CUSTOM_TARGET_AVX2 inline long long sumAvx2(const int * p, size_t n)
+{
+   __m256i total = _mm256_setzero_si256();
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+      total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+      total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+   }
+   long long lanes[4];
+   _mm256_storeu_si256((__m256i *)lanes, total);
+   return sumScalar(p + i, n - i, (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+CUSTOM_TARGET_AVX2 inline float sumAvx2(const float * p, size_t n)
+{
+   __m256 total = _mm256_setzero_ps();
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      total = _mm256_add_ps(total, _mm256_loadu_ps(p + i));
+   float lanes[8];
+   _mm256_storeu_ps(lanes, total);
+   float sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+               ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+   return sumScalar(p + i, n - i, sum);
+}
+
+CUSTOM_TARGET_AVX2 inline int minAvx2(const int * p, size_t n)
+{
+   if (n < 8)
+      return minScalar(p + 1, n - 1, p[0]);
+   __m256i best = _mm256_loadu_si256((const __m256i *)p);
+   size_t i = 8;
+   for (; i + 8 <= n; i += 8)
+      best = _mm256_min_epi32(best, _mm256_loadu_si256((const __m256i *)(p + i)));
+   int lanes[8];
+   _mm256_storeu_si256((__m256i *)lanes, best);
+   return minScalar(p + i, n - i, minScalar(lanes + 1, 7, lanes[0]));
+}
+
+CUSTOM_TARGET_AVX2 inline int maxAvx2(const int * p, size_t n)
+{
+   if (n < 8)
+      return maxScalar(p + 1, n - 1, p[0]);
+   __m256i best = _mm256_loadu_si256((const __m256i *)p);
+   size_t i = 8;
+   for (; i + 8 <= n; i += 8)
+      best = _mm256_max_epi32(best, _mm256_loadu_si256((const __m256i *)(p + i)));
+   int lanes[8];
+   _mm256_storeu_si256((__m256i *)lanes, best);
+   return maxScalar(p + i, n - i, maxScalar(lanes + 1, 7, lanes[0]));
+}
+
+CUSTOM_TARGET_AVX2 inline float minAvx2(const float * p, size_t n)
+{
+   if (n < 8)
+      return minScalar(p + 1, n - 1, p[0]);
+   __m256 best = _mm256_set1_ps(p[0]);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      best = _mm256_min_ps(_mm256_loadu_ps(p + i), best);
+   float lanes[8];
+   _mm256_storeu_ps(lanes, best);
+   return minScalar(p + i, n - i, minScalar(lanes + 1, 7, lanes[0]));
+}
+
+CUSTOM_TARGET_AVX2 inline float maxAvx2(const float * p, size_t n)
+{
+   if (n < 8)
+      return maxScalar(p + 1, n - 1, p[0]);
+   __m256 best = _mm256_set1_ps(p[0]);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      best = _mm256_max_ps(_mm256_loadu_ps(p + i), best);
+   float lanes[8];
+   _mm256_storeu_ps(lanes, best);
+   return maxScalar(p + i, n - i, maxScalar(lanes + 1, 7, lanes[0]));
+}
+
+CUSTOM_TARGET_AVX2 inline size_t findAvx2(const int * p, size_t n, int value)
+{
+   __m256i target = _mm256_set1_epi32(value);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(p + i)), target);
+      if (_mm256_movemask_ps(_mm256_castsi256_ps(equal)))
+         return i + findScalar(p + i, 8, value);
+   }
+   return i + findScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_AVX2 inline size_t findAvx2(const float * p, size_t n, float value)
+{
+   __m256 target = _mm256_set1_ps(value);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), target, _CMP_EQ_OQ)))
+         return i + findScalar(p + i, 8, value);
+   return i + findScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_AVX2 inline size_t countLessAvx2(const int * p, size_t n, int value)
+{
+   __m256i target = _mm256_set1_epi32(value);
+   size_t count = 0;
+   size_t i = 0;
+   while (i + 8 <= n)
+   {
+      __m256i lanes = _mm256_setzero_si256();
+      size_t end = n - i > countBlock ? i + countBlock : n;
+      for (; i + 8 <= end; i += 8)
+         lanes = _mm256_sub_epi32(lanes,
+            _mm256_cmpgt_epi32(target, _mm256_loadu_si256((const __m256i *)(p + i))));
+      unsigned int out[8];
+      _mm256_storeu_si256((__m256i *)out, lanes);
+      for (int j = 0; j < 8; j++)
+         count += out[j];
+   }
+   return count + countLessScalar(p + i, n - i, value);
+}
+
+CUSTOM_TARGET_AVX2 inline size_t countLessAvx2(const float * p, size_t n, float value)
+{
+   __m256 target = _mm256_set1_ps(value);
+   size_t count = 0;
+   size_t i = 0;
+   while (i + 8 <= n)
+   {
+      __m256i lanes = _mm256_setzero_si256();
+      size_t end = n - i > countBlock ? i + countBlock : n;
+      for (; i + 8 <= end; i += 8)
+         lanes = _mm256_sub_epi32(lanes, _mm256_castps_si256(
+            _mm256_cmp_ps(_mm256_loadu_ps(p + i), target, _CMP_LT_OQ)));
+      unsigned int out[8];
+      _mm256_storeu_si256((__m256i *)out, lanes);
+      for (int j = 0; j < 8; j++)
+         count += out[j];
+   }
+   return count + countLessScalar(p + i, n - i, value);
+}
+
+#endif // CUSTOM_ALGO_X86
+
+} // namespace kernel
+
+/*****************************************
+ * DISPATCH
+ * Send each call to the kernel for level()
+ ****************************************/
+#ifdef CUSTOM_ALGO_X86
+#define CUSTOM_ALGO_DISPATCH(avx2Call, sse2Call, scalarCall) \
+   switch (level())                                           \
+   {                                                          \
+      case isa::avx2: return avx2Call;                        \
+      case isa::sse2: return sse2Call;                        \
+      default:        return scalarCall;                      \
+   }
+#else
+#define CUSTOM_ALGO_DISPATCH(avx2Call, sse2Call, scalarCall) \
+   return scalarCall;
+#endif
+
+/*****************************************
+ * SUM
+ * Add up n elements. Integers are added in
+ * 64 bits so the total does not overflow.
+ ****************************************/
+inline long long sum(const int * p, size_t n)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::sumAvx2(p, n),
+                        kernel::sumSse2(p, n),
+                        kernel::sumScalar(p, n, 0LL))
+}
+inline float sum(const float * p, size_t n)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::sumAvx2(p, n),
+                        kernel::sumSse2(p, n),
+                        kernel::sumScalar(p, n, 0.0f))
+}
+
+/*****************************************
+ * MIN and MAX
+ * The smallest or largest of n elements.
+ * There must be at least one. A NaN is
+ * skipped unless it comes first, in which
+ * case it is the answer, on every level.
+ ****************************************/
+inline int min(const int * p, size_t n)
+{
+   assert(n > 0);
+   CUSTOM_ALGO_DISPATCH(kernel::minAvx2(p, n),
+                        kernel::minSse2(p, n),
+                        kernel::minScalar(p + 1, n - 1, p[0]))
+}
+inline float min(const float * p, size_t n)
+{
+   assert(n > 0);
+   CUSTOM_ALGO_DISPATCH(kernel::minAvx2(p, n),
+                        kernel::minSse2(p, n),
+                        kernel::minScalar(p + 1, n - 1, p[0]))
+}
+inline int max(const int * p, size_t n)
+{
+   assert(n > 0);
+   CUSTOM_ALGO_DISPATCH(kernel::maxAvx2(p, n),
+                        kernel::maxSse2(p, n),
+                        kernel::maxScalar(p + 1, n - 1, p[0]))
+}
+inline float max(const float * p, size_t n)
+{
+   assert(n > 0);
+   CUSTOM_ALGO_DISPATCH(kernel::maxAvx2(p, n),
+                        kernel::maxSse2(p, n),
+                        kernel::maxScalar(p + 1, n - 1, p[0]))
+}
+
+/*****************************************
+ * FIND
+ * Index of the first element equal to value,
+ * or n if there is none
+ ****************************************/
+inline size_t find(const int * p, size_t n, int value)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::findAvx2(p, n, value),
+                        kernel::findSse2(p, n, value),
+                        kernel::findScalar(p, n, value))
+}
+inline size_t find(const float * p, size_t n, float value)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::findAvx2(p, n, value),
+                        kernel::findSse2(p, n, value),
+                        kernel::findScalar(p, n, value))
+}
+
+/*****************************************
+ * COUNT LESS
+ * How many of n elements are less than value
+ ****************************************/
+inline size_t count_less(const int * p, size_t n, int value)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::countLessAvx2(p, n, value),
+                        kernel::countLessSse2(p, n, value),
+                        kernel::countLessScalar(p, n, value))
+}
+inline size_t count_less(const float * p, size_t n, float value)
+{
+   CUSTOM_ALGO_DISPATCH(kernel::countLessAvx2(p, n, value),
+                        kernel::countLessSse2(p, n, value),
+                        kernel::countLessScalar(p, n, value))
+}
+
+#undef CUSTOM_ALGO_DISPATCH
+
+/*****************************************
+ * CONTAINER VERSIONS
+ * The same on anything with data() and size(),
+ * such as custom::vector and custom::array
+ ****************************************/
+template <class Container>
+auto sum(const Container & c) -> decltype(sum(c.data(), c.size()))
+{
+   return sum(c.data(), c.size());
+}
+template <class Container>
+auto min(const Container & c) -> decltype(min(c.data(), c.size()))
+{
+   return min(c.data(), c.size());
+}
+template <class Container>
+auto max(const Container & c) -> decltype(max(c.data(), c.size()))
+{
+   return max(c.data(), c.size());
+}
+template <class Container, typename T>
+auto find(const Container & c, const T & value) -> decltype(find(c.data(), c.size(), value))
+{
+   return find(c.data(), c.size(), value);
+}
+template <class Container, typename T>
+auto count_less(const Container & c, const T & value) -> decltype(count_less(c.data(), c.size(), value))
+{
+   return count_less(c.data(), c.size(), value);
+}
+
+} // namespace algo
+} // namespace custom
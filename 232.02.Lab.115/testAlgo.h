@@ -0,0 +1,344 @@
+/***********************************************************************
+ * Header:
+ *    TEST ALGO
+ * Summary:
+ *    Unit tests for the bulk algorithms
+ * Authors
+ *    Emilio Guerrero
+ *    Austin Jesperson
+ *    Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "algo.h"
+#include "vector.h"
+#include "unitTest.h"
+
+#include <cstdlib>   // for rand
+#include <cmath>     // for nanf and isnan
+
+class TestAlgo : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+      custom::algo::isa best = custom::algo::level();
+
+      // Level
+      test_level_detect();
+      test_level_useClamps();
+
+      // Each kernel against the scalar loop
+      for (custom::algo::isa level : { custom::algo::isa::scalar,
+                                       custom::algo::isa::sse2,
+                                       custom::algo::isa::avx2 })
+         if (custom::algo::use(level) == level)
+         {
+            test_sum_int();
+            test_sum_intOverflow();
+            test_sum_float();
+            test_minMax_int();
+            test_minMax_float();
+            test_minMax_floatNaN();
+            test_find_int();
+            test_find_float();
+            test_countLess_int();
+            test_countLess_float();
+         }
+      custom::algo::use(best);
+
+      // Containers
+      test_vector_standard();
+      test_vector_empty();
+
+      report("Algo");
+   }
+
+   /***************************************
+    * LEVEL
+    ***************************************/
+
+   // we start out at the best the CPU offers
+   void test_level_detect()
+   {  // setup
+      // exercise
+      custom::algo::isa level = custom::algo::level();
+      // verify
+      assertUnit(level == custom::algo::detect());
+   }  // teardown
+
+   // asking for more than the CPU has gives what it has
+   void test_level_useClamps()
+   {  // setup
+      custom::algo::isa best = custom::algo::detect();
+      // exercise
+      custom::algo::isa low  = custom::algo::use(custom::algo::isa::scalar);
+      custom::algo::isa high = custom::algo::use(custom::algo::isa::avx2);
+      // verify
+      assertUnit(low == custom::algo::isa::scalar);
+      assertUnit(high == best);
+      assertUnit(custom::algo::level() == best);
+   }  // teardown
+
+   /***************************************
+    * SUM
+    ***************************************/
+
+   // every length and alignment matches the plain loop
+   void test_sum_int()
+   {  // setup
+      int data[80];
+      fill(data, 80);
+      bool same = true;
+      // exercise
+      for (size_t offset = 0; offset < 4; offset++)
+         for (size_t n = 0; n + offset <= 80; n++)
+            same = same && custom::algo::sum(data + offset, n) ==
+                           custom::algo::kernel::sumScalar(data + offset, n, 0LL);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // the total of many big numbers does not wrap
+   void test_sum_intOverflow()
+   {  // setup
+      int data[37];
+      for (int i = 0; i < 37; i++)
+         data[i] = i % 2 ? 2000000000 : -5;
+      // exercise
+      long long total = custom::algo::sum(data, 37);
+      // verify
+      assertUnit(total == 18LL * 2000000000 - 19 * 5);
+   }  // teardown
+
+   // small whole numbers add up exactly in any order
+   void test_sum_float()
+   {  // setup
+      float data[80];
+      fill(data, 80);
+      bool same = true;
+      // exercise
+      for (size_t offset = 0; offset < 4; offset++)
+         for (size_t n = 0; n + offset <= 80; n++)
+            same = same && custom::algo::sum(data + offset, n) ==
+                           custom::algo::kernel::sumScalar(data + offset, n, 0.0f);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   /***************************************
+    * MIN MAX
+    ***************************************/
+
+   // the extremes are found wherever they are
+   void test_minMax_int()
+   {  // setup
+      int data[80];
+      fill(data, 80);
+      data[37] = -1000;
+      data[61] = 1000;
+      bool same = true;
+      // exercise
+      for (size_t n = 1; n <= 80; n++)
+      {
+         same = same && custom::algo::min(data, n) ==
+                        custom::algo::kernel::minScalar(data + 1, n - 1, data[0]);
+         same = same && custom::algo::max(data, n) ==
+                        custom::algo::kernel::maxScalar(data + 1, n - 1, data[0]);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(custom::algo::min(data, 80) == -1000);
+      assertUnit(custom::algo::max(data, 80) == 1000);
+      assertUnit(custom::algo::min(data + 79, 1) == data[79]);
+   }  // teardown
+
+   // the same for float
+   void test_minMax_float()
+   {  // setup
+      float data[80];
+      fill(data, 80);
+      data[78] = -75.5f;
+      data[2] = 999.25f;
+      bool same = true;
+      // exercise
+      for (size_t n = 1; n <= 80; n++)
+      {
+         same = same && custom::algo::min(data, n) ==
+                        custom::algo::kernel::minScalar(data + 1, n - 1, data[0]);
+         same = same && custom::algo::max(data, n) ==
+                        custom::algo::kernel::maxScalar(data + 1, n - 1, data[0]);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(custom::algo::min(data, 80) == -75.5f);
+      assertUnit(custom::algo::max(data, 80) == 999.25f);
+   }  // teardown
+
+   // a NaN anywhere gives what the plain loop gives
+   void test_minMax_floatNaN()
+   {  // setup
+      float data[80];
+      bool same = true;
+      // exercise
+      for (size_t nan = 0; nan < 20; nan++)
+      {
+         fill(data, 80);
+         data[nan] = std::nanf("");
+         for (size_t n = nan + 1; n <= 80; n++)
+         {
+            same = same && sameFloat(custom::algo::min(data, n),
+                              custom::algo::kernel::minScalar(data + 1, n - 1, data[0]));
+            same = same && sameFloat(custom::algo::max(data, n),
+                              custom::algo::kernel::maxScalar(data + 1, n - 1, data[0]));
+         }
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(!std::isnan(custom::algo::min(data, 80)));
+      data[0] = std::nanf("");
+      assertUnit(std::isnan(custom::algo::min(data, 80)));
+      assertUnit(std::isnan(custom::algo::max(data, 80)));
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // the first match wins, and a miss gives n
+   void test_find_int()
+   {  // setup
+      int data[80];
+      for (int i = 0; i < 80; i++)
+         data[i] = i;
+      data[50] = 13;
+      bool found = true;
+      // exercise
+      for (int i = 0; i < 80; i++)
+         found = found && custom::algo::find(data, 80, i) == (i == 50 ? 80 : (size_t)i);
+      // verify
+      assertUnit(found);
+      assertUnit(custom::algo::find(data, 80, 13) == 13);
+      assertUnit(custom::algo::find(data + 14, 66, 13) == 36);
+      assertUnit(custom::algo::find(data, 80, -1) == 80);
+      assertUnit(custom::algo::find(data, 0, 0) == 0);
+   }  // teardown
+
+   // the same for float
+   void test_find_float()
+   {  // setup
+      float data[80];
+      for (int i = 0; i < 80; i++)
+         data[i] = i * 0.5f;
+      bool found = true;
+      // exercise
+      for (int i = 0; i < 80; i++)
+         found = found && custom::algo::find(data, 80, i * 0.5f) == (size_t)i;
+      // verify
+      assertUnit(found);
+      assertUnit(custom::algo::find(data, 80, 0.25f) == 80);
+   }  // teardown
+
+   /***************************************
+    * COUNT LESS
+    ***************************************/
+
+   // every length and threshold matches the plain loop
+   void test_countLess_int()
+   {  // setup
+      int data[80];
+      fill(data, 80);
+      bool same = true;
+      // exercise
+      for (size_t n = 0; n <= 80; n++)
+         for (int value = -60; value <= 60; value += 7)
+            same = same && custom::algo::count_less(data, n, value) ==
+                           custom::algo::kernel::countLessScalar(data, n, value);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // the same for float
+   void test_countLess_float()
+   {  // setup
+      float data[80];
+      fill(data, 80);
+      bool same = true;
+      // exercise
+      for (size_t n = 0; n <= 80; n++)
+         for (float value = -60.5f; value <= 60.0f; value += 7.0f)
+            same = same && custom::algo::count_less(data, n, value) ==
+                           custom::algo::kernel::countLessScalar(data, n, value);
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   /***************************************
+    * CONTAINERS
+    ***************************************/
+
+   // the container versions work on a vector through data()
+   void test_vector_standard()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<int> v;
+      v.push_back(26);
+      v.push_back(49);
+      v.push_back(67);
+      v.push_back(89);
+      custom::vector<float> vf;
+      vf.push_back(2.5f);
+      vf.push_back(-1.0f);
+      // exercise
+      // verify
+      assertUnit(custom::algo::sum(v) == 231);
+      assertUnit(custom::algo::min(v) == 26);
+      assertUnit(custom::algo::max(v) == 89);
+      assertUnit(custom::algo::find(v, 67) == 2);
+      assertUnit(custom::algo::find(v, 99) == 4);
+      assertUnit(custom::algo::count_less(v, 50) == 2);
+      assertUnit(custom::algo::sum(vf) == 1.5f);
+      assertUnit(custom::algo::min(vf) == -1.0f);
+      assertUnit(custom::algo::count_less(vf, 0.0f) == 1);
+   }  // teardown
+
+   // an empty vector sums to zero and finds nothing
+   void test_vector_empty()
+   {  // setup
+      custom::vector<int> v;
+      // exercise
+      // verify
+      assertUnit(v.data() == nullptr);
+      assertUnit(custom::algo::sum(v) == 0);
+      assertUnit(custom::algo::find(v, 26) == 0);
+      assertUnit(custom::algo::count_less(v, 26) == 0);
+   }  // teardown
+
+   /*************************************************************
+    * SAME FLOAT
+    * Equal, or both NaN
+    *************************************************************/
+   static bool sameFloat(float lhs, float rhs)
+   {
+      return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+   }
+
+   /*************************************************************
+    * FILL
+    * Whole numbers between -50 and 50, so float math is exact
+    *************************************************************/
+   template <typename T>
+   void fill(T * data, size_t n)
+   {
+      srand(232);
+      for (size_t i = 0; i < n; i++)
+         data[i] = (T)(rand() % 101 - 50);
+   }
+};
+
+#endif // DEBUG
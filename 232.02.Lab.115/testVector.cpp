@@ -14,6 +14,7 @@
 
 #include "testVector.h"     // for the vector unit tests
 #include "testSpy.h"        // for the spy unit tests
+#include "testAlgo.h"       // for the bulk algorithm unit tests
 int Spy::counters[] = {};
 
 
@@ -27,6 +28,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestVector().run();
+   TestAlgo().run();
 #endif // DEBUG
    
    return 0;
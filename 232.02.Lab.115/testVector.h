@@ -182,13 +182,13 @@ public:
       //    +----+----+----+----+
       //    | 00 | 00 | 00 | 00 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       { 
-         assertUnit(v.data[0] == Spy());
-         assertUnit(v.data[1] == Spy());
-         assertUnit(v.data[2] == Spy());
-         assertUnit(v.data[3] == Spy());
+         assertUnit(v.pData[0] == Spy());
+         assertUnit(v.pData[1] == Spy());
+         assertUnit(v.pData[2] == Spy());
+         assertUnit(v.pData[3] == Spy());
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -216,13 +216,13 @@ public:
       //    +----+----+----+----+
       //    | 99 | 99 | 99 | 99 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       { 
-         assertUnit(v.data[0] == Spy(99));
-         assertUnit(v.data[1] == Spy(99));
-         assertUnit(v.data[2] == Spy(99));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.pData[0] == Spy(99));
+         assertUnit(v.pData[1] == Spy(99));
+         assertUnit(v.pData[2] == Spy(99));
+         assertUnit(v.pData[3] == Spy(99));
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -281,9 +281,9 @@ public:
          //    | 26 | 49 |    |    |
          //    +----+----+----+----+
          custom::vector<Spy> v;
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(99));
-         v.alloc.construct(&v.data[1], Spy(99));
+         v.pData = v.alloc.allocate(4);
+         v.alloc.construct(&v.pData[0], Spy(99));
+         v.alloc.construct(&v.pData[1], Spy(99));
          v.numElements = 2;
          v.numCapacity = 4;
          Spy::reset();
@@ -342,7 +342,7 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
-      assertUnit(vSrc.data != vDest.data);
+      assertUnit(vSrc.pData != vDest.pData);
       //      0    1    2    3
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
@@ -366,9 +366,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      vSrc.pData = vSrc.alloc.allocate(4);
+      vSrc.alloc.construct(&vSrc.pData[0], Spy(26));
+      vSrc.alloc.construct(&vSrc.pData[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -388,20 +388,20 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
-      assertUnit(vSrc.data != nullptr);
-      assertUnit(vSrc.data[0] == Spy(26));
-      assertUnit(vSrc.data[1] == Spy(49));
+      assertUnit(vSrc.pData != nullptr);
+      assertUnit(vSrc.pData[0] == Spy(26));
+      assertUnit(vSrc.pData[1] == Spy(49));
       assertUnit(vSrc.numElements == 2);
       assertUnit(vSrc.numCapacity == 4);
       //      0    1
       //    +----+----+
       //    | 26 | 49 |
       //    +----+----+
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.pData != nullptr);
+      if (vDest.pData)
       {
-         assertUnit(vDest.data[0] == Spy(26));
-         assertUnit(vDest.data[1] == Spy(49));
+         assertUnit(vDest.pData[0] == Spy(26));
+         assertUnit(vDest.pData[1] == Spy(49));
       }
       assertUnit(vDest.numElements == 2);
       assertUnit(vDest.numCapacity == 2);
@@ -444,7 +444,7 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
       setupStandardFixture(vSrc);
-      Spy * p = vSrc.data;
+      Spy * p = vSrc.pData;
       Spy::reset();
       // exercise
       custom::vector<Spy> vDest(std::move(vSrc));
@@ -464,7 +464,7 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       assertStandardFixture(vDest);
-      assertUnit(p == vDest.data);
+      assertUnit(p == vDest.pData);
       // teardown
       teardownStandardFixture(vSrc);
       teardownStandardFixture(vDest);
@@ -478,9 +478,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      vSrc.pData = vSrc.alloc.allocate(4);
+      vSrc.alloc.construct(&vSrc.pData[0], Spy(26));
+      vSrc.alloc.construct(&vSrc.pData[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -501,11 +501,11 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.pData != nullptr);
+      if (vDest.pData)
       {
-         assertUnit(vDest.data[0] == Spy(26));
-         assertUnit(vDest.data[1] == Spy(49));
+         assertUnit(vDest.pData[0] == Spy(26));
+         assertUnit(vDest.pData[1] == Spy(49));
       }
       assertUnit(vDest.numElements == 2);
       assertUnit(vDest.numCapacity == 4);
@@ -703,10 +703,10 @@ public:
       //    +----+----+----+----+----+----+
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 6);
-      if (v.data)
+      if (v.pData)
       {
-         assertUnit(v.data[4] == Spy());
-         assertUnit(v.data[5] == Spy());
+         assertUnit(v.pData[4] == Spy());
+         assertUnit(v.pData[5] == Spy());
       }
       v.numCapacity = 4;
       v.numElements = 4;
@@ -744,10 +744,10 @@ public:
       //    +----+----+----+----+----+----+
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 6);
-      if (v.data && v.numElements >= 6)
+      if (v.pData && v.numElements >= 6)
       {
-         assertUnit(v.data[4] == Spy(99));
-         assertUnit(v.data[5] == Spy(99));
+         assertUnit(v.pData[4] == Spy(99));
+         assertUnit(v.pData[5] == Spy(99));
       }
       v.numCapacity = 4;
       v.numElements = 4;
@@ -812,7 +812,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.pData = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -846,7 +846,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.pData = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -880,7 +880,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.pData = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -999,7 +999,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.pData = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -1053,11 +1053,11 @@ public:
       //    | 26 | 49 | 67 | 89 |    |    |
       //    +----+----+----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(6);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
-      v.alloc.construct(&v.data[3], Spy(89));
+      v.pData = v.alloc.allocate(6);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
+      v.alloc.construct(&v.pData[2], Spy(67));
+      v.alloc.construct(&v.pData[3], Spy(89));
       v.numElements = 4;
       v.numCapacity = 6;
       Spy::reset();
@@ -1217,15 +1217,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.pData[0] = Spy(99);
+      vDest.pData[1] = Spy(99);
+      vDest.pData[2] = Spy(99);
+      vDest.pData[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numAssign() == 0);   
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -1241,13 +1241,13 @@ public:
       //    +----+----+----+----+
       assertUnit(vSrc.numCapacity == 4);
       assertUnit(vSrc.numElements == 4);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.pData != nullptr);
+      if (vSrc.pData)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
-         assertUnit(vSrc.data[2] == Spy(99));
-         assertUnit(vSrc.data[3] == Spy(99));
+         assertUnit(vSrc.pData[0] == Spy(99));
+         assertUnit(vSrc.pData[1] == Spy(99));
+         assertUnit(vSrc.pData[2] == Spy(99));
+         assertUnit(vSrc.pData[3] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1273,16 +1273,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.pData = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.pData[0], Spy(99));
+      vDest.alloc.construct(&vDest.pData[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numCopy() == 0);       
       assertUnit(Spy::numAlloc() == 0);      
       assertUnit(Spy::numDestructor() == 0); 
@@ -1298,11 +1298,11 @@ public:
       //    +----+----+
       assertUnit(vSrc.numCapacity == 2);
       assertUnit(vSrc.numElements == 2);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.pData != nullptr);
+      if (vSrc.pData)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
+         assertUnit(vSrc.pData[0] == Spy(99));
+         assertUnit(vSrc.pData[1] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1322,9 +1322,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.pData = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.pData[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.pData[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1337,7 +1337,7 @@ public:
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numAssign() == 0); 
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);    
@@ -1358,11 +1358,11 @@ public:
       //    +----+----+
       assertUnit(vDest.numCapacity == 2);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.pData != nullptr);
+      if (vDest.pData)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.pData[0] == Spy(99));
+         assertUnit(vDest.pData[1] == Spy(99));
       }
       // teardown
       teardownStandardFixture(vSrc);
@@ -1411,15 +1411,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.pData[0] = Spy(99);
+      vDest.pData[1] = Spy(99);
+      vDest.pData[2] = Spy(99);
+      vDest.pData[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numAssign() == 4);      // assign [26,49,67,89]
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -1458,16 +1458,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.pData = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.pData[0], Spy(99));
+      vDest.alloc.construct(&vDest.pData[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numCopy() == 4);       // copy [26,49,67,89] from src to dest
       assertUnit(Spy::numAlloc() == 4);      // the copy involves a new buffer for [26,49,67,89]
       assertUnit(Spy::numDestructor() == 2); // destroy [99,99]
@@ -1500,9 +1500,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.pData = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.pData[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.pData[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1515,7 +1515,7 @@ public:
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numAssign() == 2);     // assign [99,99] into dest
       assertUnit(Spy::numDestructor() == 2); // destroy [67,89]
       assertUnit(Spy::numDelete() == 2);     // delete [67,89]
@@ -1531,11 +1531,11 @@ public:
       //    +----+----+
       assertUnit(vSrc.numCapacity == 2);
       assertUnit(vSrc.numElements == 2);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.pData != nullptr);
+      if (vSrc.pData)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
+         assertUnit(vSrc.pData[0] == Spy(99));
+         assertUnit(vSrc.pData[1] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1543,11 +1543,11 @@ public:
       //    +----+----+----+----+
       assertUnit(vDest.numCapacity == 4);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.pData != nullptr);
+      if (vDest.pData)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.pData[0] == Spy(99));
+         assertUnit(vDest.pData[1] == Spy(99));
       }
       // teardown
       teardownStandardFixture(vSrc);
@@ -1591,15 +1591,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.pData[0] = Spy(99);
+      vDest.pData[1] = Spy(99);
+      vDest.pData[2] = Spy(99);
+      vDest.pData[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numDestructor() == 4);  // destroy [99,99,99,99]
       assertUnit(Spy::numDelete() == 4);      // delete  [99,99,99,99]
       assertUnit(Spy::numAssign() == 0);
@@ -1634,16 +1634,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.pData = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.pData[0], Spy(99));
+      vDest.alloc.construct(&vDest.pData[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numDestructor() == 2); // destroy [99,99]
       assertUnit(Spy::numDelete() == 2);     // delete [99,99]
       assertUnit(Spy::numCopy() == 0);
@@ -1672,9 +1672,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.pData = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.pData[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.pData[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1687,7 +1687,7 @@ public:
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.pData != vSrc.pData);
       assertUnit(Spy::numDestructor() == 4); // destroy [26,49,67,89]
       assertUnit(Spy::numDelete() == 4);     // delete [26,49,67,89]
       assertUnit(Spy::numAssign() == 0);
@@ -1703,11 +1703,11 @@ public:
       //    +----+----+
       assertUnit(vDest.numCapacity == 2);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.pData != nullptr);
+      if (vDest.pData)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.pData[0] == Spy(99));
+         assertUnit(vDest.pData[1] == Spy(99));
       }
       assertEmptyFixture(vSrc);
       // teardown
@@ -1729,9 +1729,9 @@ public:
       custom::vector<Spy> vDes;
       try
       {
-         vDes.data = vDes.alloc.allocate(4);
-         vDes.alloc.construct(&vDes.data[0], Spy(11));
-         vDes.alloc.construct(&vDes.data[1], Spy(99));
+         vDes.pData = vDes.alloc.allocate(4);
+         vDes.alloc.construct(&vDes.pData[0], Spy(11));
+         vDes.alloc.construct(&vDes.pData[1], Spy(99));
          vDes.numElements = 2;
          vDes.numCapacity = 4;
       }
@@ -1773,9 +1773,9 @@ public:
       custom::vector<Spy> vDes;
       try
       {
-         vDes.data = vDes.alloc.allocate(4);
-         vDes.alloc.construct(&vDes.data[0], Spy(11));
-         vDes.alloc.construct(&vDes.data[1], Spy(99));
+         vDes.pData = vDes.alloc.allocate(4);
+         vDes.alloc.construct(&vDes.pData[0], Spy(11));
+         vDes.alloc.construct(&vDes.pData[1], Spy(99));
          vDes.numElements = 2;
          vDes.numCapacity = 4;
       }
@@ -1864,8 +1864,8 @@ public:
       //    +----+----+----+----+
       //    | 26 | 99 | 67 | 89 |
       //    +----+----+----+----+
-      assertUnit(v.data[1] == Spy(99));
-      v.data[1] = Spy(49);
+      assertUnit(v.pData[1] == Spy(99));
+      v.pData[1] = Spy(49);
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -1927,11 +1927,11 @@ public:
       //    +----+----+----+----+
       //    | 99 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       { 
-         assertUnit(v.data[0] == Spy(99));
-         v.data[0] = Spy(26);
+         assertUnit(v.pData[0] == Spy(99));
+         v.pData[0] = Spy(26);
       }
       assertStandardFixture(v);
       // teardown
@@ -1994,11 +1994,11 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 99 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       {
-         assertUnit(v.data[3] == Spy(99));
-         v.data[3] = Spy(89);
+         assertUnit(v.pData[3] == Spy(99));
+         v.pData[3] = Spy(89);
       }
       assertStandardFixture(v);
       // teardown
@@ -2015,9 +2015,9 @@ public:
       custom::vector<Spy> v;
       try
       {
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(11));
-         v.alloc.construct(&v.data[1], Spy(22));
+         v.pData = v.alloc.allocate(4);
+         v.alloc.construct(&v.pData[0], Spy(11));
+         v.alloc.construct(&v.pData[1], Spy(22));
          v.numElements = 2;
          v.numCapacity = 4;
       }
@@ -2042,11 +2042,11 @@ public:
       assertUnit(value == Spy(22));
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 2);
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       {
-         assertUnit(v.data[0] == Spy(11));
-         assertUnit(v.data[1] == Spy(22));
+         assertUnit(v.pData[0] == Spy(11));
+         assertUnit(v.pData[1] == Spy(22));
       }
       // teardown
       teardownStandardFixture(v);
@@ -2105,12 +2105,12 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 3);
-      assertUnit(v.data != nullptr);
-      if (v.data != nullptr)
+      assertUnit(v.pData != nullptr);
+      if (v.pData != nullptr)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
+         assertUnit(v.pData[0] == Spy(26));
+         assertUnit(v.pData[1] == Spy(49));
+         assertUnit(v.pData[2] == Spy(67));
       }
       // teardown
       teardownStandardFixture(v);
@@ -2124,9 +2124,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      v.pData = v.alloc.allocate(4);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2148,10 +2148,10 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 1);
-      assertUnit(v.data != nullptr);
-      if (v.data != nullptr)
+      assertUnit(v.pData != nullptr);
+      if (v.pData != nullptr)
       {
-         assertUnit(v.data[0] == Spy(26));
+         assertUnit(v.pData[0] == Spy(26));
       }      // teardown
       teardownStandardFixture(v);
    }
@@ -2208,7 +2208,7 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 0);
-      assertUnit(v.data != nullptr);
+      assertUnit(v.pData != nullptr);
       // teardown
       teardownStandardFixture(v);
    }
@@ -2221,9 +2221,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      v.pData = v.alloc.allocate(4);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2245,7 +2245,7 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 0);
-      assertUnit(v.data != nullptr);
+      assertUnit(v.pData != nullptr);
       // teardown
       teardownStandardFixture(v);
    }
@@ -2277,9 +2277,9 @@ public:
       //    +----+
       //    | 99 |
       //    +----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
-         assertUnit(v.data[0] == Spy(99));
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
+         assertUnit(v.pData[0] == Spy(99));
       assertUnit(v.numCapacity == 1);
       assertUnit(v.numElements == 1);
       // teardown
@@ -2294,10 +2294,10 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.pData = v.alloc.allocate(4);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
+      v.alloc.construct(&v.pData[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2331,10 +2331,10 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.pData = v.alloc.allocate(3);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
+      v.alloc.construct(&v.pData[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2355,13 +2355,13 @@ public:
       //    +----+----+----+----+----+----+
       //    | 26 | 49 | 67 | 99 |    |    |
       //    +----+----+----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data && v.numElements >= 4)
+      assertUnit(v.pData != nullptr);
+      if (v.pData && v.numElements >= 4)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.pData[0] == Spy(26));
+         assertUnit(v.pData[1] == Spy(49));
+         assertUnit(v.pData[2] == Spy(67));
+         assertUnit(v.pData[3] == Spy(99));
       }
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 4);
@@ -2391,9 +2391,9 @@ public:
       //    +----+
       //    | 99 |
       //    +----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
-         assertUnit(v.data[0] == Spy(99));
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
+         assertUnit(v.pData[0] == Spy(99));
       assertUnit(v.numCapacity == 1);
       assertUnit(v.numElements == 1);
       assertUnit(s == Spy());
@@ -2409,10 +2409,10 @@ public:
      //    | 26 | 49 | 67 |    |
      //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.pData = v.alloc.allocate(4);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
+      v.alloc.construct(&v.pData[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2446,10 +2446,10 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.pData = v.alloc.allocate(3);
+      v.alloc.construct(&v.pData[0], Spy(26));
+      v.alloc.construct(&v.pData[1], Spy(49));
+      v.alloc.construct(&v.pData[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2470,13 +2470,13 @@ public:
       //    +----+----+----+----+----+----+
       //    | 26 | 49 | 67 | 99 |    |    |
       //    +----+----+----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data && v.numElements >= 4)
+      assertUnit(v.pData != nullptr);
+      if (v.pData && v.numElements >= 4)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.pData[0] == Spy(26));
+         assertUnit(v.pData[1] == Spy(49));
+         assertUnit(v.pData[2] == Spy(67));
+         assertUnit(v.pData[3] == Spy(99));
       }
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 4);
@@ -2517,11 +2517,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //      it
-      assertUnit(v.data != nullptr);
+      assertUnit(v.pData != nullptr);
       assertUnit(it.p != nullptr);
-      if (v.data && it.p)
+      if (v.pData && it.p)
       {
-         assertUnit(it.p == &(v.data[0]));
+         assertUnit(it.p == &(v.pData[0]));
          assertUnit(*(it.p) == 26);
       }
       assertStandardFixture(v);
@@ -2546,7 +2546,7 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //                           it
-      assertUnit(it.p == &(v.data[4]));
+      assertUnit(it.p == &(v.pData[4]));
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -2563,7 +2563,7 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.pData[1]);
       // exercise
       ++it;
       // verify
@@ -2589,12 +2589,12 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.pData[1]);
       // exercise
       Spy value = *it;
       // verify
       assertUnit(value == Spy(49));
-      assertUnit(it.p == &(v.data[1]));
+      assertUnit(it.p == &(v.pData[1]));
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -2611,7 +2611,7 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.pData[1]);
       // exercise
       *it = Spy(99);
       // verify
@@ -2620,14 +2620,14 @@ public:
       //    | 26 | 99 | 67 | 89 |
       //    +----+----+----+----+
       //           it
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.pData != nullptr);
+      if (v.pData)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(99));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(89));
-         assertUnit(it.p == &(v.data[1]));
+         assertUnit(v.pData[0] == Spy(26));
+         assertUnit(v.pData[1] == Spy(99));
+         assertUnit(v.pData[2] == Spy(67));
+         assertUnit(v.pData[3] == Spy(89));
+         assertUnit(it.p == &(v.pData[1]));
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -2666,9 +2666,9 @@ public:
       setupStandardFixture(v);
       Spy::reset();
       // exercise
-      custom::vector<Spy>::iterator it(v.data + 2);
+      custom::vector<Spy>::iterator it(v.pData + 2);
       // verify
-      assertUnit(it.p == v.data + 2);
+      assertUnit(it.p == v.pData + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2697,7 +2697,7 @@ public:
       // exercise
       custom::vector<Spy>::iterator it(2, v);
       // verify
-      assertUnit(it.p == v.data + 2);
+      assertUnit(it.p == v.pData + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2725,15 +2725,15 @@ public:
       setupStandardFixture(v);
       custom::vector<Spy>::iterator itLHS;
       custom::vector<Spy>::iterator itRHS;
-      itLHS.p = itRHS.p = v.data + 2;
+      itLHS.p = itRHS.p = v.pData + 2;
       bool b = false;
       Spy::reset();
       // exercise
       b = (itLHS == itRHS);
       // verify
       assertUnit(b == true);
-      assertUnit(itLHS.p == v.data + 2);
-      assertUnit(itRHS.p == v.data + 2);
+      assertUnit(itLHS.p == v.pData + 2);
+      assertUnit(itRHS.p == v.pData + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2760,16 +2760,16 @@ public:
       setupStandardFixture(v);
       custom::vector<Spy>::iterator itLHS;
       custom::vector<Spy>::iterator itRHS;
-      itLHS.p = v.data + 1;
-      itRHS.p = v.data + 3;
+      itLHS.p = v.pData + 1;
+      itRHS.p = v.pData + 3;
       bool b = true;
       Spy::reset();
       // exercise
       b = (itLHS == itRHS);
       // verify
       assertUnit(b == false);
-      assertUnit(itLHS.p == v.data + 1);
-      assertUnit(itRHS.p == v.data + 3);
+      assertUnit(itLHS.p == v.pData + 1);
+      assertUnit(itRHS.p == v.pData + 3);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2797,15 +2797,15 @@ public:
       setupStandardFixture(v);
       custom::vector<Spy>::iterator itLHS;
       custom::vector<Spy>::iterator itRHS;
-      itLHS.p = itRHS.p = v.data + 2;
+      itLHS.p = itRHS.p = v.pData + 2;
       bool b = true;
       Spy::reset();
       // exercise
       b = (itLHS != itRHS);
       // verify
       assertUnit(b == false);
-      assertUnit(itLHS.p == v.data + 2);
-      assertUnit(itRHS.p == v.data + 2);
+      assertUnit(itLHS.p == v.pData + 2);
+      assertUnit(itRHS.p == v.pData + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2832,16 +2832,16 @@ public:
       setupStandardFixture(v);
       custom::vector<Spy>::iterator itLHS;
       custom::vector<Spy>::iterator itRHS;
-      itLHS.p = v.data + 1;
-      itRHS.p = v.data + 3;
+      itLHS.p = v.pData + 1;
+      itRHS.p = v.pData + 3;
       bool b = false;
       Spy::reset();
       // exercise
       b = (itLHS != itRHS);
       // verify
       assertUnit(b == true);
-      assertUnit(itLHS.p == v.data + 1);
-      assertUnit(itRHS.p == v.data + 3);
+      assertUnit(itLHS.p == v.pData + 1);
+      assertUnit(itRHS.p == v.pData + 3);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2866,11 +2866,11 @@ public:
    {
       try
       {
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(26));
-         v.alloc.construct(&v.data[1], Spy(49));
-         v.alloc.construct(&v.data[2], Spy(67));
-         v.alloc.construct(&v.data[3], Spy(89));
+         v.pData = v.alloc.allocate(4);
+         v.alloc.construct(&v.pData[0], Spy(26));
+         v.alloc.construct(&v.pData[1], Spy(49));
+         v.alloc.construct(&v.pData[2], Spy(67));
+         v.alloc.construct(&v.pData[3], Spy(89));
          v.numElements = 4;
          v.numCapacity = 4;
       }
@@ -2889,16 +2889,16 @@ public:
     *************************************************************/
    void assertStandardFixtureParameters(const custom::vector<Spy>& v, int line, const char* function)
    {
-      assertIndirect(v.data != nullptr);
+      assertIndirect(v.pData != nullptr);
       assertIndirect(v.numCapacity == 4);
       assertIndirect(v.numElements == 4);
 
-      if (v.data != nullptr && v.numElements >= 4)
+      if (v.pData != nullptr && v.numElements >= 4)
       {
-         assertIndirect(v.data[0] == Spy(26));
-         assertIndirect(v.data[1] == Spy(49));
-         assertIndirect(v.data[2] == Spy(67));
-         assertIndirect(v.data[3] == Spy(89));
+         assertIndirect(v.pData[0] == Spy(26));
+         assertIndirect(v.pData[1] == Spy(49));
+         assertIndirect(v.pData[2] == Spy(67));
+         assertIndirect(v.pData[3] == Spy(89));
       }
    }
    
@@ -2907,7 +2907,7 @@ public:
     *************************************************************/
    void assertEmptyFixtureParameters(const custom::vector<Spy>& v, int line, const char* function)
    {
-      assertIndirect(v.data == nullptr);
+      assertIndirect(v.pData == nullptr);
       assertIndirect(v.numCapacity == 0);
       assertIndirect(v.numElements == 0);
    }
@@ -2917,14 +2917,14 @@ public:
     *************************************************************/
    void teardownStandardFixture(custom::vector<Spy>&v)
    {
-      if (v.data != nullptr && false)
+      if (v.pData != nullptr && false)
       {
          for (size_t i = 0; i < v.numElements; i++)
-            v.alloc.destroy(&v.data[i]);
-         v.alloc.deallocate(v.data, v.numCapacity);
+            v.alloc.destroy(&v.pData[i]);
+         v.alloc.deallocate(v.pData, v.numCapacity);
 
       }
-         v.data = nullptr;
+         v.pData = nullptr;
          v.numElements = v.numCapacity = 0;
    }
 
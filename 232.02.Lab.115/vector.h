@@ -67,7 +67,7 @@ public:
        std::swap(numCapacity, rhs.numCapacity);
 
        // Swap the data pointers
-       std::swap(data, rhs.data);
+       std::swap(pData, rhs.pData);
    }
    vector & operator = (const vector & rhs);
    vector & operator = (vector&& rhs);
@@ -83,11 +83,11 @@ public:
            return iterator();
        }
 
-       return iterator(&data[0]);
+       return iterator(&pData[0]);
    }
    iterator end() 
    { 
-       return iterator(&data[numElements]);
+       return iterator(&pData[numElements]);
    }
 
    //
@@ -99,6 +99,8 @@ public:
    const T& front() const;
          T& back();
    const T& back() const;
+         T* data()       { return pData; }
+   const T* data() const { return pData; }
 
    //
    // Insert
@@ -114,23 +116,23 @@ public:
    //
    void clear()
    {
-       if (data != nullptr)
+       if (pData != nullptr)
        {
            for (size_t i = 0; i < numElements; i++)
            {
-               alloc.destroy(data + i);
+               alloc.destroy(pData + i);
            }
            numElements = 0;
        }
    }
    void pop_back()
    {
-       /*if (data == nullptr)
+       /*if (pData == nullptr)
        {
            return;
        }
        return;*/
-      /* T temp = data[numElements - 1];
+      /* T temp = pData[numElements - 1];
        ~temp();
        numElements--;*/
    }
@@ -146,7 +148,7 @@ public:
 private:
    
    A    alloc;                // use allocator for memory allocation
-   T *  data;                 // user data, a dynamically-allocated array
+   T *  pData;                // user data, a dynamically-allocated array
    size_t  numCapacity;       // the capacity of the array
    size_t  numElements;       // the number of items currently used
 };
@@ -174,7 +176,7 @@ public:
    iterator()                           { this->p = nullptr; }
    iterator(T* p)                       { this->p = p; }
    iterator(const iterator& rhs)        { this->p = rhs.p; }
-   iterator(size_t index, vector<T>& v) { this->p = v.data + index; }
+   iterator(size_t index, vector<T>& v) { this->p = v.pData + index; }
    iterator& operator = (const iterator& rhs)
    {
        this->p = rhs.p;
@@ -234,7 +236,7 @@ private:
 template <typename T, typename A>
 vector <T, A> :: vector(const A & a)
 {
-   data = nullptr;
+   pData = nullptr;
    numElements = 0;
    numCapacity = 0;
    alloc = a;
@@ -252,10 +254,10 @@ vector <T, A> :: vector(size_t num, const T & t, const A & a)
     numElements = num;
     numCapacity = num;
     alloc = a;
-    data = alloc.allocate(num);
+    pData = alloc.allocate(num);
     for (size_t i = 0; i < num; i++)
     {
-        alloc.construct(data + i, t);
+        alloc.construct(pData + i, t);
     }
     
 }
@@ -270,12 +272,12 @@ vector <T, A> :: vector(const std::initializer_list<T> & l, const A & a)
     numElements = l.size();
     numCapacity = l.size();
 
-    data = alloc.allocate(numCapacity);
+    pData = alloc.allocate(numCapacity);
 
     int index = 0;
     for (auto it = l.begin(); it != l.end(); ++it)
     {
-        alloc.construct(data + index, *it);
+        alloc.construct(pData + index, *it);
         index++;
     }
 }
@@ -294,14 +296,14 @@ vector <T, A> :: vector(size_t num, const A & a)
 
     if (num == 0)
     {
-        data = nullptr;
+        pData = nullptr;
     }
     else
     {
-        data = alloc.allocate(num);
+        pData = alloc.allocate(num);
         for (size_t i = 0; i < num; i++)
         {
-            alloc.construct(data + i, T());
+            alloc.construct(pData + i, T());
         }
 
     }
@@ -319,10 +321,10 @@ vector <T, A> :: vector (const vector & rhs)
     alloc = rhs.alloc;
     numCapacity = rhs.numElements;
 
-    data = alloc.allocate(rhs.numElements);
+    pData = alloc.allocate(rhs.numElements);
     for (size_t i = 0; i < rhs.numElements; i++)
     {
-        alloc.construct(data + i, rhs.data[i]);
+        alloc.construct(pData + i, rhs.pData[i]);
     }
  
 }
@@ -340,17 +342,17 @@ vector <T, A> :: vector (vector && rhs)
     rhs.numCapacity = 0;
     alloc = rhs.alloc;
 
-    if (rhs.data == nullptr)
+    if (rhs.pData == nullptr)
     {
-        data = nullptr;
+        pData = nullptr;
     }
     else
     {
-        data = alloc.allocate(numCapacity);
+        pData = alloc.allocate(numCapacity);
         for (size_t i = 0; i < numElements; ++i) 
         {
-            alloc.construct(data + i, rhs.data[i]);
-            rhs.alloc.destroy(rhs.data + i);
+            alloc.construct(pData + i, rhs.pData[i]);
+            rhs.alloc.destroy(rhs.pData + i);
         }
             
     }
@@ -364,13 +366,13 @@ vector <T, A> :: vector (vector && rhs)
 template <typename T, typename A>
 vector <T, A> :: ~vector()
 {
-    if (data)
+    if (pData)
     {
         for (size_t i = 0; i < numElements; i++)
         {
-            alloc.destroy(data + i);
+            alloc.destroy(pData + i);
         }
-        alloc.deallocate(data, numCapacity);
+        alloc.deallocate(pData, numCapacity);
     }
 }
 
@@ -389,9 +391,9 @@ void vector <T, A> :: resize(size_t newCapacity)
     {
         for (size_t i = newCapacity; i < numCapacity; i++)
         {
-            alloc.destroy(data + i);
+            alloc.destroy(pData + i);
         }
-        alloc.deallocate(data + newCapacity, numCapacity - newCapacity);
+        alloc.deallocate(pData + newCapacity, numCapacity - newCapacity);
         if (numElements > newCapacity)
         {
             numElements = newCapacity;
@@ -411,9 +413,9 @@ void vector <T, A> :: resize(size_t newElements, const T & t)
     {
         for (size_t i = newElements; i < numCapacity; i++)
         {
-            alloc.destroy(data + i);
+            alloc.destroy(pData + i);
         }
-        alloc.deallocate(data + newElements, numCapacity - newElements);
+        alloc.deallocate(pData + newElements, numCapacity - newElements);
     }
     else
     {
@@ -421,7 +423,7 @@ void vector <T, A> :: resize(size_t newElements, const T & t)
     }
     for (size_t i = numElements; i < newElements; i++)
     {
-        alloc.construct(data + i, t);
+        alloc.construct(pData + i, t);
     }
     numElements = newElements;
     
@@ -446,16 +448,16 @@ void vector <T, A> :: reserve(size_t newCapacity)
     T * newData = alloc.allocate(newCapacity);
     for (size_t i = 0; i < numElements; i++)
     {
-        alloc.construct(newData + i, data[i]);
+        alloc.construct(newData + i, pData[i]);
     }
     for (size_t i = 0; i < numElements; ++i)
     {
-        alloc.destroy(data + i);
+        alloc.destroy(pData + i);
     }
 
-    alloc.deallocate(data, numCapacity);
+    alloc.deallocate(pData, numCapacity);
 
-    data = newData;
+    pData = newData;
     numCapacity = newCapacity;
 }
 
@@ -475,12 +477,12 @@ void vector <T, A> :: shrink_to_fit()
 
     if (numElements == 0)
     {
-        if (data != nullptr) 
+        if (pData != nullptr) 
         {
-            alloc.deallocate(data, numCapacity);
+            alloc.deallocate(pData, numCapacity);
         }
         numCapacity = 0;
-        data = nullptr;
+        pData = nullptr;
     }
 
     if (numCapacity > numElements)
@@ -488,14 +490,14 @@ void vector <T, A> :: shrink_to_fit()
         T* newData = alloc.allocate(numElements);
         for (size_t i = 0; i < numElements; ++i)
         {
-            alloc.construct(newData + i, data[i]);
+            alloc.construct(newData + i, pData[i]);
         }
         for (size_t i = 0; i < numElements; ++i)
         {
-            alloc.destroy(data + i); 
+            alloc.destroy(pData + i); 
         }
-        alloc.deallocate(data, numCapacity); 
-        data = newData;
+        alloc.deallocate(pData, numCapacity); 
+        pData = newData;
         numCapacity = numElements;
     }
 }
@@ -509,7 +511,7 @@ void vector <T, A> :: shrink_to_fit()
 template <typename T, typename A>
 T & vector <T, A> :: operator [] (size_t index)
 {
-    return data[index];
+    return pData[index];
     
 }
 
@@ -520,7 +522,7 @@ T & vector <T, A> :: operator [] (size_t index)
 template <typename T, typename A>
 const T & vector <T, A> :: operator [] (size_t index) const
 {
-    return data[index];
+    return pData[index];
 }
 
 /*****************************************
@@ -530,7 +532,7 @@ const T & vector <T, A> :: operator [] (size_t index) const
 template <typename T, typename A>
 T & vector <T, A> :: front ()
 {
-    return data[0];
+    return pData[0];
 }
 
 /******************************************
@@ -540,7 +542,7 @@ T & vector <T, A> :: front ()
 template <typename T, typename A>
 const T & vector <T, A> :: front () const
 {
-    return data[0];
+    return pData[0];
 }
 
 /*****************************************
@@ -550,7 +552,7 @@ const T & vector <T, A> :: front () const
 template <typename T, typename A>
 T & vector <T, A> :: back()
 {
-    return data[numElements - 1];
+    return pData[numElements - 1];
 }
 
 /******************************************
@@ -560,7 +562,7 @@ T & vector <T, A> :: back()
 template <typename T, typename A>
 const T & vector <T, A> :: back() const
 {
-    return data[numElements - 1];
+    return pData[numElements - 1];
 }
 
 /***************************************
@@ -578,7 +580,7 @@ void vector <T, A> :: push_back (const T & t)
     {
         reserve((numCapacity == 0) ? 1 : numCapacity * 2);
     }
-    alloc.construct(data + numElements, t);
+    alloc.construct(pData + numElements, t);
     numElements++;
 }
 
@@ -589,7 +591,7 @@ void vector <T, A> ::push_back(T && t)
     {
         reserve((numCapacity == 0) ? 1 : numCapacity * 2);
     }
-    alloc.construct(data + numElements, t);
+    alloc.construct(pData + numElements, t);
     numElements++;
 }
 
@@ -611,12 +613,12 @@ vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
 
         for (size_t i = 0; i < numElements; ++i)
         {
-            alloc.destroy(data + i);
+            alloc.destroy(pData + i);
         }
 
         for (size_t i = 0; i < rhs.numElements; ++i) 
         {
-            alloc.construct(data + i, rhs.data[i]); 
+            alloc.construct(pData + i, rhs.pData[i]); 
         }
 
         numElements = rhs.numElements;
@@ -635,12 +637,12 @@ vector <T, A>& vector <T, A> :: operator = (vector&& rhs)
 
         for (size_t i = 0; i < numElements; ++i)
         {
-            alloc.destroy(data + i);
+            alloc.destroy(pData + i);
         }
 
         for (size_t i = 0; i < rhs.numElements; ++i)
         {
-            alloc.construct(data + i, rhs.data[i]);
+            alloc.construct(pData + i, rhs.pData[i]);
         }
 
         numElements = rhs.numElements;
@@ -0,0 +1,267 @@
+/***********************************************************************
+ * Module:
+ *    Concurrent Stack
+ * Summary:
+ *    A lock-free stack that many threads may push onto and pop from
+ *    at the same time without a mutex
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       concurrent_stack  : a Treiber stack with tagged heads
+ * Author
+ *    Austin Jesperson, Emilio Ordonez, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t and uint64_t
+#include <atomic>   // for std::atomic
+#include <new>      // for placement new
+#include <utility>  // for std::move, std::forward
+
+class TestConcurrentStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * CONCURRENT STACK
+ * First-in-Last-out data structure that is safe to
+ * push and pop from any number of threads.
+ *
+ * Nodes are named by a 32-bit index instead of a
+ * pointer so the head can carry a 32-bit tag in the
+ * same 64-bit word. Every successful swap of the head
+ * bumps the tag, so a thread holding a stale head
+ * (the ABA problem) fails its compare-exchange even
+ * if the same node is back on top.
+ *
+ * Nodes live in chunks that are never freed while the
+ * stack is alive. Popped nodes go on a second tagged
+ * free list and are reused by the next push, so the
+ * steady state does no allocation at all, and reading
+ * the link of a node another thread just popped is
+ * always reading valid memory.
+ *************************************************/
+template <typename T>
+class concurrent_stack
+{
+   friend class ::TestConcurrentStack; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   concurrent_stack() : head(0), freeList(0), numNodes(0)
+   {
+      for (size_t c = 0; c < numChunks; c++)
+         chunks[c].store(nullptr, std::memory_order_relaxed);
+   }
+   concurrent_stack(const concurrent_stack &) = delete;
+   concurrent_stack & operator = (const concurrent_stack &) = delete;
+  ~concurrent_stack();
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { emplace(t);            }
+   void push(      T && t) { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+
+   //
+   // Remove
+   //
+
+   bool try_pop(T & t);
+
+   //
+   // Status
+   //
+
+   bool empty() const
+   {
+      return index(head.load(std::memory_order_acquire)) == 0;
+   }
+
+private:
+
+   struct Node
+   {
+      Node() : pNext(0) { }
+      alignas(T) unsigned char storage[sizeof(T)];  // the user's data, once pushed
+      std::atomic<uint32_t>    pNext;               // index of the node below
+      T & data() { return *reinterpret_cast<T *>(storage); }
+   };
+
+   // chunk c holds (firstChunk << c) nodes, so 26 chunks cover every 32-bit index
+   static constexpr size_t   numChunks  = 26;
+   static constexpr uint32_t firstChunk = 64;
+   static constexpr uint32_t chunkShift = 6;   // log2(firstChunk)
+
+   // a head is an index in the low word and a tag in the high word
+   static uint32_t index(uint64_t h)                 { return (uint32_t)h;                       }
+   static uint64_t tagged(uint32_t id, uint64_t old) { return ((old >> 32) + 1) << 32 | id;      }
+
+   // index id lives at position id + firstChunk - 1 counted across
+   // all the chunks, so its chunk is given by the highest set bit
+   static uint32_t chunkOf(uint32_t id)
+   {
+      uint64_t n = (uint64_t)id + firstChunk - 1;
+      uint32_t c = 0;
+      while ((n >> (c + chunkShift + 1)) != 0)
+         c++;
+      return c;
+   }
+
+   Node & node(uint32_t id);
+   uint32_t acquireNode();
+   void pushIndex(std::atomic<uint64_t> & top, uint32_t id);
+   uint32_t popIndex(std::atomic<uint64_t> & top);
+
+   std::atomic<uint64_t> head;               // tagged index of the top node
+   std::atomic<uint64_t> freeList;           // tagged index of the first recycled node
+   std::atomic<uint32_t> numNodes;           // nodes ever handed out; 0 means null
+   std::atomic<Node *>   chunks[numChunks];  // node storage, allocated on demand
+};
+
+/*****************************************
+ * CONCURRENT STACK :: DESTRUCTOR
+ * Not thread-safe: nobody else may be using the
+ * stack. Destroy what is left, then free the chunks.
+ ****************************************/
+template <typename T>
+concurrent_stack <T> :: ~concurrent_stack()
+{
+   for (uint32_t id = index(head.load()); id; id = node(id).pNext.load())
+      node(id).data().~T();
+   for (size_t c = 0; c < numChunks; c++)
+      delete [] chunks[c].load();
+}
+
+/*****************************************
+ * CONCURRENT STACK :: EMPLACE
+ * Build the new element in a private node, then
+ * publish it with a single compare-exchange on head
+ ****************************************/
+template <typename T>
+template <class ... Args>
+void concurrent_stack <T> :: emplace(Args && ... args)
+{
+   uint32_t id = acquireNode();
+   new (node(id).storage) T(std::forward<Args>(args)...);
+   pushIndex(head, id);
+}
+
+/*****************************************
+ * CONCURRENT STACK :: TRY POP
+ * Take the top element if there is one.
+ * Returns false, leaving t alone, when empty.
+ ****************************************/
+template <typename T>
+bool concurrent_stack <T> :: try_pop(T & t)
+{
+   uint32_t id = popIndex(head);
+   if (id == 0)
+      return false;
+
+   // the node is ours alone now
+   t = std::move(node(id).data());
+   node(id).data().~T();
+   pushIndex(freeList, id);
+   return true;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: NODE
+ * Find a node from its index
+ ****************************************/
+template <typename T>
+typename concurrent_stack <T> :: Node & concurrent_stack <T> :: node(uint32_t id)
+{
+   assert(id != 0);
+   uint32_t c = chunkOf(id);
+   Node * pChunk = chunks[c].load(std::memory_order_acquire);
+   assert(pChunk != nullptr);
+   return pChunk[(uint64_t)id + firstChunk - 1 - ((uint64_t)firstChunk << c)];
+}
+
+/*****************************************
+ * CONCURRENT STACK :: ACQUIRE NODE
+ * Reuse a recycled node if there is one. Otherwise
+ * hand out the next fresh index, allocating its chunk
+ * if we are the first to get there.
+ ****************************************/
+template <typename T>
+uint32_t concurrent_stack <T> :: acquireNode()
+{
+   uint32_t id = popIndex(freeList);
+   if (id)
+      return id;
+
+   id = numNodes.fetch_add(1, std::memory_order_relaxed) + 1;
+   assert(id != 0);  // ran out of 32-bit indices
+
+   uint32_t c = chunkOf(id);
+   if (chunks[c].load(std::memory_order_acquire) == nullptr)
+   {
+      Node * pNew = new Node[(size_t)firstChunk << c];
+      Node * pExpected = nullptr;
+      if (!chunks[c].compare_exchange_strong(pExpected, pNew,
+                                             std::memory_order_acq_rel))
+         delete [] pNew;  // another thread beat us to it
+   }
+   return id;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: PUSH INDEX
+ * The Treiber push: link the node to the current
+ * top and swing the top to the node
+ ****************************************/
+template <typename T>
+void concurrent_stack <T> :: pushIndex(std::atomic<uint64_t> & top, uint32_t id)
+{
+   Node & n = node(id);
+   uint64_t old = top.load(std::memory_order_relaxed);
+   do
+      n.pNext.store(index(old), std::memory_order_relaxed);
+   while (!top.compare_exchange_weak(old, tagged(id, old),
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed));
+}
+
+/*****************************************
+ * CONCURRENT STACK :: POP INDEX
+ * The Treiber pop: swing the top to whatever is
+ * below it. The link may be stale if another thread
+ * got here first, but then the tag has moved on and
+ * the compare-exchange fails.
+ ****************************************/
+template <typename T>
+uint32_t concurrent_stack <T> :: popIndex(std::atomic<uint64_t> & top)
+{
+   uint64_t old = top.load(std::memory_order_acquire);
+   while (index(old) != 0)
+   {
+      uint32_t next = node(index(old)).pNext.load(std::memory_order_relaxed);
+      if (top.compare_exchange_weak(old, tagged(next, old),
+                                    std::memory_order_acquire,
+                                    std::memory_order_acquire))
+         return index(old);
+   }
+   return 0;
+}
+
+} // custom namespace
@@ -0,0 +1,510 @@
+/***********************************************************************
+ * Header:
+ *    DEQUE
+ * Summary:
+ *    Our custom implementation of std::deque
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        deque                 : A class that represents a double-ended queue
+ *        deque::iterator       : A random-access iterator through a deque
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for size_t and ptrdiff_t
+#include <iterator>    // for std::random_access_iterator_tag
+#include <memory>      // for std::allocator
+#include <new>         // std::bad_alloc
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::move and std::swap
+
+class TestDeque;  // forward declaration for unit tests
+class TestQueue;
+class TestStack;
+
+namespace custom
+{
+
+/*****************************************
+ * DEQUE
+ * Elements live in fixed-size blocks. A map of block
+ * pointers grows at either end, so pushing and popping
+ * at the front or the back never moves an element.
+ ****************************************/
+template <typename T, typename A = std::allocator<T>>
+class deque
+{
+   friend class ::TestDeque; // give unit tests access to the privates
+   friend class ::TestQueue;
+   friend class ::TestStack;
+public:
+
+   //
+   // Construct
+   //
+   deque(const A & a = A());
+   deque(size_t num,                         const A & a = A());
+   deque(size_t num, const T & t,            const A & a = A());
+   deque(const std::initializer_list<T> & l, const A & a = A());
+   deque(const deque &  rhs);
+   deque(      deque && rhs);
+  ~deque();
+
+   //
+   // Assign
+   //
+   deque & operator = (const deque &  rhs);
+   deque & operator = (      deque && rhs);
+   deque & operator = (const std::initializer_list<T> & l);
+   void swap(deque & rhs)
+   {
+      std::swap(map,         rhs.map);
+      std::swap(numBlocks,   rhs.numBlocks);
+      std::swap(iaFront,     rhs.iaFront);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0);           }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+         T & operator [] (size_t id)       { return element(id); }
+   const T & operator [] (size_t id) const { return element(id); }
+         T & at(size_t id);
+   const T & at(size_t id) const;
+         T & front()       { return element(0);               }
+   const T & front() const { return element(0);               }
+         T & back()        { return element(numElements - 1); }
+   const T & back()  const { return element(numElements - 1); }
+
+   //
+   // Insert
+   //
+   void push_front(const T &  t) { emplace_front(t);            }
+   void push_front(      T && t) { emplace_front(std::move(t)); }
+   void push_back (const T &  t) { emplace_back(t);             }
+   void push_back (      T && t) { emplace_back(std::move(t));  }
+   template <class ... Args>
+   T & emplace_front(Args && ... args);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   //
+   // Remove
+   //
+   void pop_front();
+   void pop_back();
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+   // number of elements in each block. Aim for about 512 bytes a block
+   static constexpr size_t blockSize = sizeof(T) < 32 ? 512 / sizeof(T) : 16;
+
+private:
+
+   // find the element at a given index from the front
+   T & element(size_t id) const
+   {
+      assert(id < numElements);
+      size_t ia = iaFront + id;
+      return map[ia / blockSize][ia % blockSize];
+   }
+
+   void allocateBlock(size_t ib);
+   void deleteBlock(size_t ib);
+   void reallocateMap();
+
+   A       alloc;        // use allocator for the blocks
+   T **    map;          // the blocks. Unused slots are nullptr
+   size_t  numBlocks;    // number of slots in the map
+   size_t  iaFront;      // absolute index of the front element across all blocks
+   size_t  numElements;  // number of elements currently in the deque
+};
+
+/**************************************************
+ * DEQUE ITERATOR
+ * A random-access iterator through a deque. We keep
+ * the index rather than a pointer so that the iterator
+ * stays simple when it moves from one block to the next.
+ *************************************************/
+template <typename T, typename A>
+class deque <T, A> ::iterator
+{
+   friend class ::TestDeque; // give unit tests access to the privates
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   // constructors, destructors, and assignment operator
+   iterator()                       : pDeque(nullptr),    id(0)      {}
+   iterator(deque * pDeque, size_t id) : pDeque(pDeque),  id(id)     {}
+   iterator(const iterator & rhs)   : pDeque(rhs.pDeque), id(rhs.id) {}
+   iterator & operator = (const iterator & rhs)
+   {
+      pDeque = rhs.pDeque;
+      id     = rhs.id;
+      return *this;
+   }
+
+   // compare
+   bool operator == (const iterator & rhs) const { return id == rhs.id; }
+   bool operator != (const iterator & rhs) const { return id != rhs.id; }
+   bool operator <  (const iterator & rhs) const { return id <  rhs.id; }
+   bool operator >  (const iterator & rhs) const { return id >  rhs.id; }
+   bool operator <= (const iterator & rhs) const { return id <= rhs.id; }
+   bool operator >= (const iterator & rhs) const { return id >= rhs.id; }
+
+   // dereference
+   T & operator *  () const { return pDeque->element(id);  }
+   T * operator -> () const { return &pDeque->element(id); }
+   T & operator [] (difference_type offset) const
+   {
+      return pDeque->element(id + offset);
+   }
+
+   // arithmetic
+   iterator & operator += (difference_type offset) { id += offset; return *this; }
+   iterator & operator -= (difference_type offset) { id -= offset; return *this; }
+   iterator   operator +  (difference_type offset) const { return iterator(pDeque, id + offset); }
+   iterator   operator -  (difference_type offset) const { return iterator(pDeque, id - offset); }
+   difference_type operator - (const iterator & rhs) const
+   {
+      return (difference_type)id - (difference_type)rhs.id;
+   }
+
+   // increment and decrement
+   iterator & operator ++ ()    { ++id; return *this; }
+   iterator   operator ++ (int) { iterator temp(*this); ++id; return temp; }
+   iterator & operator -- ()    { --id; return *this; }
+   iterator   operator -- (int) { iterator temp(*this); --id; return temp; }
+
+private:
+   deque * pDeque;    // the deque we are iterating through
+   size_t  id;        // index from the front of the deque
+};
+
+/*****************************************
+ * DEQUE :: DEFAULT constructor
+ * No blocks and no map until something is added
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> ::deque(const A & a) :
+   alloc(a), map(nullptr), numBlocks(0), iaFront(0), numElements(0)
+{
+}
+
+/*****************************************
+ * DEQUE :: NON-DEFAULT constructors
+ * Create a deque with num default or copied elements
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> ::deque(size_t num, const A & a) :
+   alloc(a), map(nullptr), numBlocks(0), iaFront(0), numElements(0)
+{
+   for (size_t i = 0; i < num; i++)
+      emplace_back();
+}
+
+template <typename T, typename A>
+deque <T, A> ::deque(size_t num, const T & t, const A & a) :
+   alloc(a), map(nullptr), numBlocks(0), iaFront(0), numElements(0)
+{
+   for (size_t i = 0; i < num; i++)
+      emplace_back(t);
+}
+
+/*****************************************
+ * DEQUE :: INITIALIZATION LIST constructor
+ * Create a deque with an initialization list
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> ::deque(const std::initializer_list<T> & l, const A & a) :
+   alloc(a), map(nullptr), numBlocks(0), iaFront(0), numElements(0)
+{
+   for (const T & t : l)
+      emplace_back(t);
+}
+
+/*****************************************
+ * DEQUE :: COPY constructor
+ * Copy every element from the rhs
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> ::deque(const deque & rhs) :
+   alloc(rhs.alloc), map(nullptr), numBlocks(0), iaFront(0), numElements(0)
+{
+   for (size_t id = 0; id < rhs.numElements; id++)
+      emplace_back(rhs.element(id));
+}
+
+/*****************************************
+ * DEQUE :: MOVE constructor
+ * Steal the map and the blocks from the rhs
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> ::deque(deque && rhs) :
+   alloc(rhs.alloc), map(rhs.map), numBlocks(rhs.numBlocks),
+   iaFront(rhs.iaFront), numElements(rhs.numElements)
+{
+   rhs.map = nullptr;
+   rhs.numBlocks = 0;
+   rhs.iaFront = 0;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * DEQUE :: DESTRUCTOR
+ * Destroy the elements, free the blocks, then the map
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> :: ~deque()
+{
+   clear();
+   delete [] map;
+}
+
+/*****************************************
+ * DEQUE :: ASSIGNMENT
+ * Copy the elements of the rhs onto *this
+ ****************************************/
+template <typename T, typename A>
+deque <T, A> & deque <T, A> :: operator = (const deque & rhs)
+{
+   if (this != &rhs)
+   {
+      // overwrite the elements we already have
+      size_t id = 0;
+      for (; id < numElements && id < rhs.numElements; id++)
+         element(id) = rhs.element(id);
+
+      // then add or remove what is left
+      for (; id < rhs.numElements; id++)
+         emplace_back(rhs.element(id));
+      while (numElements > rhs.numElements)
+         pop_back();
+   }
+   return *this;
+}
+
+template <typename T, typename A>
+deque <T, A> & deque <T, A> :: operator = (deque && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+template <typename T, typename A>
+deque <T, A> & deque <T, A> :: operator = (const std::initializer_list<T> & l)
+{
+   clear();
+   for (const T & t : l)
+      emplace_back(t);
+   return *this;
+}
+
+/*****************************************
+ * DEQUE :: AT
+ * Access with bounds checking
+ ****************************************/
+template <typename T, typename A>
+T & deque <T, A> ::at(size_t id)
+{
+   if (id >= numElements)
+      throw std::out_of_range("invalid deque<T> subscript");
+   return element(id);
+}
+
+template <typename T, typename A>
+const T & deque <T, A> ::at(size_t id) const
+{
+   if (id >= numElements)
+      throw std::out_of_range("invalid deque<T> subscript");
+   return element(id);
+}
+
+/*****************************************
+ * DEQUE :: EMPLACE FRONT
+ * Construct a new element in front of the first one.
+ * Only the map ever moves, never the elements.
+ ****************************************/
+template <typename T, typename A>
+template <class ... Args>
+T & deque <T, A> ::emplace_front(Args && ... args)
+{
+   // no room in front of the first block
+   if (iaFront == 0)
+      reallocateMap();
+
+   // the slot before the front may be in a block we do not have yet
+   size_t ia = iaFront - 1;
+   if (map[ia / blockSize] == nullptr)
+      allocateBlock(ia / blockSize);
+
+   T * p = map[ia / blockSize] + (ia % blockSize);
+   std::allocator_traits<A>::construct(alloc, p, std::forward<Args>(args)...);
+   iaFront = ia;
+   numElements++;
+   return *p;
+}
+
+/*****************************************
+ * DEQUE :: EMPLACE BACK
+ * Construct a new element after the last one
+ ****************************************/
+template <typename T, typename A>
+template <class ... Args>
+T & deque <T, A> ::emplace_back(Args && ... args)
+{
+   // no room after the last block
+   if (iaFront + numElements == numBlocks * blockSize)
+      reallocateMap();
+
+   // the slot after the back may be in a block we do not have yet
+   size_t ia = iaFront + numElements;
+   if (map[ia / blockSize] == nullptr)
+      allocateBlock(ia / blockSize);
+
+   T * p = map[ia / blockSize] + (ia % blockSize);
+   std::allocator_traits<A>::construct(alloc, p, std::forward<Args>(args)...);
+   numElements++;
+   return *p;
+}
+
+/*****************************************
+ * DEQUE :: POP FRONT
+ * Destroy the first element, freeing its block
+ * once the block has nothing left in it
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::pop_front()
+{
+   if (numElements == 0)
+      return;
+
+   size_t ia = iaFront;
+   std::allocator_traits<A>::destroy(alloc, map[ia / blockSize] + (ia % blockSize));
+   iaFront++;
+   numElements--;
+
+   if (ia % blockSize == blockSize - 1 || numElements == 0)
+      deleteBlock(ia / blockSize);
+}
+
+/*****************************************
+ * DEQUE :: POP BACK
+ * Destroy the last element, freeing its block
+ * once the block has nothing left in it
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::pop_back()
+{
+   if (numElements == 0)
+      return;
+
+   size_t ia = iaFront + numElements - 1;
+   std::allocator_traits<A>::destroy(alloc, map[ia / blockSize] + (ia % blockSize));
+   numElements--;
+
+   if (ia % blockSize == 0 || numElements == 0)
+      deleteBlock(ia / blockSize);
+}
+
+/*****************************************
+ * DEQUE :: CLEAR
+ * Destroy every element and free every block.
+ * The map stays so we can fill it again.
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::clear()
+{
+   for (size_t id = 0; id < numElements; id++)
+      std::allocator_traits<A>::destroy(alloc, &element(id));
+
+   for (size_t ib = 0; ib < numBlocks; ib++)
+      if (map[ib])
+         deleteBlock(ib);
+
+   numElements = 0;
+   iaFront = (numBlocks / 2) * blockSize;
+}
+
+/*****************************************
+ * DEQUE :: ALLOCATE BLOCK
+ * Get the raw memory for one block. No elements are constructed.
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::allocateBlock(size_t ib)
+{
+   assert(ib < numBlocks && map[ib] == nullptr);
+   map[ib] = std::allocator_traits<A>::allocate(alloc, blockSize);
+}
+
+/*****************************************
+ * DEQUE :: DELETE BLOCK
+ * Give back the memory of one block. Its elements
+ * must already be destroyed.
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::deleteBlock(size_t ib)
+{
+   assert(ib < numBlocks && map[ib] != nullptr);
+   std::allocator_traits<A>::deallocate(alloc, map[ib], blockSize);
+   map[ib] = nullptr;
+}
+
+/*****************************************
+ * DEQUE :: REALLOCATE MAP
+ * Make room for a block at both ends of the map. If the
+ * map is mostly empty we just re-center the blocks we have,
+ * otherwise we double it. Elements are never copied.
+ ****************************************/
+template <typename T, typename A>
+void deque <T, A> ::reallocateMap()
+{
+   // which blocks are in use right now
+   size_t ibFirst = iaFront / blockSize;
+   size_t numUsed = (numElements == 0) ? 0 :
+      (iaFront + numElements - 1) / blockSize - ibFirst + 1;
+
+   // keep the size if at least half the map is free, otherwise grow
+   size_t numBlocksNew = (numBlocks >= 2 * numUsed + 2) ? numBlocks : numBlocks * 2 + 2;
+
+   // put the blocks in use in the middle of the new map
+   T ** mapNew = new T * [numBlocksNew]();
+   size_t ibFirstNew = (numBlocksNew - numUsed) / 2;
+   for (size_t i = 0; i < numUsed; i++)
+      mapNew[ibFirstNew + i] = map[ibFirst + i];
+
+   delete [] map;
+   map = mapNew;
+   numBlocks = numBlocksNew;
+   iaFront = ibFirstNew * blockSize + (numElements == 0 ? blockSize / 2 : iaFront % blockSize);
+}
+
+} // namespace custom
@@ -0,0 +1,117 @@
+/***********************************************************************
+ * Module:
+ *    Queue
+ * Summary:
+ *    Our custom implementation of std::queue
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       queue             : similar to std::queue
+ * Author
+ *    Austin Jesperson, Emilio Ordonez, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+#include <utility>  // for std::move
+#include "deque.h"
+
+class TestQueue; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * QUEUE
+ * First-in-First-out data structure. Any container
+ * with push_back, pop_front, front and back will do.
+ *************************************************/
+template<class T, class Container = custom::deque<T>>
+class queue
+{
+   friend class ::TestQueue; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+
+   queue()                                                               { }
+   queue(const queue &  rhs)     : container(rhs.container)            { }
+   queue(      queue && rhs)     : container(std::move(rhs.container)) { }
+   queue(const Container &  rhs) : container(rhs)                      { }
+   queue(      Container && rhs) : container(std::move(rhs))           { }
+  ~queue()                                                               { }
+
+   //
+   // Assign
+   //
+
+   queue & operator = (const queue & rhs)
+   {
+      container = rhs.container;
+      return *this;
+   }
+   queue & operator = (queue && rhs)
+   {
+      container = std::move(rhs.container);
+      return *this;
+   }
+   void swap(queue & rhs)
+   {
+      container.swap(rhs.container);
+   }
+
+   //
+   // Access
+   //
+
+         T & front()       { return container.front(); }
+   const T & front() const { return container.front(); }
+         T & back()        { return container.back();  }
+   const T & back()  const { return container.back();  }
+
+   //
+   // Insert
+   //
+
+   void push(const T &  t) { container.push_back(t);            }
+   void push(      T && t) { container.push_back(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args)
+   {
+      container.emplace_back(std::forward<Args>(args)...);
+   }
+
+   //
+   // Remove
+   //
+
+   void pop()
+   {
+      if (!container.empty())
+         container.pop_front();
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return container.size();  }
+   bool   empty() const { return container.empty(); }
+
+private:
+
+   Container container;  // underlying container
+};
+
+} // custom namespace
@@ -21,8 +21,9 @@
 #pragma once
 
 #include <cassert>  // because I am paranoid
-//#include "vector.h"
-#include <vector>
+#include <cstddef>  // for size_t
+#include <utility>  // for std::move, std::forward
+#include "vector.h"
 
 class TestStack; // forward declaration for unit tests
 
@@ -31,9 +32,10 @@ namespace custom
 
 /**************************************************
  * STACK
- * First-in-Last-out data structure
+ * First-in-Last-out data structure. Any container
+ * with push_back, pop_back and back will do.
  *************************************************/
-template<class T>
+template<class T, class Container = custom::vector<T>>
 class stack
 {
    friend class ::TestStack; // give unit tests access to the privates
@@ -43,36 +45,28 @@ public:
    // Construct
    // 
 
-   stack()  { container.resize(defaultSize); }
-   stack(const stack <T> &  rhs)      
-   { 
-       container.reserve(rhs.container.size()); // Reserve space to avoid unnecessary reallocations
-       for (const T& element : rhs.container) {
-           container.push_back(element); // Copy each element from rhs to this container
-       }
-   }
-   stack(      stack <T> && rhs)      { container.swap(rhs.container); }
-   
-   stack(const std::vector<T> &  rhs) { container.resize(rhs.size()); }
-   stack(      std::vector<T> && rhs) { container.resize(rhs.size()); }
-
-   ~stack()                           {                      }
+   stack()                                                               { }
+   stack(const stack &  rhs)     : container(rhs.container)            { }
+   stack(      stack && rhs)     : container(std::move(rhs.container)) { }
+   stack(const Container &  rhs) : container(rhs)                      { }
+   stack(      Container && rhs) : container(std::move(rhs))           { }
+  ~stack()                                                               { }
 
    //
    // Assign
    //
 
-   stack <T> & operator = (const stack <T> & rhs)
+   stack & operator = (const stack & rhs)
    {
        container = rhs.container;
        return *this;
    }
-   stack <T>& operator = (stack <T> && rhs)
+   stack& operator = (stack && rhs)
    {
        container = std::move(rhs.container);
        return *this;
    }
-   void swap(stack <T>& rhs)
+   void swap(stack& rhs)
    {
        container.swap(rhs.container);
    }
@@ -81,8 +75,8 @@ public:
    // Access
    //
 
-   T& top() { return container[container.size() - 1]; }
-   const T& top() const { return container[container.size() - 1]; }
+   T& top() { return container.back(); }
+   const T& top() const { return container.back(); }
 
    // 
    // Insert
@@ -96,6 +90,11 @@ public:
    {
        container.push_back(std::move(t));
    }
+   template <class ... Args>
+   void emplace(Args && ... args)
+   {
+       container.emplace_back(std::forward<Args>(args)...);
+   }
 
    //
    // Remove
@@ -128,9 +127,7 @@ public:
    
 private:
 
-    int defaultSize = 0;
-   
-  std::vector<T> container;  // underlying container
+   Container container;  // underlying container
 };
 
 
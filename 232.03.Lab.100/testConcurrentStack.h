@@ -0,0 +1,337 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT STACK
+ * Summary:
+ *    Unit tests for concurrent_stack
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "concurrent_stack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <thread>   // for std::thread
+#include <vector>   // for a team of threads
+
+class TestConcurrentStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_standard();
+
+      // Insert
+      test_push_copy();
+      test_push_move();
+      test_emplace_empty();
+      test_push_chunks();
+
+      // Remove
+      test_tryPop_empty();
+      test_tryPop_standard();
+      test_tryPop_lifo();
+      test_tryPop_recycle();
+
+      // Threads
+      test_threads_pushThenPop();
+      test_threads_mixed();
+
+      report("ConcurrentStack");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::concurrent_stack<Spy> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(s.empty());
+      assertUnit(s.numNodes == 0);
+      assertUnit(s.chunks[0] == nullptr);
+   }  // teardown
+
+   // the destructor cleans up whatever is still on the stack
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::concurrent_stack<Spy> s;
+         setupStandardFixture(s);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete  [26,49,67,89]
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push a copy onto an empty stack
+   void test_push_copy()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      s.push(value);
+      // verify
+      assertUnit(Spy::numCopy() == 1);     // copy     [99]
+      assertUnit(Spy::numAlloc() == 1);    // allocate [99]
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(value == Spy(99));
+      assertUnit(!s.empty());
+      assertUnit(s.numNodes == 1);
+   }  // teardown
+
+   // push with move semantics
+   void test_push_move()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      s.push(std::move(value));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1); // move     [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value.empty());
+      assertUnit(!s.empty());
+   }  // teardown
+
+   // emplace builds the element in the node
+   void test_emplace_empty()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      Spy::reset();
+      // exercise
+      s.emplace(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      Spy value;
+      assertUnit(s.try_pop(value));
+      assertUnit(value == Spy(99));
+   }  // teardown
+
+   // enough pushes to spill into a second and third chunk
+   void test_push_chunks()
+   {  // setup
+      custom::concurrent_stack<int> s;
+      // exercise
+      for (int i = 1; i <= 200; i++)
+         s.push(i);
+      // verify
+      assertUnit(s.numNodes == 200);
+      assertUnit(s.chunks[0] != nullptr);  // 1..64
+      assertUnit(s.chunks[1] != nullptr);  // 65..192
+      assertUnit(s.chunks[2] != nullptr);  // 193..448
+      assertUnit(s.chunks[3] == nullptr);
+      int value = 0;
+      bool inOrder = true;
+      for (int i = 200; i >= 1; i--)
+         inOrder = inOrder && s.try_pop(value) && value == i;
+      assertUnit(inOrder);
+      assertUnit(s.empty());
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop from an empty stack leaves the destination alone
+   void test_tryPop_empty()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool popped = s.try_pop(value);
+      // verify
+      assertUnit(!popped);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(value == Spy(99));
+   }  // teardown
+
+   // pop the top of the standard fixture
+   void test_tryPop_standard()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      setupStandardFixture(s);
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool popped = s.try_pop(value);
+      // verify
+      assertUnit(popped);
+      assertUnit(Spy::numAssignMove() == 1); // move    [89]
+      assertUnit(Spy::numDestructor() == 1); // destroy [89]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(value == Spy(89));
+   }  // teardown
+
+   // elements come out in reverse order
+   void test_tryPop_lifo()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      setupStandardFixture(s);
+      Spy value;
+      // exercise
+      bool popped89 = s.try_pop(value) && value == Spy(89);
+      bool popped67 = s.try_pop(value) && value == Spy(67);
+      bool popped49 = s.try_pop(value) && value == Spy(49);
+      bool popped26 = s.try_pop(value) && value == Spy(26);
+      // verify
+      assertUnit(popped89);
+      assertUnit(popped67);
+      assertUnit(popped49);
+      assertUnit(popped26);
+      assertUnit(s.empty());
+      assertUnit(!s.try_pop(value));
+   }  // teardown
+
+   // popped nodes are reused instead of growing the pool
+   void test_tryPop_recycle()
+   {  // setup
+      custom::concurrent_stack<int> s;
+      for (int i = 0; i < 10; i++)
+         s.push(i);
+      int value;
+      for (int i = 0; i < 10; i++)
+         s.try_pop(value);
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         s.push(i);
+         s.try_pop(value);
+      }
+      for (int i = 0; i < 10; i++)
+         s.push(i);
+      // verify
+      assertUnit(s.numNodes == 10);
+      assertUnit(s.chunks[1] == nullptr);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // many threads push, then many threads pop; nothing is lost or duplicated
+   void test_threads_pushThenPop()
+   {  // setup
+      const int numThreads = 8;
+      const int numEach = 5000;
+      custom::concurrent_stack<int> s;
+      std::vector<std::thread> team;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&s, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+               s.push(t * numEach + i);
+         });
+      for (auto & thread : team)
+         thread.join();
+      team.clear();
+      std::vector<int> seen(numThreads * numEach, 0);
+      std::vector<long long> sums(numThreads, 0);
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&s, &sums, &seen, t]()
+         {
+            int value;
+            while (s.try_pop(value))
+            {
+               sums[t] += value;
+               seen[value]++;
+            }
+         });
+      for (auto & thread : team)
+         thread.join();
+      // verify
+      long long total = 0;
+      for (long long sum : sums)
+         total += sum;
+      long long n = numThreads * numEach;
+      assertUnit(total == n * (n - 1) / 2);
+      bool once = true;
+      for (int count : seen)
+         once = once && count == 1;
+      assertUnit(once);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // threads push and pop at the same time, the free-list case that invites ABA
+   void test_threads_mixed()
+   {  // setup
+      const int numThreads = 8;
+      const int numEach = 20000;
+      custom::concurrent_stack<int> s;
+      std::vector<std::thread> team;
+      std::vector<long long> pushed(numThreads, 0);
+      std::vector<long long> popped(numThreads, 0);
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         team.emplace_back([&s, &pushed, &popped, t]()
+         {
+            int value;
+            for (int i = 0; i < numEach; i++)
+            {
+               s.push(i);
+               pushed[t] += i;
+               if (s.try_pop(value))
+                  popped[t] += value;
+            }
+         });
+      for (auto & thread : team)
+         thread.join();
+      // verify
+      long long totalPushed = 0;
+      long long totalPopped = 0;
+      for (int t = 0; t < numThreads; t++)
+      {
+         totalPushed += pushed[t];
+         totalPopped += popped[t];
+      }
+      int value;
+      while (s.try_pop(value))
+         totalPopped += value;
+      assertUnit(totalPushed == totalPopped);
+      assertUnit(s.numNodes <= (uint32_t)(numThreads * 2));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |  <-- top
+    *    +----+----+----+----+
+    *************************************************************/
+   void setupStandardFixture(custom::concurrent_stack<Spy>& s)
+   {
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      s.push(Spy(89));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,510 @@
+/***********************************************************************
+ * Header:
+ *    TEST DEQUE
+ * Summary:
+ *    Unit tests for deque
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "deque.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <algorithm>   // for std::sort
+#include <stdexcept>   // for std::out_of_range
+
+class TestDeque : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_empty();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_destructor_standard();
+
+      // Assign
+      test_assign_standardToEmpty();
+      test_assign_emptyToStandard();
+
+      // Access
+      test_subscript_standard();
+      test_at_standardMissing();
+      test_iterator_standard();
+      test_iterator_sort();
+
+      // Insert
+      test_pushBack_empty();
+      test_pushBack_move();
+      test_pushBack_blocks();
+      test_pushFront_empty();
+      test_pushFront_blocks();
+      test_emplaceBack_empty();
+
+      // Remove
+      test_popFront_standard();
+      test_popBack_standard();
+      test_pop_empty();
+      test_pop_fifo();
+      test_clear_standard();
+
+      report("Deque");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::deque<Spy> d;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(d.map == nullptr);
+      assertUnit(d.numBlocks == 0);
+      assertEmptyFixture(d);
+   }  // teardown
+
+   // copy an empty deque
+   void test_constructCopy_empty()
+   {  // setup
+      custom::deque<Spy> dSrc;
+      Spy::reset();
+      // exercise
+      custom::deque<Spy> dDest(dSrc);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertEmptyFixture(dSrc);
+      assertEmptyFixture(dDest);
+   }  // teardown
+
+   // copy the standard fixture
+   void test_constructCopy_standard()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::deque<Spy> dSrc;
+      setupStandardFixture(dSrc);
+      Spy::reset();
+      // exercise
+      custom::deque<Spy> dDest(dSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 4);     // copy     [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);    // allocate [26,49,67,89]
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertStandardFixture(dSrc);
+      assertStandardFixture(dDest);
+   }  // teardown
+
+   // move the standard fixture: no element is touched
+   void test_constructMove_standard()
+   {  // setup
+      custom::deque<Spy> dSrc;
+      setupStandardFixture(dSrc);
+      Spy::reset();
+      // exercise
+      custom::deque<Spy> dDest(std::move(dSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertEmptyFixture(dSrc);
+      assertStandardFixture(dDest);
+   }  // teardown
+
+   // destroy the standard fixture
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::deque<Spy> d;
+         setupStandardFixture(d);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy  [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete   [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 0);
+   }
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign the standard fixture onto an empty deque
+   void test_assign_standardToEmpty()
+   {  // setup
+      custom::deque<Spy> dSrc;
+      setupStandardFixture(dSrc);
+      custom::deque<Spy> dDest;
+      Spy::reset();
+      // exercise
+      dDest = dSrc;
+      // verify
+      assertUnit(Spy::numCopy() == 4);     // copy     [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);    // allocate [26,49,67,89]
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(dSrc);
+      assertStandardFixture(dDest);
+   }  // teardown
+
+   // assign an empty deque onto the standard fixture
+   void test_assign_emptyToStandard()
+   {  // setup
+      custom::deque<Spy> dSrc;
+      custom::deque<Spy> dDest;
+      setupStandardFixture(dDest);
+      Spy::reset();
+      // exercise
+      dDest = dSrc;
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy  [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete   [26,49,67,89]
+      assertUnit(Spy::numCopy() == 0);
+      assertEmptyFixture(dSrc);
+      assertEmptyFixture(dDest);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // read and write through the subscript operator
+   void test_subscript_standard()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      Spy::reset();
+      // exercise
+      d[1] = Spy(11);
+      // verify
+      assertUnit(d[0] == Spy(26));
+      assertUnit(d[1] == Spy(11));
+      assertUnit(d.front() == Spy(26));
+      assertUnit(d.back() == Spy(89));
+   }  // teardown
+
+   // at() past the end throws
+   void test_at_standardMissing()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         d.at(4);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(d.at(3) == Spy(89));
+      assertStandardFixture(d);
+   }  // teardown
+
+   // walk the standard fixture front to back
+   void test_iterator_standard()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      // exercise
+      custom::deque<Spy>::iterator it = d.begin();
+      // verify
+      assertUnit(*it == Spy(26));
+      assertUnit(*(it + 3) == Spy(89));
+      assertUnit(it[2] == Spy(67));
+      assertUnit(d.end() - d.begin() == 4);
+      ++it;
+      assertUnit(*it == Spy(49));
+      it += 3;
+      assertUnit(it == d.end());
+      --it;
+      assertUnit(*it == Spy(89));
+   }  // teardown
+
+   // the iterator is good enough for std::sort across several blocks
+   void test_iterator_sort()
+   {  // setup
+      custom::deque<int> d;
+      int num = (int)custom::deque<int>::blockSize * 3 + 5;
+      for (int i = 0; i < num; i++)
+         if (i % 2)
+            d.push_back(i);
+         else
+            d.push_front(i);
+      // exercise
+      std::sort(d.begin(), d.end());
+      // verify
+      bool sorted = true;
+      for (int i = 0; i < num; i++)
+         sorted = sorted && d[i] == i;
+      assertUnit(sorted);
+      assertUnit(d.size() == (size_t)num);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push_back onto an empty deque
+   void test_pushBack_empty()
+   {  // setup
+      custom::deque<Spy> d;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      d.push_back(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);     // copy     [99]
+      assertUnit(Spy::numAlloc() == 1);    // allocate [99]
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(d.size() == 1);
+      assertUnit(d.front() == Spy(99));
+      assertUnit(d.back() == Spy(99));
+   }  // teardown
+
+   // push_back with move semantics does not allocate
+   void test_pushBack_move()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      d.push_back(std::move(s));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1); // move     [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(d.size() == 5);
+      assertUnit(d.back() == Spy(99));
+      assertUnit(s.empty());
+   }  // teardown
+
+   // push_back enough to need several blocks. Nothing moves
+   void test_pushBack_blocks()
+   {  // setup
+      custom::deque<int> d;
+      int num = (int)custom::deque<int>::blockSize * 5;
+      d.push_back(0);
+      int * pFirst = &d.front();
+      // exercise
+      for (int i = 1; i < num; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.size() == (size_t)num);
+      assertUnit(&d.front() == pFirst);
+      bool inOrder = true;
+      for (int i = 0; i < num; i++)
+         inOrder = inOrder && d[i] == i;
+      assertUnit(inOrder);
+   }  // teardown
+
+   // push_front onto an empty deque
+   void test_pushFront_empty()
+   {  // setup
+      custom::deque<Spy> d;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      d.push_front(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);     // copy     [99]
+      assertUnit(Spy::numAlloc() == 1);    // allocate [99]
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(d.size() == 1);
+      assertUnit(d.front() == Spy(99));
+   }  // teardown
+
+   // push_front enough to need several blocks. Nothing moves
+   void test_pushFront_blocks()
+   {  // setup
+      custom::deque<int> d;
+      int num = (int)custom::deque<int>::blockSize * 5;
+      d.push_front(num - 1);
+      int * pLast = &d.back();
+      // exercise
+      for (int i = num - 2; i >= 0; i--)
+         d.push_front(i);
+      // verify
+      assertUnit(d.size() == (size_t)num);
+      assertUnit(&d.back() == pLast);
+      bool inOrder = true;
+      for (int i = 0; i < num; i++)
+         inOrder = inOrder && d[i] == i;
+      assertUnit(inOrder);
+   }  // teardown
+
+   // emplace_back constructs in place
+   void test_emplaceBack_empty()
+   {  // setup
+      custom::deque<Spy> d;
+      Spy::reset();
+      // exercise
+      d.emplace_back(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create   [99]
+      assertUnit(Spy::numAlloc() == 1);      // allocate [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(d.size() == 1);
+      assertUnit(d.back() == Spy(99));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop_front from the standard fixture
+   void test_popFront_standard()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      Spy::reset();
+      // exercise
+      d.pop_front();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [26]
+      assertUnit(Spy::numDelete() == 1);     // delete  [26]
+      assertUnit(d.size() == 3);
+      assertUnit(d.front() == Spy(49));
+      assertUnit(d.back() == Spy(89));
+   }  // teardown
+
+   // pop_back from the standard fixture
+   void test_popBack_standard()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      Spy::reset();
+      // exercise
+      d.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [89]
+      assertUnit(Spy::numDelete() == 1);     // delete  [89]
+      assertUnit(d.size() == 3);
+      assertUnit(d.front() == Spy(26));
+      assertUnit(d.back() == Spy(67));
+   }  // teardown
+
+   // popping an empty deque does nothing
+   void test_pop_empty()
+   {  // setup
+      custom::deque<Spy> d;
+      Spy::reset();
+      // exercise
+      d.pop_front();
+      d.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertEmptyFixture(d);
+   }  // teardown
+
+   // a long first-in-first-out run only ever needs a handful of blocks
+   void test_pop_fifo()
+   {  // setup
+      custom::deque<int> d;
+      int num = (int)custom::deque<int>::blockSize * 100;
+      // exercise
+      bool inOrder = true;
+      for (int i = 0; i < num; i++)
+      {
+         d.push_back(i);
+         if (i >= 3)
+         {
+            inOrder = inOrder && d.front() == i - 3;
+            d.pop_front();
+         }
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(d.size() == 3);
+      assertUnit(d.numBlocks <= 8);
+      size_t numAllocated = 0;
+      for (size_t ib = 0; ib < d.numBlocks; ib++)
+         numAllocated += (d.map[ib] != nullptr);
+      assertUnit(numAllocated <= 2);
+   }  // teardown
+
+   // clear the standard fixture
+   void test_clear_standard()
+   {  // setup
+      custom::deque<Spy> d;
+      setupStandardFixture(d);
+      Spy::reset();
+      // exercise
+      d.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy  [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);     // delete   [26,49,67,89]
+      assertEmptyFixture(d);
+      d.push_back(Spy(11));
+      assertUnit(d.size() == 1);
+      assertUnit(d.front() == Spy(11));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |
+    *    +----+----+----+----+
+    *************************************************************/
+   void setupStandardFixture(custom::deque<Spy>& d)
+   {
+      d.push_back(Spy(49));
+      d.push_back(Spy(67));
+      d.push_front(Spy(26));
+      d.push_back(Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY EMPTY FIXTURE
+    *************************************************************/
+   void assertEmptyFixtureParameters(const custom::deque<Spy>& d, int line, const char* function)
+   {
+      assertIndirect(d.empty());
+      assertIndirect(d.size() == 0);
+      assertIndirect(d.numElements == 0);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |
+    *    +----+----+----+----+
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::deque<Spy>& d, int line, const char* function)
+   {
+      assertIndirect(d.size() == 4);
+      if (d.size() == 4)
+      {
+         assertIndirect(d[0] == Spy(26));
+         assertIndirect(d[1] == Spy(49));
+         assertIndirect(d[2] == Spy(67));
+         assertIndirect(d[3] == Spy(89));
+      }
+   }
+};
+
+#endif // DEBUG
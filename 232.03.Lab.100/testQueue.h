@@ -0,0 +1,290 @@
+/***********************************************************************
+ * Header:
+ *    TEST QUEUE
+ * Summary:
+ *    Unit tests for queue
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "queue.h"
+#include "deque.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <list>     // std::list as an alternate container
+
+class TestQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructContainer_standard();
+
+      // Access
+      test_front_standard();
+      test_back_standard();
+
+      // Insert
+      test_push_empty();
+      test_push_move();
+      test_emplace_empty();
+
+      // Remove
+      test_pop_empty();
+      test_pop_standard();
+      test_pop_fifo();
+
+      // Alternate container
+      test_push_list();
+
+      report("Queue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::queue<Spy> q;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(q.empty());
+      assertUnit(q.size() == 0);
+   }  // teardown
+
+   // copy the standard fixture
+   void test_constructCopy_standard()
+   {  // setup
+      custom::queue<Spy> qSrc;
+      setupStandardFixture(qSrc);
+      Spy::reset();
+      // exercise
+      custom::queue<Spy> qDest(qSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 4);     // copy     [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);    // allocate [26,49,67,89]
+      assertStandardFixture(qSrc);
+      assertStandardFixture(qDest);
+   }  // teardown
+
+   // move the standard fixture
+   void test_constructMove_standard()
+   {  // setup
+      custom::queue<Spy> qSrc;
+      setupStandardFixture(qSrc);
+      Spy::reset();
+      // exercise
+      custom::queue<Spy> qDest(std::move(qSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(qSrc.empty());
+      assertStandardFixture(qDest);
+   }  // teardown
+
+   // adopt an existing deque
+   void test_constructContainer_standard()
+   {  // setup
+      custom::deque<Spy> d{ Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::queue<Spy> q(std::move(d));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertStandardFixture(q);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // front is the oldest element
+   void test_front_standard()
+   {  // setup
+      custom::queue<Spy> q;
+      setupStandardFixture(q);
+      Spy::reset();
+      // exercise
+      q.front() = Spy(11);
+      // verify
+      assertUnit(q.front() == Spy(11));
+      assertUnit(q.size() == 4);
+   }  // teardown
+
+   // back is the newest element
+   void test_back_standard()
+   {  // setup
+      custom::queue<Spy> q;
+      setupStandardFixture(q);
+      // exercise
+      q.back() = Spy(11);
+      // verify
+      assertUnit(q.back() == Spy(11));
+      assertUnit(q.front() == Spy(26));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty queue
+   void test_push_empty()
+   {  // setup
+      custom::queue<Spy> q;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      q.push(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);     // copy     [99]
+      assertUnit(Spy::numAlloc() == 1);    // allocate [99]
+      assertUnit(q.size() == 1);
+      assertUnit(q.front() == Spy(99));
+      assertUnit(q.back() == Spy(99));
+   }  // teardown
+
+   // push with move semantics
+   void test_push_move()
+   {  // setup
+      custom::queue<Spy> q;
+      setupStandardFixture(q);
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      q.push(std::move(s));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1); // move     [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(q.back() == Spy(99));
+      assertUnit(q.front() == Spy(26));
+   }  // teardown
+
+   // emplace constructs in place
+   void test_emplace_empty()
+   {  // setup
+      custom::queue<Spy> q;
+      Spy::reset();
+      // exercise
+      q.emplace(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create   [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(q.front() == Spy(99));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop from an empty queue does nothing
+   void test_pop_empty()
+   {  // setup
+      custom::queue<Spy> q;
+      Spy::reset();
+      // exercise
+      q.pop();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // pop the oldest element
+   void test_pop_standard()
+   {  // setup
+      custom::queue<Spy> q;
+      setupStandardFixture(q);
+      Spy::reset();
+      // exercise
+      q.pop();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [26]
+      assertUnit(Spy::numDelete() == 1);     // delete  [26]
+      assertUnit(q.size() == 3);
+      assertUnit(q.front() == Spy(49));
+      assertUnit(q.back() == Spy(89));
+   }  // teardown
+
+   // many elements come out in the order they went in
+   void test_pop_fifo()
+   {  // setup
+      custom::queue<int> q;
+      // exercise
+      for (int i = 0; i < 10000; i++)
+         q.push(i);
+      bool inOrder = true;
+      for (int i = 0; i < 10000; i++)
+      {
+         inOrder = inOrder && q.front() == i;
+         q.pop();
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // any container with the right methods will do
+   void test_push_list()
+   {  // setup
+      custom::queue<int, std::list<int>> q;
+      // exercise
+      q.push(26);
+      q.push(49);
+      q.pop();
+      q.push(67);
+      // verify
+      assertUnit(q.size() == 2);
+      assertUnit(q.front() == 49);
+      assertUnit(q.back() == 67);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    front                back
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |
+    *    +----+----+----+----+
+    *************************************************************/
+   void setupStandardFixture(custom::queue<Spy>& q)
+   {
+      q.push(Spy(26));
+      q.push(Spy(49));
+      q.push(Spy(67));
+      q.push(Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::queue<Spy>& q, int line, const char* function)
+   {
+      assertIndirect(q.size() == 4);
+      if (q.size() == 4)
+      {
+         assertIndirect(q.container[0] == Spy(26));
+         assertIndirect(q.container[1] == Spy(49));
+         assertIndirect(q.container[2] == Spy(67));
+         assertIndirect(q.container[3] == Spy(89));
+      }
+   }
+};
+
+#endif // DEBUG
@@ -13,6 +13,9 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testStack.h"       // for the stack unit tests
+#include "testDeque.h"       // for the deque unit tests
+#include "testQueue.h"       // for the queue unit tests
+#include "testConcurrentStack.h" // for the concurrent stack unit tests
 #include "testSpy.h"         // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -26,6 +29,9 @@ int main()
    // unit tests
    TestSpy().run();
    TestStack().run();
+   TestDeque().run();
+   TestQueue().run();
+   TestConcurrentStack().run();
 #endif // DEBUG
   
    return 0;
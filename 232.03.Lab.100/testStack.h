@@ -11,6 +11,7 @@
 
 #ifdef DEBUG
 #include "stack.h"
+#include "deque.h"
 #include "unitTest.h"
 #include "spy.h"
 
@@ -37,6 +38,14 @@ public:
       test_constructMove_empty();
       test_constructMove_standard();
       test_constructMove_partiallyFilled();
+      test_constructInit_empty();
+      test_constructInit_standard();
+      test_constructInit_emptySTD();
+      test_constructInit_standardSTD();
+      test_constructInitMove_empty();
+      test_constructInitMove_standard();
+      test_constructInitMove_emptySTD();
+      test_constructInitMove_standardSTD();
       test_destructor_empty();
       test_destructor_standard();
       test_destructor_partiallyFilled();
@@ -66,10 +75,14 @@ public:
       test_pushCopy_standard();
       test_pushMove_empty();
       test_pushMove_standard();
+      test_pushMove_standardList();
+      test_pushCopy_standardList();
+      test_emplace_standard();
 
       // Delete
       test_pop_empty();
       test_pop_standard();
+      test_pushPop_deque();
       
 
       // Status
@@ -387,6 +400,271 @@ public:
    }
 
 
+   /***************************************
+    * INITIALIZE CONSTRUCTOR
+    ***************************************/
+
+    // initialize constructor of an empty stack
+   void test_constructInit_empty()
+   {  // setup
+      custom::vector<Spy> vSrc;
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, custom::vector<Spy>> sDest(vSrc);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.empty() == true);
+      assertEmptyFixture(sDest);
+   }  // teardown
+
+   // move constructor of a 4-element collection
+   void test_constructInit_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> vSrc{Spy(26), Spy(49), Spy(67), Spy(89)};
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, custom::vector<Spy>> sDest(vSrc);
+      // verify      // verify
+      assertUnit(Spy::numCopy() == 4);     // create   [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);    // allocate [26,49,67,89]
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertUnit(vSrc.size() == 4);
+      assertUnit(vSrc.capacity() == 4);
+      if (vSrc.size() >= 4)
+      {
+         assertUnit(vSrc[0] == Spy(26));
+         assertUnit(vSrc[1] == Spy(49));
+         assertUnit(vSrc[2] == Spy(67));
+         assertUnit(vSrc[3] == Spy(89));
+      }
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(sDest);
+      // teardown
+      teardownStandardFixture(sDest);
+   }
+
+   // initialize constructor of an empty stack
+   void test_constructInit_emptySTD()
+   {  // setup
+      std::vector<Spy> vSrc;
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, std::vector<Spy>> sDest(vSrc);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.empty() == true);
+      assertUnit(sDest.container.size() == 0);
+      assertUnit(sDest.container.capacity() == 0);
+      assertUnit(vSrc.size() == 0);
+      assertUnit(vSrc.capacity() == 0);
+   }  // teardown
+
+   // move constructor of a 4-element collection
+   void test_constructInit_standardSTD()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      std::vector<Spy> vSrc{ Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, std::vector<Spy>> sDest(vSrc);
+      // verify      // verify
+      assertUnit(Spy::numCopy() == 4);     // create   [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);    // allocate [26,49,67,89]
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertUnit(vSrc.size() == 4);
+      assertUnit(vSrc.capacity() == 4);
+      if (vSrc.size() >= 4)
+      {
+         assertUnit(vSrc[0] == Spy(26));
+         assertUnit(vSrc[1] == Spy(49));
+         assertUnit(vSrc[2] == Spy(67));
+         assertUnit(vSrc[3] == Spy(89));
+      }
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertUnit(sDest.container.size() == 4);
+      assertUnit(sDest.container.capacity() == 4);
+      if (sDest.container.size() >= 4)
+      {
+         assertUnit(sDest.container[0] == Spy(26));
+         assertUnit(sDest.container[1] == Spy(49));
+         assertUnit(sDest.container[2] == Spy(67));
+         assertUnit(sDest.container[3] == Spy(89));
+      }
+      // teardown
+      sDest.container.clear();
+   }
+
+   /***************************************
+    * INITIALIZE CONSTRUCTOR
+    ***************************************/
+
+    // initialize constructor of an empty stack
+   void test_constructInitMove_empty()
+   {  // setup
+      custom::vector<Spy> vSrc;
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, custom::vector<Spy>> sDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.empty() == true);
+      assertEmptyFixture(sDest);
+   }  // teardown
+
+   // move constructor of a 4-element collection
+   void test_constructInitMove_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> vSrc{ Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, custom::vector<Spy>> sDest(std::move(vSrc));
+      // verify      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.size() == 0);
+      assertUnit(vSrc.capacity() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(sDest);
+      // teardown
+      teardownStandardFixture(sDest);
+   }
+
+   // initialize constructor of an empty stack
+   void test_constructInitMove_emptySTD()
+   {  // setup
+      std::vector<Spy> vSrc;
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, std::vector<Spy>> sDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.empty() == true);
+      assertUnit(sDest.container.size() == 0);
+      assertUnit(sDest.container.capacity() == 0);
+      assertUnit(vSrc.size() == 0);
+      assertUnit(vSrc.capacity() == 0);
+   }  // teardown
+
+   // move constructor of a 4-element collection
+   void test_constructInitMove_standardSTD()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      std::vector<Spy> vSrc{ Spy(26), Spy(49), Spy(67), Spy(89) };
+      Spy::reset();
+      // exercise
+      custom::stack<Spy, std::vector<Spy>> sDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(vSrc.size() == 0);
+      assertUnit(vSrc.capacity() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertUnit(sDest.container.size() == 4);
+      assertUnit(sDest.container.capacity() == 4);
+      if (sDest.container.size() >= 4)
+      {
+         assertUnit(sDest.container[0] == Spy(26));
+         assertUnit(sDest.container[1] == Spy(49));
+         assertUnit(sDest.container[2] == Spy(67));
+         assertUnit(sDest.container[3] == Spy(89));
+      }
+      // teardown
+      sDest.container.clear();
+   }
+
+
    /***************************************
  * ASSIGN COPY
  ***************************************/
@@ -1134,6 +1412,124 @@ public:
       teardownStandardFixture(s);
    }
 
+   // add an element to a std::list stck
+   void test_pushCopy_standardList()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy, std::list<Spy>> s;
+      s.container.push_back(Spy(26));
+      s.container.push_back(Spy(49));
+      s.container.push_back(Spy(67));
+      s.container.push_back(Spy(89));
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      s.push(value);
+      // verify
+      assertUnit(Spy::numCopy() == 1);    // copy-create [99]
+      assertUnit(Spy::numAlloc() == 1);   // allocate    [99]
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(value == Spy(99));
+      //    +----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 99 |
+      //    +----+----+----+----+----+
+      assertUnit(s.container.size() == 5);
+      if (s.container.size() >= 5)
+      {
+         auto it = s.container.begin();
+         assertUnit(*(it++) == Spy(26));
+         assertUnit(*(it++) == Spy(49));
+         assertUnit(*(it++) == Spy(67));
+         assertUnit(*(it++) == Spy(89));
+         assertUnit(*(it++) == Spy(99));
+         assertUnit(it == s.container.end());
+      }
+      // teardown
+      s.container.clear();
+   }
+
+   // add an element to a std::list stck
+   void test_pushMove_standardList()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy, std::list<Spy>> s;
+      s.container.push_back(Spy(26));
+      s.container.push_back(Spy(49));
+      s.container.push_back(Spy(67));
+      s.container.push_back(Spy(89));
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      s.push(std::move(value));
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);  // copy-constructor of [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(value.empty());
+      //    +----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 99 |
+      //    +----+----+----+----+----+
+      assertUnit(s.container.size() == 5);
+      if (s.container.size() >= 5)
+      {
+         auto it = s.container.begin();
+         assertUnit(*(it++) == Spy(26));
+         assertUnit(*(it++) == Spy(49));
+         assertUnit(*(it++) == Spy(67));
+         assertUnit(*(it++) == Spy(89));
+         assertUnit(*(it++) == Spy(99));
+         assertUnit(it == s.container.end());
+      }
+      // teardown
+      s.container.clear();
+   }
+
+   // emplace constructs the new element directly on top of the stack
+   void test_emplace_standard()
+   {  // setup
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::stack<Spy> s;
+      setupStandardFixture(s);
+      s.container.reserve(5);
+      Spy::reset();
+      // exercise
+      s.emplace(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create   [99]
+      assertUnit(Spy::numAlloc() == 1);      // allocate [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //    +----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 99 |
+      //    +----+----+----+----+----+
+      assertUnit(s.container.size() == 5);
+      assertUnit(s.top() == Spy(99));
+      // teardown
+      teardownStandardFixture(s);
+   }
+
 
 
    /***************************************
@@ -1198,6 +1594,31 @@ public:
 
    }
 
+   // the stack works just as well on top of a deque
+   void test_pushPop_deque()
+   {  // setup
+      custom::stack<Spy, custom::deque<Spy>> s;
+      Spy::reset();
+      // exercise
+      s.push(Spy(26));
+      s.push(Spy(49));
+      s.push(Spy(67));
+      s.pop();
+      // verify
+      assertUnit(Spy::numNondefault() == 3); // create  [26][49][67]
+      assertUnit(Spy::numCopyMove() == 3);   // move    [26][49][67]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(49));
+      assertUnit(s.container.size() == 2);
+      if (s.container.size() == 2)
+      {
+         assertUnit(s.container[0] == Spy(26));
+         assertUnit(s.container[1] == Spy(49));
+      }
+   }  // teardown
+
 
    
    /*************************************************************
@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include <vector>
+#include <string>
 #include "vector.h"
 #include "unitTest.h"
 
@@ -86,6 +87,7 @@ public:
       test_pushback_moveEmpty();
       test_pushback_moveExcessCapacity();
       test_pushback_moveRequireReallocate();
+      test_pushback_selfRequireReallocate();
       test_resize_emptyZero();
       test_resize_emptyFourDefault();
       test_resize_emptyFourValue();
@@ -1816,6 +1818,34 @@ public:
       teardownStandardFixture(v);
    }
    
+   // add a copy of an element already in the vector when there is not room
+   void test_pushback_selfRequireReallocate()
+   {  // setup
+      //      0         1
+      //    +---------+---------+
+      //    | aaa...a | bbb...b |
+      //    +---------+---------+
+      custom::vector<std::string> v;
+      v.push_back(std::string(20, 'a'));
+      v.push_back(std::string(20, 'b'));
+      assertUnit(v.numCapacity == 2);
+      // exercise
+      v.push_back(v[0]);
+      // verify
+      //      0         1         2
+      //    +---------+---------+---------+----+
+      //    | aaa...a | bbb...b | aaa...a |    |
+      //    +---------+---------+---------+----+
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      if (v.numElements == 3)
+      {
+         assertUnit(v.data[0] == std::string(20, 'a'));
+         assertUnit(v.data[1] == std::string(20, 'b'));
+         assertUnit(v.data[2] == std::string(20, 'a'));
+      }
+   }  // teardown
+   
    
    /***************************************
     * ITERATOR
@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include "list.h"
+#include "dump.h"
 #include <list>
 #include "unitTest.h"
 
@@ -19,6 +20,7 @@
 #include <cassert>
 #include <memory>
 #include <iostream>
+#include <sstream>
 
 class TestList : public UnitTest
 {
@@ -120,6 +122,10 @@ public:
       test_empty_empty();
       test_empty_three();
 
+      // Dump
+      test_dump_empty();
+      test_dump_standard();
+
       report("List");
    }
 
@@ -2348,6 +2354,40 @@ public:
       teardownStandardFixture(l);
    }
 
+   /***************************************
+    * DUMP
+    ***************************************/
+
+   // an empty list writes nothing
+   void test_dump_empty()
+   {  // setup
+      custom::list<int> l;
+      std::ostringstream out;
+      // exercise
+      custom::dump(out, l);
+      // verify
+      assertUnit(out.str().empty());
+   }  // teardown
+
+   // each element in order, followed by a space
+   void test_dump_standard()
+   {  // setup
+      //        pHead             pTail
+      //       +----+   +----+   +----+
+      //       | 11 | - | 26 | - | 31 |
+      //       +----+   +----+   +----+
+      custom::list<int> l;
+      setupStandardFixture(l);
+      std::ostringstream out;
+      // exercise
+      custom::dump(out, l);
+      // verify
+      assertUnit(out.str() == "11 26 31 ");
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
    /****************************************************************
     * Setup Standard Fixture
     *        pHead             pTail
@@ -11,6 +11,7 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *    This will contain the class definition of:
+ *        bst_layout          : The order compact() lays the nodes out in
  *        BST                 : A class that represents a binary search tree
  *        BST::iterator       : An iterator through BST
  * Author
@@ -30,6 +31,17 @@
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
 #include <utility>    // for std::pair
+#include <iterator>   // for std::distance
+#include <new>        // for placement new
+
+#ifndef CUSTOM_PREFETCH
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define CUSTOM_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define CUSTOM_PREFETCH(p) __builtin_prefetch(p)
+#endif
+#endif
 
 class TestBST; // forward declaration for unit tests
 class TestMap;
@@ -38,1220 +50,1831 @@ class TestSet;
 namespace custom
 {
 
-   template <class TT>
-   class set;
-   template <class KK, class VV>
-   class map;
-
-/*****************************************************************
- * BINARY SEARCH TREE
- * Create a Binary Search Tree
- *****************************************************************/
-template <typename T>
-class BST
-{
-   friend class ::TestBST; // give unit tests access to the privates
-   friend class ::TestMap;
-   friend class ::TestSet;
-
-   template <class KK, class VV>
-   friend class map;
-
-   template <class TT>
-   friend class set;
-
-   template <class KK, class VV>
-   friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
-public:
-   //
-   // Construct
-   //
-
-   BST();
-   BST(const BST &  rhs);
-   BST(      BST && rhs);
-   BST(const std::initializer_list<T>& il);
-   ~BST();
-
-   //
-   // Assign
-   //
-
-   BST & operator = (const BST &  rhs);
-   BST & operator = (      BST && rhs);
-   BST & operator = (const std::initializer_list<T>& il);
-   void swap(BST & rhs);
-
-   //
-   // Iterator
-   //
-
-   class iterator;
-   iterator   begin() const noexcept;
-   iterator   end()   const noexcept { return iterator(nullptr); }
-
-   //
-   // Access
-   //
-
-   iterator find(const T& t);
-
-   // 
-   // Insert
-   //
-
-   std::pair<iterator, bool> insert(const T&  t, bool keepUnique = false);
-   std::pair<iterator, bool> insert(      T&& t, bool keepUnique = false);
-
-   //
-   // Remove
-   // 
-
-   iterator erase(iterator& it);
-   void   clear() noexcept;
-
-   // 
-   // Status
-   //
-
-   bool   empty() const noexcept { return numElements == 0; }
-   size_t size()  const noexcept { return numElements; }
-   
-
-private:
-
-   class BNode;
-   BNode * root;              // root node of the binary search tree
-   size_t numElements;        // number of elements currently in the tree
-   BNode* copyBNode(BNode* src, BNode* parent); // Helper Function to help copy nodes from one tree to the next
-   void deleteBNode(BNode* node); // Helper function to help delete every node in the bst
-};
-
-
-/*****************************************************************
- * BINARY NODE
- * A single node in a binary tree. Note that the node does not know
- * anything about the properties of the tree so no validation can be done.
- *****************************************************************/
-template <typename T>
-class BST <T> :: BNode
-{
-public:
-   // 
-   // Construct
-   //
-   BNode() : pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
-   BNode(const T& t) : data(t), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
-   BNode(T&& t) : data(std::move(t)), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
-
-   //
-   // Insert
-   //
-   void addLeft (BNode * pNode);
-   void addRight(BNode * pNode);
-   void addLeft (const T &  t);
-   void addRight(const T &  t);
-   void addLeft(       T && t);
-   void addRight(      T && t);
-
-   // 
-   // Status
-   //
-   bool isRightChild(BNode * pNode) const { return pNode && pNode->pParent && pNode->pParent->pRight == pNode; }
-   bool isLeftChild( BNode * pNode) const { return pNode && pNode->pParent && pNode->pParent->pLeft == pNode; }
-
-   //
-   // Data
-   //
-   T data;                  // Actual data stored in the BNode
-   BNode* pLeft;          // Left child - smaller
-   BNode* pRight;         // Right child - larger
-   BNode* pParent;        // Parent
-   bool isRed;              // Red-black balancing stuff
-};
-
-/**********************************************************
- * BINARY SEARCH TREE ITERATOR
- * Forward and reverse iterator through a BST
- *********************************************************/
-template <typename T>
-class BST <T> :: iterator
-{
-   friend class ::TestBST; // give unit tests access to the privates
-   friend class ::TestMap;
-   friend class ::TestSet;
-
-   template <class KK, class VV>
-   friend class map;
-
-   template <class TT>
-   friend class set; 
-public:
-   // constructors and assignment
-    iterator(BNode* p = nullptr)
+    template <class TT, class CC>
+    class set;
+    template <class KK, class VV, class CC>
+    class map;
+    template <class TR, class CC>
+    class MultiTree;
+
+    /*****************************************************************
+     * BST LAYOUT
+     * How compact() orders the nodes in memory: in order is best for
+     * walking the tree with an iterator, breadth first puts the top
+     * levels together, and van Emde Boas keeps every short path down
+     * the tree close together, which is best for lookups
+     *****************************************************************/
+    enum class bst_layout { in_order, breadth_first, van_emde_boas };
+
+    /*****************************************************************
+     * BINARY SEARCH TREE
+     * Create a Binary Search Tree
+     *****************************************************************/
+    template <typename T, class Compare = std::less<T>>
+    class BST
     {
-        pNode = p;
-    }
-    iterator(const iterator& rhs)
+        friend class ::TestBST; // give unit tests access to the privates
+        friend class ::TestMap;
+        friend class ::TestSet;
+
+        template <class KK, class VV, class CC>
+        friend class map;
+
+        template <class TT, class CC>
+        friend class set;
+
+        template <class TR, class CC>
+        friend class MultiTree;
+
+        template <class KK, class VV, class CC>
+        friend void swap(map<KK, VV, CC>& lhs, map<KK, VV, CC>& rhs);
+    public:
+        //
+        // Construct
+        //
+
+        BST();
+        BST(const BST& rhs);
+        BST(BST&& rhs);
+        BST(const std::initializer_list<T>& il);
+        ~BST();
+
+        //
+        // Assign
+        //
+
+        BST& operator = (const BST& rhs);
+        BST& operator = (BST&& rhs);
+        BST& operator = (const std::initializer_list<T>& il);
+        template <class Iterator>
+        void assign_sorted(Iterator first, Iterator last); // sorted, no repeats
+        void swap(BST& rhs);
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator   begin() const noexcept;
+        iterator   end()   const noexcept { return iterator(nullptr); }
+
+        //
+        // Access
+        //
+
+        iterator find(const T& t);
+        template <class Iterator, class OutputIterator>
+        OutputIterator find_batch(Iterator first, Iterator last, OutputIterator out);
+
+        // 
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t, bool keepUnique = false);
+        std::pair<iterator, bool> insert(T&& t, bool keepUnique = false);
+        std::pair<iterator, bool> insert(iterator hint, const T& t, bool keepUnique = false);
+        std::pair<iterator, bool> insert(iterator hint, T&& t, bool keepUnique = false);
+
+        //
+        // Remove
+        // 
+
+        iterator erase(iterator& it);
+        iterator erase(iterator first, iterator last); // no duplicates, as in set and map
+        void   clear() noexcept;
+
+        //
+        // Layout
+        //
+
+        void compact(bst_layout layout = bst_layout::in_order); // invalidates iterators
+
+        // 
+        // Status
+        //
+
+        bool   empty() const noexcept { return numElements == 0; }
+        size_t size()  const noexcept { return numElements; }
+
+
+    private:
+
+        class BNode;
+        BNode* root;              // root node of the binary search tree
+        size_t numElements;        // number of elements currently in the tree
+        Compare compare;           // orders the elements
+        BNode* pRightmost;         // the last node in order, or nullptr if not known yet
+        BNode* pSlab;              // the block compact() put the nodes in, or nullptr
+        size_t slabSize;           // how many nodes fit in the slab
+        size_t slabLive;           // how many nodes in the slab are still in use
+        BNode* copyBNode(const BNode* src, BNode*& pRecycle); // Helper Function to help copy nodes from one tree to the next
+        BNode* recycleBNode(const T& t, BNode*& pRecycle);  // Helper function to reuse a node before allocating a new one
+        BNode* flattenBNode(BNode* node); // Helper function to turn a subtree into a chain of nodes to recycle
+        size_t deleteBNode(BNode* node); // Helper function to help delete every node in the bst, returning how many
+        void freeBNode(BNode* pNode); // Helper function to free one node, whether in the slab or not
+        size_t vanEmdeBoas(BNode* node, size_t height, BNode** pOrder, size_t i); // Helper function to list the nodes in van Emde Boas order
+        BNode* trimBNode(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed); // Helper function to cut [*pLo, *pHi) out of a subtree
+        BNode* trimEdge(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed); // Helper function to trim a subtree only one bound cuts
+        BNode* joinBNode(BNode* pLeft, BNode* pRight); // Helper function to join two subtrees, all of pLeft before pRight
+        template <class Iterator>
+        BNode* buildBNode(Iterator& it, size_t n, BNode*& pRecycle); // Helper function to build a balanced subtree from sorted input
+        BNode* descend(const T& t, BNode*& pParent, bool& isLeft) const; // Helper function to find where t goes, one comparison per level
+        iterator attach(BNode* pNode, BNode* pParent, bool isLeft); // Helper function to link a new node where descend() pointed
+        bool besideHint(BNode* pHint, const T& t, bool keepUnique, BNode*& pParent, bool& isLeft, BNode*& pEqual); // Helper function to find where t goes next to a hint
+        BNode* rightmost(); // Helper function to find the last node, remembering it for next time
+        template <class Iterator, class Less, class Emit>
+        void findBatch(Iterator first, Iterator last, Less less, Emit emit) const; // Helper function to run several searches side by side
+    };
+
+
+    /*****************************************************************
+     * BINARY NODE
+     * A single node in a binary tree. Note that the node does not know
+     * anything about the properties of the tree so no validation can be done.
+     *****************************************************************/
+    template <typename T, class Compare>
+    class BST <T, Compare> ::BNode
     {
-        pNode = rhs.pNode;
-    }
-    iterator& operator = (const iterator& rhs)
+    public:
+        // 
+        // Construct
+        //
+        BNode() : pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
+        BNode(const T& t) : data(t), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
+        BNode(T&& t) : data(std::move(t)), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(false) {}
+
+        //
+        // Insert
+        //
+        void addLeft(BNode* pNode);
+        void addRight(BNode* pNode);
+        void addLeft(const T& t);
+        void addRight(const T& t);
+        void addLeft(T&& t);
+        void addRight(T&& t);
+
+        // 
+        // Status
+        //
+        bool isRightChild(BNode* pNode) const { return pNode && pNode->pParent && pNode->pParent->pRight == pNode; }
+        bool isLeftChild(BNode* pNode) const { return pNode && pNode->pParent && pNode->pParent->pLeft == pNode; }
+
+        //
+        // Data
+        //
+        T data;                  // Actual data stored in the BNode
+        BNode* pLeft;          // Left child - smaller
+        BNode* pRight;         // Right child - larger
+        BNode* pParent;        // Parent
+        bool isRed;              // Red-black balancing stuff
+    };
+
+    /**********************************************************
+     * BINARY SEARCH TREE ITERATOR
+     * Forward and reverse iterator through a BST
+     *********************************************************/
+    template <typename T, class Compare>
+    class BST <T, Compare> ::iterator
     {
-        pNode = rhs.pNode;
-        return *this;
-    }
-
-   // compare
-   bool operator == (const iterator & rhs) const
-   {
-       return pNode == rhs.pNode;
-   }
-   bool operator != (const iterator & rhs) const
-   {
-       return pNode != rhs.pNode;
-   }
-
-   // de-reference. Cannot change because it will invalidate the BST
-   const T & operator * () const 
-   {
-       return pNode->data;
-   }
-
-   // increment and decrement
-   iterator & operator ++ ();
-   iterator   operator ++ (int postfix)
-   {
-       iterator temp = *this;
-       ++(*this);
-       return temp;
-   }
-   iterator & operator -- ();
-   iterator   operator -- (int postfix)
-   {
-       iterator temp = *this;
-       --(*this);
-       return temp;
-   }
-
-   BNode* getNode()
-   {
-       return pNode;
-   }
-
-   // must give friend status to remove so it can call getNode() from it
-   friend BST <T> :: iterator BST <T> :: erase(iterator & it);
-
-private:
-
-    // the node
-    BNode * pNode;
-};
-
-
-/*********************************************
- *********************************************
- *********************************************
- ******************** BST ********************
- *********************************************
- *********************************************
- *********************************************/
-
-
- /*********************************************
-  * BST :: DEFAULT CONSTRUCTOR
-  * Initialize a tree with no elements and a null root
-  ********************************************/
-template <typename T>
-BST <T> ::BST() : root(nullptr), numElements(0) {}
-
-/*********************************************
- * BST :: COPY CONSTRUCTOR
- * Copy one tree to another
- ********************************************/
-template <typename T>
-BST <T> :: BST ( const BST<T>& rhs) 
-{
-    // Initialize the new tree
-    numElements = rhs.numElements;
-    root = nullptr;
+        friend class ::TestBST; // give unit tests access to the privates
+        friend class ::TestMap;
+        friend class ::TestSet;
+
+        template <class KK, class VV, class CC>
+        friend class map;
+
+        template <class TT, class CC>
+        friend class set;
+    public:
+        // constructors and assignment
+        iterator(BNode* p = nullptr)
+        {
+            pNode = p;
+        }
+        iterator(const iterator& rhs)
+        {
+            pNode = rhs.pNode;
+        }
+        iterator& operator = (const iterator& rhs)
+        {
+            pNode = rhs.pNode;
+            return *this;
+        }
 
-    // Use copyBNode function to recursively copy the nodes from the rhs
-    if (rhs.root != nullptr)
-    {
-        root = copyBNode(rhs.root, nullptr);
-    }
-}
-
-/********************************************
- * BST :: COPY BNODE
- * Recursively copy a node and its children
- ********************************************/
-template <typename T>
-typename BST<T>::BNode* BST<T>::copyBNode(BNode* src, BNode* parent)
-{
-    // If the src node is empty, there's nothing to copy. Recursive loop will stop.
-    if (src == nullptr)
-    {
-        return nullptr;
-    }
+        // compare
+        bool operator == (const iterator& rhs) const
+        {
+            return pNode == rhs.pNode;
+        }
+        bool operator != (const iterator& rhs) const
+        {
+            return pNode != rhs.pNode;
+        }
 
-    //create a temperary new node
-    BNode* newNode = nullptr;
+        // de-reference. Cannot change because it will invalidate the BST
+        const T& operator * () const
+        {
+            return pNode->data;
+        }
 
-    //make sure that parent isn't null
-    if (parent)
-    {
-        //if src is a left child then set the new node to the left child of parent
-        if ((src->pParent)->isLeftChild(src))
+        // increment and decrement
+        iterator& operator ++ ();
+        iterator   operator ++ (int postfix)
         {
-            newNode = parent->pLeft;
+            iterator temp = *this;
+            ++(*this);
+            return temp;
         }
-        //otherwise must be right child
-        else
+        iterator& operator -- ();
+        iterator   operator -- (int postfix)
         {
-            newNode = parent->pRight;
+            iterator temp = *this;
+            --(*this);
+            return temp;
         }
-    }
-    
 
-    // if new node is still null then make it a new node with the same data as the src
-    if (!newNode)  
-    {
-        newNode = new BNode(src->data);   
-    }
-    //otherwise copy the data over
-    else
-    {
-        newNode->data = src->data;
-    }
-    
-    //attach to parent
-    newNode->pParent = parent;
+        BNode* getNode()
+        {
+            return pNode;
+        }
 
-    //establish logic to ensure deletion of extraneous nodes if *this is bigger than src
-    if (!src->pLeft && newNode->pLeft) 
-    {
-        deleteBNode(newNode->pLeft);  
-    }
-    if (!src->pRight && newNode->pLeft)  
-    {
-        deleteBNode(newNode->pRight);  
-    }
+        // must give friend status to remove so it can call getNode() from it
+        friend BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator& it);
 
-    // Using recursion, copy the left and right children
-    newNode->pLeft = copyBNode(src->pLeft, newNode); 
-    newNode->pRight = copyBNode(src->pRight, newNode);
+    private:
 
+        // the node
+        BNode* pNode;
+    };
 
 
-    // Return the newNode, which is now the root of the copied BST
-    return newNode;
-}
+    /*********************************************
+     *********************************************
+     *********************************************
+     ******************** BST ********************
+     *********************************************
+     *********************************************
+     *********************************************/
 
-/*********************************************
- * BST :: MOVE CONSTRUCTOR
- * Move one tree to another
- ********************************************/
-template <typename T>
-BST <T> :: BST(BST <T> && rhs) 
-{
-    // Transfer root and numElements from rhs to this BST
-    root = rhs.root;
-    numElements = rhs.numElements;
-
-    // Clear rhs BST
-    rhs.root = nullptr;
-    rhs.numElements = 0;
-}
-
-/*********************************************
- * BST :: INITIALIZER LIST CONSTRUCTOR
- * Create a BST from an initializer list
- ********************************************/
-template <typename T>
-BST <T> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(0)
-{
-    // Iterate through each item in the initializer list
-    for (const T& element : il)
+
+     /*********************************************
+      * BST :: DEFAULT CONSTRUCTOR
+      * Initialize a tree with no elements and a null root
+      ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST() : root(nullptr), numElements(0), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0) {}
+
+    /*********************************************
+     * BST :: COPY CONSTRUCTOR
+     * Copy one tree to another
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(const BST<T, Compare>& rhs) : compare(rhs.compare), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0)
     {
-        // If the root hasn't been initalized yet, intialize it with the first item from the list.
-        if (root == nullptr)
+        // Initialize the new tree
+        numElements = rhs.numElements;
+
+        // Use copyBNode to copy the nodes from the rhs. There is nothing to recycle yet.
+        BNode* pRecycle = nullptr;
+        root = copyBNode(rhs.root, pRecycle);
+    }
+
+    /********************************************
+     * BST :: COPY BNODE
+     * Copy a node and its children without recursion so a long,
+     * unbalanced tree cannot overflow the stack. Nodes are taken
+     * from pRecycle before any new ones are allocated.
+     ********************************************/
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::copyBNode(const BNode* src, BNode*& pRecycle)
+    {
+        // If the src node is empty, there's nothing to copy
+        if (src == nullptr)
         {
-            root = new BNode(element);
+            return nullptr;
         }
-        else
-        {
-            // Initialize a pointer to the root
-            BNode* currentNode = root;
-
-            // Begin adding nodes to the tree
-            while (currentNode != nullptr)
-            {
-                // A node should be added to the left if the current element in the list is less than the root
-                if (element < currentNode->data)
-                {
-                    // Check if the current node has no node on the left
-                    if (currentNode->pLeft == nullptr)
-                    {
-                        // Create and link a node to the left of the currentNode using the element from the il
-                        currentNode->pLeft = new BNode(element);
 
-                        // Link the curerntNode as the parent to the new node that was just created
-                        currentNode->pLeft->pParent = currentNode;
-                        break;
-                    }
-                    else
-                    {
-                        // Advance to the next node on the left
-                        currentNode = currentNode->pLeft;
-                    }
-                }
-                else // A node will be added to the right side of the bst
-                {
-                    // Check if the current node has no node to the right
-                    if (currentNode->pRight == nullptr)
-                    {
-                        // Create and link a node to the right of the currentNode using the element from il
-                        currentNode->pRight = new BNode(element);
+        // Copy the top of the subtree. It has no parent in the new tree.
+        BNode* newRoot = recycleBNode(src->data, pRecycle);
 
-                        // LInk the currentNode as the parent to the new node that was just created
-                        currentNode->pRight->pParent = currentNode;
-                        break;
-                    }
-                    else
-                    {
-                        // Advance to the next node on the right
-                        currentNode = currentNode->pRight;
-                    }
-                }
+        // Walk both trees in lockstep. A null child in the destination means we have
+        // not visited that side yet; once both sides are done we climb back up.
+        const BNode* pSrc = src;
+        BNode* pDest = newRoot;
+        while (true)
+        {
+            if (pSrc->pLeft && !pDest->pLeft)
+            {
+                // Copy the left child and go down to it
+                pDest->addLeft(recycleBNode(pSrc->pLeft->data, pRecycle));
+                pSrc = pSrc->pLeft;
+                pDest = pDest->pLeft;
+            }
+            else if (pSrc->pRight && !pDest->pRight)
+            {
+                // Copy the right child and go down to it
+                pDest->addRight(recycleBNode(pSrc->pRight->data, pRecycle));
+                pSrc = pSrc->pRight;
+                pDest = pDest->pRight;
+            }
+            else if (pSrc == src)
+            {
+                // Both sides of the top node are done
+                break;
+            }
+            else
+            {
+                // Both sides of this node are done, go back up
+                pSrc = pSrc->pParent;
+                pDest = pDest->pParent;
             }
         }
-        // Update the numElements count after a node is added to the bst
-        numElements++;
-    }
-}
 
-/*********************************************
- * BST :: DESTRUCTOR
- ********************************************/
-template <typename T>
-BST <T> :: ~BST()
-{
-    // Use deleteBnode to delete all nodes
-    deleteBNode(root);
-
-    // Reset root and numElements to nullptr and 0
-    root = nullptr;
-    numElements = 0;
-}
-
-/**********************************************
- * BST :: DELETE BNODE
- * Recursively delete nodes in the bst
- **********************************************/
-template <typename T>
-void BST<T>::deleteBNode(BNode* node)
-{
-    // If the node to be deleted is already deleted, the recusive loop should stop
-    if (!node)
-        return;
-
-    // Recursively delete the right and left children
-    deleteBNode(node->pLeft);
-    deleteBNode(node->pRight);
-
-    // Delete the current node
-    delete node;
-}
-
-/*********************************************
- * BST :: ASSIGNMENT OPERATOR
- * Copy one tree to another
- ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (const BST <T> & rhs)
-{
-   // Check for self-assignment
-   if (this != &rhs)
-   {
-       //if both roots are allocated then copy the data over
-       if (root && rhs.root)
-       {
-           root->data = rhs.root->data;
-       }
-       else
-       {
-           //this catches an empty rhs bst and clears *this
-           if (!rhs.root)
-           {
-               clear();
-               return *this;
-           }
-           //if we get here then *this is empty and a new root must be allocated
-           else
-           {
-               root = new BNode(rhs.root->data);
-           }
-       }
-
-       //check if rhs has children and delete nodes from *this if necessary
-       if (!rhs.root->pLeft && root->pLeft)
-       {
-           deleteBNode(root->pLeft);
-       }
-       if (!rhs.root->pRight && root->pRight)
-       {
-           deleteBNode(root->pRight);
-       }
-
-       //start the copy recursion
-       root->pLeft = copyBNode(rhs.root->pLeft, root); 
-       root->pRight = copyBNode(rhs.root->pRight, root); 
-
-       //update the numElements not the the data is updated
-       numElements = rhs.numElements;
-   }
-
-   // Return the new bst
-   return *this;
-}
-
-/*********************************************
- * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
- * Copy nodes onto a BTree
- ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (const std::initializer_list<T>& il)
-{
-    // Clear the current contents of the tree
-    clear();
-
-    // Initialize flags for insertion direction
-    bool insertLeft = false;
-    bool insertRight = false;
+        // Return the newRoot, which is now the root of the copied BST
+        return newRoot;
+    }
 
-    // Begin inserting each element from the initializer list into the tree
-    for (const T& element : il)
+    /********************************************
+     * BST :: RECYCLE BNODE
+     * Take a node off the recycle chain and overwrite its payload,
+     * or allocate a new node when the chain is empty
+     ********************************************/
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::recycleBNode(const T& t, BNode*& pRecycle)
     {
-        // Begin by inserting the root
-        if (root == nullptr)
+        // Nothing left to reuse, so we have to allocate
+        if (pRecycle == nullptr)
         {
-            root = new BNode(element);
-            ++numElements;
+            return new BNode(t);
         }
-        else
-        {
-            // Initialize pointers to current node starting at the root
-            BNode* current = root;
-            BNode* parent = nullptr;
-
-            // Begin traversing the tree to find the right position for the element
-            while (current != nullptr)
-            {
-                parent = current;
-                if (element < current->data)
-                {
-                    // Move to the left child
-                    current = current->pLeft;
-                    
-                    // Update flags
-                    if (insertRight)
-                        insertRight = false;
-                    insertLeft = true;
-                }
-                else // element >= current->data
-                {
-                    // Move to the right child
-                    current = current->pRight;
 
-                    // Update flags
-                    if (insertLeft)
-                        insertLeft = false;
-                    insertRight = true;
-                }
-            }
+        // Unhook the first node in the chain and copy the data over. Everything
+        // else is reset so it looks just like a freshly allocated node.
+        BNode* pNode = pRecycle;
+        pRecycle = pRecycle->pRight;
+        pNode->data = t;
+        pNode->pLeft = pNode->pRight = pNode->pParent = nullptr;
+        pNode->isRed = false;
+        return pNode;
+    }
 
-            // Determine whether to insert the new node as the left or right child
-            BNode* newNode = new BNode(element);
-            if (insertLeft)
+    /********************************************
+     * BST :: FLATTEN BNODE
+     * Rotate a subtree into a chain linked through pRight.
+     * Every rotation moves one node off the left spine so this
+     * takes O(n) time and no extra space.
+     ********************************************/
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::flattenBNode(BNode* node)
+    {
+        // The head of the chain is the left-most node after the rotations
+        BNode* pHead = nullptr;
+        BNode* pTail = nullptr;
+        while (node)
+        {
+            if (node->pLeft)
             {
-                parent->pLeft = newNode;
+                // Rotate right so the left child moves up
+                BNode* pLeft = node->pLeft;
+                node->pLeft = pLeft->pRight;
+                pLeft->pRight = node;
+                node = pLeft;
             }
             else
             {
-                parent->pRight = newNode;
+                // No left child: this node goes on the end of the chain
+                if (pTail)
+                    pTail->pRight = node;
+                else
+                    pHead = node;
+                pTail = node;
+                node = node->pRight;
             }
-            newNode->pParent = parent;
-            ++numElements;
         }
+        return pHead;
     }
-    return *this;
-}
-
-/*********************************************
- * BST :: ASSIGN-MOVE OPERATOR
- * Move one tree to another
- ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (BST <T> && rhs)
-{
-    // Check for self assignment
-    if (this != &rhs)
-    {
-        // Clear the current contents of the tree
-        clear();
 
-        // Move resources from rhs to this
+    /*********************************************
+     * BST :: MOVE CONSTRUCTOR
+     * Move one tree to another
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(BST <T, Compare>&& rhs) : compare(rhs.compare)
+    {
+        // Transfer root and numElements from rhs to this BST
         root = rhs.root;
         numElements = rhs.numElements;
+        pRightmost = rhs.pRightmost;
+        pSlab = rhs.pSlab;
+        slabSize = rhs.slabSize;
+        slabLive = rhs.slabLive;
 
-        // Leave rhs emtpy
+        // Clear rhs BST
         rhs.root = nullptr;
         rhs.numElements = 0;
+        rhs.pRightmost = nullptr;
+        rhs.pSlab = nullptr;
+        rhs.slabSize = rhs.slabLive = 0;
     }
-    return *this;
-}
-
-/*********************************************
- * BST :: SWAP
- * Swap two trees
- ********************************************/
-template <typename T>
-void BST <T> :: swap (BST <T>& rhs)
-{
-    // Swap the root pointers of the two trees
-    std::swap(root, rhs.root);
-
-    // Swap the numElements of the two trees
-    std::swap(numElements, rhs.numElements);
-}
-
-/*****************************************************
- * BST :: INSERT
- * Insert a node at a given location in the tree
- ****************************************************/
-template <typename T>
-std::pair<typename BST <T> :: iterator, bool> BST <T> :: insert(const T & t, bool keepUnique)
-{
-    // Initialize the return value as a pair with end() and false
-    std::pair<iterator, bool> pairReturn(end(), false);
-
-    // Initialize flags for inserting left or right
-    bool insertRight = false;
-    bool insertLeft = false;
 
-    // If the tree is empty, create a new root node
-    if (root == nullptr)
+    /*********************************************
+     * BST :: INITIALIZER LIST CONSTRUCTOR
+     * Create a BST from an initializer list
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(0), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0)
     {
-        root = new BNode(t);
-        ++numElements;
+        // Iterate through each item in the initializer list
+        for (const T& element : il)
+        {
+            // If the root hasn't been initalized yet, intialize it with the first item from the list.
+            if (root == nullptr)
+            {
+                root = new BNode(element);
+            }
+            else
+            {
+                // Initialize a pointer to the root
+                BNode* currentNode = root;
 
-        // Update the return pair
-        pairReturn.first = iterator(root);
-        pairReturn.second = true;
-        return pairReturn;
+                // Begin adding nodes to the tree
+                while (currentNode != nullptr)
+                {
+                    // A node should be added to the left if the current element in the list is less than the root
+                    if (compare(element, currentNode->data))
+                    {
+                        // Check if the current node has no node on the left
+                        if (currentNode->pLeft == nullptr)
+                        {
+                            // Create and link a node to the left of the currentNode using the element from the il
+                            currentNode->pLeft = new BNode(element);
+
+                            // Link the curerntNode as the parent to the new node that was just created
+                            currentNode->pLeft->pParent = currentNode;
+                            break;
+                        }
+                        else
+                        {
+                            // Advance to the next node on the left
+                            currentNode = currentNode->pLeft;
+                        }
+                    }
+                    else // A node will be added to the right side of the bst
+                    {
+                        // Check if the current node has no node to the right
+                        if (currentNode->pRight == nullptr)
+                        {
+                            // Create and link a node to the right of the currentNode using the element from il
+                            currentNode->pRight = new BNode(element);
+
+                            // LInk the currentNode as the parent to the new node that was just created
+                            currentNode->pRight->pParent = currentNode;
+                            break;
+                        }
+                        else
+                        {
+                            // Advance to the next node on the right
+                            currentNode = currentNode->pRight;
+                        }
+                    }
+                }
+            }
+            // Update the numElements count after a node is added to the bst
+            numElements++;
+        }
     }
 
-    // Start at the root and traverse the tree to find the insertion point
-    BNode* current = root;
-    BNode* parent = nullptr;
+    /*********************************************
+     * BST :: DESTRUCTOR
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare> :: ~BST()
+    {
+        // Use deleteBnode to delete all nodes
+        deleteBNode(root);
+
+        // Reset root and numElements to nullptr and 0
+        root = nullptr;
+        numElements = 0;
+    }
 
-    // If duplicates are allowed
-    if (keepUnique == false)
+    /**********************************************
+     * BST :: DELETE BNODE
+     * Delete every node in a subtree. This rotates the left
+     * children up instead of recursing so a long, unbalanced
+     * tree cannot overflow the stack.
+     **********************************************/
+    template <typename T, class Compare>
+    size_t BST<T, Compare>::deleteBNode(BNode* node)
     {
-        // Begin traversing through the tree to find insertion point
-        while (current != nullptr)
+        size_t numDeleted = 0;
+        while (node)
         {
-            parent = current;
-
-            // Determine if data should go on the left side of the current node
-            if (t < current->data)
+            if (node->pLeft)
             {
-                // Advance to the left node
-                current = current->pLeft;
-
-                // Update flags
-                insertLeft = true;
-                insertRight = false;
+                // Rotate right so the left child moves up
+                BNode* pLeft = node->pLeft;
+                node->pLeft = pLeft->pRight;
+                pLeft->pRight = node;
+                node = pLeft;
             }
             else
             {
-                // Advance to the right node (including duplicates)
-                current = current->pRight;
+                // No left child: delete the node and continue with the right
+                BNode* pRight = node->pRight;
+                freeBNode(node);
+                numDeleted++;
+                node = pRight;
+            }
+        }
+        return numDeleted;
+    }
 
-                // Update flags
-                insertRight = true;
-                insertLeft = false;
+    /**********************************************
+     * BST :: FREE BNODE
+     * Free one node. A node compact() placed in the slab
+     * is only destroyed; the slab itself goes when the
+     * last node in it does.
+     **********************************************/
+    template <typename T, class Compare>
+    void BST<T, Compare>::freeBNode(BNode* pNode)
+    {
+        std::less<const BNode*> before;
+        if (pSlab && !before(pNode, pSlab) && before(pNode, pSlab + slabSize))
+        {
+            pNode->~BNode();
+            if (--slabLive == 0)
+            {
+                ::operator delete(pSlab);
+                pSlab = nullptr;
+                slabSize = 0;
             }
         }
+        else
+            delete pNode;
     }
-    else // duplicates are not allowed
+
+    /*********************************************
+     * BST :: ASSIGNMENT OPERATOR
+     * Copy one tree to another, reusing the nodes we already
+     * have by overwriting their payloads
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (const BST <T, Compare>& rhs)
     {
-        // Begin traversing the tree to find the insertion point
-        while (current != nullptr)
+        // Check for self-assignment
+        if (this != &rhs)
         {
-            parent = current;
+            // Every node we own can be recycled whatever the shape of rhs
+            BNode* pRecycle = flattenBNode(root);
+
+            // Copy the rhs, only allocating when we run out of nodes to recycle
+            root = copyBNode(rhs.root, pRecycle);
+
+            // Anything left over was not needed
+            deleteBNode(pRecycle);
 
-            // Determine if t is equal to the data inside the current node
-            if (t == current->data)
+            //update the numElements now that the data is updated
+            numElements = rhs.numElements;
+            compare = rhs.compare;
+            pRightmost = nullptr;
+        }
+
+        // Return the new bst
+        return *this;
+    }
+
+    /*********************************************
+     * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
+     * Copy nodes onto a BTree
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (const std::initializer_list<T>& il)
+    {
+        // Clear the current contents of the tree
+        clear();
+
+        // Initialize flags for insertion direction
+        bool insertLeft = false;
+        bool insertRight = false;
+
+        // Begin inserting each element from the initializer list into the tree
+        for (const T& element : il)
+        {
+            // Begin by inserting the root
+            if (root == nullptr)
             {
-                // Since duplicates are not allowed, simpl return the current node
-                pairReturn.first = iterator(current);
-                return pairReturn;
+                root = new BNode(element);
+                ++numElements;
             }
-            else if (t < current->data) // Determine if t is less than the data inside the current node
+            else
             {
-                // Advance to the next node on the left
-                current = current->pLeft;
+                // Initialize pointers to current node starting at the root
+                BNode* current = root;
+                BNode* parent = nullptr;
 
-                // Update flags
-                insertLeft = true;
-                insertRight = false;
-            }
-            else // t > current->data is now handled by default
-            {
-                // Advance to the next node on the right
-                current = current->pRight;
+                // Begin traversing the tree to find the right position for the element
+                while (current != nullptr)
+                {
+                    parent = current;
+                    if (compare(element, current->data))
+                    {
+                        // Move to the left child
+                        current = current->pLeft;
+
+                        // Update flags
+                        if (insertRight)
+                            insertRight = false;
+                        insertLeft = true;
+                    }
+                    else // element >= current->data
+                    {
+                        // Move to the right child
+                        current = current->pRight;
+
+                        // Update flags
+                        if (insertLeft)
+                            insertLeft = false;
+                        insertRight = true;
+                    }
+                }
 
-                // Update flags
-                insertRight = true;
-                insertLeft = false;
+                // Determine whether to insert the new node as the left or right child
+                BNode* newNode = new BNode(element);
+                if (insertLeft)
+                {
+                    parent->pLeft = newNode;
+                }
+                else
+                {
+                    parent->pRight = newNode;
+                }
+                newNode->pParent = parent;
+                ++numElements;
             }
         }
+        return *this;
     }
 
-    // Create a new node
-    BNode* newNode = new BNode(t);
-
-    // Link it to the parent using the flags
-    if (insertLeft)
+    /*********************************************
+     * BST :: ASSIGN-MOVE OPERATOR
+     * Move one tree to another
+     ********************************************/
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (BST <T, Compare>&& rhs)
     {
-        parent->pLeft = newNode;
+        // Check for self assignment
+        if (this != &rhs)
+        {
+            // Clear the current contents of the tree
+            clear();
+
+            // Move resources from rhs to this
+            root = rhs.root;
+            numElements = rhs.numElements;
+            compare = rhs.compare;
+            pRightmost = rhs.pRightmost;
+            pSlab = rhs.pSlab;
+            slabSize = rhs.slabSize;
+            slabLive = rhs.slabLive;
+
+            // Leave rhs emtpy
+            rhs.root = nullptr;
+            rhs.numElements = 0;
+            rhs.pRightmost = nullptr;
+            rhs.pSlab = nullptr;
+            rhs.slabSize = rhs.slabLive = 0;
+        }
+        return *this;
     }
-    else
+
+    /*********************************************
+     * BST :: ASSIGN SORTED
+     * Replace the contents with a range that is already
+     * sorted and has no repeats. The middle element becomes
+     * the root, so the tree comes out balanced in O(n)
+     * instead of the O(n^2) chain inserting in order builds.
+     ********************************************/
+    template <typename T, class Compare>
+    template <class Iterator>
+    void BST <T, Compare> ::assign_sorted(Iterator first, Iterator last)
     {
-        parent->pRight = newNode;
+        // Every node we own can be recycled
+        BNode* pRecycle = flattenBNode(root);
+
+        // Build the new tree, only allocating when we run out of nodes to recycle
+        size_t n = std::distance(first, last);
+        root = buildBNode(first, n, pRecycle);
+        if (root)
+            root->pParent = nullptr;
+        numElements = n;
+        pRightmost = nullptr;
+
+        // Anything left over was not needed
+        deleteBNode(pRecycle);
     }
 
-    // Link the new node to the parent
-    newNode->pParent = parent;
-
-    // Increase the numElements by 1 and return the newNode
-    ++numElements;
-    pairReturn.first = iterator(newNode);
-    pairReturn.second = true;
-    return pairReturn;
-}
+    /*********************************************
+     * BST :: BUILD BNODE
+     * Build a subtree of the next n elements: the first half
+     * on the left, then the middle, then the rest on the right.
+     * The subtree is balanced, so the recursion is only
+     * log(n) deep.
+     ********************************************/
+    template <typename T, class Compare>
+    template <class Iterator>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::buildBNode(Iterator& it, size_t n, BNode*& pRecycle)
+    {
+        // An empty subtree
+        if (n == 0)
+            return nullptr;
 
-template <typename T>
-std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T && t, bool keepUnique)
-{
-    // Initialize the return value as a pair with end() and false
-    std::pair<iterator, bool> pairReturn(end(), false);
+        // The left half comes first in the input
+        BNode* pLeft = buildBNode(it, n / 2, pRecycle);
 
-    // Initialize flags for inserting left or right
-    bool insertRight = false;
-    bool insertLeft = false;
+        // Then the middle
+        BNode* pNode = recycleBNode(*it, pRecycle);
+        ++it;
+        pNode->addLeft(pLeft);
 
-    // If the tree is empty, create a new root node
-    if (root == nullptr) {
-        root = new BNode(std::move(t));
-        ++numElements;
-        pairReturn.first = iterator(root);
-        pairReturn.second = true;
-        return pairReturn;
+        // Then the right half
+        pNode->addRight(buildBNode(it, n - n / 2 - 1, pRecycle));
+        return pNode;
     }
 
-    // Start at the root and traverse the tree to find the insertion point
-    BNode* current = root;
-    BNode* parent = nullptr;
+    /*********************************************
+     * BST :: SWAP
+     * Swap two trees
+     ********************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::swap(BST <T, Compare>& rhs)
+    {
+        // Swap the root pointers of the two trees
+        std::swap(root, rhs.root);
+
+        // Swap the numElements of the two trees
+        std::swap(numElements, rhs.numElements);
+        std::swap(compare, rhs.compare);
+        std::swap(pRightmost, rhs.pRightmost);
+        std::swap(pSlab, rhs.pSlab);
+        std::swap(slabSize, rhs.slabSize);
+        std::swap(slabLive, rhs.slabLive);
+    }
 
-    // If duplicates are allowed
-    if (!keepUnique)
+    /*****************************************************
+     * BST :: DESCEND
+     * Walk down to the empty spot where t belongs, with one
+     * comparison per level. Equivalent elements go right, so
+     * the returned node is the last one not greater than t:
+     * if anything in the tree is equivalent to t, it is that.
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::descend(const T& t, BNode*& pParent, bool& isLeft) const
     {
-        // Begin traversing the tree to find the insertion point
-        while (current != nullptr)
-        {
-            parent = current;
+        BNode* pCandidate = nullptr;
+        pParent = nullptr;
+        isLeft = false;
 
-            // Determine which side of current t goes on
-            if (t < current->data)
-            {
-                // Advance to the next node on the left
+        for (BNode* current = root; current != nullptr; )
+        {
+            pParent = current;
+            isLeft = compare(t, current->data);
+            if (isLeft)
                 current = current->pLeft;
-
-                // Update flags
-                if (insertRight)
-                    insertRight = false;
-                insertLeft = true;
-            }
             else
             {
-                // Advance to the next node on the right (including duplicates)
+                // Not less, so this may be the one
+                pCandidate = current;
                 current = current->pRight;
-
-                // Update flags
-                if (insertLeft)
-                    insertLeft = false;
-                insertRight = true;
             }
         }
+
+        return pCandidate;
     }
-    else // Duplicates are not allowed
-    {
-        // Begin traversing through the tree
-        while (current != nullptr)
-        {
-            parent = current;
 
-            // Determine if t is equal to the current node's data
-            if (t == current->data) 
-            {
-                // Since duplicates are not allowed, no new node is added simple return the current node
-                pairReturn.first = iterator(current);
-                return pairReturn;
-            }
-            else if (t < current->data)  // Determine which side of current t goes on
-            {
-                // Advance to the node on the left
-                current = current->pLeft;
+    /*****************************************************
+     * BST :: ATTACH
+     * Hang a new node in the spot descend() found
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::attach(BNode* pNode, BNode* pParent, bool isLeft)
+    {
+        if (pParent == nullptr)
+            root = pNode;
+        else if (isLeft)
+            pParent->pLeft = pNode;
+        else
+            pParent->pRight = pNode;
+        pNode->pParent = pParent;
 
-                // Update flags
-                if (insertRight)
-                    insertRight = false;
-                insertLeft = true;
-            }
-            else
-            {
-                // Advance to the node on the right
-                current = current->pRight;
+        // A new last node replaces the old one
+        if (pParent == nullptr || (pParent == pRightmost && !isLeft))
+            pRightmost = pNode;
 
-                // Update flags
-                if (insertLeft)
-                    insertLeft = false;
-                insertRight = true;
-            }
-        }
+        ++numElements;
+        return iterator(pNode);
     }
 
-    // Create a new node and attach it to the parent
-    BNode* newNode = new BNode(std::move(t));
+    /*****************************************************
+     * BST :: INSERT
+     * Insert a node at a given location in the tree. When
+     * keepUnique is set, one more comparison at the bottom
+     * tells whether t is already here.
+     ****************************************************/
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(const T& t, bool keepUnique)
+    {
+        // Find the spot, and the one element that might match
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
+
+        // Duplicates are not allowed, so return the one already here
+        if (keepUnique && pCandidate && !compare(pCandidate->data, t))
+            return std::pair<iterator, bool>(iterator(pCandidate), false);
 
-    // Use flags to determine which side of the parent the newNode must be linked to
-    if (insertLeft) {
-        parent->pLeft = newNode;
+        // Otherwise make a new node and link it in
+        return std::pair<iterator, bool>(attach(new BNode(t), pParent, isLeft), true);
     }
-    else {
-        parent->pRight = newNode;
+
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(T&& t, bool keepUnique)
+    {
+        // Find the spot, and the one element that might match
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
+
+        // Duplicates are not allowed, so return the one already here
+        if (keepUnique && pCandidate && !compare(pCandidate->data, t))
+            return std::pair<iterator, bool>(iterator(pCandidate), false);
+
+        // Otherwise move t into a new node and link it in
+        return std::pair<iterator, bool>(attach(new BNode(std::move(t)), pParent, isLeft), true);
     }
 
-    // Link the newNode to the parent
-    newNode->pParent = parent;
-
-    // Increase the numElements by 1 and return the newNode
-    ++numElements;
-    pairReturn.first = iterator(newNode);
-    pairReturn.second = true;
-    return pairReturn;
-}
-
-/*************************************************
- * BST :: ERASE
- * Remove a given node as specified by the iterator
- ************************************************/
-template <typename T>
-typename BST <T> ::iterator BST <T> :: erase(iterator & it)
-{
-    // If tree is emtpy or the iterator is empty, return an iterator pointing to a nulllptr
-    if (numElements == 0 || it.getNode() == nullptr)
+    /*****************************************************
+     * BST :: INSERT with a HINT
+     * Insert t next to hint if it belongs there, which costs
+     * a comparison or two instead of a walk from the root.
+     * Otherwise fall back to the usual insert. Feeding back
+     * the iterator each insert returns, or end(), makes
+     * appending in order O(1) per element.
+     ****************************************************/
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(iterator hint, const T& t, bool keepUnique)
     {
-        return end();
+        BNode* pParent;
+        bool isLeft;
+        BNode* pEqual = nullptr;
+        if (!besideHint(hint.getNode(), t, keepUnique, pParent, isLeft, pEqual))
+            return insert(t, keepUnique);
+
+        // Duplicates are not allowed, so return the one already here
+        if (pEqual)
+            return std::pair<iterator, bool>(iterator(pEqual), false);
+
+        return std::pair<iterator, bool>(attach(new BNode(t), pParent, isLeft), true);
     }
 
-    // Initialize pointers pointing to the node to get deleted and its parent
-    BNode* nodeToDelete = it.getNode();
-    BNode* parent = nodeToDelete->pParent;
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(iterator hint, T&& t, bool keepUnique)
+    {
+        BNode* pParent;
+        bool isLeft;
+        BNode* pEqual = nullptr;
+        if (!besideHint(hint.getNode(), t, keepUnique, pParent, isLeft, pEqual))
+            return insert(std::move(t), keepUnique);
 
-    //we want to return an iterator to the next node in sequene
-    iterator nextNode = it; 
-    ++nextNode; 
+        // Duplicates are not allowed, so return the one already here
+        if (pEqual)
+            return std::pair<iterator, bool>(iterator(pEqual), false);
 
-    // If the node to delete is a leaf node, simply delete the node
-    if (nodeToDelete->pLeft == nullptr && nodeToDelete->pRight == nullptr)
+        return std::pair<iterator, bool>(attach(new BNode(std::move(t)), pParent, isLeft), true);
+    }
+
+    /*****************************************************
+     * BST :: BESIDE HINT
+     * Decide if t goes just before pHint (nullptr for end())
+     * or just after it. If so, set pParent and isLeft to the
+     * empty spot, or pEqual to an equivalent element when
+     * keepUnique is set, and return true. Return false if
+     * t belongs somewhere else.
+     ****************************************************/
+    template <typename T, class Compare>
+    bool BST <T, Compare> ::besideHint(BNode* pHint, const T& t, bool keepUnique,
+                                       BNode*& pParent, bool& isLeft, BNode*& pEqual)
     {
-        // nodeToDelete is on the right side of its parent
-        if (nodeToDelete->isRightChild(nodeToDelete))
+        // An empty tree has only one spot
+        if (root == nullptr)
         {
-            // Update the parent's right side
-            parent->pRight = nullptr;
+            pParent = nullptr;
+            isLeft = false;
+            return true;
         }
-        else // nodeToDelete is on the left side of its parent
+
+        // Just before the hint: between it and the one before it
+        if (pHint == nullptr || compare(t, pHint->data))
         {
-            // Update the parent's left side
-            parent->pLeft = nullptr;
+            BNode* pPrev;
+            if (pHint == nullptr)
+                pPrev = rightmost();
+            else
+            {
+                iterator it(pHint);
+                --it;
+                pPrev = it.getNode();
+            }
+
+            if (pPrev && !compare(pPrev->data, t))
+            {
+                if (compare(t, pPrev->data))
+                    return false;            // t goes further left
+                if (keepUnique)
+                {
+                    pEqual = pPrev;
+                    return true;
+                }
+            }
+
+            // The hint has no left child or the one before has no right child
+            if (pHint && pHint->pLeft == nullptr)
+            {
+                pParent = pHint;
+                isLeft = true;
+            }
+            else
+            {
+                pParent = pPrev;
+                isLeft = false;
+            }
+            return true;
         }
 
-        // Delete nodeToDelete, decrease the numElements by 1, and return the parent
-        delete nodeToDelete;
-        --numElements;
-        return nextNode;
-    }
-    else if (nodeToDelete->pLeft != nullptr && nodeToDelete->pRight != nullptr) // Node to delete has children on both sides
-    {
-        // First traverse through the tree starting at the nodeToDelete to find the in-order successor
-        BNode* successor = nodeToDelete->pRight;
-        while (successor->pLeft != nullptr)
+        // Just after the hint: between it and the one after it
+        BNode* pNext = nullptr;
+        if (pHint != pRightmost)
         {
-            successor = successor->pLeft;
+            iterator it(pHint);
+            ++it;
+            pNext = it.getNode();
         }
-
-        // Determine which side nodeToDelete is on
-        if (nodeToDelete->isLeftChild(nodeToDelete))
+        if (pNext && compare(pNext->data, t))
+            return false;                    // t goes further right
+        if (keepUnique)
         {
-            // Link the successor to the parent's left side
-            nodeToDelete->pParent->pLeft = successor;
+            if (!compare(pHint->data, t))
+            {
+                pEqual = pHint;
+                return true;
+            }
+            if (pNext && !compare(t, pNext->data))
+            {
+                pEqual = pNext;
+                return true;
+            }
         }
-        else if (nodeToDelete->isRightChild(nodeToDelete))
+
+        // The hint has no right child or the one after has no left child
+        if (pHint->pRight == nullptr)
         {
-            // Link the successor to the parent's right side
-            nodeToDelete->pParent->pRight = successor; 
+            pParent = pHint;
+            isLeft = false;
         }
         else
         {
-            // If the node is the root
-            root = successor;
+            pParent = pNext;
+            isLeft = true;
         }
+        return true;
+    }
 
-        // Link the successor to nodeToDelete's parent and left child
-        if (successor->isLeftChild(successor))
+    /*****************************************************
+     * BST :: RIGHTMOST
+     * The last node in order. Once found it is kept up to
+     * date by attach(), so appending does not walk the tree.
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::rightmost()
+    {
+        if (pRightmost == nullptr && root != nullptr)
         {
-            successor->pParent->pLeft = nullptr;
+            pRightmost = root;
+            while (pRightmost->pRight)
+                pRightmost = pRightmost->pRight;
         }
-        
-        successor->pParent = nodeToDelete->pParent;
-        successor->pLeft = nodeToDelete->pLeft;
+        return pRightmost;
+    }
 
-        // Link nodeToDelete's left child back to the successor
-        successor->pLeft->pParent = successor;
+    /*************************************************
+     * BST :: ERASE
+     * Remove every node from first up to last. Instead of
+     * erasing them one at a time, cut the range out along
+     * the two paths to its ends, taking whole subtrees
+     * that fall inside it at once: O(log n + k). The
+     * elements must be unique, as in set and map, so the
+     * range is every element not less than *first and
+     * less than *last.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator first, iterator last)
+    {
+        if (first == last || first.getNode() == nullptr)
+            return last;
+
+        // Cut the range out; the doomed subtrees are chained through pParent
+        BNode* pDoomed = nullptr;
+        const T* pHi = last.getNode() ? &last.getNode()->data : nullptr;
+        root = trimBNode(root, &first.getNode()->data, pHi, pDoomed);
+        if (root)
+            root->pParent = nullptr;
+
+        // Now that nothing compares against them, free them
+        while (pDoomed)
+        {
+            BNode* pNext = pDoomed->pParent;
+            numElements -= deleteBNode(pDoomed);
+            pDoomed = pNext;
+        }
 
-       
+        // The last node goes with a range that runs to the end
+        if (pHi == nullptr)
+            pRightmost = nullptr;
+        return last;
+    }
 
-        // Link the successor to nodeToDelete's right child
-        if (successor != nodeToDelete->pRight)
+    /*************************************************
+     * BST :: TRIM BNODE
+     * Remove the nodes from *pLo up to *pHi out of a
+     * subtree and return its new root. A null bound is
+     * open. Only the paths to the bounds are walked: a
+     * subtree known to be inside the range is added to
+     * pDoomed whole. Each path is walked with a loop, so
+     * a long chain cannot overflow the stack.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::trimBNode(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed)
+    {
+        // Walk down to the first node inside the range; those on the way stay
+        BNode* pTop = node;
+        BNode* pParent = nullptr;
+        bool isLeft = false;
+        while (node)
         {
-            // Determine if the successor has children on the right
-            if (successor->pRight != nullptr)
+            if (pLo && compare(node->data, *pLo))
             {
-                // Link successor child with nodeToDelete's right child and vice versa
-                nodeToDelete->pRight->pLeft = successor->pRight;
-                successor->pRight->pParent = nodeToDelete->pRight;
+                // Before the range: only the right side can hold some of it
+                pParent = node;
+                isLeft = false;
+                node = node->pRight;
             }
-            successor->pRight = nodeToDelete->pRight;
+            else if (pHi && !compare(node->data, *pHi))
+            {
+                // After the range: only the left side can
+                pParent = node;
+                isLeft = true;
+                node = node->pLeft;
+            }
+            else
+                break;
+        }
+        if (node == nullptr)
+            return pTop;
+
+        // Inside the range: without a bound on a side, that whole side goes
+        BNode* pLeft = node->pLeft;
+        BNode* pRight = node->pRight;
+        node->pLeft = node->pRight = nullptr;
+        node->pParent = pDoomed;
+        pDoomed = node;
+        if (pLo)
+            pLeft = trimEdge(pLeft, pLo, nullptr, pDoomed);
+        else if (pLeft)
+        {
+            pLeft->pParent = pDoomed;
+            pDoomed = pLeft;
+            pLeft = nullptr;
+        }
+        if (pHi)
+            pRight = trimEdge(pRight, nullptr, pHi, pDoomed);
+        else if (pRight)
+        {
+            pRight->pParent = pDoomed;
+            pDoomed = pRight;
+            pRight = nullptr;
+        }
+
+        // What is left of the two sides takes the node's place
+        BNode* pJoined = joinBNode(pLeft, pRight);
+        if (pParent == nullptr)
+            return pJoined;
+        if (isLeft)
+            pParent->addLeft(pJoined);
+        else
+            pParent->addRight(pJoined);
+        return pTop;
+    }
 
-            // Link nodeToDelete's right child back to the successor
-            nodeToDelete->pRight->pParent = successor;
+    /*************************************************
+     * BST :: TRIM EDGE
+     * Trim a subtree that only one bound cuts, *pLo or
+     * *pHi, the other being open. A node outside the
+     * range stays and the path goes on toward the range;
+     * a node inside it goes together with the side facing
+     * away from the bound, and the path goes on the other
+     * way. The nodes that stay are chained back up in the
+     * order they were met.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::trimEdge(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed)
+    {
+        BNode* pTop = nullptr;    // the new root of the subtree
+        BNode* pKept = nullptr;   // the last node to stay; the path continues below it
+        while (node)
+        {
+            bool isKept = pLo ? compare(node->data, *pLo) : !compare(node->data, *pHi);
+            BNode* pNext = (pLo != nullptr) == isKept ? node->pRight : node->pLeft;
+            if (isKept)
+            {
+                if (pKept == nullptr)
+                    pTop = node;
+                else if (pLo)
+                    pKept->addRight(node);
+                else
+                    pKept->addLeft(node);
+                pKept = node;
+            }
+            else
+            {
+                if (pLo)
+                    node->pLeft = nullptr;
+                else
+                    node->pRight = nullptr;
+                node->pParent = pDoomed;
+                pDoomed = node;
+            }
+            node = pNext;
         }
 
+        // Nothing more is left below the last node to stay
+        if (pKept && pLo)
+            pKept->pRight = nullptr;
+        else if (pKept)
+            pKept->pLeft = nullptr;
+        return pTop;
+    }
 
-        // Delete the node and decrease numElements by 1
-        delete nodeToDelete;
-        --numElements;
+    /*************************************************
+     * BST :: JOIN BNODE
+     * Join two subtrees where everything in pLeft comes
+     * before everything in pRight. The first node on the
+     * right becomes the root, as erase() does for a node
+     * with two children.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::joinBNode(BNode* pLeft, BNode* pRight)
+    {
+        if (pLeft == nullptr || pRight == nullptr)
+            return pLeft ? pLeft : pRight;
 
-        // Return the successor
-        return nextNode; 
+        BNode* pSuccessor = pRight;
+        while (pSuccessor->pLeft)
+            pSuccessor = pSuccessor->pLeft;
+        if (pSuccessor != pRight)
+        {
+            pSuccessor->pParent->addLeft(pSuccessor->pRight);
+            pSuccessor->addRight(pRight);
+        }
+        pSuccessor->addLeft(pLeft);
+        return pSuccessor;
     }
-    else // Node to delete has one child
+
+    /*************************************************
+     * BST :: ERASE
+     * Remove a given node as specified by the iterator
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator& it)
     {
-        
+        // If tree is emtpy or the iterator is empty, return an iterator pointing to a nulllptr
+        if (numElements == 0 || it.getNode() == nullptr)
+        {
+            return end();
+        }
+
+        // Initialize pointers pointing to the node to get deleted and its parent
+        BNode* nodeToDelete = it.getNode();
+        BNode* parent = nodeToDelete->pParent;
+
+        // If the last node goes, find the new one when it is next needed
+        if (nodeToDelete == pRightmost)
+            pRightmost = nullptr;
 
-        // Node has its child on the right side
-        if (nodeToDelete->pRight != nullptr)
+        //we want to return an iterator to the next node in sequene
+        iterator nextNode = it;
+        ++nextNode;
+
+        // If the node to delete is a leaf node, simply delete the node
+        if (nodeToDelete->pLeft == nullptr && nodeToDelete->pRight == nullptr)
         {
-            // Determine if nodeToDelete is right child
+            // nodeToDelete is on the right side of its parent
             if (nodeToDelete->isRightChild(nodeToDelete))
             {
-                // Update parent's right side with nodeToDelete's child
-                parent->pRight = nodeToDelete->pRight;
-                
-                // Update nodeToDelete's child's parent
-                nodeToDelete->pRight->pParent = parent;
+                // Update the parent's right side
+                parent->pRight = nullptr;
             }
-            else
+            else if (nodeToDelete->isLeftChild(nodeToDelete))
             {
-                // Update parent's left side with nodeToDelete's child
-                parent->pLeft = nodeToDelete->pRight;
-
-                // Update nodeToDelete's child's parent
-                nodeToDelete->pRight->pParent = parent;
+                // Update the parent's left side
+                parent->pLeft = nullptr;
             }
+            else // deleted node is the root and the only node
+            {
+                root = nullptr;
+            }
+
+            // Delete nodeToDelete, decrease the numElements by 1, and return the parent
+            freeBNode(nodeToDelete);
+            --numElements;
+            return nextNode;
         }
-        else // Node has its child on the left side
+        else if (nodeToDelete->pLeft != nullptr && nodeToDelete->pRight != nullptr) // Node to delete has children on both sides
         {
-            // Determine if nodeToDelete is right child
-            if (nodeToDelete->isRightChild(nodeToDelete))
+            // First traverse through the tree starting at the nodeToDelete to find the in-order successor
+            BNode* successor = nodeToDelete->pRight;
+            while (successor->pLeft != nullptr)
             {
-                // Update parent's right side with nodeToDelete's child
-                parent->pRight = nodeToDelete->pLeft;
+                successor = successor->pLeft;
+            }
 
-                // Update nodeToDelete's child's parent
-                nodeToDelete->pLeft->pParent = parent;
+            // Determine which side nodeToDelete is on
+            if (nodeToDelete->isLeftChild(nodeToDelete))
+            {
+                // Link the successor to the parent's left side
+                nodeToDelete->pParent->pLeft = successor;
+            }
+            else if (nodeToDelete->isRightChild(nodeToDelete))
+            {
+                // Link the successor to the parent's right side
+                nodeToDelete->pParent->pRight = successor;
             }
             else
             {
-                // Update parent's left side with nodeToDelete's child
-                parent->pLeft = nodeToDelete->pLeft;
+                // If the node is the root
+                root = successor;
+            }
+
+            // Link the successor to nodeToDelete's parent and left child. If it is
+            // further down than the right child, its own right child takes its place.
+            if (successor->isLeftChild(successor))
+            {
+                successor->pParent->pLeft = successor->pRight;
+                if (successor->pRight != nullptr)
+                {
+                    successor->pRight->pParent = successor->pParent;
+                }
+            }
+
+            successor->pParent = nodeToDelete->pParent;
+            successor->pLeft = nodeToDelete->pLeft;
+
+            // Link nodeToDelete's left child back to the successor
+            successor->pLeft->pParent = successor;
+
+
+
+            // Link the successor to nodeToDelete's right child
+            if (successor != nodeToDelete->pRight)
+            {
+                successor->pRight = nodeToDelete->pRight;
 
-                // Update nodeToDelete's child's parent
-                nodeToDelete->pLeft->pParent = parent;
+                // Link nodeToDelete's right child back to the successor
+                nodeToDelete->pRight->pParent = successor;
             }
+
+
+            // Delete the node and decrease numElements by 1
+            freeBNode(nodeToDelete);
+            --numElements;
+
+            // Return the successor
+            return nextNode;
         }
+        else // Node to delete has one child
+        {
 
-        // Delete node, decrease number of elements by 1, and return the next node in the sequence.
-        delete nodeToDelete;
-        --numElements;
-        return nextNode;
-    }
-}
-
-/*****************************************************
- * BST :: CLEAR
- * Removes all the BNodes from a tree
- ****************************************************/
-template <typename T>
-void BST <T> ::clear() noexcept
-{
-    // Use deleteBNode to delete all nodes from the bst
-    deleteBNode(root);
 
-    // Reset root and num elements to nullptr and 0
-    root = nullptr;
-    numElements = 0;
+            // Node has its child on the right side
+            if (nodeToDelete->pRight != nullptr)
+            {
+                // Determine if nodeToDelete is right child
+                if (nodeToDelete->isRightChild(nodeToDelete))
+                {
+                    // Update parent's right side with nodeToDelete's child
+                    parent->pRight = nodeToDelete->pRight;
 
-}
+                    // Update nodeToDelete's child's parent
+                    nodeToDelete->pRight->pParent = parent;
+                }
+                else if (nodeToDelete->isLeftChild(nodeToDelete))
+                {
+                    // Update parent's left side with nodeToDelete's child
+                    parent->pLeft = nodeToDelete->pRight;
 
-/*****************************************************
- * BST :: BEGIN
- * Return the first node (left-most) in a binary search tree
- ****************************************************/
-template <typename T>
-typename BST <T> :: iterator custom :: BST <T> :: begin() const noexcept
-{
-    // Initialize a pointer to the root
-    BNode* current = root;
+                    // Update nodeToDelete's child's parent
+                    nodeToDelete->pRight->pParent = parent;
+                }
+                else //deleted node is the root
+                {
+                    this->root = nodeToDelete->pRight;
+                    nodeToDelete->pRight->pParent = parent;
+                }
+            }
+            else // Node has its child on the left side
+            {
+                // Determine if nodeToDelete is right child
+                if (nodeToDelete->isRightChild(nodeToDelete))
+                {
+                    // Update parent's right side with nodeToDelete's child
+                    parent->pRight = nodeToDelete->pLeft;
 
-    // Traverse the tree to get to the left most node
-    while (current && current->pLeft != nullptr)
+                    // Update nodeToDelete's child's parent
+                    nodeToDelete->pLeft->pParent = parent;
+                }
+                else if (nodeToDelete->isLeftChild(nodeToDelete))
+                {
+                    // Update parent's left side with nodeToDelete's child
+                    parent->pLeft = nodeToDelete->pLeft;
+
+                    // Update nodeToDelete's child's parent
+                    nodeToDelete->pLeft->pParent = parent;
+                }
+                else //deleted node is the root
+                {
+                    this->root = nodeToDelete->pLeft;
+                    nodeToDelete->pLeft->pParent = parent;
+                }
+            }
+
+            // Delete node, decrease number of elements by 1, and return the next node in the sequence.
+            freeBNode(nodeToDelete);
+            --numElements;
+            return nextNode;
+        }
+    }
+
+    /*****************************************************
+     * BST :: CLEAR
+     * Removes all the BNodes from a tree
+     ****************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::clear() noexcept
     {
-        current = current->pLeft;
+        // Use deleteBNode to delete all nodes from the bst
+        deleteBNode(root);
+
+        // Reset root and num elements to nullptr and 0
+        root = nullptr;
+        numElements = 0;
+        pRightmost = nullptr;
+
     }
 
-    // Return an iterator pointing to the left most node
-    return iterator(current);
-}
+    /*****************************************************
+     * BST :: COMPACT
+     * Move every node into one block of memory, in the
+     * order the layout asks for, and free the old ones.
+     * After many inserts and erases the nodes are spread
+     * all over the heap; afterwards a scan or a lookup
+     * walks through memory that is close together. The
+     * shape of the tree does not change, nor does any
+     * element get copied. Iterators are invalidated.
+     ****************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::compact(bst_layout layout)
+    {
+        if (root == nullptr)
+            return;
 
+        // List the nodes in the order they will be laid out
+        size_t n = numElements;
+        BNode** pOrder = new BNode*[n];
+        if (layout == bst_layout::in_order)
+        {
+            size_t i = 0;
+            for (iterator it = begin(); it != end(); ++it)
+                pOrder[i++] = it.getNode();
+        }
+        else
+        {
+            // Breadth first, using the list itself as the queue
+            pOrder[0] = root;
+            for (size_t iHead = 0, iTail = 1; iHead < iTail; iHead++)
+            {
+                if (pOrder[iHead]->pLeft)
+                    pOrder[iTail++] = pOrder[iHead]->pLeft;
+                if (pOrder[iHead]->pRight)
+                    pOrder[iTail++] = pOrder[iHead]->pRight;
+            }
 
-/****************************************************
- * BST :: FIND
- * Return the node corresponding to a given value
- ****************************************************/
-template <typename T>
-typename BST <T> :: iterator BST<T> :: find(const T & t)
-{
-    // Initialize a pointer to the root
-    BNode* current = root;
+            // The last node breadth first is on the bottom level
+            if (layout == bst_layout::van_emde_boas)
+            {
+                size_t height = 1;
+                for (BNode* p = pOrder[n - 1]; p != root; p = p->pParent)
+                    height++;
+                vanEmdeBoas(root, height, pOrder, 0);
+            }
+        }
+
+        // Move the payloads over. The new nodes still point at the old ones...
+        BNode* pNew = static_cast<BNode*>(::operator new(n * sizeof(BNode)));
+        for (size_t i = 0; i < n; i++)
+        {
+            BNode* pOld = pOrder[i];
+            BNode* p = new (pNew + i) BNode(std::move(pOld->data));
+            p->pLeft = pOld->pLeft;
+            p->pRight = pOld->pRight;
+            p->pParent = pOld->pParent;
+            p->isRed = pOld->isRed;
+        }
+
+        // ...so each old node forwards to its new place through pParent
+        for (size_t i = 0; i < n; i++)
+            pOrder[i]->pParent = pNew + i;
+        for (size_t i = 0; i < n; i++)
+        {
+            BNode* p = pNew + i;
+            if (p->pLeft)
+                p->pLeft = p->pLeft->pParent;
+            if (p->pRight)
+                p->pRight = p->pRight->pParent;
+            if (p->pParent)
+                p->pParent = p->pParent->pParent;
+        }
+        root = root->pParent;
+
+        // The old nodes go, and with them any slab they were in
+        for (size_t i = 0; i < n; i++)
+            freeBNode(pOrder[i]);
+        delete[] pOrder;
 
-    // Traverse through the tree to find the node with the value t
-    while (current != nullptr)
+        pSlab = pNew;
+        slabSize = slabLive = n;
+        pRightmost = nullptr;
+    }
+
+    /*****************************************************
+     * BST :: VAN EMDE BOAS
+     * List the top height levels of a subtree, starting at
+     * pOrder[i]: the top half of those levels first, laid
+     * out the same way, then each subtree hanging below
+     * them from left to right. Returns where the next node
+     * goes. Only the halving recurses, so the recursion is
+     * log(height) deep even in a long, unbalanced tree.
+     ****************************************************/
+    template <typename T, class Compare>
+    size_t BST <T, Compare> ::vanEmdeBoas(BNode* node, size_t height, BNode** pOrder, size_t i)
     {
-        // If the current node has the value t, return an iterator to it
-        if (t == current->data)
+        if (height == 1)
         {
-            return iterator(current);
+            pOrder[i] = node;
+            return i + 1;
         }
-        else if (t < current->data) // If t is less than the current node's value, move to the left child 
+
+        // The top half
+        size_t top = height / 2;
+        i = vanEmdeBoas(node, top, pOrder, i);
+
+        // Then the bottom half under each node top levels down, left to right
+        BNode* p = node;
+        size_t depth = 0;
+        while (p)
         {
-            current = current->pLeft;
+            if (depth < top && p->pLeft)
+            {
+                p = p->pLeft;
+                depth++;
+                continue;
+            }
+            if (depth < top && p->pRight)
+            {
+                p = p->pRight;
+                depth++;
+                continue;
+            }
+            if (depth == top)
+                i = vanEmdeBoas(p, height - top, pOrder, i);
+
+            // Climb to the nearest right side not visited yet
+            BNode* pNext = nullptr;
+            while (p != node && pNext == nullptr)
+            {
+                BNode* pParent = p->pParent;
+                depth--;
+                if (p == pParent->pLeft && pParent->pRight)
+                {
+                    pNext = pParent->pRight;
+                    depth++;
+                }
+                p = pParent;
+            }
+            p = pNext;
         }
-        else
+        return i;
+    }
+
+    /*****************************************************
+     * BST :: BEGIN
+     * Return the first node (left-most) in a binary search tree
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator custom::BST <T, Compare> ::begin() const noexcept
+    {
+        // Initialize a pointer to the root
+        BNode* current = root;
+
+        // Traverse the tree to get to the left most node
+        while (current && current->pLeft != nullptr)
         {
-            current = current->pRight; // If t is greater than the current node's value, move to the right child
+            current = current->pLeft;
         }
+
+        // Return an iterator pointing to the left most node
+        return iterator(current);
     }
 
-    // if the value is not found, return an iterator to nulllptr
-    return iterator(nullptr);
-}
-
-/******************************************************
- ******************************************************
- ******************************************************
- *********************** B NODE ***********************
- ******************************************************
- ******************************************************
- ******************************************************/
-
- 
-/******************************************************
- * BINARY NODE :: ADD LEFT
- * Add a node to the left of the current node
- ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addLeft (BNode * pNode)
-{
-    // If pNode is not null, link it to the current node
-    if (pNode) {
-        pNode->pParent = this;
+
+    /****************************************************
+     * BST :: FIND
+     * Return the node corresponding to a given value. One
+     * comparison per level on the way down, then one more
+     * to see if the last candidate is equivalent to t.
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST<T, Compare> ::find(const T& t)
+    {
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
+
+        // The candidate is not greater than t; if t is not greater either, they match
+        if (pCandidate && !compare(pCandidate->data, t))
+            return iterator(pCandidate);
+
+        // if the value is not found, return an iterator to nulllptr
+        return iterator(nullptr);
     }
-    
-    // Link pNode to the current node's left
-    pLeft = pNode;
-}
-
-/******************************************************
- * BINARY NODE :: ADD RIGHT
- * Add a node to the right of the current node
- ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (BNode * pNode)
-{
-    // If pNode is not null, link it to the current node
-    if (pNode) {
-        pNode->pParent = this;
+
+    /****************************************************
+     * BST :: FIND BATCH
+     * Look up every value from first to last, writing one
+     * iterator per value to out, end() for a miss. The
+     * same comparisons as find(), but several searches
+     * take turns so their cache misses overlap.
+     ****************************************************/
+    template <typename T, class Compare>
+    template <class Iterator, class OutputIterator>
+    OutputIterator BST<T, Compare> ::find_batch(Iterator first, Iterator last, OutputIterator out)
+    {
+        findBatch(first, last, compare, [&out](BNode* pNode)
+        {
+            *out = iterator(pNode);
+            ++out;
+        });
+        return out;
     }
 
-    // Link pNode to the current node's right
-    pRight = pNode;
-}
+    /****************************************************
+     * BST :: FIND BATCH helper
+     * Up to batchWidth searches walk down the tree in
+     * lockstep, one level each per pass. Each prefetches
+     * the node it will look at next, so by the time the
+     * others have had their turn it is likely in cache.
+     * less(key, data) and less(data, key) must both work,
+     * and the keys must stay put while they are searched.
+     * emit() gets the node found for each key, in order.
+     ****************************************************/
+    template <typename T, class Compare>
+    template <class Iterator, class Less, class Emit>
+    void BST<T, Compare> ::findBatch(Iterator first, Iterator last, Less less, Emit emit) const
+    {
+        const size_t batchWidth = 16;
+        decltype(&*first) pKey[batchWidth];
+        BNode* pNode[batchWidth];
+        BNode* pCandidate[batchWidth];
 
-/******************************************************
- * BINARY NODE :: ADD LEFT
- * Add a node to the left of the current node
- ******************************************************/
-template <typename T>
-void BST<T> :: BNode :: addLeft (const T & t)
-{
-    // Create a new node and call addLeft
-    BNode* pNode = new BNode(t);
-    addLeft(pNode);
-}
-
-/******************************************************
- * BINARY NODE :: ADD LEFT
- * Add a node to the left of the current node
- ******************************************************/
-template <typename T>
-void BST<T> ::BNode::addLeft(T && t)
-{
-    // Create a new node and call addLeft
-    BNode* pNode = new BNode(std::move(t));
-    addLeft(pNode);
-}
-
-/******************************************************
- * BINARY NODE :: ADD RIGHT
- * Add a node to the right of the current node
- ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (const T & t)
-{
-    // Create a new node and call addRight
-    BNode* pNode = new BNode(t);
-    addRight(pNode);
-}
-
-/******************************************************
- * BINARY NODE :: ADD RIGHT
- * Add a node to the right of the current node
- ******************************************************/
-template <typename T>
-void BST <T> ::BNode::addRight(T && t)
-{
-    // Create a new node and call addRight
-    BNode* pNode = new BNode(std::move(t));
-    addRight(pNode);
-}
-
-
-
-/*************************************************
- *************************************************
- *************************************************
- ****************** ITERATOR *********************
- *************************************************
- *************************************************
- *************************************************/     
-
-/**************************************************
- * BST ITERATOR :: INCREMENT PREFIX
- * advance by one
- *************************************************/
-template <typename T>
-typename BST <T> :: iterator & BST <T> :: iterator :: operator ++ ()
-{
-    // If pNode points to a nullptr, no advancement is performed
-    if (!pNode)
-        return *this;
+        while (first != last)
+        {
+            // start the next group at the root
+            size_t n = 0;
+            for (; n < batchWidth && first != last; ++n, ++first)
+            {
+                pKey[n] = &*first;
+                pNode[n] = root;
+                pCandidate[n] = nullptr;
+            }
 
-    // If the current node has a right child
-    if (pNode->pRight) {
-        
-        // Move to the right child
-        pNode = pNode->pRight;
+            // one level per search per pass, until they all fall off
+            for (bool active = root != nullptr; active; )
+            {
+                active = false;
+                for (size_t i = 0; i < n; i++)
+                {
+                    BNode* current = pNode[i];
+                    if (current == nullptr)
+                        continue;
+                    if (less(*pKey[i], current->data))
+                        current = current->pLeft;
+                    else
+                    {
+                        pCandidate[i] = current;
+                        current = current->pRight;
+                    }
+                    if (current)
+                    {
+                        CUSTOM_PREFETCH(current);
+                        active = true;
+                    }
+                    pNode[i] = current;
+                }
+            }
 
-        // Move to the leftmost node in the right subtree
-        while (pNode->pLeft)
-            pNode = pNode->pLeft;
+            // the candidate is not greater than the key; if the key is not greater either, they match
+            for (size_t i = 0; i < n; i++)
+                emit(pCandidate[i] && !less(pCandidate[i]->data, *pKey[i]) ? pCandidate[i] : nullptr);
+        }
     }
-    else {
 
-        // Move up the tree until a node is found that is the left child of its parent
-        BNode* pParent = pNode->pParent;
-        while (pParent && pNode == pParent->pRight) {
-            pNode = pParent;
-            pParent = pParent->pParent;
+    /******************************************************
+     ******************************************************
+     ******************************************************
+     *********************** B NODE ***********************
+     ******************************************************
+     ******************************************************
+     ******************************************************/
+
+
+     /******************************************************
+      * BINARY NODE :: ADD LEFT
+      * Add a node to the left of the current node
+      ******************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addLeft(BNode* pNode)
+    {
+        // If pNode is not null, link it to the current node
+        if (pNode) {
+            pNode->pParent = this;
         }
 
-        // Set pNode to the parent, which will be the next in-order node
-        pNode = pParent;
+        // Link pNode to the current node's left
+        pLeft = pNode;
     }
-    return *this;
-}
-
-/**************************************************
- * BST ITERATOR :: DECREMENT PREFIX
- * advance by one
- *************************************************/
-template <typename T>
-typename BST <T> :: iterator & BST <T> :: iterator :: operator -- ()
-{
-    // If pNode points to a nulltr, no decrement is done
-    if (!pNode)
-        return *this;
 
-    // If the current node has a left child
-    if (pNode->pLeft) {
+    /******************************************************
+     * BINARY NODE :: ADD RIGHT
+     * Add a node to the right of the current node
+     ******************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(BNode* pNode)
+    {
+        // If pNode is not null, link it to the current node
+        if (pNode) {
+            pNode->pParent = this;
+        }
 
-        // Move to the left child
-        pNode = pNode->pLeft;
+        // Link pNode to the current node's right
+        pRight = pNode;
+    }
 
-        // Move to the rightmost node in the left subtree
-        while (pNode->pRight)
-            pNode = pNode->pRight;
+    /******************************************************
+     * BINARY NODE :: ADD LEFT
+     * Add a node to the left of the current node
+     ******************************************************/
+    template <typename T, class Compare>
+    void BST<T, Compare> ::BNode::addLeft(const T& t)
+    {
+        // Create a new node and call addLeft
+        BNode* pNode = new BNode(t);
+        addLeft(pNode);
+    }
+
+    /******************************************************
+     * BINARY NODE :: ADD LEFT
+     * Add a node to the left of the current node
+     ******************************************************/
+    template <typename T, class Compare>
+    void BST<T, Compare> ::BNode::addLeft(T&& t)
+    {
+        // Create a new node and call addLeft
+        BNode* pNode = new BNode(std::move(t));
+        addLeft(pNode);
+    }
+
+    /******************************************************
+     * BINARY NODE :: ADD RIGHT
+     * Add a node to the right of the current node
+     ******************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(const T& t)
+    {
+        // Create a new node and call addRight
+        BNode* pNode = new BNode(t);
+        addRight(pNode);
+    }
+
+    /******************************************************
+     * BINARY NODE :: ADD RIGHT
+     * Add a node to the right of the current node
+     ******************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(T&& t)
+    {
+        // Create a new node and call addRight
+        BNode* pNode = new BNode(std::move(t));
+        addRight(pNode);
     }
-    else {
-        // Move up the tree until a node that is a right child of its parent
-        BNode* pParent = pNode->pParent;
-        while (pParent && pNode == pParent->pLeft) {
+
+
+
+    /*************************************************
+     *************************************************
+     *************************************************
+     ****************** ITERATOR *********************
+     *************************************************
+     *************************************************
+     *************************************************/
+
+     /**************************************************
+      * BST ITERATOR :: INCREMENT PREFIX
+      * advance by one
+      *************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator& BST <T, Compare> ::iterator :: operator ++ ()
+    {
+        // If pNode points to a nullptr, no advancement is performed
+        if (!pNode)
+            return *this;
+
+        // If the current node has a right child
+        if (pNode->pRight) {
+
+            // Move to the right child
+            pNode = pNode->pRight;
+
+            // Move to the leftmost node in the right subtree
+            while (pNode->pLeft)
+                pNode = pNode->pLeft;
+        }
+        else {
+
+            // Move up the tree until a node is found that is the left child of its parent
+            BNode* pParent = pNode->pParent;
+            while (pParent && pNode == pParent->pRight) {
+                pNode = pParent;
+                pParent = pParent->pParent;
+            }
+
+            // Set pNode to the parent, which will be the next in-order node
             pNode = pParent;
-            pParent = pParent->pParent;
         }
+        return *this;
+    }
+
+    /**************************************************
+     * BST ITERATOR :: DECREMENT PREFIX
+     * advance by one
+     *************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator& BST <T, Compare> ::iterator :: operator -- ()
+    {
+        // If pNode points to a nulltr, no decrement is done
+        if (!pNode)
+            return *this;
+
+        // If the current node has a left child
+        if (pNode->pLeft) {
+
+            // Move to the left child
+            pNode = pNode->pLeft;
 
-        // Set pNode to the parent, which will be the previous node in-order
-        pNode = pParent;
+            // Move to the rightmost node in the left subtree
+            while (pNode->pRight)
+                pNode = pNode->pRight;
+        }
+        else {
+            // Move up the tree until a node that is a right child of its parent
+            BNode* pParent = pNode->pParent;
+            while (pParent && pNode == pParent->pLeft) {
+                pNode = pParent;
+                pParent = pParent->pParent;
+            }
+
+            // Set pNode to the parent, which will be the previous node in-order
+            pNode = pParent;
+        }
+        return *this;
     }
-    return *this;
-}
 
 
 } // namespace custom
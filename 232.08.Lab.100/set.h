@@ -33,7 +33,7 @@ namespace custom
  * SET
  * A class that represents a Set
  ***********************************************/
-template <typename T>
+template <typename T, class Compare = std::less<T>>
 class set
 {
    friend class ::TestSet; // give unit tests access to the privates
@@ -60,7 +60,7 @@ public:
    set(const std::initializer_list <T> & il) 
    {
        // Use BST intializer list constructor
-       bst = custom::BST <T>(il);
+       bst = custom::BST <T, Compare>(il);
    }
 
    template <class Iterator>
@@ -97,14 +97,20 @@ public:
        bst.clear();
 
        // Use initializer list constructor from BST class. 
-       bst = custom::BST <T>(il);
+       bst = custom::BST <T, Compare>(il);
        return *this;
    }
+   template <class Iterator>
+   void assign_sorted(Iterator first, Iterator last)
+   {
+       // Must be sorted with no repeats; builds a balanced tree in O(n)
+       bst.assign_sorted(first, last);
+   }
 
    void swap(set& rhs) noexcept
    {
-       // Use std::swap to swap this.bst and rhs.bst
-       std::swap(bst, rhs.bst);
+       // Swap the trees, and with them the comparators that order them
+       bst.swap(rhs.bst);
    }
 
    //
@@ -131,6 +137,17 @@ public:
        // Return bst.find() method
        return bst.find(t);
    }
+   template <class Iterator, class OutputIterator>
+   OutputIterator find_batch(Iterator first, Iterator last, OutputIterator out)
+   {
+       // Let the bst run the searches side by side, handing back set iterators
+       bst.findBatch(first, last, bst.compare, [&out](typename custom::BST<T, Compare>::BNode* pNode)
+       {
+           *out = iterator(typename custom::BST<T, Compare>::iterator(pNode));
+           ++out;
+       });
+       return out;
+   }
 
    //
    // Status
@@ -157,7 +174,22 @@ public:
    std::pair<iterator, bool> insert(T&& t)
    {
        // Use bst.insert, use true because we don't want duplicates
-       return bst.insert(t, true);
+       return bst.insert(std::move(t), true);
+   }
+   iterator insert(iterator hint, const T& t)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, t, true).first);
+   }
+   iterator insert(iterator hint, T&& t)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, std::move(t), true).first);
+   }
+   template <class... Args>
+   iterator emplace_hint(iterator hint, Args&&... args)
+   {
+       return insert(hint, T(std::forward<Args>(args)...));
    }
    void insert(const std::initializer_list <T>& il)
    {
@@ -174,8 +206,8 @@ public:
        // Iterate from first to last
        for (Iterator it = first; it != last; ++it) 
        {
-           // Insert each iterator using the bst.insert method
-           bst.insert(it);
+           // Try the end first, so a sorted range appends in O(1) each
+           bst.insert(bst.end(), *it, true);
        }
    }
 
@@ -209,23 +241,23 @@ public:
    }
    iterator erase(iterator &itBegin, iterator &itEnd)
    {
-       //set an iterator to return
-       iterator temp = itBegin; 
-       
-       // Iterate from itBegin to itEnd
-       for (iterator it = itBegin; it != itEnd;)
-       {
-           //erase automatically returns an iterator to the next node
-           it = erase(it); 
-           temp = it;
-       }
+       // Use bst.erase on the range, elements are unique so it can cut by value
+       return bst.erase(itBegin.it, itEnd.it);
+   }
 
-       return temp;   
+   //
+   // Layout
+   //
+   void compact(bst_layout layout = bst_layout::in_order)
+   {
+       // Gather the nodes together after heavy churn; iterators are invalidated
+       bst.compact(layout);
    }
 
+
 private:
    
-   custom::BST <T> bst;
+   custom::BST <T, Compare> bst;
 };
 
 
@@ -233,11 +265,11 @@ private:
  * SET ITERATOR
  * An iterator through Set
  *************************************************/
-template <typename T>
-class set <T> :: iterator
+template <typename T, class Compare>
+class set <T, Compare> :: iterator
 {
    friend class ::TestSet; // give unit tests access to the privates
-   friend class custom::set<T>;
+   friend class custom::set<T, Compare>;
 
 public:
    // constructors, destructors, and assignment operator
@@ -245,7 +277,7 @@ public:
    {
        it = nullptr;
    }
-   iterator(const typename custom::BST<T>::iterator& itRHS) 
+   iterator(const typename custom::BST<T, Compare>::iterator& itRHS) 
    {
        it = itRHS;
    }
@@ -278,36 +310,36 @@ public:
    // prefix increment
    iterator & operator ++ ()
    {
-       iterator temp = *this;
        ++(it);
-       return temp;
+       return *this;
    }
 
    // postfix increment
    iterator operator++ (int postfix)
    {
+      iterator temp = *this;
       ++(*this);
-      return *this;
+      return temp;
    }
    
    // prefix decrement
    iterator & operator -- ()
    {
-       iterator temp = *this;
-       --(*this);
-       return temp;
+       --(it);
+       return *this;
    }
    
    // postfix decrement
    iterator operator-- (int postfix)
    {
+       iterator temp = *this;
        --(*this);
-       return *this;
+       return temp;
    }
    
 private:
 
-   typename custom::BST<T>::iterator it;
+   typename custom::BST<T, Compare>::iterator it;
 };
 
 
@@ -14,12 +14,16 @@
 
 #include "set.h"
 #include "unitTest.h"
+#include "spy.h"        // for the Spy
 #include <set>
 #include <vector>
+#include <string>
 
 #include <iostream>
 #include <cassert>
 #include <memory>
+#include <functional> // for std::greater
+#include <iterator>   // for std::back_inserter
 
 class TestSet : public UnitTest
 {
@@ -58,6 +62,7 @@ public:
       test_assignMove_oneToStandard();
       test_assignMove_standardToOne();
       test_assignMove_standardToStandard();
+      test_assignSorted_standardToStandard();
       test_assignInit_emptyToEmpty();
       test_assignInit_standardToEmpty();
       test_assignInit_emptyToStandard();
@@ -68,6 +73,7 @@ public:
       test_swap_standardToEmpty();
       test_swap_emptyToStandard();
       test_swap_standardToStandard();
+      test_swap_comparator();
 
 
       // Iterator
@@ -81,12 +87,14 @@ public:
       test_iterator_increment_standardToDone();
       test_iterator_increment_standardEnd();
       test_iterator_dereference_standardRead();
+      test_iterator_postfix_standard();
 
       // Access
       test_find_empty();
       test_find_standardBegin();
       test_find_standardLast();
       test_find_standardMissing();
+      test_findBatch_standard();
 
       // Insert
       test_insert_empty();
@@ -94,11 +102,17 @@ public:
       test_insert_standardFront();
       test_insert_standardMiddle();
       test_insert_standardDuplicate();
+      test_insert_compareGreater();
+      test_insertHint_appendEnd();
+      test_insertHint_wrong();
+      test_emplaceHint_duplicate();
+      test_insert_rangeSorted();
       test_insertMove_empty();
       test_insertMove_standardEnd();
       test_insertMove_standardFront();
       test_insertMove_standardMiddle();
       test_insertMove_standardDuplicate();
+      test_insertMove_noCopy();
       test_insertInit_emptyInsertNone();
       test_insertInit_emptyInsertMany();
       test_insertInit_standardInsertNone();
@@ -125,6 +139,9 @@ public:
       test_eraseRange_oneChild();
       test_eraseRange_twoChildren();
 
+      // Layout
+      test_compact_churn();
+
 
       // Status
       test_empty_empty();
@@ -886,6 +903,30 @@ public:
       teardownStandardFixture(sDest);
    }
 
+   // sorted input replaces the contents with a balanced tree
+   void test_assignSorted_standardToStandard()
+   {  // setup
+      std::vector<int> src{ 20, 30, 40, 50, 60, 70, 80 };
+      //                (50b) = sDest
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      custom::set <int> sDest;
+      setupStandardFixture(sDest);
+      // exercise
+      sDest.assign_sorted(src.begin(), src.end());
+      // verify
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      assertStandardFixture(sDest);
+      // teardown
+      teardownStandardFixture(sDest);
+   }
+
    /***************************************
     * Assignment
     *    set::operator=(const std::initializer_list<T>& il)
@@ -1101,6 +1142,41 @@ public:
       teardownStandardFixture(s2);
    }
 
+   // orders ints either way, as the comparator's own state says
+   struct Direction
+   {
+      bool descending = false;
+      bool operator()(int lhs, int rhs) const { return descending ? rhs < lhs : lhs < rhs; }
+   };
+
+   // a stateful comparator goes along with the tree it ordered
+   void test_swap_comparator()
+   {  // setup
+      custom::set<int, Direction> sUp;
+      custom::set<int, Direction> sDown;
+      sDown.bst.compare.descending = true;
+      for (int i = 1; i <= 3; i++)
+      {
+         sUp.insert(i);
+         sDown.insert(i);
+      }
+      // exercise
+      sUp.swap(sDown);
+      sUp.insert(4);
+      sDown.insert(4);
+      // verify
+      assertUnit(sUp.bst.compare.descending);
+      assertUnit(!sDown.bst.compare.descending);
+      std::vector<int> up;
+      for (auto it = sUp.begin(); it != sUp.end(); ++it)
+         up.push_back(*it);
+      std::vector<int> down;
+      for (auto it = sDown.begin(); it != sDown.end(); ++it)
+         down.push_back(*it);
+      assertUnit(up == std::vector<int>({ 4, 3, 2, 1 }));
+      assertUnit(down == std::vector<int>({ 1, 2, 3, 4 }));
+   }  // teardown
+
 
    /***************************************
     * CLEAR
@@ -1410,6 +1486,33 @@ public:
       teardownStandardFixture(s);
    }
 
+   // postfix gives back where it was, prefix where it is, both ways
+   void test_iterator_postfix_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20      [[40]]  60        80  
+      custom::set <int> s;
+      setupStandardFixture(s);
+      custom::set<int>::iterator it;
+      it.it.pNode = s.bst.root->pLeft->pRight;
+      // exercise
+      custom::set<int>::iterator itOld = it++;
+      custom::set<int>::iterator& itRef = ++it;
+      // verify
+      assertUnit(*itOld == 40);
+      assertUnit(*it == 60);
+      assertUnit(&itRef == &it);
+      assertUnit(*(it--) == 60);
+      assertUnit(*it == 50);
+      assertUnit(*(--it) == 40);
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
    /***************************************
     * Find
     *    set::find(const T &)
@@ -1515,6 +1618,30 @@ public:
       teardownStandardFixture(s);
    }
 
+   // a batch finds the same as one find per key, in order
+   void test_findBatch_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::set <int> s;
+      setupStandardFixture(s);
+      std::vector<int> keys{ 80, 42, 20, 50 };
+      std::vector<custom::set<int>::iterator> found;
+      // exercise
+      s.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+      // verify
+      assertUnit(found.size() == 4);
+      for (size_t i = 0; i < found.size(); i++)
+         assertUnit(found[i] == s.find(keys[i]));
+      assertUnit(found.size() == 4 && found[1] == s.end());
+      assertStandardFixture(s);
+      // teardown
+      teardownStandardFixture(s);
+   }
+
 
    /***************************************
     * INSERT
@@ -1676,6 +1803,101 @@ public:
       teardownStandardFixture(s);
    }
 
+   // the comparator is handed down to the tree
+   void test_insert_compareGreater()
+   {  // setup
+      custom::set <int, std::greater<int>> s;
+      // exercise
+      s.insert(50);
+      s.insert(30);
+      s.insert(70);
+      auto pairSet = s.insert(30);
+      // verify
+      assertUnit(pairSet.second == false);
+      assertUnit(s.size() == 3);
+      assertUnit(s.find(70) != s.end());
+      assertUnit(s.find(60) == s.end());
+      //                 50 
+      //          +-------+-------+
+      //         70              30  
+      assertUnit(s.bst.root != nullptr);
+      if (s.bst.root)
+      {
+         assertUnit(s.bst.root->data == 50);
+         assertUnit(s.bst.root->pLeft && s.bst.root->pLeft->data == 70);
+         assertUnit(s.bst.root->pRight && s.bst.root->pRight->data == 30);
+      }
+      std::vector<int> order;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         order.push_back(*it);
+      assertUnit(order == std::vector<int>({ 70, 50, 30 }));
+   }  // teardown
+
+   // appending at end() keeps the set in order
+   void test_insertHint_appendEnd()
+   {  // setup
+      custom::set <int> s;
+      // exercise
+      for (int i = 1; i <= 100; i++)
+         s.insert(s.end(), i);
+      // verify
+      assertUnit(s.size() == 100);
+      int i = 1;
+      for (auto it = s.begin(); it != s.end(); ++it, i++)
+         assertUnit(*it == i);
+      assertUnit(s.bst.pRightmost != nullptr);
+      if (s.bst.pRightmost)
+         assertUnit(s.bst.pRightmost->data == 100);
+   }  // teardown
+
+   // a hint in the wrong place still puts the element where it belongs
+   void test_insertHint_wrong()
+   {  // setup
+      custom::set <int> s{ 50, 30, 70 };
+      // exercise
+      auto it = s.insert(s.end(), 40);
+      // verify
+      assertUnit(it != s.end());
+      if (it != s.end())
+         assertUnit(*it == 40);
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //          +----+
+      //              40
+      assertUnit(s.bst.root && s.bst.root->pLeft && s.bst.root->pLeft->pRight);
+      if (s.bst.root && s.bst.root->pLeft && s.bst.root->pLeft->pRight)
+         assertUnit(s.bst.root->pLeft->pRight->data == 40);
+      assertUnit(s.size() == 4);
+   }  // teardown
+
+   // an element already next to the hint is returned, not added
+   void test_emplaceHint_duplicate()
+   {  // setup
+      custom::set <std::string> s{ "b", "d" };
+      auto itHint = s.find("d");
+      // exercise
+      auto it = s.emplace_hint(itHint, 1, 'b');
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(it == s.find("b"));
+   }  // teardown
+
+   // a sorted range goes in through the end
+   void test_insert_rangeSorted()
+   {  // setup
+      std::vector<int> v{ 10, 20, 20, 30, 40 };
+      custom::set <int> s;
+      // exercise
+      s.insert(v.begin(), v.end());
+      // verify
+      assertUnit(s.size() == 4);
+      std::vector<int> order;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         order.push_back(*it);
+      assertUnit(order == std::vector<int>({ 10, 20, 30, 40 }));
+   }  // teardown
+
    
    /***************************************
     * INSERT MOVE
@@ -1841,6 +2063,23 @@ public:
       teardownStandardFixture(s);
    }
 
+   // insert an rvalue: it is moved into the new node, never copied
+   void test_insertMove_noCopy()
+   {  // setup
+      custom::set <Spy> s;
+      Spy spy(50);
+      Spy::reset();
+      // exercise
+      auto pairSet = s.insert(std::move(spy));
+      // verify
+      assertUnit(pairSet.second == true);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(s.size() == 1);
+      if (pairSet.first != s.end())
+         assertUnit(*(pairSet.first) == Spy(50));
+   }  // teardown
+
    /***************************************
     * Insert Initializer
     *    set::insert(const std::initializer_list<T>& il)
@@ -2577,6 +2816,33 @@ public:
 
    }
 
+
+   /***************************************
+    * Compact
+    *    set::compact(bst_layout layout)
+    ***************************************/
+    // after inserts and erases every node is in one block, and nothing is lost
+   void test_compact_churn()
+   {  // setup
+      custom::set <int> s;
+      for (int i = 0; i < 1000; i++)
+         s.insert(i * 7 % 1000);
+      for (int i = 0; i < 1000; i += 3)
+         s.erase(i);
+      // exercise
+      s.compact(custom::bst_layout::van_emde_boas);
+      // verify
+      assertUnit(s.size() == 666);
+      assertUnit(s.bst.root == s.bst.pSlab);
+      assertUnit(s.bst.slabLive == 666);
+      bool same = true;
+      int i = 1;
+      for (auto it = s.begin(); it != s.end(); ++it, i += (i % 3 == 1 ? 1 : 2))
+         same = same && *it == i && s.find(i) == it;
+      assertUnit(same);
+      assertUnit(i == 1000);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *                (50b)
@@ -11,6 +11,7 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *    This will contain the class definition of:
+ *        bst_layout          : The order compact() lays the nodes out in
  *        BST                 : A class that represents a binary search tree
  *        BST::iterator       : An iterator through BST
  * Author
@@ -30,6 +31,17 @@
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
 #include <utility>    // for std::pair
+#include <iterator>   // for std::distance
+#include <new>        // for placement new
+
+#ifndef CUSTOM_PREFETCH
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define CUSTOM_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define CUSTOM_PREFETCH(p) __builtin_prefetch(p)
+#endif
+#endif
 
 class TestBST; // forward declaration for unit tests
 class TestMap;
@@ -38,30 +50,44 @@ class TestSet;
 namespace custom
 {
 
-    template <class TT>
+    template <class TT, class CC>
     class set;
-    template <class KK, class VV>
+    template <class KK, class VV, class CC>
     class map;
+    template <class TR, class CC>
+    class MultiTree;
+
+    /*****************************************************************
+     * BST LAYOUT
+     * How compact() orders the nodes in memory: in order is best for
+     * walking the tree with an iterator, breadth first puts the top
+     * levels together, and van Emde Boas keeps every short path down
+     * the tree close together, which is best for lookups
+     *****************************************************************/
+    enum class bst_layout { in_order, breadth_first, van_emde_boas };
 
     /*****************************************************************
      * BINARY SEARCH TREE
      * Create a Binary Search Tree
      *****************************************************************/
-    template <typename T>
+    template <typename T, class Compare = std::less<T>>
     class BST
     {
         friend class ::TestBST; // give unit tests access to the privates
         friend class ::TestMap;
         friend class ::TestSet;
 
-        template <class KK, class VV>
+        template <class KK, class VV, class CC>
         friend class map;
 
-        template <class TT>
+        template <class TT, class CC>
         friend class set;
 
-        template <class KK, class VV>
-        friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+        template <class TR, class CC>
+        friend class MultiTree;
+
+        template <class KK, class VV, class CC>
+        friend void swap(map<KK, VV, CC>& lhs, map<KK, VV, CC>& rhs);
     public:
         //
         // Construct
@@ -80,6 +106,8 @@ namespace custom
         BST& operator = (const BST& rhs);
         BST& operator = (BST&& rhs);
         BST& operator = (const std::initializer_list<T>& il);
+        template <class Iterator>
+        void assign_sorted(Iterator first, Iterator last); // sorted, no repeats
         void swap(BST& rhs);
 
         //
@@ -95,6 +123,8 @@ namespace custom
         //
 
         iterator find(const T& t);
+        template <class Iterator, class OutputIterator>
+        OutputIterator find_batch(Iterator first, Iterator last, OutputIterator out);
 
         // 
         // Insert
@@ -102,14 +132,23 @@ namespace custom
 
         std::pair<iterator, bool> insert(const T& t, bool keepUnique = false);
         std::pair<iterator, bool> insert(T&& t, bool keepUnique = false);
+        std::pair<iterator, bool> insert(iterator hint, const T& t, bool keepUnique = false);
+        std::pair<iterator, bool> insert(iterator hint, T&& t, bool keepUnique = false);
 
         //
         // Remove
         // 
 
         iterator erase(iterator& it);
+        iterator erase(iterator first, iterator last); // no duplicates, as in set and map
         void   clear() noexcept;
 
+        //
+        // Layout
+        //
+
+        void compact(bst_layout layout = bst_layout::in_order); // invalidates iterators
+
         // 
         // Status
         //
@@ -123,8 +162,28 @@ namespace custom
         class BNode;
         BNode* root;              // root node of the binary search tree
         size_t numElements;        // number of elements currently in the tree
-        BNode* copyBNode(BNode* src, BNode* parent); // Helper Function to help copy nodes from one tree to the next
-        void deleteBNode(BNode* node); // Helper function to help delete every node in the bst
+        Compare compare;           // orders the elements
+        BNode* pRightmost;         // the last node in order, or nullptr if not known yet
+        BNode* pSlab;              // the block compact() put the nodes in, or nullptr
+        size_t slabSize;           // how many nodes fit in the slab
+        size_t slabLive;           // how many nodes in the slab are still in use
+        BNode* copyBNode(const BNode* src, BNode*& pRecycle); // Helper Function to help copy nodes from one tree to the next
+        BNode* recycleBNode(const T& t, BNode*& pRecycle);  // Helper function to reuse a node before allocating a new one
+        BNode* flattenBNode(BNode* node); // Helper function to turn a subtree into a chain of nodes to recycle
+        size_t deleteBNode(BNode* node); // Helper function to help delete every node in the bst, returning how many
+        void freeBNode(BNode* pNode); // Helper function to free one node, whether in the slab or not
+        size_t vanEmdeBoas(BNode* node, size_t height, BNode** pOrder, size_t i); // Helper function to list the nodes in van Emde Boas order
+        BNode* trimBNode(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed); // Helper function to cut [*pLo, *pHi) out of a subtree
+        BNode* trimEdge(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed); // Helper function to trim a subtree only one bound cuts
+        BNode* joinBNode(BNode* pLeft, BNode* pRight); // Helper function to join two subtrees, all of pLeft before pRight
+        template <class Iterator>
+        BNode* buildBNode(Iterator& it, size_t n, BNode*& pRecycle); // Helper function to build a balanced subtree from sorted input
+        BNode* descend(const T& t, BNode*& pParent, bool& isLeft) const; // Helper function to find where t goes, one comparison per level
+        iterator attach(BNode* pNode, BNode* pParent, bool isLeft); // Helper function to link a new node where descend() pointed
+        bool besideHint(BNode* pHint, const T& t, bool keepUnique, BNode*& pParent, bool& isLeft, BNode*& pEqual); // Helper function to find where t goes next to a hint
+        BNode* rightmost(); // Helper function to find the last node, remembering it for next time
+        template <class Iterator, class Less, class Emit>
+        void findBatch(Iterator first, Iterator last, Less less, Emit emit) const; // Helper function to run several searches side by side
     };
 
 
@@ -133,8 +192,8 @@ namespace custom
      * A single node in a binary tree. Note that the node does not know
      * anything about the properties of the tree so no validation can be done.
      *****************************************************************/
-    template <typename T>
-    class BST <T> ::BNode
+    template <typename T, class Compare>
+    class BST <T, Compare> ::BNode
     {
     public:
         // 
@@ -174,17 +233,17 @@ namespace custom
      * BINARY SEARCH TREE ITERATOR
      * Forward and reverse iterator through a BST
      *********************************************************/
-    template <typename T>
-    class BST <T> ::iterator
+    template <typename T, class Compare>
+    class BST <T, Compare> ::iterator
     {
         friend class ::TestBST; // give unit tests access to the privates
         friend class ::TestMap;
         friend class ::TestSet;
 
-        template <class KK, class VV>
+        template <class KK, class VV, class CC>
         friend class map;
 
-        template <class TT>
+        template <class TT, class CC>
         friend class set;
     public:
         // constructors and assignment
@@ -240,7 +299,7 @@ namespace custom
         }
 
         // must give friend status to remove so it can call getNode() from it
-        friend BST <T> ::iterator BST <T> ::erase(iterator& it);
+        friend BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator& it);
 
     private:
 
@@ -262,115 +321,168 @@ namespace custom
       * BST :: DEFAULT CONSTRUCTOR
       * Initialize a tree with no elements and a null root
       ********************************************/
-    template <typename T>
-    BST <T> ::BST() : root(nullptr), numElements(0) {}
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST() : root(nullptr), numElements(0), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0) {}
 
     /*********************************************
      * BST :: COPY CONSTRUCTOR
      * Copy one tree to another
      ********************************************/
-    template <typename T>
-    BST <T> ::BST(const BST<T>& rhs)
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(const BST<T, Compare>& rhs) : compare(rhs.compare), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0)
     {
         // Initialize the new tree
         numElements = rhs.numElements;
-        root = nullptr;
 
-        // Use copyBNode function to recursively copy the nodes from the rhs
-        if (rhs.root != nullptr)
-        {
-            root = copyBNode(rhs.root, nullptr);
-        }
+        // Use copyBNode to copy the nodes from the rhs. There is nothing to recycle yet.
+        BNode* pRecycle = nullptr;
+        root = copyBNode(rhs.root, pRecycle);
     }
 
     /********************************************
      * BST :: COPY BNODE
-     * Recursively copy a node and its children
+     * Copy a node and its children without recursion so a long,
+     * unbalanced tree cannot overflow the stack. Nodes are taken
+     * from pRecycle before any new ones are allocated.
      ********************************************/
-    template <typename T>
-    typename BST<T>::BNode* BST<T>::copyBNode(BNode* src, BNode* parent)
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::copyBNode(const BNode* src, BNode*& pRecycle)
     {
-        // If the src node is empty, there's nothing to copy. Recursive loop will stop.
+        // If the src node is empty, there's nothing to copy
         if (src == nullptr)
         {
             return nullptr;
         }
 
-        //create a temperary new node
-        BNode* newNode = nullptr;
+        // Copy the top of the subtree. It has no parent in the new tree.
+        BNode* newRoot = recycleBNode(src->data, pRecycle);
 
-        //make sure that parent isn't null
-        if (parent)
+        // Walk both trees in lockstep. A null child in the destination means we have
+        // not visited that side yet; once both sides are done we climb back up.
+        const BNode* pSrc = src;
+        BNode* pDest = newRoot;
+        while (true)
         {
-            //if src is a left child then set the new node to the left child of parent
-            if ((src->pParent)->isLeftChild(src))
+            if (pSrc->pLeft && !pDest->pLeft)
+            {
+                // Copy the left child and go down to it
+                pDest->addLeft(recycleBNode(pSrc->pLeft->data, pRecycle));
+                pSrc = pSrc->pLeft;
+                pDest = pDest->pLeft;
+            }
+            else if (pSrc->pRight && !pDest->pRight)
+            {
+                // Copy the right child and go down to it
+                pDest->addRight(recycleBNode(pSrc->pRight->data, pRecycle));
+                pSrc = pSrc->pRight;
+                pDest = pDest->pRight;
+            }
+            else if (pSrc == src)
             {
-                newNode = parent->pLeft;
+                // Both sides of the top node are done
+                break;
             }
-            //otherwise must be right child
             else
             {
-                newNode = parent->pRight;
+                // Both sides of this node are done, go back up
+                pSrc = pSrc->pParent;
+                pDest = pDest->pParent;
             }
         }
 
+        // Return the newRoot, which is now the root of the copied BST
+        return newRoot;
+    }
 
-        // if new node is still null then make it a new node with the same data as the src
-        if (!newNode)
-        {
-            newNode = new BNode(src->data);
-        }
-        //otherwise copy the data over
-        else
+    /********************************************
+     * BST :: RECYCLE BNODE
+     * Take a node off the recycle chain and overwrite its payload,
+     * or allocate a new node when the chain is empty
+     ********************************************/
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::recycleBNode(const T& t, BNode*& pRecycle)
+    {
+        // Nothing left to reuse, so we have to allocate
+        if (pRecycle == nullptr)
         {
-            newNode->data = src->data;
+            return new BNode(t);
         }
 
-        //attach to parent
-        newNode->pParent = parent;
+        // Unhook the first node in the chain and copy the data over. Everything
+        // else is reset so it looks just like a freshly allocated node.
+        BNode* pNode = pRecycle;
+        pRecycle = pRecycle->pRight;
+        pNode->data = t;
+        pNode->pLeft = pNode->pRight = pNode->pParent = nullptr;
+        pNode->isRed = false;
+        return pNode;
+    }
 
-        //establish logic to ensure deletion of extraneous nodes if *this is bigger than src
-        if (!src->pLeft && newNode->pLeft)
-        {
-            deleteBNode(newNode->pLeft);
-        }
-        if (!src->pRight && newNode->pLeft)
+    /********************************************
+     * BST :: FLATTEN BNODE
+     * Rotate a subtree into a chain linked through pRight.
+     * Every rotation moves one node off the left spine so this
+     * takes O(n) time and no extra space.
+     ********************************************/
+    template <typename T, class Compare>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::flattenBNode(BNode* node)
+    {
+        // The head of the chain is the left-most node after the rotations
+        BNode* pHead = nullptr;
+        BNode* pTail = nullptr;
+        while (node)
         {
-            deleteBNode(newNode->pRight);
+            if (node->pLeft)
+            {
+                // Rotate right so the left child moves up
+                BNode* pLeft = node->pLeft;
+                node->pLeft = pLeft->pRight;
+                pLeft->pRight = node;
+                node = pLeft;
+            }
+            else
+            {
+                // No left child: this node goes on the end of the chain
+                if (pTail)
+                    pTail->pRight = node;
+                else
+                    pHead = node;
+                pTail = node;
+                node = node->pRight;
+            }
         }
-
-        // Using recursion, copy the left and right children
-        newNode->pLeft = copyBNode(src->pLeft, newNode);
-        newNode->pRight = copyBNode(src->pRight, newNode);
-
-
-
-        // Return the newNode, which is now the root of the copied BST
-        return newNode;
+        return pHead;
     }
 
     /*********************************************
      * BST :: MOVE CONSTRUCTOR
      * Move one tree to another
      ********************************************/
-    template <typename T>
-    BST <T> ::BST(BST <T>&& rhs)
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(BST <T, Compare>&& rhs) : compare(rhs.compare)
     {
         // Transfer root and numElements from rhs to this BST
         root = rhs.root;
         numElements = rhs.numElements;
+        pRightmost = rhs.pRightmost;
+        pSlab = rhs.pSlab;
+        slabSize = rhs.slabSize;
+        slabLive = rhs.slabLive;
 
         // Clear rhs BST
         rhs.root = nullptr;
         rhs.numElements = 0;
+        rhs.pRightmost = nullptr;
+        rhs.pSlab = nullptr;
+        rhs.slabSize = rhs.slabLive = 0;
     }
 
     /*********************************************
      * BST :: INITIALIZER LIST CONSTRUCTOR
      * Create a BST from an initializer list
      ********************************************/
-    template <typename T>
-    BST <T> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(0)
+    template <typename T, class Compare>
+    BST <T, Compare> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(0), pRightmost(nullptr), pSlab(nullptr), slabSize(0), slabLive(0)
     {
         // Iterate through each item in the initializer list
         for (const T& element : il)
@@ -389,7 +501,7 @@ namespace custom
                 while (currentNode != nullptr)
                 {
                     // A node should be added to the left if the current element in the list is less than the root
-                    if (element < currentNode->data)
+                    if (compare(element, currentNode->data))
                     {
                         // Check if the current node has no node on the left
                         if (currentNode->pLeft == nullptr)
@@ -435,8 +547,8 @@ namespace custom
     /*********************************************
      * BST :: DESTRUCTOR
      ********************************************/
-    template <typename T>
-    BST <T> :: ~BST()
+    template <typename T, class Compare>
+    BST <T, Compare> :: ~BST()
     {
         // Use deleteBnode to delete all nodes
         deleteBNode(root);
@@ -448,69 +560,84 @@ namespace custom
 
     /**********************************************
      * BST :: DELETE BNODE
-     * Recursively delete nodes in the bst
+     * Delete every node in a subtree. This rotates the left
+     * children up instead of recursing so a long, unbalanced
+     * tree cannot overflow the stack.
      **********************************************/
-    template <typename T>
-    void BST<T>::deleteBNode(BNode* node)
+    template <typename T, class Compare>
+    size_t BST<T, Compare>::deleteBNode(BNode* node)
     {
-        // If the node to be deleted is already deleted, the recusive loop should stop
-        if (!node)
-            return;
-
-        // Recursively delete the right and left children
-        deleteBNode(node->pLeft);
-        deleteBNode(node->pRight);
+        size_t numDeleted = 0;
+        while (node)
+        {
+            if (node->pLeft)
+            {
+                // Rotate right so the left child moves up
+                BNode* pLeft = node->pLeft;
+                node->pLeft = pLeft->pRight;
+                pLeft->pRight = node;
+                node = pLeft;
+            }
+            else
+            {
+                // No left child: delete the node and continue with the right
+                BNode* pRight = node->pRight;
+                freeBNode(node);
+                numDeleted++;
+                node = pRight;
+            }
+        }
+        return numDeleted;
+    }
 
-        // Delete the current node
-        delete node;
+    /**********************************************
+     * BST :: FREE BNODE
+     * Free one node. A node compact() placed in the slab
+     * is only destroyed; the slab itself goes when the
+     * last node in it does.
+     **********************************************/
+    template <typename T, class Compare>
+    void BST<T, Compare>::freeBNode(BNode* pNode)
+    {
+        std::less<const BNode*> before;
+        if (pSlab && !before(pNode, pSlab) && before(pNode, pSlab + slabSize))
+        {
+            pNode->~BNode();
+            if (--slabLive == 0)
+            {
+                ::operator delete(pSlab);
+                pSlab = nullptr;
+                slabSize = 0;
+            }
+        }
+        else
+            delete pNode;
     }
 
     /*********************************************
      * BST :: ASSIGNMENT OPERATOR
-     * Copy one tree to another
+     * Copy one tree to another, reusing the nodes we already
+     * have by overwriting their payloads
      ********************************************/
-    template <typename T>
-    BST <T>& BST <T> :: operator = (const BST <T>& rhs)
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (const BST <T, Compare>& rhs)
     {
         // Check for self-assignment
         if (this != &rhs)
         {
-            //if both roots are allocated then copy the data over
-            if (root && rhs.root)
-            {
-                root->data = rhs.root->data;
-            }
-            else
-            {
-                //this catches an empty rhs bst and clears *this
-                if (!rhs.root)
-                {
-                    clear();
-                    return *this;
-                }
-                //if we get here then *this is empty and a new root must be allocated
-                else
-                {
-                    root = new BNode(rhs.root->data);
-                }
-            }
+            // Every node we own can be recycled whatever the shape of rhs
+            BNode* pRecycle = flattenBNode(root);
 
-            //check if rhs has children and delete nodes from *this if necessary
-            if (!rhs.root->pLeft && root->pLeft)
-            {
-                deleteBNode(root->pLeft);
-            }
-            if (!rhs.root->pRight && root->pRight)
-            {
-                deleteBNode(root->pRight);
-            }
+            // Copy the rhs, only allocating when we run out of nodes to recycle
+            root = copyBNode(rhs.root, pRecycle);
 
-            //start the copy recursion
-            root->pLeft = copyBNode(rhs.root->pLeft, root);
-            root->pRight = copyBNode(rhs.root->pRight, root);
+            // Anything left over was not needed
+            deleteBNode(pRecycle);
 
-            //update the numElements not the the data is updated
+            //update the numElements now that the data is updated
             numElements = rhs.numElements;
+            compare = rhs.compare;
+            pRightmost = nullptr;
         }
 
         // Return the new bst
@@ -521,8 +648,8 @@ namespace custom
      * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
      * Copy nodes onto a BTree
      ********************************************/
-    template <typename T>
-    BST <T>& BST <T> :: operator = (const std::initializer_list<T>& il)
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (const std::initializer_list<T>& il)
     {
         // Clear the current contents of the tree
         clear();
@@ -550,7 +677,7 @@ namespace custom
                 while (current != nullptr)
                 {
                     parent = current;
-                    if (element < current->data)
+                    if (compare(element, current->data))
                     {
                         // Move to the left child
                         current = current->pLeft;
@@ -593,8 +720,8 @@ namespace custom
      * BST :: ASSIGN-MOVE OPERATOR
      * Move one tree to another
      ********************************************/
-    template <typename T>
-    BST <T>& BST <T> :: operator = (BST <T>&& rhs)
+    template <typename T, class Compare>
+    BST <T, Compare>& BST <T, Compare> :: operator = (BST <T, Compare>&& rhs)
     {
         // Check for self assignment
         if (this != &rhs)
@@ -605,263 +732,529 @@ namespace custom
             // Move resources from rhs to this
             root = rhs.root;
             numElements = rhs.numElements;
+            compare = rhs.compare;
+            pRightmost = rhs.pRightmost;
+            pSlab = rhs.pSlab;
+            slabSize = rhs.slabSize;
+            slabLive = rhs.slabLive;
 
             // Leave rhs emtpy
             rhs.root = nullptr;
             rhs.numElements = 0;
+            rhs.pRightmost = nullptr;
+            rhs.pSlab = nullptr;
+            rhs.slabSize = rhs.slabLive = 0;
         }
         return *this;
     }
 
+    /*********************************************
+     * BST :: ASSIGN SORTED
+     * Replace the contents with a range that is already
+     * sorted and has no repeats. The middle element becomes
+     * the root, so the tree comes out balanced in O(n)
+     * instead of the O(n^2) chain inserting in order builds.
+     ********************************************/
+    template <typename T, class Compare>
+    template <class Iterator>
+    void BST <T, Compare> ::assign_sorted(Iterator first, Iterator last)
+    {
+        // Every node we own can be recycled
+        BNode* pRecycle = flattenBNode(root);
+
+        // Build the new tree, only allocating when we run out of nodes to recycle
+        size_t n = std::distance(first, last);
+        root = buildBNode(first, n, pRecycle);
+        if (root)
+            root->pParent = nullptr;
+        numElements = n;
+        pRightmost = nullptr;
+
+        // Anything left over was not needed
+        deleteBNode(pRecycle);
+    }
+
+    /*********************************************
+     * BST :: BUILD BNODE
+     * Build a subtree of the next n elements: the first half
+     * on the left, then the middle, then the rest on the right.
+     * The subtree is balanced, so the recursion is only
+     * log(n) deep.
+     ********************************************/
+    template <typename T, class Compare>
+    template <class Iterator>
+    typename BST<T, Compare>::BNode* BST<T, Compare>::buildBNode(Iterator& it, size_t n, BNode*& pRecycle)
+    {
+        // An empty subtree
+        if (n == 0)
+            return nullptr;
+
+        // The left half comes first in the input
+        BNode* pLeft = buildBNode(it, n / 2, pRecycle);
+
+        // Then the middle
+        BNode* pNode = recycleBNode(*it, pRecycle);
+        ++it;
+        pNode->addLeft(pLeft);
+
+        // Then the right half
+        pNode->addRight(buildBNode(it, n - n / 2 - 1, pRecycle));
+        return pNode;
+    }
+
     /*********************************************
      * BST :: SWAP
      * Swap two trees
      ********************************************/
-    template <typename T>
-    void BST <T> ::swap(BST <T>& rhs)
+    template <typename T, class Compare>
+    void BST <T, Compare> ::swap(BST <T, Compare>& rhs)
     {
         // Swap the root pointers of the two trees
         std::swap(root, rhs.root);
 
         // Swap the numElements of the two trees
         std::swap(numElements, rhs.numElements);
+        std::swap(compare, rhs.compare);
+        std::swap(pRightmost, rhs.pRightmost);
+        std::swap(pSlab, rhs.pSlab);
+        std::swap(slabSize, rhs.slabSize);
+        std::swap(slabLive, rhs.slabLive);
+    }
+
+    /*****************************************************
+     * BST :: DESCEND
+     * Walk down to the empty spot where t belongs, with one
+     * comparison per level. Equivalent elements go right, so
+     * the returned node is the last one not greater than t:
+     * if anything in the tree is equivalent to t, it is that.
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::descend(const T& t, BNode*& pParent, bool& isLeft) const
+    {
+        BNode* pCandidate = nullptr;
+        pParent = nullptr;
+        isLeft = false;
+
+        for (BNode* current = root; current != nullptr; )
+        {
+            pParent = current;
+            isLeft = compare(t, current->data);
+            if (isLeft)
+                current = current->pLeft;
+            else
+            {
+                // Not less, so this may be the one
+                pCandidate = current;
+                current = current->pRight;
+            }
+        }
+
+        return pCandidate;
+    }
+
+    /*****************************************************
+     * BST :: ATTACH
+     * Hang a new node in the spot descend() found
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::attach(BNode* pNode, BNode* pParent, bool isLeft)
+    {
+        if (pParent == nullptr)
+            root = pNode;
+        else if (isLeft)
+            pParent->pLeft = pNode;
+        else
+            pParent->pRight = pNode;
+        pNode->pParent = pParent;
+
+        // A new last node replaces the old one
+        if (pParent == nullptr || (pParent == pRightmost && !isLeft))
+            pRightmost = pNode;
+
+        ++numElements;
+        return iterator(pNode);
     }
 
     /*****************************************************
      * BST :: INSERT
-     * Insert a node at a given location in the tree
+     * Insert a node at a given location in the tree. When
+     * keepUnique is set, one more comparison at the bottom
+     * tells whether t is already here.
      ****************************************************/
-    template <typename T>
-    std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(const T& t, bool keepUnique)
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(const T& t, bool keepUnique)
     {
-        // Initialize the return value as a pair with end() and false
-        std::pair<iterator, bool> pairReturn(end(), false);
+        // Find the spot, and the one element that might match
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
 
-        // Initialize flags for inserting left or right
-        bool insertRight = false;
-        bool insertLeft = false;
+        // Duplicates are not allowed, so return the one already here
+        if (keepUnique && pCandidate && !compare(pCandidate->data, t))
+            return std::pair<iterator, bool>(iterator(pCandidate), false);
 
-        // If the tree is empty, create a new root node
-        if (root == nullptr)
-        {
-            root = new BNode(t);
-            ++numElements;
+        // Otherwise make a new node and link it in
+        return std::pair<iterator, bool>(attach(new BNode(t), pParent, isLeft), true);
+    }
 
-            // Update the return pair
-            pairReturn.first = iterator(root);
-            pairReturn.second = true;
-            return pairReturn;
-        }
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(T&& t, bool keepUnique)
+    {
+        // Find the spot, and the one element that might match
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
 
-        // Start at the root and traverse the tree to find the insertion point
-        BNode* current = root;
-        BNode* parent = nullptr;
+        // Duplicates are not allowed, so return the one already here
+        if (keepUnique && pCandidate && !compare(pCandidate->data, t))
+            return std::pair<iterator, bool>(iterator(pCandidate), false);
 
-        // If duplicates are allowed
-        if (keepUnique == false)
-        {
-            // Begin traversing through the tree to find insertion point
-            while (current != nullptr)
-            {
-                parent = current;
+        // Otherwise move t into a new node and link it in
+        return std::pair<iterator, bool>(attach(new BNode(std::move(t)), pParent, isLeft), true);
+    }
 
-                // Determine if data should go on the left side of the current node
-                if (t < current->data)
-                {
-                    // Advance to the left node
-                    current = current->pLeft;
+    /*****************************************************
+     * BST :: INSERT with a HINT
+     * Insert t next to hint if it belongs there, which costs
+     * a comparison or two instead of a walk from the root.
+     * Otherwise fall back to the usual insert. Feeding back
+     * the iterator each insert returns, or end(), makes
+     * appending in order O(1) per element.
+     ****************************************************/
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(iterator hint, const T& t, bool keepUnique)
+    {
+        BNode* pParent;
+        bool isLeft;
+        BNode* pEqual = nullptr;
+        if (!besideHint(hint.getNode(), t, keepUnique, pParent, isLeft, pEqual))
+            return insert(t, keepUnique);
 
-                    // Update flags
-                    insertLeft = true;
-                    insertRight = false;
-                }
-                else
-                {
-                    // Advance to the right node (including duplicates)
-                    current = current->pRight;
+        // Duplicates are not allowed, so return the one already here
+        if (pEqual)
+            return std::pair<iterator, bool>(iterator(pEqual), false);
 
-                    // Update flags
-                    insertRight = true;
-                    insertLeft = false;
-                }
-            }
+        return std::pair<iterator, bool>(attach(new BNode(t), pParent, isLeft), true);
+    }
+
+    template <typename T, class Compare>
+    std::pair<typename BST <T, Compare> ::iterator, bool> BST <T, Compare> ::insert(iterator hint, T&& t, bool keepUnique)
+    {
+        BNode* pParent;
+        bool isLeft;
+        BNode* pEqual = nullptr;
+        if (!besideHint(hint.getNode(), t, keepUnique, pParent, isLeft, pEqual))
+            return insert(std::move(t), keepUnique);
+
+        // Duplicates are not allowed, so return the one already here
+        if (pEqual)
+            return std::pair<iterator, bool>(iterator(pEqual), false);
+
+        return std::pair<iterator, bool>(attach(new BNode(std::move(t)), pParent, isLeft), true);
+    }
+
+    /*****************************************************
+     * BST :: BESIDE HINT
+     * Decide if t goes just before pHint (nullptr for end())
+     * or just after it. If so, set pParent and isLeft to the
+     * empty spot, or pEqual to an equivalent element when
+     * keepUnique is set, and return true. Return false if
+     * t belongs somewhere else.
+     ****************************************************/
+    template <typename T, class Compare>
+    bool BST <T, Compare> ::besideHint(BNode* pHint, const T& t, bool keepUnique,
+                                       BNode*& pParent, bool& isLeft, BNode*& pEqual)
+    {
+        // An empty tree has only one spot
+        if (root == nullptr)
+        {
+            pParent = nullptr;
+            isLeft = false;
+            return true;
         }
-        else // duplicates are not allowed
+
+        // Just before the hint: between it and the one before it
+        if (pHint == nullptr || compare(t, pHint->data))
         {
-            // Begin traversing the tree to find the insertion point
-            while (current != nullptr)
+            BNode* pPrev;
+            if (pHint == nullptr)
+                pPrev = rightmost();
+            else
             {
-                parent = current;
+                iterator it(pHint);
+                --it;
+                pPrev = it.getNode();
+            }
 
-                // Determine if t is equal to the data inside the current node
-                if (t == current->data)
-                {
-                    // Since duplicates are not allowed, simpl return the current node
-                    pairReturn.first = iterator(current);
-                    return pairReturn;
-                }
-                else if (t < current->data) // Determine if t is less than the data inside the current node
+            if (pPrev && !compare(pPrev->data, t))
+            {
+                if (compare(t, pPrev->data))
+                    return false;            // t goes further left
+                if (keepUnique)
                 {
-                    // Advance to the next node on the left
-                    current = current->pLeft;
-
-                    // Update flags
-                    insertLeft = true;
-                    insertRight = false;
+                    pEqual = pPrev;
+                    return true;
                 }
-                else // t > current->data is now handled by default
-                {
-                    // Advance to the next node on the right
-                    current = current->pRight;
+            }
 
-                    // Update flags
-                    insertRight = true;
-                    insertLeft = false;
-                }
+            // The hint has no left child or the one before has no right child
+            if (pHint && pHint->pLeft == nullptr)
+            {
+                pParent = pHint;
+                isLeft = true;
             }
+            else
+            {
+                pParent = pPrev;
+                isLeft = false;
+            }
+            return true;
         }
 
-        // Create a new node
-        BNode* newNode = new BNode(t);
+        // Just after the hint: between it and the one after it
+        BNode* pNext = nullptr;
+        if (pHint != pRightmost)
+        {
+            iterator it(pHint);
+            ++it;
+            pNext = it.getNode();
+        }
+        if (pNext && compare(pNext->data, t))
+            return false;                    // t goes further right
+        if (keepUnique)
+        {
+            if (!compare(pHint->data, t))
+            {
+                pEqual = pHint;
+                return true;
+            }
+            if (pNext && !compare(t, pNext->data))
+            {
+                pEqual = pNext;
+                return true;
+            }
+        }
 
-        // Link it to the parent using the flags
-        if (insertLeft)
+        // The hint has no right child or the one after has no left child
+        if (pHint->pRight == nullptr)
         {
-            parent->pLeft = newNode;
+            pParent = pHint;
+            isLeft = false;
         }
         else
         {
-            parent->pRight = newNode;
+            pParent = pNext;
+            isLeft = true;
         }
-
-        // Link the new node to the parent
-        newNode->pParent = parent;
-
-        // Increase the numElements by 1 and return the newNode
-        ++numElements;
-        pairReturn.first = iterator(newNode);
-        pairReturn.second = true;
-        return pairReturn;
+        return true;
     }
 
-    template <typename T>
-    std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T&& t, bool keepUnique)
+    /*****************************************************
+     * BST :: RIGHTMOST
+     * The last node in order. Once found it is kept up to
+     * date by attach(), so appending does not walk the tree.
+     ****************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::rightmost()
     {
-        // Initialize the return value as a pair with end() and false
-        std::pair<iterator, bool> pairReturn(end(), false);
-
-        // Initialize flags for inserting left or right
-        bool insertRight = false;
-        bool insertLeft = false;
+        if (pRightmost == nullptr && root != nullptr)
+        {
+            pRightmost = root;
+            while (pRightmost->pRight)
+                pRightmost = pRightmost->pRight;
+        }
+        return pRightmost;
+    }
 
-        // If the tree is empty, create a new root node
-        if (root == nullptr) {
-            root = new BNode(std::move(t));
-            ++numElements;
-            pairReturn.first = iterator(root);
-            pairReturn.second = true;
-            return pairReturn;
+    /*************************************************
+     * BST :: ERASE
+     * Remove every node from first up to last. Instead of
+     * erasing them one at a time, cut the range out along
+     * the two paths to its ends, taking whole subtrees
+     * that fall inside it at once: O(log n + k). The
+     * elements must be unique, as in set and map, so the
+     * range is every element not less than *first and
+     * less than *last.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator first, iterator last)
+    {
+        if (first == last || first.getNode() == nullptr)
+            return last;
+
+        // Cut the range out; the doomed subtrees are chained through pParent
+        BNode* pDoomed = nullptr;
+        const T* pHi = last.getNode() ? &last.getNode()->data : nullptr;
+        root = trimBNode(root, &first.getNode()->data, pHi, pDoomed);
+        if (root)
+            root->pParent = nullptr;
+
+        // Now that nothing compares against them, free them
+        while (pDoomed)
+        {
+            BNode* pNext = pDoomed->pParent;
+            numElements -= deleteBNode(pDoomed);
+            pDoomed = pNext;
         }
 
-        // Start at the root and traverse the tree to find the insertion point
-        BNode* current = root;
-        BNode* parent = nullptr;
+        // The last node goes with a range that runs to the end
+        if (pHi == nullptr)
+            pRightmost = nullptr;
+        return last;
+    }
 
-        // If duplicates are allowed
-        if (!keepUnique)
+    /*************************************************
+     * BST :: TRIM BNODE
+     * Remove the nodes from *pLo up to *pHi out of a
+     * subtree and return its new root. A null bound is
+     * open. Only the paths to the bounds are walked: a
+     * subtree known to be inside the range is added to
+     * pDoomed whole. Each path is walked with a loop, so
+     * a long chain cannot overflow the stack.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::trimBNode(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed)
+    {
+        // Walk down to the first node inside the range; those on the way stay
+        BNode* pTop = node;
+        BNode* pParent = nullptr;
+        bool isLeft = false;
+        while (node)
         {
-            // Begin traversing the tree to find the insertion point
-            while (current != nullptr)
+            if (pLo && compare(node->data, *pLo))
             {
-                parent = current;
-
-                // Determine which side of current t goes on
-                if (t < current->data)
-                {
-                    // Advance to the next node on the left
-                    current = current->pLeft;
-
-                    // Update flags
-                    if (insertRight)
-                        insertRight = false;
-                    insertLeft = true;
-                }
-                else
-                {
-                    // Advance to the next node on the right (including duplicates)
-                    current = current->pRight;
-
-                    // Update flags
-                    if (insertLeft)
-                        insertLeft = false;
-                    insertRight = true;
-                }
+                // Before the range: only the right side can hold some of it
+                pParent = node;
+                isLeft = false;
+                node = node->pRight;
             }
+            else if (pHi && !compare(node->data, *pHi))
+            {
+                // After the range: only the left side can
+                pParent = node;
+                isLeft = true;
+                node = node->pLeft;
+            }
+            else
+                break;
         }
-        else // Duplicates are not allowed
+        if (node == nullptr)
+            return pTop;
+
+        // Inside the range: without a bound on a side, that whole side goes
+        BNode* pLeft = node->pLeft;
+        BNode* pRight = node->pRight;
+        node->pLeft = node->pRight = nullptr;
+        node->pParent = pDoomed;
+        pDoomed = node;
+        if (pLo)
+            pLeft = trimEdge(pLeft, pLo, nullptr, pDoomed);
+        else if (pLeft)
         {
-            // Begin traversing through the tree
-            while (current != nullptr)
-            {
-                parent = current;
+            pLeft->pParent = pDoomed;
+            pDoomed = pLeft;
+            pLeft = nullptr;
+        }
+        if (pHi)
+            pRight = trimEdge(pRight, nullptr, pHi, pDoomed);
+        else if (pRight)
+        {
+            pRight->pParent = pDoomed;
+            pDoomed = pRight;
+            pRight = nullptr;
+        }
 
-                // Determine if t is equal to the current node's data
-                if (t == current->data)
-                {
-                    // Since duplicates are not allowed, no new node is added simple return the current node
-                    pairReturn.first = iterator(current);
-                    return pairReturn;
-                }
-                else if (t < current->data)  // Determine which side of current t goes on
-                {
-                    // Advance to the node on the left
-                    current = current->pLeft;
+        // What is left of the two sides takes the node's place
+        BNode* pJoined = joinBNode(pLeft, pRight);
+        if (pParent == nullptr)
+            return pJoined;
+        if (isLeft)
+            pParent->addLeft(pJoined);
+        else
+            pParent->addRight(pJoined);
+        return pTop;
+    }
 
-                    // Update flags
-                    if (insertRight)
-                        insertRight = false;
-                    insertLeft = true;
-                }
+    /*************************************************
+     * BST :: TRIM EDGE
+     * Trim a subtree that only one bound cuts, *pLo or
+     * *pHi, the other being open. A node outside the
+     * range stays and the path goes on toward the range;
+     * a node inside it goes together with the side facing
+     * away from the bound, and the path goes on the other
+     * way. The nodes that stay are chained back up in the
+     * order they were met.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::trimEdge(BNode* node, const T* pLo, const T* pHi, BNode*& pDoomed)
+    {
+        BNode* pTop = nullptr;    // the new root of the subtree
+        BNode* pKept = nullptr;   // the last node to stay; the path continues below it
+        while (node)
+        {
+            bool isKept = pLo ? compare(node->data, *pLo) : !compare(node->data, *pHi);
+            BNode* pNext = (pLo != nullptr) == isKept ? node->pRight : node->pLeft;
+            if (isKept)
+            {
+                if (pKept == nullptr)
+                    pTop = node;
+                else if (pLo)
+                    pKept->addRight(node);
                 else
-                {
-                    // Advance to the node on the right
-                    current = current->pRight;
-
-                    // Update flags
-                    if (insertLeft)
-                        insertLeft = false;
-                    insertRight = true;
-                }
+                    pKept->addLeft(node);
+                pKept = node;
+            }
+            else
+            {
+                if (pLo)
+                    node->pLeft = nullptr;
+                else
+                    node->pRight = nullptr;
+                node->pParent = pDoomed;
+                pDoomed = node;
             }
+            node = pNext;
         }
 
-        // Create a new node and attach it to the parent
-        BNode* newNode = new BNode(std::move(t));
-
-        // Use flags to determine which side of the parent the newNode must be linked to
-        if (insertLeft) {
-            parent->pLeft = newNode;
-        }
-        else {
-            parent->pRight = newNode;
-        }
+        // Nothing more is left below the last node to stay
+        if (pKept && pLo)
+            pKept->pRight = nullptr;
+        else if (pKept)
+            pKept->pLeft = nullptr;
+        return pTop;
+    }
 
-        // Link the newNode to the parent
-        newNode->pParent = parent;
+    /*************************************************
+     * BST :: JOIN BNODE
+     * Join two subtrees where everything in pLeft comes
+     * before everything in pRight. The first node on the
+     * right becomes the root, as erase() does for a node
+     * with two children.
+     ************************************************/
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::BNode* BST <T, Compare> ::joinBNode(BNode* pLeft, BNode* pRight)
+    {
+        if (pLeft == nullptr || pRight == nullptr)
+            return pLeft ? pLeft : pRight;
 
-        // Increase the numElements by 1 and return the newNode
-        ++numElements;
-        pairReturn.first = iterator(newNode);
-        pairReturn.second = true;
-        return pairReturn;
+        BNode* pSuccessor = pRight;
+        while (pSuccessor->pLeft)
+            pSuccessor = pSuccessor->pLeft;
+        if (pSuccessor != pRight)
+        {
+            pSuccessor->pParent->addLeft(pSuccessor->pRight);
+            pSuccessor->addRight(pRight);
+        }
+        pSuccessor->addLeft(pLeft);
+        return pSuccessor;
     }
 
     /*************************************************
      * BST :: ERASE
      * Remove a given node as specified by the iterator
      ************************************************/
-    template <typename T>
-    typename BST <T> ::iterator BST <T> ::erase(iterator& it)
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST <T, Compare> ::erase(iterator& it)
     {
         // If tree is emtpy or the iterator is empty, return an iterator pointing to a nulllptr
         if (numElements == 0 || it.getNode() == nullptr)
@@ -873,6 +1266,10 @@ namespace custom
         BNode* nodeToDelete = it.getNode();
         BNode* parent = nodeToDelete->pParent;
 
+        // If the last node goes, find the new one when it is next needed
+        if (nodeToDelete == pRightmost)
+            pRightmost = nullptr;
+
         //we want to return an iterator to the next node in sequene
         iterator nextNode = it;
         ++nextNode;
@@ -886,14 +1283,18 @@ namespace custom
                 // Update the parent's right side
                 parent->pRight = nullptr;
             }
-            else // nodeToDelete is on the left side of its parent
+            else if (nodeToDelete->isLeftChild(nodeToDelete))
             {
                 // Update the parent's left side
                 parent->pLeft = nullptr;
             }
+            else // deleted node is the root and the only node
+            {
+                root = nullptr;
+            }
 
             // Delete nodeToDelete, decrease the numElements by 1, and return the parent
-            delete nodeToDelete;
+            freeBNode(nodeToDelete);
             --numElements;
             return nextNode;
         }
@@ -923,10 +1324,15 @@ namespace custom
                 root = successor;
             }
 
-            // Link the successor to nodeToDelete's parent and left child
+            // Link the successor to nodeToDelete's parent and left child. If it is
+            // further down than the right child, its own right child takes its place.
             if (successor->isLeftChild(successor))
             {
-                successor->pParent->pLeft = nullptr;
+                successor->pParent->pLeft = successor->pRight;
+                if (successor->pRight != nullptr)
+                {
+                    successor->pRight->pParent = successor->pParent;
+                }
             }
 
             successor->pParent = nodeToDelete->pParent;
@@ -940,13 +1346,6 @@ namespace custom
             // Link the successor to nodeToDelete's right child
             if (successor != nodeToDelete->pRight)
             {
-                // Determine if the successor has children on the right
-                if (successor->pRight != nullptr)
-                {
-                    // Link successor child with nodeToDelete's right child and vice versa
-                    nodeToDelete->pRight->pLeft = successor->pRight;
-                    successor->pRight->pParent = nodeToDelete->pRight;
-                }
                 successor->pRight = nodeToDelete->pRight;
 
                 // Link nodeToDelete's right child back to the successor
@@ -955,7 +1354,7 @@ namespace custom
 
 
             // Delete the node and decrease numElements by 1
-            delete nodeToDelete;
+            freeBNode(nodeToDelete);
             --numElements;
 
             // Return the successor
@@ -1018,7 +1417,7 @@ namespace custom
             }
 
             // Delete node, decrease number of elements by 1, and return the next node in the sequence.
-            delete nodeToDelete;
+            freeBNode(nodeToDelete);
             --numElements;
             return nextNode;
         }
@@ -1028,8 +1427,8 @@ namespace custom
      * BST :: CLEAR
      * Removes all the BNodes from a tree
      ****************************************************/
-    template <typename T>
-    void BST <T> ::clear() noexcept
+    template <typename T, class Compare>
+    void BST <T, Compare> ::clear() noexcept
     {
         // Use deleteBNode to delete all nodes from the bst
         deleteBNode(root);
@@ -1037,15 +1436,160 @@ namespace custom
         // Reset root and num elements to nullptr and 0
         root = nullptr;
         numElements = 0;
+        pRightmost = nullptr;
 
     }
 
+    /*****************************************************
+     * BST :: COMPACT
+     * Move every node into one block of memory, in the
+     * order the layout asks for, and free the old ones.
+     * After many inserts and erases the nodes are spread
+     * all over the heap; afterwards a scan or a lookup
+     * walks through memory that is close together. The
+     * shape of the tree does not change, nor does any
+     * element get copied. Iterators are invalidated.
+     ****************************************************/
+    template <typename T, class Compare>
+    void BST <T, Compare> ::compact(bst_layout layout)
+    {
+        if (root == nullptr)
+            return;
+
+        // List the nodes in the order they will be laid out
+        size_t n = numElements;
+        BNode** pOrder = new BNode*[n];
+        if (layout == bst_layout::in_order)
+        {
+            size_t i = 0;
+            for (iterator it = begin(); it != end(); ++it)
+                pOrder[i++] = it.getNode();
+        }
+        else
+        {
+            // Breadth first, using the list itself as the queue
+            pOrder[0] = root;
+            for (size_t iHead = 0, iTail = 1; iHead < iTail; iHead++)
+            {
+                if (pOrder[iHead]->pLeft)
+                    pOrder[iTail++] = pOrder[iHead]->pLeft;
+                if (pOrder[iHead]->pRight)
+                    pOrder[iTail++] = pOrder[iHead]->pRight;
+            }
+
+            // The last node breadth first is on the bottom level
+            if (layout == bst_layout::van_emde_boas)
+            {
+                size_t height = 1;
+                for (BNode* p = pOrder[n - 1]; p != root; p = p->pParent)
+                    height++;
+                vanEmdeBoas(root, height, pOrder, 0);
+            }
+        }
+
+        // Move the payloads over. The new nodes still point at the old ones...
+        BNode* pNew = static_cast<BNode*>(::operator new(n * sizeof(BNode)));
+        for (size_t i = 0; i < n; i++)
+        {
+            BNode* pOld = pOrder[i];
+            BNode* p = new (pNew + i) BNode(std::move(pOld->data));
+            p->pLeft = pOld->pLeft;
+            p->pRight = pOld->pRight;
+            p->pParent = pOld->pParent;
+            p->isRed = pOld->isRed;
+        }
+
+        // ...so each old node forwards to its new place through pParent
+        for (size_t i = 0; i < n; i++)
+            pOrder[i]->pParent = pNew + i;
+        for (size_t i = 0; i < n; i++)
+        {
+            BNode* p = pNew + i;
+            if (p->pLeft)
+                p->pLeft = p->pLeft->pParent;
+            if (p->pRight)
+                p->pRight = p->pRight->pParent;
+            if (p->pParent)
+                p->pParent = p->pParent->pParent;
+        }
+        root = root->pParent;
+
+        // The old nodes go, and with them any slab they were in
+        for (size_t i = 0; i < n; i++)
+            freeBNode(pOrder[i]);
+        delete[] pOrder;
+
+        pSlab = pNew;
+        slabSize = slabLive = n;
+        pRightmost = nullptr;
+    }
+
+    /*****************************************************
+     * BST :: VAN EMDE BOAS
+     * List the top height levels of a subtree, starting at
+     * pOrder[i]: the top half of those levels first, laid
+     * out the same way, then each subtree hanging below
+     * them from left to right. Returns where the next node
+     * goes. Only the halving recurses, so the recursion is
+     * log(height) deep even in a long, unbalanced tree.
+     ****************************************************/
+    template <typename T, class Compare>
+    size_t BST <T, Compare> ::vanEmdeBoas(BNode* node, size_t height, BNode** pOrder, size_t i)
+    {
+        if (height == 1)
+        {
+            pOrder[i] = node;
+            return i + 1;
+        }
+
+        // The top half
+        size_t top = height / 2;
+        i = vanEmdeBoas(node, top, pOrder, i);
+
+        // Then the bottom half under each node top levels down, left to right
+        BNode* p = node;
+        size_t depth = 0;
+        while (p)
+        {
+            if (depth < top && p->pLeft)
+            {
+                p = p->pLeft;
+                depth++;
+                continue;
+            }
+            if (depth < top && p->pRight)
+            {
+                p = p->pRight;
+                depth++;
+                continue;
+            }
+            if (depth == top)
+                i = vanEmdeBoas(p, height - top, pOrder, i);
+
+            // Climb to the nearest right side not visited yet
+            BNode* pNext = nullptr;
+            while (p != node && pNext == nullptr)
+            {
+                BNode* pParent = p->pParent;
+                depth--;
+                if (p == pParent->pLeft && pParent->pRight)
+                {
+                    pNext = pParent->pRight;
+                    depth++;
+                }
+                p = pParent;
+            }
+            p = pNext;
+        }
+        return i;
+    }
+
     /*****************************************************
      * BST :: BEGIN
      * Return the first node (left-most) in a binary search tree
      ****************************************************/
-    template <typename T>
-    typename BST <T> ::iterator custom::BST <T> ::begin() const noexcept
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator custom::BST <T, Compare> ::begin() const noexcept
     {
         // Initialize a pointer to the root
         BNode* current = root;
@@ -1063,34 +1607,103 @@ namespace custom
 
     /****************************************************
      * BST :: FIND
-     * Return the node corresponding to a given value
+     * Return the node corresponding to a given value. One
+     * comparison per level on the way down, then one more
+     * to see if the last candidate is equivalent to t.
      ****************************************************/
-    template <typename T>
-    typename BST <T> ::iterator BST<T> ::find(const T& t)
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator BST<T, Compare> ::find(const T& t)
     {
-        // Initialize a pointer to the root
-        BNode* current = root;
+        BNode* pParent;
+        bool isLeft;
+        BNode* pCandidate = descend(t, pParent, isLeft);
+
+        // The candidate is not greater than t; if t is not greater either, they match
+        if (pCandidate && !compare(pCandidate->data, t))
+            return iterator(pCandidate);
+
+        // if the value is not found, return an iterator to nulllptr
+        return iterator(nullptr);
+    }
 
-        // Traverse through the tree to find the node with the value t
-        while (current != nullptr)
+    /****************************************************
+     * BST :: FIND BATCH
+     * Look up every value from first to last, writing one
+     * iterator per value to out, end() for a miss. The
+     * same comparisons as find(), but several searches
+     * take turns so their cache misses overlap.
+     ****************************************************/
+    template <typename T, class Compare>
+    template <class Iterator, class OutputIterator>
+    OutputIterator BST<T, Compare> ::find_batch(Iterator first, Iterator last, OutputIterator out)
+    {
+        findBatch(first, last, compare, [&out](BNode* pNode)
         {
-            // If the current node has the value t, return an iterator to it
-            if (t == current->data)
-            {
-                return iterator(current);
-            }
-            else if (t < current->data) // If t is less than the current node's value, move to the left child 
+            *out = iterator(pNode);
+            ++out;
+        });
+        return out;
+    }
+
+    /****************************************************
+     * BST :: FIND BATCH helper
+     * Up to batchWidth searches walk down the tree in
+     * lockstep, one level each per pass. Each prefetches
+     * the node it will look at next, so by the time the
+     * others have had their turn it is likely in cache.
+     * less(key, data) and less(data, key) must both work,
+     * and the keys must stay put while they are searched.
+     * emit() gets the node found for each key, in order.
+     ****************************************************/
+    template <typename T, class Compare>
+    template <class Iterator, class Less, class Emit>
+    void BST<T, Compare> ::findBatch(Iterator first, Iterator last, Less less, Emit emit) const
+    {
+        const size_t batchWidth = 16;
+        decltype(&*first) pKey[batchWidth];
+        BNode* pNode[batchWidth];
+        BNode* pCandidate[batchWidth];
+
+        while (first != last)
+        {
+            // start the next group at the root
+            size_t n = 0;
+            for (; n < batchWidth && first != last; ++n, ++first)
             {
-                current = current->pLeft;
+                pKey[n] = &*first;
+                pNode[n] = root;
+                pCandidate[n] = nullptr;
             }
-            else
+
+            // one level per search per pass, until they all fall off
+            for (bool active = root != nullptr; active; )
             {
-                current = current->pRight; // If t is greater than the current node's value, move to the right child
+                active = false;
+                for (size_t i = 0; i < n; i++)
+                {
+                    BNode* current = pNode[i];
+                    if (current == nullptr)
+                        continue;
+                    if (less(*pKey[i], current->data))
+                        current = current->pLeft;
+                    else
+                    {
+                        pCandidate[i] = current;
+                        current = current->pRight;
+                    }
+                    if (current)
+                    {
+                        CUSTOM_PREFETCH(current);
+                        active = true;
+                    }
+                    pNode[i] = current;
+                }
             }
-        }
 
-        // if the value is not found, return an iterator to nulllptr
-        return iterator(nullptr);
+            // the candidate is not greater than the key; if the key is not greater either, they match
+            for (size_t i = 0; i < n; i++)
+                emit(pCandidate[i] && !less(pCandidate[i]->data, *pKey[i]) ? pCandidate[i] : nullptr);
+        }
     }
 
     /******************************************************
@@ -1106,8 +1719,8 @@ namespace custom
       * BINARY NODE :: ADD LEFT
       * Add a node to the left of the current node
       ******************************************************/
-    template <typename T>
-    void BST <T> ::BNode::addLeft(BNode* pNode)
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addLeft(BNode* pNode)
     {
         // If pNode is not null, link it to the current node
         if (pNode) {
@@ -1122,8 +1735,8 @@ namespace custom
      * BINARY NODE :: ADD RIGHT
      * Add a node to the right of the current node
      ******************************************************/
-    template <typename T>
-    void BST <T> ::BNode::addRight(BNode* pNode)
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(BNode* pNode)
     {
         // If pNode is not null, link it to the current node
         if (pNode) {
@@ -1138,8 +1751,8 @@ namespace custom
      * BINARY NODE :: ADD LEFT
      * Add a node to the left of the current node
      ******************************************************/
-    template <typename T>
-    void BST<T> ::BNode::addLeft(const T& t)
+    template <typename T, class Compare>
+    void BST<T, Compare> ::BNode::addLeft(const T& t)
     {
         // Create a new node and call addLeft
         BNode* pNode = new BNode(t);
@@ -1150,8 +1763,8 @@ namespace custom
      * BINARY NODE :: ADD LEFT
      * Add a node to the left of the current node
      ******************************************************/
-    template <typename T>
-    void BST<T> ::BNode::addLeft(T&& t)
+    template <typename T, class Compare>
+    void BST<T, Compare> ::BNode::addLeft(T&& t)
     {
         // Create a new node and call addLeft
         BNode* pNode = new BNode(std::move(t));
@@ -1162,8 +1775,8 @@ namespace custom
      * BINARY NODE :: ADD RIGHT
      * Add a node to the right of the current node
      ******************************************************/
-    template <typename T>
-    void BST <T> ::BNode::addRight(const T& t)
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(const T& t)
     {
         // Create a new node and call addRight
         BNode* pNode = new BNode(t);
@@ -1174,8 +1787,8 @@ namespace custom
      * BINARY NODE :: ADD RIGHT
      * Add a node to the right of the current node
      ******************************************************/
-    template <typename T>
-    void BST <T> ::BNode::addRight(T&& t)
+    template <typename T, class Compare>
+    void BST <T, Compare> ::BNode::addRight(T&& t)
     {
         // Create a new node and call addRight
         BNode* pNode = new BNode(std::move(t));
@@ -1196,8 +1809,8 @@ namespace custom
       * BST ITERATOR :: INCREMENT PREFIX
       * advance by one
       *************************************************/
-    template <typename T>
-    typename BST <T> ::iterator& BST <T> ::iterator :: operator ++ ()
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator& BST <T, Compare> ::iterator :: operator ++ ()
     {
         // If pNode points to a nullptr, no advancement is performed
         if (!pNode)
@@ -1232,8 +1845,8 @@ namespace custom
      * BST ITERATOR :: DECREMENT PREFIX
      * advance by one
      *************************************************/
-    template <typename T>
-    typename BST <T> ::iterator& BST <T> ::iterator :: operator -- ()
+    template <typename T, class Compare>
+    typename BST <T, Compare> ::iterator& BST <T, Compare> ::iterator :: operator -- ()
     {
         // If pNode points to a nulltr, no decrement is done
         if (!pNode)
@@ -0,0 +1,1071 @@
+/***********************************************************************
+ * Header:
+ *    BTREE
+ * Summary:
+ *    A cache-conscious B+ tree, and a set and a map built on it
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        BTree               : A B+ tree of up to B elements per node
+ *        BTree::iterator     : An iterator through the leaves of a BTree
+ *        btree_set           : A set with the same interface as custom::set
+ *        btree_map           : A map with the same interface as custom::map
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <new>              // for placement new
+#include <stdexcept>        // for std::out_of_range
+#include <utility>          // for std::pair, std::move
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+
+class TestBTree; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * B TREE
+     * Every element lives in a leaf, B to a node, in one contiguous
+     * array. Inner nodes hold only copies of the keys and the child
+     * pointers, so a lookup touches one small node per level instead
+     * of one node per comparison. The leaves are linked so a scan is
+     * a walk through arrays.
+     *
+     * KeyOf pulls the key out of an element: the element itself for a
+     * set, .first for a map.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    class BTree
+    {
+        static_assert(B >= 4, "a BTree node needs room for at least four elements");
+        static_assert(B < 65536, "a BTree node counts its elements in 16 bits");
+
+        friend class ::TestBTree; // give unit tests access to the privates
+    public:
+        using key_type = K;
+        using value_type = T;
+
+        //
+        // Construct
+        //
+
+        BTree() : root(nullptr), pFirst(nullptr), pLast(nullptr), numElements(0) {}
+        BTree(const BTree& rhs);
+        BTree(BTree&& rhs) noexcept;
+        ~BTree() { clear(); }
+
+        //
+        // Assign
+        //
+
+        BTree& operator = (const BTree& rhs);
+        BTree& operator = (BTree&& rhs) noexcept;
+        void swap(BTree& rhs) noexcept;
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() const noexcept { return iterator(pFirst, 0); }
+        iterator end()   const noexcept { return iterator(pLast, pLast ? pLast->count : 0); }
+
+        //
+        // Access
+        //
+
+        iterator find(const K& k) const;
+        iterator lower_bound(const K& k) const;
+        T& value(const iterator& it) const { return it.pLeaf->data()[it.index]; }
+
+        //
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t) { return emplaceKey(KeyOf()(t), t); }
+        std::pair<iterator, bool> insert(T&& t)
+        {
+            const K& k = KeyOf()(t);
+            return emplaceKey(k, std::move(t));
+        }
+        template <class ... Args>
+        std::pair<iterator, bool> emplaceKey(const K& k, Args&& ... args);
+
+        //
+        // Remove
+        //
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(iterator first, const iterator& last);
+        void     clear() noexcept;
+
+        //
+        // Status
+        //
+
+        bool   empty() const noexcept { return numElements == 0; }
+        size_t size()  const noexcept { return numElements; }
+
+    private:
+
+        struct Node;
+        struct Leaf;
+        struct Inner;
+
+        // the fewest a node other than the root may hold
+        static constexpr size_t minLeaf  = B / 2;
+        static constexpr size_t minInner = (B - 1) / 2;
+
+        Node*  root;              // top of the tree, a leaf while the tree is small
+        Leaf*  pFirst;            // leftmost leaf, where begin() is
+        Leaf*  pLast;             // rightmost leaf, where end() is
+        size_t numElements;       // number of elements in all the leaves
+
+        template <class U, class Before>
+        static size_t search(const U* base, size_t n, Before before);
+        static size_t leafLowerBound(const Leaf* pLeaf, const K& k);
+        static size_t childIndex(const Inner* pInner, const K& k);
+
+        void   splitChild(Inner* pParent, size_t i);
+        size_t fillChild(Inner* pParent, size_t i);
+        void   mergeChildren(Inner* pParent, size_t i);
+
+        Node*  copyNode(const Node* pSrc, Leaf*& pPrev);
+        void   deleteNode(Node* pNode) noexcept;
+
+        template <class U>
+        static void relocate(U* pDest, U* pSrc)
+        {
+            new (pDest) U(std::move(*pSrc));
+            pSrc->~U();
+        }
+    };
+
+    /*****************************************************************
+     * BTREE :: NODE
+     * What leaves and inner nodes have in common. Count is the number
+     * of elements in a leaf and the number of keys in an inner node.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    struct BTree <K, T, KeyOf, B> ::Node
+    {
+        Node(bool isLeaf) : count(0), isLeaf(isLeaf) {}
+        unsigned short count;
+        bool isLeaf;
+    };
+
+    /*****************************************************************
+     * BTREE :: LEAF
+     * Up to B elements, sorted, in raw storage so an element is only
+     * constructed when it is inserted.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    struct BTree <K, T, KeyOf, B> ::Leaf : public Node
+    {
+        Leaf() : Node(true), pPrev(nullptr), pNext(nullptr) {}
+        T*       data()       { return reinterpret_cast<T*>(storage); }
+        const T* data() const { return reinterpret_cast<const T*>(storage); }
+
+        Leaf* pPrev;
+        Leaf* pNext;
+        alignas(T) unsigned char storage[B * sizeof(T)];
+    };
+
+    /*****************************************************************
+     * BTREE :: INNER
+     * Up to B separator keys and one more child than keys. Every key
+     * in children[i] is below keys()[i], and every key in children[i+1]
+     * is at or above it.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    struct BTree <K, T, KeyOf, B> ::Inner : public Node
+    {
+        Inner() : Node(false) {}
+        K*       keys()       { return reinterpret_cast<K*>(storage); }
+        const K* keys() const { return reinterpret_cast<const K*>(storage); }
+
+        alignas(K) unsigned char storage[B * sizeof(K)];
+        Node* children[B + 1];
+    };
+
+    /**********************************************************
+     * BTREE ITERATOR
+     * A leaf and a position in it. The end is one past the last
+     * element of the last leaf. Any insert or erase invalidates
+     * every iterator, since elements move between nodes.
+     *********************************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    class BTree <K, T, KeyOf, B> ::iterator
+    {
+        friend class ::TestBTree; // give unit tests access to the privates
+        friend class BTree;
+    public:
+        iterator() : pLeaf(nullptr), index(0) {}
+        iterator(Leaf* pLeaf, size_t index) : pLeaf(pLeaf), index(index) {}
+
+        bool operator == (const iterator& rhs) const { return pLeaf == rhs.pLeaf && index == rhs.index; }
+        bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+        const T& operator * () const { return pLeaf->data()[index]; }
+        const T* operator -> () const { return pLeaf->data() + index; }
+
+        iterator& operator ++ ()
+        {
+            if (++index == pLeaf->count && pLeaf->pNext)
+            {
+                pLeaf = pLeaf->pNext;
+                index = 0;
+            }
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+        iterator& operator -- ()
+        {
+            if (index == 0)
+            {
+                pLeaf = pLeaf->pPrev;
+                index = pLeaf->count;
+            }
+            --index;
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        Leaf*  pLeaf;              // the leaf holding the element
+        size_t index;              // which element of the leaf
+    };
+
+
+    /*********************************************
+     * BTREE :: COPY CONSTRUCTOR
+     * Same shape as rhs, node for node
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    BTree <K, T, KeyOf, B> ::BTree(const BTree& rhs) :
+        root(nullptr), pFirst(nullptr), pLast(nullptr), numElements(0)
+    {
+        *this = rhs;
+    }
+
+    /*********************************************
+     * BTREE :: MOVE CONSTRUCTOR
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    BTree <K, T, KeyOf, B> ::BTree(BTree&& rhs) noexcept :
+        root(rhs.root), pFirst(rhs.pFirst), pLast(rhs.pLast), numElements(rhs.numElements)
+    {
+        rhs.root = nullptr;
+        rhs.pFirst = rhs.pLast = nullptr;
+        rhs.numElements = 0;
+    }
+
+    /*********************************************
+     * BTREE :: ASSIGNMENT OPERATOR
+     * Build the copy first so a throwing copy leaves us unchanged
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    BTree <K, T, KeyOf, B>& BTree <K, T, KeyOf, B> :: operator = (const BTree& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        BTree copy;
+        if (rhs.root)
+        {
+            Leaf* pPrev = nullptr;
+            copy.root = copyNode(rhs.root, pPrev);
+            copy.pLast = pPrev;
+            while (pPrev->pPrev)
+                pPrev = pPrev->pPrev;
+            copy.pFirst = pPrev;
+            copy.numElements = rhs.numElements;
+        }
+        swap(copy);
+        return *this;
+    }
+
+    /*********************************************
+     * BTREE :: MOVE ASSIGNMENT
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    BTree <K, T, KeyOf, B>& BTree <K, T, KeyOf, B> :: operator = (BTree&& rhs) noexcept
+    {
+        clear();
+        swap(rhs);
+        return *this;
+    }
+
+    /*********************************************
+     * BTREE :: SWAP
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    void BTree <K, T, KeyOf, B> ::swap(BTree& rhs) noexcept
+    {
+        std::swap(root, rhs.root);
+        std::swap(pFirst, rhs.pFirst);
+        std::swap(pLast, rhs.pLast);
+        std::swap(numElements, rhs.numElements);
+    }
+
+    /*********************************************
+     * BTREE :: SEARCH
+     * The number of elements at the front of base that come before
+     * the target. Each step halves the range with a conditional move
+     * rather than a branch, so there is nothing to mispredict.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    template <class U, class Before>
+    size_t BTree <K, T, KeyOf, B> ::search(const U* base, size_t n, Before before)
+    {
+        if (n == 0)
+            return 0;
+        const U* p = base;
+        while (n > 1)
+        {
+            size_t half = n / 2;
+            p = before(p[half]) ? p + half : p;
+            n -= half;
+        }
+        return (p - base) + (before(*p) ? 1 : 0);
+    }
+
+    /*********************************************
+     * BTREE :: LEAF LOWER BOUND
+     * Position of the first element of the leaf not below k
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    size_t BTree <K, T, KeyOf, B> ::leafLowerBound(const Leaf* pLeaf, const K& k)
+    {
+        return search(pLeaf->data(), pLeaf->count,
+                      [&k](const T& t) { return KeyOf()(t) < k; });
+    }
+
+    /*********************************************
+     * BTREE :: CHILD INDEX
+     * Which child of an inner node k belongs under. A key equal to
+     * a separator belongs to the right of it.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    size_t BTree <K, T, KeyOf, B> ::childIndex(const Inner* pInner, const K& k)
+    {
+        return search(pInner->keys(), pInner->count,
+                      [&k](const K& key) { return !(k < key); });
+    }
+
+    /*********************************************
+     * BTREE :: LOWER BOUND
+     * The first element not below k
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    typename BTree <K, T, KeyOf, B> ::iterator BTree <K, T, KeyOf, B> ::lower_bound(const K& k) const
+    {
+        if (!root)
+            return end();
+
+        const Node* p = root;
+        while (!p->isLeaf)
+        {
+            const Inner* pInner = static_cast<const Inner*>(p);
+            p = pInner->children[childIndex(pInner, k)];
+        }
+
+        Leaf* pLeaf = const_cast<Leaf*>(static_cast<const Leaf*>(p));
+        size_t i = leafLowerBound(pLeaf, k);
+        if (i == pLeaf->count && pLeaf->pNext)
+            return iterator(pLeaf->pNext, 0);
+        return iterator(pLeaf, i);
+    }
+
+    /*********************************************
+     * BTREE :: FIND
+     * The element with key k, or end()
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    typename BTree <K, T, KeyOf, B> ::iterator BTree <K, T, KeyOf, B> ::find(const K& k) const
+    {
+        iterator it = lower_bound(k);
+        if (it == end() || k < KeyOf()(*it))
+            return end();
+        return it;
+    }
+
+    /*********************************************
+     * BTREE :: EMPLACE KEY
+     * Make an element from args, but only if k is not already there.
+     * Full nodes are split on the way down so there is always room
+     * in the parent for the new separator.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    template <class ... Args>
+    std::pair<typename BTree <K, T, KeyOf, B> ::iterator, bool>
+        BTree <K, T, KeyOf, B> ::emplaceKey(const K& k, Args&& ... args)
+    {
+        if (!root)
+            root = pFirst = pLast = new Leaf;
+
+        // a full root grows the tree by one level
+        if (root->count == B)
+        {
+            Inner* pNewRoot = new Inner;
+            pNewRoot->children[0] = root;
+            root = pNewRoot;
+            splitChild(pNewRoot, 0);
+        }
+
+        Node* p = root;
+        while (!p->isLeaf)
+        {
+            Inner* pInner = static_cast<Inner*>(p);
+            size_t i = childIndex(pInner, k);
+            if (pInner->children[i]->count == B)
+            {
+                splitChild(pInner, i);
+                if (!(k < pInner->keys()[i]))
+                    i++;
+            }
+            p = pInner->children[i];
+        }
+
+        Leaf* pLeaf = static_cast<Leaf*>(p);
+        size_t i = leafLowerBound(pLeaf, k);
+        T* data = pLeaf->data();
+        if (i < pLeaf->count && !(k < KeyOf()(data[i])))
+            return std::pair<iterator, bool>(iterator(pLeaf, i), false);
+
+        // make the element before opening the gap, so args may refer to k
+        T t(std::forward<Args>(args)...);
+        for (size_t j = pLeaf->count; j > i; j--)
+            relocate(data + j, data + j - 1);
+        new (data + i) T(std::move(t));
+        pLeaf->count++;
+        numElements++;
+        return std::pair<iterator, bool>(iterator(pLeaf, i), true);
+    }
+
+    /*********************************************
+     * BTREE :: SPLIT CHILD
+     * Split the full child i of a parent that has room. The upper
+     * half goes into a new right sibling, and the parent gets a
+     * separator between them.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    void BTree <K, T, KeyOf, B> ::splitChild(Inner* pParent, size_t i)
+    {
+        Node* pChild = pParent->children[i];
+        Node* pRight;
+        K* keys = pParent->keys();
+
+        // open a gap in the parent for the new separator and child
+        for (size_t j = pParent->count; j > i; j--)
+        {
+            relocate(keys + j, keys + j - 1);
+            pParent->children[j + 1] = pParent->children[j];
+        }
+
+        if (pChild->isLeaf)
+        {
+            // the upper half of the elements go to a new leaf after this one
+            Leaf* pLeft = static_cast<Leaf*>(pChild);
+            Leaf* pNew = new Leaf;
+            size_t mid = pLeft->count / 2;
+            for (size_t j = mid; j < pLeft->count; j++)
+                relocate(pNew->data() + (j - mid), pLeft->data() + j);
+            pNew->count = pLeft->count - mid;
+            pLeft->count = mid;
+
+            pNew->pPrev = pLeft;
+            pNew->pNext = pLeft->pNext;
+            if (pLeft->pNext)
+                pLeft->pNext->pPrev = pNew;
+            else
+                pLast = pNew;
+            pLeft->pNext = pNew;
+
+            new (keys + i) K(KeyOf()(pNew->data()[0]));
+            pRight = pNew;
+        }
+        else
+        {
+            // the middle key moves up, the ones after it go to a new node
+            Inner* pLeft = static_cast<Inner*>(pChild);
+            Inner* pNew = new Inner;
+            size_t mid = pLeft->count / 2;
+            for (size_t j = mid + 1; j < pLeft->count; j++)
+            {
+                relocate(pNew->keys() + (j - mid - 1), pLeft->keys() + j);
+                pNew->children[j - mid - 1] = pLeft->children[j];
+            }
+            pNew->children[pLeft->count - mid - 1] = pLeft->children[pLeft->count];
+            pNew->count = pLeft->count - mid - 1;
+
+            relocate(keys + i, pLeft->keys() + mid);
+            pLeft->count = mid;
+            pRight = pNew;
+        }
+
+        pParent->children[i + 1] = pRight;
+        pParent->count++;
+    }
+
+    /*********************************************
+     * BTREE :: ERASE
+     * Remove the element with key k. On the way down, a child at its
+     * minimum is topped up from a sibling or merged with one, so the
+     * leaf always has an element to spare.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    size_t BTree <K, T, KeyOf, B> ::erase(const K& k)
+    {
+        if (!root)
+            return 0;
+
+        Node* p = root;
+        while (!p->isLeaf)
+        {
+            Inner* pInner = static_cast<Inner*>(p);
+            size_t i = childIndex(pInner, k);
+            Node* pChild = pInner->children[i];
+            if (pChild->count <= (pChild->isLeaf ? minLeaf : minInner))
+                i = fillChild(pInner, i);
+
+            // a root that gave away its last key shrinks the tree by one level
+            if (pInner == root && pInner->count == 0)
+            {
+                root = pInner->children[0];
+                delete pInner;
+                p = root;
+            }
+            else
+                p = pInner->children[i];
+        }
+
+        Leaf* pLeaf = static_cast<Leaf*>(p);
+        size_t i = leafLowerBound(pLeaf, k);
+        T* data = pLeaf->data();
+        if (i == pLeaf->count || k < KeyOf()(data[i]))
+            return 0;
+
+        data[i].~T();
+        for (size_t j = i + 1; j < pLeaf->count; j++)
+            relocate(data + j - 1, data + j);
+        pLeaf->count--;
+        numElements--;
+
+        if (numElements == 0)
+        {
+            delete pLeaf;
+            root = pFirst = pLast = nullptr;
+        }
+        return 1;
+    }
+
+    /*********************************************
+     * BTREE :: ERASE
+     * Remove the element at it and return the one after it
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    typename BTree <K, T, KeyOf, B> ::iterator BTree <K, T, KeyOf, B> ::erase(const iterator& it)
+    {
+        // the element is about to be destroyed, and the one after it may move
+        K k(KeyOf()(*it));
+        erase(k);
+        return lower_bound(k);
+    }
+
+    /*********************************************
+     * BTREE :: ERASE
+     * Remove [first, last)
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    typename BTree <K, T, KeyOf, B> ::iterator BTree <K, T, KeyOf, B> ::erase(iterator first, const iterator& last)
+    {
+        if (first == last)
+            return first;
+
+        // last moves as we erase, so stop at its key instead
+        bool toEnd = (last == end());
+        K kLast(toEnd ? KeyOf()(*first) : KeyOf()(*last));
+        while (first != end() && (toEnd || KeyOf()(*first) < kLast))
+            first = erase(first);
+        return first;
+    }
+
+    /*********************************************
+     * BTREE :: FILL CHILD
+     * Give child i of the parent an element or key to spare: borrow
+     * one from a sibling that can afford it, otherwise merge with a
+     * sibling. Returns the index the child's range now lives at.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    size_t BTree <K, T, KeyOf, B> ::fillChild(Inner* pParent, size_t i)
+    {
+        Node* pChild = pParent->children[i];
+        size_t minimum = pChild->isLeaf ? minLeaf : minInner;
+        K* keys = pParent->keys();
+
+        // borrow the last of the left sibling
+        if (i > 0 && pParent->children[i - 1]->count > minimum)
+        {
+            Node* pSibling = pParent->children[i - 1];
+            if (pChild->isLeaf)
+            {
+                Leaf* pLeaf = static_cast<Leaf*>(pChild);
+                Leaf* pLeft = static_cast<Leaf*>(pSibling);
+                for (size_t j = pLeaf->count; j > 0; j--)
+                    relocate(pLeaf->data() + j, pLeaf->data() + j - 1);
+                relocate(pLeaf->data(), pLeft->data() + pLeft->count - 1);
+                keys[i - 1] = KeyOf()(pLeaf->data()[0]);
+            }
+            else
+            {
+                Inner* pInner = static_cast<Inner*>(pChild);
+                Inner* pLeft = static_cast<Inner*>(pSibling);
+                pInner->children[pInner->count + 1] = pInner->children[pInner->count];
+                for (size_t j = pInner->count; j > 0; j--)
+                {
+                    relocate(pInner->keys() + j, pInner->keys() + j - 1);
+                    pInner->children[j] = pInner->children[j - 1];
+                }
+                new (pInner->keys()) K(std::move(keys[i - 1]));
+                pInner->children[0] = pLeft->children[pLeft->count];
+                keys[i - 1] = std::move(pLeft->keys()[pLeft->count - 1]);
+                pLeft->keys()[pLeft->count - 1].~K();
+            }
+            pChild->count++;
+            pSibling->count--;
+            return i;
+        }
+
+        // borrow the first of the right sibling
+        if (i < pParent->count && pParent->children[i + 1]->count > minimum)
+        {
+            Node* pSibling = pParent->children[i + 1];
+            if (pChild->isLeaf)
+            {
+                Leaf* pLeaf = static_cast<Leaf*>(pChild);
+                Leaf* pRight = static_cast<Leaf*>(pSibling);
+                relocate(pLeaf->data() + pLeaf->count, pRight->data());
+                for (size_t j = 1; j < pRight->count; j++)
+                    relocate(pRight->data() + j - 1, pRight->data() + j);
+                keys[i] = KeyOf()(pRight->data()[0]);
+            }
+            else
+            {
+                Inner* pInner = static_cast<Inner*>(pChild);
+                Inner* pRight = static_cast<Inner*>(pSibling);
+                new (pInner->keys() + pInner->count) K(std::move(keys[i]));
+                pInner->children[pInner->count + 1] = pRight->children[0];
+                keys[i] = std::move(pRight->keys()[0]);
+                pRight->keys()[0].~K();
+                for (size_t j = 1; j < pRight->count; j++)
+                {
+                    relocate(pRight->keys() + j - 1, pRight->keys() + j);
+                    pRight->children[j - 1] = pRight->children[j];
+                }
+                pRight->children[pRight->count - 1] = pRight->children[pRight->count];
+            }
+            pChild->count++;
+            pSibling->count--;
+            return i;
+        }
+
+        // neither sibling can spare one, so two become one
+        if (i < pParent->count)
+        {
+            mergeChildren(pParent, i);
+            return i;
+        }
+        mergeChildren(pParent, i - 1);
+        return i - 1;
+    }
+
+    /*********************************************
+     * BTREE :: MERGE CHILDREN
+     * Fold child i+1 into child i and drop the separator between them
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    void BTree <K, T, KeyOf, B> ::mergeChildren(Inner* pParent, size_t i)
+    {
+        K* keys = pParent->keys();
+        if (pParent->children[i]->isLeaf)
+        {
+            Leaf* pLeft = static_cast<Leaf*>(pParent->children[i]);
+            Leaf* pRight = static_cast<Leaf*>(pParent->children[i + 1]);
+            for (size_t j = 0; j < pRight->count; j++)
+                relocate(pLeft->data() + pLeft->count + j, pRight->data() + j);
+            pLeft->count += pRight->count;
+
+            pLeft->pNext = pRight->pNext;
+            if (pRight->pNext)
+                pRight->pNext->pPrev = pLeft;
+            else
+                pLast = pLeft;
+            keys[i].~K();
+            delete pRight;
+        }
+        else
+        {
+            Inner* pLeft = static_cast<Inner*>(pParent->children[i]);
+            Inner* pRight = static_cast<Inner*>(pParent->children[i + 1]);
+            relocate(pLeft->keys() + pLeft->count, keys + i);
+            for (size_t j = 0; j < pRight->count; j++)
+            {
+                relocate(pLeft->keys() + pLeft->count + 1 + j, pRight->keys() + j);
+                pLeft->children[pLeft->count + 1 + j] = pRight->children[j];
+            }
+            pLeft->children[pLeft->count + 1 + pRight->count] = pRight->children[pRight->count];
+            pLeft->count += pRight->count + 1;
+            delete pRight;
+        }
+
+        // close the gap in the parent
+        for (size_t j = i + 1; j < pParent->count; j++)
+        {
+            relocate(keys + j - 1, keys + j);
+            pParent->children[j] = pParent->children[j + 1];
+        }
+        pParent->count--;
+    }
+
+    /*********************************************
+     * BTREE :: COPY NODE
+     * Copy a subtree, linking its leaves after pPrev as they are made
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    typename BTree <K, T, KeyOf, B> ::Node* BTree <K, T, KeyOf, B> ::copyNode(const Node* pSrc, Leaf*& pPrev)
+    {
+        if (pSrc->isLeaf)
+        {
+            const Leaf* pSrcLeaf = static_cast<const Leaf*>(pSrc);
+            Leaf* pLeaf = new Leaf;
+            for (size_t j = 0; j < pSrcLeaf->count; j++)
+            {
+                new (pLeaf->data() + j) T(pSrcLeaf->data()[j]);
+                pLeaf->count++;
+            }
+            pLeaf->pPrev = pPrev;
+            if (pPrev)
+                pPrev->pNext = pLeaf;
+            pPrev = pLeaf;
+            return pLeaf;
+        }
+
+        const Inner* pSrcInner = static_cast<const Inner*>(pSrc);
+        Inner* pInner = new Inner;
+        for (size_t j = 0; j < pSrcInner->count; j++)
+            new (pInner->keys() + j) K(pSrcInner->keys()[j]);
+        pInner->count = pSrcInner->count;
+        for (size_t j = 0; j <= pSrcInner->count; j++)
+            pInner->children[j] = copyNode(pSrcInner->children[j], pPrev);
+        return pInner;
+    }
+
+    /*********************************************
+     * BTREE :: CLEAR
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    void BTree <K, T, KeyOf, B> ::clear() noexcept
+    {
+        if (root)
+            deleteNode(root);
+        root = nullptr;
+        pFirst = pLast = nullptr;
+        numElements = 0;
+    }
+
+    /*********************************************
+     * BTREE :: DELETE NODE
+     * Destroy everything in a subtree and free its nodes
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, size_t B>
+    void BTree <K, T, KeyOf, B> ::deleteNode(Node* pNode) noexcept
+    {
+        if (pNode->isLeaf)
+        {
+            Leaf* pLeaf = static_cast<Leaf*>(pNode);
+            for (size_t j = 0; j < pLeaf->count; j++)
+                pLeaf->data()[j].~T();
+            delete pLeaf;
+            return;
+        }
+
+        Inner* pInner = static_cast<Inner*>(pNode);
+        for (size_t j = 0; j <= pInner->count; j++)
+            deleteNode(pInner->children[j]);
+        for (size_t j = 0; j < pInner->count; j++)
+            pInner->keys()[j].~K();
+        delete pInner;
+    }
+
+
+    /*****************************************************************
+     * BTREE SET
+     * A set with the interface of custom::set, kept in a BTree
+     *****************************************************************/
+    template <typename T, size_t B = 32>
+    class btree_set
+    {
+        friend class ::TestBTree; // give unit tests access to the privates
+
+        struct KeyOf
+        {
+            const T& operator () (const T& t) const { return t; }
+        };
+    public:
+        using iterator = typename BTree <T, T, KeyOf, B> ::iterator;
+
+        //
+        // Construct
+        //
+        btree_set() {}
+        btree_set(const btree_set& rhs) : tree(rhs.tree) {}
+        btree_set(btree_set&& rhs) : tree(std::move(rhs.tree)) {}
+        btree_set(const std::initializer_list <T>& il) { insert(il); }
+        template <class Iterator>
+        btree_set(Iterator first, Iterator last) { insert(first, last); }
+        ~btree_set() {}
+
+        //
+        // Assign
+        //
+        btree_set& operator = (const btree_set& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        btree_set& operator = (btree_set&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        btree_set& operator = (const std::initializer_list <T>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(btree_set& rhs) noexcept { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const { return tree.find(t); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+        //
+        // Insert
+        //
+        std::pair<iterator, bool> insert(const T& t) { return tree.insert(t); }
+        std::pair<iterator, bool> insert(T&& t)      { return tree.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il)
+        {
+            for (const T& t : il)
+                tree.insert(t);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        size_t erase(const T& t) { return tree.erase(t); }
+        iterator erase(const iterator& itBegin, const iterator& itEnd) { return tree.erase(itBegin, itEnd); }
+
+    private:
+        BTree <T, T, KeyOf, B> tree;
+    };
+
+
+    /*****************************************************************
+     * BTREE MAP
+     * A map with the interface of custom::map, kept in a BTree
+     *****************************************************************/
+    template <typename K, typename V, size_t B = 32>
+    class btree_map
+    {
+        friend class ::TestBTree; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+    private:
+        struct KeyOf
+        {
+            const K& operator () (const Pairs& p) const { return p.first; }
+        };
+    public:
+        using iterator = typename BTree <K, Pairs, KeyOf, B> ::iterator;
+
+        //
+        // Construct
+        //
+        btree_map() {}
+        btree_map(const btree_map& rhs) : tree(rhs.tree) {}
+        btree_map(btree_map&& rhs) : tree(std::move(rhs.tree)) {}
+        template <class Iterator>
+        btree_map(Iterator first, Iterator last) { insert(first, last); }
+        btree_map(const std::initializer_list <Pairs>& il) { insert(il); }
+        ~btree_map() {}
+
+        //
+        // Assign
+        //
+        btree_map& operator = (const btree_map& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        btree_map& operator = (btree_map&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        btree_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(btree_map& rhs) noexcept { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k)
+        {
+            return tree.value(tree.emplaceKey(k, k, V()).first).second;
+        }
+        const V& at(const K& k) const;
+              V& at(const K& k);
+        iterator find(const K& k) const { return tree.find(k); }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(rhs);
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        custom::pair<iterator, bool> insert(Pairs&& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(std::move(rhs));
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                tree.insert(element);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        size_t erase(const K& k) { return tree.erase(k); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        iterator erase(const iterator& first, const iterator& last) { return tree.erase(first, last); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+    private:
+        BTree <K, Pairs, KeyOf, B> tree;
+    };
+
+    /*****************************************************
+     * BTREE MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, size_t B>
+    V& btree_map <K, V, B> ::at(const K& k)
+    {
+        iterator it = tree.find(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return tree.value(it).second;
+    }
+
+    /*****************************************************
+     * BTREE MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, size_t B>
+    const V& btree_map <K, V, B> ::at(const K& k) const
+    {
+        iterator it = tree.find(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return (*it).second;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two B-tree sets or two B-tree maps
+     ****************************************************/
+    template <typename T, size_t B>
+    void swap(btree_set <T, B>& lhs, btree_set <T, B>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V, size_t B>
+    void swap(btree_map <K, V, B>& lhs, btree_map <K, V, B>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
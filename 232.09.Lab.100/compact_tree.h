@@ -0,0 +1,744 @@
+/***********************************************************************
+ * Header:
+ *    COMPACT TREE
+ * Summary:
+ *    A binary search tree whose nodes live side by side in one vector
+ *    and point at each other with 32-bit indices, and a set and a map
+ *    built on it
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        CompactTree           : A BST with its nodes in a slab
+ *        CompactTree::iterator : An in-order iterator through a CompactTree
+ *        compact_set           : A set with the same interface as custom::set
+ *        compact_map           : A map with the same interface as custom::map
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint32_t
+#include <functional>       // for std::less
+#include <stdexcept>        // for std::out_of_range, std::length_error
+#include <utility>          // for std::pair, std::move, std::forward
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+#include "vector.h"         // for custom::vector
+
+class TestCompactTree; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * COMPACT TREE
+     * The same unbalanced tree as BST, with the same comparisons, but
+     * a node is its element and three 32-bit links instead of three
+     * pointers and a padded bool. For a set of int that is 16 bytes a
+     * node instead of 40, and the nodes sit together in one block
+     * instead of one allocation each.
+     *
+     * Erasing moves the last node into the hole so the slab stays
+     * dense; like BTree, that invalidates iterators other than the
+     * one returned. A copy is a copy of the vector, links and all.
+     *
+     * KeyOf pulls the key out of an element: the element itself for a
+     * set, .first for a map.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare = std::less<K>>
+    class CompactTree
+    {
+        friend class ::TestCompactTree; // give unit tests access to the privates
+    public:
+        using key_type = K;
+        using value_type = T;
+
+        //
+        // Construct
+        //
+
+        CompactTree() : root(nil) {}
+        CompactTree(const CompactTree& rhs) : nodes(rhs.nodes), root(rhs.root), compare(rhs.compare) {}
+        CompactTree(CompactTree&& rhs) : nodes(std::move(rhs.nodes)), root(rhs.root), compare(rhs.compare)
+        {
+            rhs.root = nil;
+        }
+
+        //
+        // Assign
+        //
+
+        CompactTree& operator = (const CompactTree& rhs)
+        {
+            nodes = rhs.nodes;
+            root = rhs.root;
+            compare = rhs.compare;
+            return *this;
+        }
+        CompactTree& operator = (CompactTree&& rhs)
+        {
+            nodes = std::move(rhs.nodes);
+            root = rhs.root;
+            compare = rhs.compare;
+            rhs.root = nil;
+            return *this;
+        }
+        void swap(CompactTree& rhs)
+        {
+            nodes.swap(rhs.nodes);
+            std::swap(root, rhs.root);
+            std::swap(compare, rhs.compare);
+        }
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() const noexcept;
+        iterator end()   const noexcept { return iterator(this, nil); }
+
+        //
+        // Access
+        //
+
+        iterator find(const K& k) const;
+        T& value(const iterator& it) { return nodes[it.index].data; }
+
+        //
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t) { return emplaceKey(KeyOf()(t), t); }
+        std::pair<iterator, bool> insert(T&& t)
+        {
+            const K& k = KeyOf()(t);
+            return emplaceKey(k, std::move(t));
+        }
+        template <class ... Args>
+        std::pair<iterator, bool> emplaceKey(const K& k, Args&& ... args);
+        void reserve(size_t n) { nodes.reserve(n); }
+
+        //
+        // Remove
+        //
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(iterator first, iterator last);
+        void     clear() noexcept
+        {
+            nodes.clear();
+            root = nil;
+        }
+        void     shrink_to_fit() { nodes.shrink_to_fit(); }
+
+        //
+        // Status
+        //
+
+        bool   empty() const noexcept { return nodes.empty(); }
+        size_t size()  const noexcept { return nodes.size();  }
+
+    private:
+
+        struct Node;
+
+        // no node; the top bit of a parent link is left for the color
+        static const uint32_t nil     = 0x7FFFFFFF;
+        static const uint32_t linkBits = 0x7FFFFFFF;
+
+        custom::vector<Node> nodes;    // every node, in no particular order
+        uint32_t root;                 // index of the root, or nil
+        Compare  compare;              // orders the keys
+
+        uint32_t parentOf(uint32_t i) const { return nodes[i].parent & linkBits; }
+        void     setParent(uint32_t i, uint32_t parent)
+        {
+            nodes[i].parent = (nodes[i].parent & ~linkBits) | parent;
+        }
+        uint32_t leftmost(uint32_t i) const;
+        uint32_t next(uint32_t i) const;
+        uint32_t descend(const K& k, uint32_t& parent, bool& isLeft) const;
+        void     replace(uint32_t i, uint32_t child);
+        uint32_t eraseIndex(uint32_t i, uint32_t& other);
+    };
+
+    /*****************************************************************
+     * COMPACT TREE :: NODE
+     * An element and the indices of its neighbours. The parent link
+     * keeps its top bit free for a color, as BNode keeps isRed.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    struct CompactTree <K, T, KeyOf, Compare> ::Node
+    {
+        template <class ... Args>
+        Node(uint32_t parent, Args&& ... args) :
+            data(std::forward<Args>(args)...), left(nil), right(nil), parent(parent) {}
+
+        T        data;
+        uint32_t left;                 // smaller, or nil
+        uint32_t right;                // larger, or nil
+        uint32_t parent;               // the low 31 bits; nil at the root
+    };
+
+    /**********************************************************
+     * COMPACT TREE ITERATOR
+     * The tree and an index into it. End is the index nil.
+     *********************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    class CompactTree <K, T, KeyOf, Compare> ::iterator
+    {
+        friend class ::TestCompactTree; // give unit tests access to the privates
+        friend class CompactTree;
+    public:
+        iterator() : pTree(nullptr), index(nil) {}
+        iterator(const CompactTree* pTree, uint32_t index) : pTree(pTree), index(index) {}
+
+        bool operator == (const iterator& rhs) const { return index == rhs.index; }
+        bool operator != (const iterator& rhs) const { return index != rhs.index; }
+
+        const T& operator * () const { return pTree->nodes[index].data; }
+        const T* operator -> () const { return &pTree->nodes[index].data; }
+
+        iterator& operator ++ ()
+        {
+            index = pTree->next(index);
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+        // from end() this goes to the last element
+        iterator& operator -- ()
+        {
+            const custom::vector<Node>& nodes = pTree->nodes;
+            if (index == nil)
+            {
+                index = pTree->root;
+                while (index != nil && nodes[index].right != nil)
+                    index = nodes[index].right;
+            }
+            else if (nodes[index].left != nil)
+            {
+                index = nodes[index].left;
+                while (nodes[index].right != nil)
+                    index = nodes[index].right;
+            }
+            else
+            {
+                // climb until we come up from a right child
+                uint32_t child = index;
+                index = pTree->parentOf(index);
+                while (index != nil && nodes[index].left == child)
+                {
+                    child = index;
+                    index = pTree->parentOf(index);
+                }
+            }
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        const CompactTree* pTree;      // the tree holding the nodes
+        uint32_t index;                // which node, or nil for end()
+    };
+
+    /*********************************************
+     * COMPACT TREE :: BEGIN
+     * The left-most node
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename CompactTree <K, T, KeyOf, Compare> ::iterator CompactTree <K, T, KeyOf, Compare> ::begin() const noexcept
+    {
+        return iterator(this, root == nil ? nil : leftmost(root));
+    }
+
+    /*********************************************
+     * COMPACT TREE :: LEFTMOST
+     * The smallest node in the subtree at i
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    uint32_t CompactTree <K, T, KeyOf, Compare> ::leftmost(uint32_t i) const
+    {
+        while (nodes[i].left != nil)
+            i = nodes[i].left;
+        return i;
+    }
+
+    /*********************************************
+     * COMPACT TREE :: NEXT
+     * The node after i in order, or nil
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    uint32_t CompactTree <K, T, KeyOf, Compare> ::next(uint32_t i) const
+    {
+        if (nodes[i].right != nil)
+            return leftmost(nodes[i].right);
+
+        // climb until we come up from a left child
+        uint32_t parent = parentOf(i);
+        while (parent != nil && nodes[parent].right == i)
+        {
+            i = parent;
+            parent = parentOf(i);
+        }
+        return parent;
+    }
+
+    /*********************************************
+     * COMPACT TREE :: DESCEND
+     * Like BST::descend: one comparison per level. Set parent
+     * and isLeft to where k would hang and return the last
+     * node whose key is not greater than k, or nil.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    uint32_t CompactTree <K, T, KeyOf, Compare> ::descend(const K& k, uint32_t& parent, bool& isLeft) const
+    {
+        uint32_t candidate = nil;
+        parent = nil;
+        isLeft = false;
+        for (uint32_t i = root; i != nil; )
+        {
+            parent = i;
+            isLeft = compare(k, KeyOf()(nodes[i].data));
+            if (isLeft)
+                i = nodes[i].left;
+            else
+            {
+                candidate = i;
+                i = nodes[i].right;
+            }
+        }
+        return candidate;
+    }
+
+    /*********************************************
+     * COMPACT TREE :: FIND
+     * The node with key k, or end()
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename CompactTree <K, T, KeyOf, Compare> ::iterator CompactTree <K, T, KeyOf, Compare> ::find(const K& k) const
+    {
+        uint32_t parent;
+        bool isLeft;
+        uint32_t candidate = descend(k, parent, isLeft);
+        if (candidate != nil && !compare(KeyOf()(nodes[candidate].data), k))
+            return iterator(this, candidate);
+        return end();
+    }
+
+    /*********************************************
+     * COMPACT TREE :: EMPLACE KEY
+     * Build an element from args at the end of the slab and
+     * link it where k belongs, unless k is already here
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    template <class ... Args>
+    std::pair<typename CompactTree <K, T, KeyOf, Compare> ::iterator, bool>
+    CompactTree <K, T, KeyOf, Compare> ::emplaceKey(const K& k, Args&& ... args)
+    {
+        uint32_t parent;
+        bool isLeft;
+        uint32_t candidate = descend(k, parent, isLeft);
+        if (candidate != nil && !compare(KeyOf()(nodes[candidate].data), k))
+            return std::pair<iterator, bool>(iterator(this, candidate), false);
+
+        if (nodes.size() >= nil)
+            throw std::length_error("compact tree is full");
+
+        uint32_t i = (uint32_t)nodes.size();
+        nodes.emplace_back(parent, std::forward<Args>(args)...);
+        if (parent == nil)
+            root = i;
+        else if (isLeft)
+            nodes[parent].left = i;
+        else
+            nodes[parent].right = i;
+        return std::pair<iterator, bool>(iterator(this, i), true);
+    }
+
+    /*********************************************
+     * COMPACT TREE :: REPLACE
+     * Put child, which may be nil, where i hangs
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    void CompactTree <K, T, KeyOf, Compare> ::replace(uint32_t i, uint32_t child)
+    {
+        uint32_t parent = parentOf(i);
+        if (parent == nil)
+            root = child;
+        else if (nodes[parent].left == i)
+            nodes[parent].left = child;
+        else
+            nodes[parent].right = child;
+        if (child != nil)
+            setParent(child, parent);
+    }
+
+    /*********************************************
+     * COMPACT TREE :: ERASE INDEX
+     * Unlink node i the way BST::erase does, then move the
+     * last node into its slot and shrink the slab. Return
+     * the node after i. If other was the last node, it now
+     * names the slot it moved to.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    uint32_t CompactTree <K, T, KeyOf, Compare> ::eraseIndex(uint32_t i, uint32_t& other)
+    {
+        uint32_t after = next(i);
+        Node& node = nodes[i];
+
+        // Unlink: a missing child is easy, otherwise the successor takes i's place
+        if (node.left == nil)
+            replace(i, node.right);
+        else if (node.right == nil)
+            replace(i, node.left);
+        else
+        {
+            uint32_t successor = after;
+            if (successor != node.right)
+            {
+                replace(successor, nodes[successor].right);
+                nodes[successor].right = node.right;
+                setParent(node.right, successor);
+            }
+            replace(i, successor);
+            nodes[successor].left = node.left;
+            setParent(node.left, successor);
+        }
+
+        // Fill the hole with the last node, pointing its neighbours at the new slot
+        uint32_t last = (uint32_t)nodes.size() - 1;
+        if (i != last)
+        {
+            nodes[i] = std::move(nodes[last]);
+            uint32_t parent = parentOf(i);
+            if (parent == nil)
+                root = i;
+            else if (nodes[parent].left == last)
+                nodes[parent].left = i;
+            else
+                nodes[parent].right = i;
+            if (nodes[i].left != nil)
+                setParent(nodes[i].left, i);
+            if (nodes[i].right != nil)
+                setParent(nodes[i].right, i);
+            if (after == last)
+                after = i;
+            if (other == last)
+                other = i;
+        }
+        nodes.pop_back();
+        return after;
+    }
+
+    /*********************************************
+     * COMPACT TREE :: ERASE
+     * Remove the element with key k
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    size_t CompactTree <K, T, KeyOf, Compare> ::erase(const K& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    /*********************************************
+     * COMPACT TREE :: ERASE
+     * Remove the element at it and return the one after it
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename CompactTree <K, T, KeyOf, Compare> ::iterator CompactTree <K, T, KeyOf, Compare> ::erase(const iterator& it)
+    {
+        if (it.index == nil)
+            return end();
+        uint32_t unused = nil;
+        return iterator(this, eraseIndex(it.index, unused));
+    }
+
+    /*********************************************
+     * COMPACT TREE :: ERASE
+     * Remove [first, last), following last as nodes move
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename CompactTree <K, T, KeyOf, Compare> ::iterator CompactTree <K, T, KeyOf, Compare> ::erase(iterator first, iterator last)
+    {
+        uint32_t i = first.index;
+        while (i != last.index)
+            i = eraseIndex(i, last.index);
+        return iterator(this, i);
+    }
+
+
+    /*****************************************************************
+     * COMPACT SET
+     * A set with the interface of custom::set, kept in a CompactTree
+     *****************************************************************/
+    template <typename T, class Compare = std::less<T>>
+    class compact_set
+    {
+        friend class ::TestCompactTree; // give unit tests access to the privates
+
+        struct KeyOf
+        {
+            const T& operator () (const T& t) const { return t; }
+        };
+    public:
+        using iterator = typename CompactTree <T, T, KeyOf, Compare> ::iterator;
+
+        //
+        // Construct
+        //
+        compact_set() {}
+        compact_set(const compact_set& rhs) : tree(rhs.tree) {}
+        compact_set(compact_set&& rhs) : tree(std::move(rhs.tree)) {}
+        compact_set(const std::initializer_list <T>& il) { insert(il); }
+        template <class Iterator>
+        compact_set(Iterator first, Iterator last) { insert(first, last); }
+        ~compact_set() {}
+
+        //
+        // Assign
+        //
+        compact_set& operator = (const compact_set& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        compact_set& operator = (compact_set&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        compact_set& operator = (const std::initializer_list <T>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(compact_set& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const { return tree.find(t); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+        //
+        // Insert
+        //
+        std::pair<iterator, bool> insert(const T& t) { return tree.insert(t); }
+        std::pair<iterator, bool> insert(T&& t)      { return tree.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il)
+        {
+            for (const T& t : il)
+                tree.insert(t);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+        void reserve(size_t n) { tree.reserve(n); }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        size_t erase(const T& t) { return tree.erase(t); }
+        iterator erase(const iterator& itBegin, const iterator& itEnd) { return tree.erase(itBegin, itEnd); }
+
+    private:
+        CompactTree <T, T, KeyOf, Compare> tree;
+    };
+
+
+    /*****************************************************************
+     * COMPACT MAP
+     * A map with the interface of custom::map, kept in a CompactTree
+     *****************************************************************/
+    template <typename K, typename V, class Compare = std::less<K>>
+    class compact_map
+    {
+        friend class ::TestCompactTree; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+    private:
+        struct KeyOf
+        {
+            const K& operator () (const Pairs& p) const { return p.first; }
+        };
+    public:
+        using iterator = typename CompactTree <K, Pairs, KeyOf, Compare> ::iterator;
+
+        //
+        // Construct
+        //
+        compact_map() {}
+        compact_map(const compact_map& rhs) : tree(rhs.tree) {}
+        compact_map(compact_map&& rhs) : tree(std::move(rhs.tree)) {}
+        template <class Iterator>
+        compact_map(Iterator first, Iterator last) { insert(first, last); }
+        compact_map(const std::initializer_list <Pairs>& il) { insert(il); }
+        ~compact_map() {}
+
+        //
+        // Assign
+        //
+        compact_map& operator = (const compact_map& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        compact_map& operator = (compact_map&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        compact_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(compact_map& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k)
+        {
+            return tree.value(tree.emplaceKey(k, k, V()).first).second;
+        }
+        const V& at(const K& k) const;
+              V& at(const K& k);
+        iterator find(const K& k) const { return tree.find(k); }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(rhs);
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        custom::pair<iterator, bool> insert(Pairs&& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(std::move(rhs));
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                tree.insert(element);
+        }
+        void reserve(size_t n) { tree.reserve(n); }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        size_t erase(const K& k) { return tree.erase(k); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        iterator erase(const iterator& first, const iterator& last) { return tree.erase(first, last); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+    private:
+        CompactTree <K, Pairs, KeyOf, Compare> tree;
+    };
+
+    /*****************************************************
+     * COMPACT MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, class Compare>
+    V& compact_map <K, V, Compare> ::at(const K& k)
+    {
+        iterator it = tree.find(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return tree.value(it).second;
+    }
+
+    /*****************************************************
+     * COMPACT MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, class Compare>
+    const V& compact_map <K, V, Compare> ::at(const K& k) const
+    {
+        iterator it = tree.find(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return (*it).second;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two compact sets or two compact maps
+     ****************************************************/
+    template <typename T, class Compare>
+    void swap(compact_set <T, Compare>& lhs, compact_set <T, Compare>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V, class Compare>
+    void swap(compact_map <K, V, Compare>& lhs, compact_map <K, V, Compare>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
@@ -0,0 +1,689 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT MAP
+ * Summary:
+ *    An ordered map that readers search without taking a lock while
+ *    a writer changes it
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        concurrent_map                   : A map with lock-free readers
+ *        concurrent_map::reader           : A pinned, consistent view of the map
+ *        concurrent_map::reader::iterator : An iterator through a view
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>           // for the root, the epoch, and the reader slots
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint64_t
+#include <functional>       // for std::hash
+#include <mutex>            // for the writer lock
+#include <stdexcept>        // for std::out_of_range
+#include <thread>           // for std::this_thread::get_id
+#include <utility>          // for std::move
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+#include "vector.h"         // for custom::vector
+
+class TestConcurrentMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * CONCURRENT MAP
+     * Read-copy-update over an AVL tree. Readers never lock and never
+     * write to a node: they load the root and search. A writer never
+     * changes a node a reader can see. It copies the path it changes,
+     * publishes the new root with one atomic store, and retires the
+     * nodes it replaced.
+     *
+     * A retired node is freed once every reader that might still be
+     * looking at it has finished. Each reader announces the epoch it
+     * started in, in one of a fixed set of slots. Each write moves
+     * the epoch on, and a node retired in epoch e is freed when no
+     * reader from epoch e or before is left.
+     *
+     * Writers take turns on a mutex but never wait for a reader.
+     * Values come back by copy, or through a reader that keeps its
+     * version alive for as long as it is held. A node could otherwise
+     * be freed under a bare reference.
+     *****************************************************************/
+    template <class K, class V>
+    class concurrent_map
+    {
+        friend class ::TestConcurrentMap; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+
+        //
+        // Construct
+        //
+        concurrent_map() : root(nullptr), epoch(1), numElements(0) {}
+        concurrent_map(const std::initializer_list <Pairs>& il) : concurrent_map()
+        {
+            for (const Pairs& element : il)
+                insert(element);
+        }
+        concurrent_map(const concurrent_map& rhs) = delete;
+        concurrent_map& operator = (const concurrent_map& rhs) = delete;
+        ~concurrent_map();
+
+        //
+        // Read: never blocks, never blocked
+        //
+        class reader;
+        reader read() const { return reader(*this); }
+        bool   contains(const K& k) const;
+        V      at(const K& k) const;
+        size_t size()  const noexcept { return numElements.load(std::memory_order_relaxed); }
+        bool   empty() const noexcept { return size() == 0; }
+
+        //
+        // Write: one writer at a time
+        //
+        bool   insert(const Pairs& rhs);
+        bool   insert(Pairs&& rhs);
+        bool   insert_or_assign(const K& k, const V& v);
+        size_t erase(const K& k);
+        void   clear();
+
+    private:
+
+        struct Node;
+        struct Retired
+        {
+            Node*    p;
+            uint64_t epoch;       // the epoch it was unlinked in
+        };
+
+        // one reader's announcement, alone on its cache line
+        struct alignas(64) Slot
+        {
+            Slot() : epoch(0) {}
+            std::atomic<uint64_t> epoch;   // 0 when no reader holds the slot
+        };
+        static const size_t numSlots = 64;
+
+        std::atomic<Node*>    root;           // the current version
+        std::atomic<uint64_t> epoch;          // moves on with every write
+        std::atomic<size_t>   numElements;    // size of the newest version
+        mutable Slot          slots[numSlots];
+        std::mutex            writer;         // held for the length of a write
+        custom::vector<Retired> retired;      // replaced nodes waiting on readers
+
+        size_t pin(uint64_t& e) const;
+        void   unpin(size_t slot) const { slots[slot].epoch.store(0, std::memory_order_release); }
+
+        // used only while holding the writer lock
+        Node* own(Node*& p);
+        void  retire(Node* p) { retired.push_back(Retired{ p, epoch.load(std::memory_order_relaxed) }); }
+        void  publish(Node* pRoot, size_t size);
+        void  reclaim();
+
+        static int    height(const Node* p) { return p ? p->height : 0; }
+        static size_t count(const Node* p)  { return p ? p->count : 0; }
+        static void update(Node* p);
+        void  rotateLeft(Node*& p);
+        void  rotateRight(Node*& p);
+        void  rebalance(Node*& p);
+        static const Node* findNode(const Node* p, const K& k);
+        template <class P>
+        void  insertNode(Node*& p, P&& element);
+        void  eraseNode(Node*& p, const K& k);
+        void  eraseMin(Node*& p, Pairs& min);
+        static void deleteTree(Node* p);
+    };
+
+    /*****************************************************************
+     * CONCURRENT MAP :: NODE
+     * An element and its children. Count is the size of the subtree,
+     * so a version knows its own size. Born is the epoch of the write
+     * that made it: a node born in this write has not been published,
+     * so the writer may still change it in place.
+     *****************************************************************/
+    template <class K, class V>
+    struct concurrent_map <K, V> ::Node
+    {
+        Node(const Pairs& data, uint64_t born) :
+            data(data), pLeft(nullptr), pRight(nullptr), height(1), count(1), born(born) {}
+        Node(Pairs&& data, uint64_t born) :
+            data(std::move(data)), pLeft(nullptr), pRight(nullptr), height(1), count(1), born(born) {}
+        Node(const Node& rhs, uint64_t born) :
+            data(rhs.data), pLeft(rhs.pLeft), pRight(rhs.pRight), height(rhs.height), count(rhs.count), born(born) {}
+
+        Pairs    data;
+        Node*    pLeft;
+        Node*    pRight;
+        int      height;
+        size_t   count;
+        uint64_t born;
+    };
+
+    /**********************************************************
+     * CONCURRENT MAP :: READER
+     * One version of the map, held still. While a reader is alive no
+     * node of its version is freed, so it can hand out references and
+     * iterators. Hold one only as long as needed: nodes retired while
+     * it is held pile up until it goes.
+     *********************************************************/
+    template <class K, class V>
+    class concurrent_map <K, V> ::reader
+    {
+        friend class ::TestConcurrentMap; // give unit tests access to the privates
+        friend class concurrent_map;
+    public:
+        class iterator;
+
+        reader(reader&& rhs) noexcept : pMap(rhs.pMap), slot(rhs.slot), pRoot(rhs.pRoot)
+        {
+            rhs.pMap = nullptr;
+        }
+        reader(const reader& rhs) = delete;
+        reader& operator = (const reader& rhs) = delete;
+        ~reader()
+        {
+            if (pMap)
+                pMap->unpin(slot);
+        }
+
+        iterator begin() const;
+        iterator end()   const { return iterator(pRoot, nullptr); }
+        iterator find(const K& k) const { return iterator(pRoot, findNode(pRoot, k)); }
+        const V& at(const K& k) const
+        {
+            const Node* p = findNode(pRoot, k);
+            if (!p)
+                throw std::out_of_range("invalid map<K, T> key");
+            return p->data.second;
+        }
+        size_t size()  const noexcept { return pRoot ? pRoot->count : 0; }
+        bool   empty() const noexcept { return pRoot == nullptr; }
+
+    private:
+        // pin first, then look: whatever root we see is safe until we unpin
+        reader(const concurrent_map& map) : pMap(&map)
+        {
+            uint64_t e;
+            slot = map.pin(e);
+            pRoot = map.root.load(std::memory_order_seq_cst);
+        }
+
+        const concurrent_map* pMap;    // whose slot we hold
+        size_t      slot;              // which slot
+        const Node* pRoot;             // the version we are reading
+    };
+
+    /**********************************************************
+     * CONCURRENT MAP :: READER :: ITERATOR
+     * In-order through one version. Old nodes are shared by new
+     * versions, so there are no parent pointers, and a step looks
+     * up its neighbor from the root.
+     *********************************************************/
+    template <class K, class V>
+    class concurrent_map <K, V> ::reader::iterator
+    {
+        friend class ::TestConcurrentMap; // give unit tests access to the privates
+    public:
+        iterator() : pRoot(nullptr), pNode(nullptr) {}
+        iterator(const Node* pRoot, const Node* pNode) : pRoot(pRoot), pNode(pNode) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode; }
+        bool operator != (const iterator& rhs) const { return pNode != rhs.pNode; }
+
+        const Pairs& operator * () const { return pNode->data; }
+        const Pairs* operator -> () const { return &pNode->data; }
+
+        // the smallest key above ours
+        iterator& operator ++ ()
+        {
+            const Node* pNext = nullptr;
+            for (const Node* p = pRoot; p; )
+                if (pNode->data.first < p->data.first)
+                {
+                    pNext = p;
+                    p = p->pLeft;
+                }
+                else
+                    p = p->pRight;
+            pNode = pNext;
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+    private:
+        const Node* pRoot;         // the version we are walking
+        const Node* pNode;         // where we are, nullptr at the end
+    };
+
+
+    /*********************************************
+     * CONCURRENT MAP :: DESTRUCTOR
+     * No reader may outlive the map
+     ********************************************/
+    template <class K, class V>
+    concurrent_map <K, V> :: ~concurrent_map()
+    {
+        deleteTree(root.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < retired.size(); i++)
+            delete retired[i].p;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: PIN
+     * Claim a free slot and announce the current epoch in it. Each
+     * thread starts looking at its own place, so readers on different
+     * threads rarely touch the same cache line.
+     ********************************************/
+    template <class K, class V>
+    size_t concurrent_map <K, V> ::pin(uint64_t& e) const
+    {
+        size_t i = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (;; i++)
+        {
+            Slot& slot = slots[i % numSlots];
+            uint64_t free = 0;
+            e = epoch.load(std::memory_order_seq_cst);
+            if (slot.epoch.load(std::memory_order_relaxed) == 0 &&
+                slot.epoch.compare_exchange_strong(free, e, std::memory_order_seq_cst))
+                return i % numSlots;
+            if (i % numSlots == numSlots - 1)
+                std::this_thread::yield();   // every slot is taken
+        }
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: CONTAINS
+     ********************************************/
+    template <class K, class V>
+    bool concurrent_map <K, V> ::contains(const K& k) const
+    {
+        reader view(*this);
+        return findNode(view.pRoot, k) != nullptr;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: AT
+     * A copy of the value, since the node may be freed once we leave
+     ********************************************/
+    template <class K, class V>
+    V concurrent_map <K, V> ::at(const K& k) const
+    {
+        reader view(*this);
+        return view.at(k);
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: INSERT
+     * Nothing is copied if the key is already there
+     ********************************************/
+    template <class K, class V>
+    bool concurrent_map <K, V> ::insert(const Pairs& rhs)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        Node* pRoot = root.load(std::memory_order_relaxed);
+        if (findNode(pRoot, rhs.first))
+            return false;
+        insertNode(pRoot, rhs);
+        publish(pRoot, numElements.load(std::memory_order_relaxed) + 1);
+        return true;
+    }
+    template <class K, class V>
+    bool concurrent_map <K, V> ::insert(Pairs&& rhs)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        Node* pRoot = root.load(std::memory_order_relaxed);
+        if (findNode(pRoot, rhs.first))
+            return false;
+        insertNode(pRoot, std::move(rhs));
+        publish(pRoot, numElements.load(std::memory_order_relaxed) + 1);
+        return true;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: INSERT OR ASSIGN
+     * Stands in for the subscript, which cannot hand out a reference
+     * to a node a later write might free. True if k was new.
+     ********************************************/
+    template <class K, class V>
+    bool concurrent_map <K, V> ::insert_or_assign(const K& k, const V& v)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        Node* pRoot = root.load(std::memory_order_relaxed);
+        if (!findNode(pRoot, k))
+        {
+            insertNode(pRoot, Pairs(k, v));
+            publish(pRoot, numElements.load(std::memory_order_relaxed) + 1);
+            return true;
+        }
+
+        // copy the path down to k, then change the copy
+        Node** pp = &pRoot;
+        while (true)
+        {
+            Node* p = own(*pp);
+            if (k < p->data.first)
+                pp = &p->pLeft;
+            else if (p->data.first < k)
+                pp = &p->pRight;
+            else
+            {
+                p->data.second = v;
+                break;
+            }
+        }
+        publish(pRoot, numElements.load(std::memory_order_relaxed));
+        return false;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: ERASE
+     * Nothing is copied if the key is not there
+     ********************************************/
+    template <class K, class V>
+    size_t concurrent_map <K, V> ::erase(const K& k)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        Node* pRoot = root.load(std::memory_order_relaxed);
+        if (!findNode(pRoot, k))
+            return 0;
+        eraseNode(pRoot, k);
+        publish(pRoot, numElements.load(std::memory_order_relaxed) - 1);
+        return 1;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: CLEAR
+     * The whole tree is retired at once
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::clear()
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        custom::vector<Node*> pending;
+        if (Node* p = root.load(std::memory_order_relaxed))
+            pending.push_back(p);
+        while (!pending.empty())
+        {
+            Node* p = pending.back();
+            pending.pop_back();
+            if (p->pLeft)
+                pending.push_back(p->pLeft);
+            if (p->pRight)
+                pending.push_back(p->pRight);
+            retire(p);
+        }
+        publish(nullptr, 0);
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: PUBLISH
+     * Make the new version the current one, move the epoch on, and
+     * free what no reader can still see
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::publish(Node* pRoot, size_t size)
+    {
+        root.store(pRoot, std::memory_order_seq_cst);
+        numElements.store(size, std::memory_order_relaxed);
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        reclaim();
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: RECLAIM
+     * A node retired in epoch e was unlinked before the epoch moved
+     * past e. A reader that announced a later epoch loaded the root
+     * after that, so it cannot reach the node. Only readers at e or
+     * before hold it up.
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::reclaim()
+    {
+        uint64_t oldest = epoch.load(std::memory_order_seq_cst);
+        for (size_t i = 0; i < numSlots; i++)
+        {
+            uint64_t e = slots[i].epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < oldest)
+                oldest = e;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++)
+            if (retired[i].epoch < oldest)
+                delete retired[i].p;
+            else
+                retired[kept++] = retired[i];
+        while (retired.size() > kept)
+            retired.pop_back();
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: OWN
+     * Make p safe to change: a node born in this write already is,
+     * any other may be in a reader's hands, so it is replaced with a
+     * copy and retired
+     ********************************************/
+    template <class K, class V>
+    typename concurrent_map <K, V> ::Node* concurrent_map <K, V> ::own(Node*& p)
+    {
+        uint64_t now = epoch.load(std::memory_order_relaxed);
+        if (p->born != now)
+        {
+            Node* pCopy = new Node(*p, now);
+            retire(p);
+            p = pCopy;
+        }
+        return p;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: UPDATE
+     * Height and count from the children
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::update(Node* p)
+    {
+        int hLeft = height(p->pLeft);
+        int hRight = height(p->pRight);
+        p->height = 1 + (hLeft > hRight ? hLeft : hRight);
+        p->count = 1 + count(p->pLeft) + count(p->pRight);
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: ROTATE LEFT
+     * The right child of an owned node takes its place
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::rotateLeft(Node*& p)
+    {
+        Node* pRight = own(p->pRight);
+        p->pRight = pRight->pLeft;
+        pRight->pLeft = p;
+        update(p);
+        update(pRight);
+        p = pRight;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: ROTATE RIGHT
+     * The left child of an owned node takes its place
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::rotateRight(Node*& p)
+    {
+        Node* pLeft = own(p->pLeft);
+        p->pLeft = pLeft->pRight;
+        pLeft->pRight = p;
+        update(p);
+        update(pLeft);
+        p = pLeft;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: REBALANCE
+     * Restore the AVL property at an owned node
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::rebalance(Node*& p)
+    {
+        update(p);
+        int balance = height(p->pLeft) - height(p->pRight);
+        if (balance > 1)
+        {
+            if (height(p->pLeft->pLeft) < height(p->pLeft->pRight))
+            {
+                own(p->pLeft);
+                rotateLeft(p->pLeft);
+            }
+            rotateRight(p);
+        }
+        else if (balance < -1)
+        {
+            if (height(p->pRight->pRight) < height(p->pRight->pLeft))
+            {
+                own(p->pRight);
+                rotateRight(p->pRight);
+            }
+            rotateLeft(p);
+        }
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: FIND NODE
+     ********************************************/
+    template <class K, class V>
+    const typename concurrent_map <K, V> ::Node* concurrent_map <K, V> ::findNode(const Node* p, const K& k)
+    {
+        while (p)
+        {
+            if (k < p->data.first)
+                p = p->pLeft;
+            else if (p->data.first < k)
+                p = p->pRight;
+            else
+                return p;
+        }
+        return nullptr;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: INSERT NODE
+     * Add an element whose key is not in the subtree
+     ********************************************/
+    template <class K, class V>
+    template <class P>
+    void concurrent_map <K, V> ::insertNode(Node*& p, P&& element)
+    {
+        if (!p)
+        {
+            p = new Node(std::forward<P>(element), epoch.load(std::memory_order_relaxed));
+            return;
+        }
+
+        own(p);
+        if (element.first < p->data.first)
+            insertNode(p->pLeft, std::forward<P>(element));
+        else
+            insertNode(p->pRight, std::forward<P>(element));
+        rebalance(p);
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: ERASE NODE
+     * Remove the key, which is known to be in the subtree
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::eraseNode(Node*& p, const K& k)
+    {
+        bool found = !(k < p->data.first) && !(p->data.first < k);
+
+        // one child or none: the child takes this one's place
+        if (found && !(p->pLeft && p->pRight))
+        {
+            Node* pChild = p->pLeft ? p->pLeft : p->pRight;
+            if (p->born == epoch.load(std::memory_order_relaxed))
+                delete p;         // never published, nobody else has seen it
+            else
+                retire(p);
+            p = pChild;
+            return;
+        }
+
+        own(p);
+        if (found)
+            // two children: the next element up takes this one's place
+            eraseMin(p->pRight, p->data);
+        else if (k < p->data.first)
+            eraseNode(p->pLeft, k);
+        else
+            eraseNode(p->pRight, k);
+        rebalance(p);
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: ERASE MIN
+     * Remove the smallest element of a subtree, copying it to min
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::eraseMin(Node*& p, Pairs& min)
+    {
+        if (p->pLeft)
+        {
+            own(p);
+            eraseMin(p->pLeft, min);
+            rebalance(p);
+            return;
+        }
+
+        // a reader may still be looking at it, so copy rather than move
+        min = p->data;
+        Node* pRight = p->pRight;
+        if (p->born == epoch.load(std::memory_order_relaxed))
+            delete p;
+        else
+            retire(p);
+        p = pRight;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: DELETE TREE
+     * Free every node of a version nobody can see any more
+     ********************************************/
+    template <class K, class V>
+    void concurrent_map <K, V> ::deleteTree(Node* p)
+    {
+        if (!p)
+            return;
+        deleteTree(p->pLeft);
+        deleteTree(p->pRight);
+        delete p;
+    }
+
+    /*********************************************
+     * CONCURRENT MAP :: READER :: BEGIN
+     ********************************************/
+    template <class K, class V>
+    typename concurrent_map <K, V> ::reader::iterator concurrent_map <K, V> ::reader::begin() const
+    {
+        const Node* p = pRoot;
+        while (p && p->pLeft)
+            p = p->pLeft;
+        return iterator(pRoot, p);
+    }
+
+}; // namespace custom
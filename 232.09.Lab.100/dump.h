@@ -0,0 +1,195 @@
+/***********************************************************************
+ * Header:
+ *    DUMP
+ * Summary:
+ *    Write every element of a container to a stream, formatted into
+ *    a buffer first so the stream sees a few large writes instead of
+ *    one small one per element
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the definition of:
+ *        dump_buffer         : Formats values into a buffer for a stream
+ *        dump                : Write a container or a range to a stream
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <charconv>     // for std::to_chars
+#include <cstring>      // for memcpy, strlen
+#include <ostream>
+#include <string>
+#include <type_traits>  // for std::is_arithmetic, std::enable_if
+
+class TestDump;         // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * DUMP RANK
+     * Picks among the put() overloads: the more specific ones take
+     * a higher rank, so they are tried first
+     *****************************************************************/
+    template <int N> struct dump_rank : dump_rank<N - 1> {};
+    template <> struct dump_rank<0> {};
+
+    /*****************************************************************
+     * DUMP BUFFER
+     * Numbers are formatted with std::to_chars straight into the
+     * buffer, with no locale and no stream state. They come out the
+     * same as a stream with its default settings would write them.
+     * Pairs come out as (first, second), like pair's operator <<.
+     * Anything else goes to the stream's own operator <<.
+     *****************************************************************/
+    class dump_buffer
+    {
+        friend class ::TestDump; // give unit tests access to the privates
+    public:
+        explicit dump_buffer(std::ostream& out, size_t capacity = 65536) :
+            out(out), pBuffer(new char[capacity < 64 ? 64 : capacity]),
+            capacity(capacity < 64 ? 64 : capacity), used(0) {}
+        dump_buffer(const dump_buffer& rhs) = delete;
+        dump_buffer& operator = (const dump_buffer& rhs) = delete;
+        ~dump_buffer()
+        {
+            flush();
+            delete[] pBuffer;
+        }
+
+        template <class T>
+        dump_buffer& operator << (const T& t)
+        {
+            put(t, dump_rank<2>());
+            return *this;
+        }
+
+        // hand what we have to the stream
+        void flush()
+        {
+            if (used)
+                out.write(pBuffer, used);
+            used = 0;
+        }
+
+    private:
+        // the longest a number can be: a double in general format
+        static const size_t maxNumber = 32;
+
+        void reserve(size_t n)
+        {
+            if (used + n > capacity)
+                flush();
+        }
+
+        void write(const char* p, size_t n)
+        {
+            if (n > capacity)
+            {
+                flush();
+                out.write(p, n);
+                return;
+            }
+            reserve(n);
+            memcpy(pBuffer + used, p, n);
+            used += n;
+        }
+
+        // integers and floating point
+        template <class T>
+        typename std::enable_if<std::is_arithmetic<T>::value>::type put(const T& t, dump_rank<2>)
+        {
+            reserve(maxNumber);
+            char* pEnd = toChars(pBuffer + used, pBuffer + capacity, t);
+            used = pEnd - pBuffer;
+        }
+
+        // text
+        void put(const std::string& s, dump_rank<2>) { write(s.data(), s.size()); }
+        void put(const char* s, dump_rank<2>)        { write(s, strlen(s)); }
+
+        // pairs, both ours and std::pair
+        template <class P>
+        auto put(const P& p, dump_rank<1>) -> decltype(p.first, p.second, void())
+        {
+            write("(", 1);
+            *this << p.first;
+            write(", ", 2);
+            *this << p.second;
+            write(")", 1);
+        }
+
+        // everything else, through the stream
+        template <class T>
+        void put(const T& t, dump_rank<0>)
+        {
+            flush();
+            out << t;
+        }
+
+        // a stream writes char as a character and bool as 0 or 1
+        static char* toChars(char* p, char*, char c) { *p = c; return p + 1; }
+        static char* toChars(char* p, char*, signed char c) { *p = c; return p + 1; }
+        static char* toChars(char* p, char*, unsigned char c) { *p = c; return p + 1; }
+        static char* toChars(char* p, char*, bool b) { *p = b ? '1' : '0'; return p + 1; }
+
+        // a stream writes floating point with 6 significant digits
+        static char* toChars(char* p, char* pEnd, float f)
+        {
+            return std::to_chars(p, pEnd, f, std::chars_format::general, 6).ptr;
+        }
+        static char* toChars(char* p, char* pEnd, double d)
+        {
+            return std::to_chars(p, pEnd, d, std::chars_format::general, 6).ptr;
+        }
+        static char* toChars(char* p, char* pEnd, long double d)
+        {
+            return std::to_chars(p, pEnd, d, std::chars_format::general, 6).ptr;
+        }
+
+        template <class T>
+        static char* toChars(char* p, char* pEnd, T t)
+        {
+            return std::to_chars(p, pEnd, t).ptr;
+        }
+
+        std::ostream& out;
+        char*  pBuffer;
+        size_t capacity;
+        size_t used;        // bytes formatted but not yet written
+    };
+
+    /*****************************************************
+     * DUMP
+     * Every element from first up to last, each followed
+     * by a space
+     ****************************************************/
+    template <class Iterator>
+    inline std::ostream& dump(std::ostream& out, Iterator first, Iterator last)
+    {
+        {
+            dump_buffer buffer(out);
+            for (; first != last; ++first)
+                buffer << *first << ' ';
+        }
+        return out;
+    }
+
+    /*****************************************************
+     * DUMP
+     * Every element of a list, vector, set, or map, in
+     * the order its iterator visits them
+     ****************************************************/
+    template <class Container>
+    inline std::ostream& dump(std::ostream& out, Container&& container)
+    {
+        return dump(out, container.begin(), container.end());
+    }
+
+}; // namespace custom
@@ -0,0 +1,763 @@
+/***********************************************************************
+ * Header:
+ *    FLAT MAP
+ * Summary:
+ *    A set and a map kept in one sorted vector, for tables that are
+ *    built once and then mostly read
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        flat_layout          : sorted order or Eytzinger (BFS) order
+ *        FlatTable            : the elements in a vector, in one of the layouts
+ *        FlatTable::iterator  : An in-order iterator through a FlatTable
+ *        flat_set             : A set with the same interface as custom::set
+ *        flat_map             : A map with the same interface as custom::map
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <algorithm>        // for std::stable_sort
+#include <stdexcept>        // for std::out_of_range
+#include <utility>          // for std::pair, std::move
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+#include "vector.h"         // for custom::vector
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define CUSTOM_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define CUSTOM_PREFETCH(p) __builtin_prefetch(p)
+#endif
+
+class TestFlatMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * FLAT LAYOUT
+     * How a FlatTable orders its vector. Sorted is a plain sorted
+     * array searched by halving. Eytzinger stores the implicit binary
+     * search tree level by level: the root first, then its children,
+     * and so on. The next few levels of a search are then next to each
+     * other in memory and can be prefetched while this one is compared.
+     *****************************************************************/
+    enum class flat_layout { sorted, eytzinger };
+
+    /*****************************************************************
+     * FLAT TABLE
+     * Every element in one contiguous vector, unique by key. Lookup is
+     * O(log n) with no pointers to chase. An insert or erase moves up
+     * to n elements, so build in bulk through the range constructor or
+     * the range insert.
+     *
+     * KeyOf pulls the key out of an element: the element itself for a
+     * set, .first for a map.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    class FlatTable
+    {
+        friend class ::TestFlatMap; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        FlatTable() {}
+        template <class Iterator>
+        FlatTable(Iterator first, Iterator last) { insert(first, last); }
+
+        void swap(FlatTable& rhs) noexcept { elements.swap(rhs.elements); }
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() const noexcept;
+        iterator end()   const noexcept;
+
+        //
+        // Access
+        //
+
+        iterator find(const K& k) const;
+        iterator lower_bound(const K& k) const;
+        T& value(const iterator& it) const { return it.base[it.slot()]; }
+
+        //
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t) { return emplaceKey(KeyOf()(t), t); }
+        std::pair<iterator, bool> insert(T&& t)
+        {
+            const K& k = KeyOf()(t);
+            return emplaceKey(k, std::move(t));
+        }
+        template <class ... Args>
+        std::pair<iterator, bool> emplaceKey(const K& k, Args&& ... args);
+        template <class Iterator>
+        void insert(Iterator first, Iterator last);
+
+        //
+        // Remove
+        //
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(const iterator& first, const iterator& last);
+        void     clear() noexcept { elements.clear(); }
+
+        //
+        // Status
+        //
+
+        bool   empty() const noexcept { return elements.empty(); }
+        size_t size()  const noexcept { return elements.size(); }
+
+    private:
+
+        custom::vector<T> elements;
+
+        T* base() const { return elements.empty() ? nullptr : const_cast<T*>(&elements[0]); }
+
+        size_t sortedLowerBound(const K& k) const;
+        size_t eytzingerLowerBound(const K& k) const;
+        size_t rank(const iterator& it) const;
+        size_t nodeOf(size_t i) const;
+        void   eraseSorted(size_t first, size_t last);
+        void   toSorted();
+        void   toEytzinger();
+
+        // in-order neighbors in a 1-based Eytzinger tree of n nodes, 0 past either end
+        static size_t leftmost(size_t k, size_t n)
+        {
+            while (2 * k <= n)
+                k = 2 * k;
+            return k;
+        }
+        static size_t rightmost(size_t k, size_t n)
+        {
+            while (2 * k + 1 <= n)
+                k = 2 * k + 1;
+            return k;
+        }
+        static size_t next(size_t k, size_t n)
+        {
+            if (2 * k + 1 <= n)
+                return leftmost(2 * k + 1, n);
+            while (k & 1)       // climb while we are a right child
+                k >>= 1;
+            return k >> 1;
+        }
+        static size_t prev(size_t k, size_t n)
+        {
+            if (2 * k <= n)
+                return rightmost(2 * k, n);
+            while (k > 1 && !(k & 1))  // climb while we are a left child
+                k >>= 1;
+            return k >> 1;
+        }
+    };
+
+    /**********************************************************
+     * FLAT TABLE ITERATOR
+     * Visits the elements in key order whatever the layout. In
+     * sorted order pos is the index and the end is size(). In
+     * Eytzinger order pos is the 1-based tree node and the end
+     * is 0. Any insert or erase invalidates every iterator.
+     *********************************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    class FlatTable <K, T, KeyOf, L> ::iterator
+    {
+        friend class ::TestFlatMap; // give unit tests access to the privates
+        friend class FlatTable;
+    public:
+        iterator() : base(nullptr), n(0), pos(0) {}
+        iterator(T* base, size_t n, size_t pos) : base(base), n(n), pos(pos) {}
+
+        bool operator == (const iterator& rhs) const { return pos == rhs.pos && base == rhs.base; }
+        bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+        const T& operator * () const { return base[slot()]; }
+        const T* operator -> () const { return base + slot(); }
+
+        iterator& operator ++ ()
+        {
+            pos = (L == flat_layout::sorted) ? pos + 1 : FlatTable::next(pos, n);
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+        iterator& operator -- ()
+        {
+            if (L == flat_layout::sorted)
+                pos--;
+            else
+                pos = (pos == 0) ? FlatTable::rightmost(1, n) : FlatTable::prev(pos, n);
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        size_t slot() const { return (L == flat_layout::sorted) ? pos : pos - 1; }
+
+        T*     base;               // the first element of the table
+        size_t n;                  // number of elements in the table
+        size_t pos;                // where we are, in the layout's terms
+    };
+
+
+    /*********************************************
+     * FLAT TABLE :: BEGIN
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::begin() const noexcept
+    {
+        size_t n = elements.size();
+        if (L == flat_layout::sorted || n == 0)
+            return iterator(base(), n, 0);
+        return iterator(base(), n, leftmost(1, n));
+    }
+
+    /*********************************************
+     * FLAT TABLE :: END
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::end() const noexcept
+    {
+        size_t n = elements.size();
+        return iterator(base(), n, L == flat_layout::sorted ? n : 0);
+    }
+
+    /*********************************************
+     * FLAT TABLE :: SORTED LOWER BOUND
+     * Index of the first element not below k. Each step halves the
+     * range with a conditional move rather than a branch.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    size_t FlatTable <K, T, KeyOf, L> ::sortedLowerBound(const K& k) const
+    {
+        size_t n = elements.size();
+        if (n == 0)
+            return 0;
+        const T* first = base();
+        const T* p = first;
+        while (n > 1)
+        {
+            size_t half = n / 2;
+            p = (KeyOf()(p[half]) < k) ? p + half : p;
+            n -= half;
+        }
+        return (p - first) + (KeyOf()(*p) < k ? 1 : 0);
+    }
+
+    /*********************************************
+     * FLAT TABLE :: EYTZINGER LOWER BOUND
+     * Node of the first element not below k, or 0. The descent goes
+     * left or right by arithmetic, never by a branch, and fetches the
+     * node four levels down (the sixteen at 16k) while this one is
+     * compared. The answer is the last node where we went left, found
+     * by dropping the trailing right turns and then one more.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    size_t FlatTable <K, T, KeyOf, L> ::eytzingerLowerBound(const K& k) const
+    {
+        size_t n = elements.size();
+        const T* p = base();
+        size_t node = 1;
+        while (node <= n)
+        {
+            CUSTOM_PREFETCH(p + 16 * node - 1);
+            node = 2 * node + (KeyOf()(p[node - 1]) < k ? 1 : 0);
+        }
+        while (node & 1)
+            node >>= 1;
+        return node >> 1;
+    }
+
+    /*********************************************
+     * FLAT TABLE :: LOWER BOUND
+     * The first element not below k
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::lower_bound(const K& k) const
+    {
+        if (L == flat_layout::sorted)
+            return iterator(base(), elements.size(), sortedLowerBound(k));
+        return iterator(base(), elements.size(), eytzingerLowerBound(k));
+    }
+
+    /*********************************************
+     * FLAT TABLE :: FIND
+     * The element with key k, or end()
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::find(const K& k) const
+    {
+        iterator it = lower_bound(k);
+        if (it == end() || k < KeyOf()(*it))
+            return end();
+        return it;
+    }
+
+    /*********************************************
+     * FLAT TABLE :: EMPLACE KEY
+     * Make an element from args, but only if k is not already there.
+     * The elements after it each move up one.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    template <class ... Args>
+    std::pair<typename FlatTable <K, T, KeyOf, L> ::iterator, bool>
+        FlatTable <K, T, KeyOf, L> ::emplaceKey(const K& k, Args&& ... args)
+    {
+        iterator it = lower_bound(k);
+        if (it != end() && !(k < KeyOf()(*it)))
+            return std::pair<iterator, bool>(it, false);
+
+        // an Eytzinger table is put in order, changed, and laid out again
+        size_t i = it.pos;
+        if (L == flat_layout::eytzinger)
+        {
+            toSorted();
+            i = sortedLowerBound(k);
+        }
+        elements.emplace_back(std::forward<Args>(args)...);
+        for (size_t j = elements.size() - 1; j > i; j--)
+            std::swap(elements[j], elements[j - 1]);
+
+        if (L == flat_layout::sorted)
+            return std::pair<iterator, bool>(iterator(base(), elements.size(), i), true);
+
+        toEytzinger();
+        return std::pair<iterator, bool>(iterator(base(), elements.size(), nodeOf(i)), true);
+    }
+
+    /*********************************************
+     * FLAT TABLE :: INSERT
+     * Bulk insert: append everything, then sort once. The sort is
+     * stable so, as with one at a time, a key already in the table
+     * keeps its element, and the first of a repeated key wins.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    template <class Iterator>
+    void FlatTable <K, T, KeyOf, L> ::insert(Iterator first, Iterator last)
+    {
+        if (L == flat_layout::eytzinger)
+            toSorted();
+
+        for (Iterator it = first; it != last; ++it)
+            elements.push_back(*it);
+
+        size_t n = elements.size();
+        if (n > 1)
+        {
+            T* p = base();
+            std::stable_sort(p, p + n, [](const T& lhs, const T& rhs)
+                             { return KeyOf()(lhs) < KeyOf()(rhs); });
+
+            // keep the first of each run of equal keys
+            size_t kept = 1;
+            for (size_t i = 1; i < n; i++)
+                if (KeyOf()(p[kept - 1]) < KeyOf()(p[i]))
+                {
+                    if (kept != i)
+                        p[kept] = std::move(p[i]);
+                    kept++;
+                }
+            while (elements.size() > kept)
+                elements.pop_back();
+        }
+
+        if (L == flat_layout::eytzinger)
+            toEytzinger();
+    }
+
+    /*********************************************
+     * FLAT TABLE :: ERASE
+     * Remove the element with key k
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    size_t FlatTable <K, T, KeyOf, L> ::erase(const K& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    /*********************************************
+     * FLAT TABLE :: ERASE
+     * Remove the element at it and return the one after it
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::erase(const iterator& it)
+    {
+        iterator itNext = it;
+        return erase(it, ++itNext);
+    }
+
+    /*********************************************
+     * FLAT TABLE :: ERASE
+     * Remove [first, last) and return what last now is
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    typename FlatTable <K, T, KeyOf, L> ::iterator FlatTable <K, T, KeyOf, L> ::erase(const iterator& first, const iterator& last)
+    {
+        size_t iFirst = rank(first);
+        size_t iLast = rank(last);
+        if (iFirst == iLast)
+            return first;
+
+        if (L == flat_layout::sorted)
+        {
+            eraseSorted(iFirst, iLast);
+            return iterator(base(), elements.size(), iFirst);
+        }
+
+        toSorted();
+        eraseSorted(iFirst, iLast);
+        toEytzinger();
+        return iterator(base(), elements.size(), nodeOf(iFirst));
+    }
+
+    /*********************************************
+     * FLAT TABLE :: RANK
+     * How many elements come before it. In Eytzinger order that
+     * means walking the tree, which is no worse than the O(n) move
+     * an erase does anyway.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    size_t FlatTable <K, T, KeyOf, L> ::rank(const iterator& it) const
+    {
+        if (L == flat_layout::sorted)
+            return it.pos;
+        size_t n = elements.size();
+        size_t i = 0;
+        for (size_t node = n ? leftmost(1, n) : 0; node != it.pos; node = next(node, n))
+            i++;
+        return i;
+    }
+
+    /*********************************************
+     * FLAT TABLE :: NODE OF
+     * The Eytzinger node holding the element of rank i, or 0 for
+     * one past the last
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    size_t FlatTable <K, T, KeyOf, L> ::nodeOf(size_t i) const
+    {
+        size_t n = elements.size();
+        if (i >= n)
+            return 0;
+        size_t node = leftmost(1, n);
+        while (i--)
+            node = next(node, n);
+        return node;
+    }
+
+    /*********************************************
+     * FLAT TABLE :: ERASE SORTED
+     * Remove [first, last) from a table in sorted order
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    void FlatTable <K, T, KeyOf, L> ::eraseSorted(size_t first, size_t last)
+    {
+        size_t n = elements.size();
+        for (size_t i = last; i < n; i++)
+            elements[first + i - last] = std::move(elements[i]);
+        for (size_t i = first + n - last; i < n; i++)
+            elements.pop_back();
+    }
+
+    /*********************************************
+     * FLAT TABLE :: TO SORTED
+     * Put an Eytzinger table back in key order
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    void FlatTable <K, T, KeyOf, L> ::toSorted()
+    {
+        size_t n = elements.size();
+        custom::vector<T> sorted;
+        sorted.reserve(n);
+        for (size_t node = n ? leftmost(1, n) : 0; node; node = next(node, n))
+            sorted.push_back(std::move(elements[node - 1]));
+        elements.swap(sorted);
+    }
+
+    /*********************************************
+     * FLAT TABLE :: TO EYTZINGER
+     * Lay a sorted table out level by level. Walking the tree in order
+     * visits the nodes in the order of the sorted elements, so that
+     * walk says which element each node gets.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, flat_layout L>
+    void FlatTable <K, T, KeyOf, L> ::toEytzinger()
+    {
+        size_t n = elements.size();
+        custom::vector<size_t> source(n);
+        size_t i = 0;
+        for (size_t node = n ? leftmost(1, n) : 0; node; node = next(node, n))
+            source[node - 1] = i++;
+
+        custom::vector<T> tree;
+        tree.reserve(n);
+        for (size_t node = 0; node < n; node++)
+            tree.push_back(std::move(elements[source[node]]));
+        elements.swap(tree);
+    }
+
+
+    /*****************************************************************
+     * FLAT SET
+     * A set with the interface of custom::set, kept in a FlatTable
+     *****************************************************************/
+    template <typename T, flat_layout L = flat_layout::sorted>
+    class flat_set
+    {
+        friend class ::TestFlatMap; // give unit tests access to the privates
+
+        struct KeyOf
+        {
+            const T& operator () (const T& t) const { return t; }
+        };
+    public:
+        using iterator = typename FlatTable <T, T, KeyOf, L> ::iterator;
+
+        //
+        // Construct
+        //
+        flat_set() {}
+        flat_set(const flat_set& rhs) : table(rhs.table) {}
+        flat_set(flat_set&& rhs) : table(std::move(rhs.table)) {}
+        flat_set(const std::initializer_list <T>& il) : table(il.begin(), il.end()) {}
+        template <class Iterator>
+        flat_set(Iterator first, Iterator last) : table(first, last) {}
+        ~flat_set() {}
+
+        //
+        // Assign
+        //
+        flat_set& operator = (const flat_set& rhs)
+        {
+            table = rhs.table;
+            return *this;
+        }
+        flat_set& operator = (flat_set&& rhs)
+        {
+            table = std::move(rhs.table);
+            return *this;
+        }
+        flat_set& operator = (const std::initializer_list <T>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(flat_set& rhs) noexcept { table.swap(rhs.table); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return table.begin(); }
+        iterator end()   const noexcept { return table.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const { return table.find(t); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return table.empty(); }
+        size_t size()  const noexcept { return table.size();  }
+
+        //
+        // Insert
+        //
+        std::pair<iterator, bool> insert(const T& t) { return table.insert(t); }
+        std::pair<iterator, bool> insert(T&& t)      { return table.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il) { table.insert(il.begin(), il.end()); }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last) { table.insert(first, last); }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { table.clear(); }
+        iterator erase(const iterator& it) { return table.erase(it); }
+        size_t erase(const T& t) { return table.erase(t); }
+        iterator erase(const iterator& itBegin, const iterator& itEnd) { return table.erase(itBegin, itEnd); }
+
+    private:
+        FlatTable <T, T, KeyOf, L> table;
+    };
+
+
+    /*****************************************************************
+     * FLAT MAP
+     * A map with the interface of custom::map, kept in a FlatTable
+     *****************************************************************/
+    template <typename K, typename V, flat_layout L = flat_layout::sorted>
+    class flat_map
+    {
+        friend class ::TestFlatMap; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+    private:
+        struct KeyOf
+        {
+            const K& operator () (const Pairs& p) const { return p.first; }
+        };
+    public:
+        using iterator = typename FlatTable <K, Pairs, KeyOf, L> ::iterator;
+
+        //
+        // Construct
+        //
+        flat_map() {}
+        flat_map(const flat_map& rhs) : table(rhs.table) {}
+        flat_map(flat_map&& rhs) : table(std::move(rhs.table)) {}
+        template <class Iterator>
+        flat_map(Iterator first, Iterator last) : table(first, last) {}
+        flat_map(const std::initializer_list <Pairs>& il) : table(il.begin(), il.end()) {}
+        ~flat_map() {}
+
+        //
+        // Assign
+        //
+        flat_map& operator = (const flat_map& rhs)
+        {
+            table = rhs.table;
+            return *this;
+        }
+        flat_map& operator = (flat_map&& rhs)
+        {
+            table = std::move(rhs.table);
+            return *this;
+        }
+        flat_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(flat_map& rhs) noexcept { table.swap(rhs.table); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return table.begin(); }
+        iterator end()   const noexcept { return table.end();   }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k)
+        {
+            return table.value(table.emplaceKey(k, k, V()).first).second;
+        }
+        const V& at(const K& k) const;
+              V& at(const K& k);
+        iterator find(const K& k) const { return table.find(k); }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs)
+        {
+            std::pair<iterator, bool> result = table.insert(rhs);
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        custom::pair<iterator, bool> insert(Pairs&& rhs)
+        {
+            std::pair<iterator, bool> result = table.insert(std::move(rhs));
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last) { table.insert(first, last); }
+        void insert(const std::initializer_list <Pairs>& il) { table.insert(il.begin(), il.end()); }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { table.clear(); }
+        size_t erase(const K& k) { return table.erase(k); }
+        iterator erase(const iterator& it) { return table.erase(it); }
+        iterator erase(const iterator& first, const iterator& last) { return table.erase(first, last); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return table.empty(); }
+        size_t size()  const noexcept { return table.size();  }
+
+    private:
+        FlatTable <K, Pairs, KeyOf, L> table;
+    };
+
+    /*****************************************************
+     * FLAT MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, flat_layout L>
+    V& flat_map <K, V, L> ::at(const K& k)
+    {
+        iterator it = table.find(k);
+        if (it == table.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return table.value(it).second;
+    }
+
+    /*****************************************************
+     * FLAT MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, flat_layout L>
+    const V& flat_map <K, V, L> ::at(const K& k) const
+    {
+        iterator it = table.find(k);
+        if (it == table.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return (*it).second;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two flat sets or two flat maps
+     ****************************************************/
+    template <typename T, flat_layout L>
+    void swap(flat_set <T, L>& lhs, flat_set <T, L>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V, flat_layout L>
+    void swap(flat_map <K, V, L>& lhs, flat_map <K, V, L>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
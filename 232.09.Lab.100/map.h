@@ -21,6 +21,8 @@
 
 #include "pair.h"     // for pair
 #include "bst.h"      // no nested class necessary for this assignment
+#include "vector.h"   // for custom::vector
+#include <utility>    // for std::forward, std::move
 
 #ifndef debug
 #ifdef DEBUG
@@ -39,14 +41,14 @@ namespace custom
  * MAP
  * Create a Map, similar to a Binary Search Tree
  *****************************************************************/
-template <class K, class V>
+template <class K, class V, class Compare = std::less<K>>
 class map
 {
    friend ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
-   friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+   template <class KK, class VV, class CC>
+   friend void swap(map<KK, VV, CC>& lhs, map<KK, VV, CC>& rhs);
 public:
-   using Pairs = custom::pair<K, V>;
+   using Pairs = custom::pair<K, V, Compare>;   // ordered by Compare on the key
 
    // 
    // Construct
@@ -107,17 +109,23 @@ public:
        bst = custom::BST <Pairs>(il); 
        return *this;
    }
+   template <class Iterator>
+   void assign_sorted(Iterator first, Iterator last)
+   {
+       // Keys must be sorted with no repeats; builds a balanced tree in O(n)
+       bst.assign_sorted(first, last);
+   }
    
    // 
    // Iterator
    //
    class iterator;
-   iterator begin() 
+   iterator begin() const noexcept
    { 
        // Return bst.begin() method
        return bst.begin();
    }
-   iterator end() 
+   iterator end() const noexcept
    { 
        // Return bst.end() method
        return bst.end();
@@ -132,8 +140,19 @@ public:
          V & at (const K& k);
    iterator    find(const K & k)
    {
-       // Return bst.find() method
-       return bst.find(k);
+       // Search by the key alone so no V is made
+       return iterator(findNode(k));
+   }
+   template <class Iterator, class OutputIterator>
+   OutputIterator find_batch(Iterator first, Iterator last, OutputIterator out)
+   {
+       // Search by the key alone, several keys side by side
+       bst.findBatch(first, last, KeyLess{ compare }, [&out](BNode* pNode)
+       {
+           *out = iterator(typename BST <Pairs> :: iterator(pNode));
+           ++out;
+       });
+       return out;
    }
 
    //
@@ -142,7 +161,7 @@ public:
    custom::pair<typename map::iterator, bool> insert(Pairs && rhs)
    {
        custom::pair<typename map::iterator, bool> pairReturn(end(), false);
-       std::pair<iterator, bool> tempPair = bst.insert(rhs, true);
+       std::pair<iterator, bool> tempPair = bst.insert(std::move(rhs), true);
        
        pairReturn.first = iterator(tempPair.first);
        pairReturn.second = tempPair.second;
@@ -160,14 +179,45 @@ public:
        return pairReturn;
    }
 
+   iterator insert(iterator hint, Pairs && rhs)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, std::move(rhs), true).first);
+   }
+   iterator insert(iterator hint, const Pairs & rhs)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, rhs, true).first);
+   }
+
+   template <class... Args>
+   custom::pair<typename map::iterator, bool> emplace(Args&&... args)
+   {
+       // The pair is built before we know if its key is already here
+       return insert(Pairs(std::forward<Args>(args)...));
+   }
+   template <class... Args>
+   iterator emplace_hint(iterator hint, Args&&... args)
+   {
+       return insert(hint, Pairs(std::forward<Args>(args)...));
+   }
+   template <class... Args>
+   custom::pair<typename map::iterator, bool> try_emplace(const K& k, Args&&... args);
+   template <class... Args>
+   custom::pair<typename map::iterator, bool> try_emplace(K&& k, Args&&... args);
+   template <class M>
+   custom::pair<typename map::iterator, bool> insert_or_assign(const K& k, M&& obj);
+   template <class M>
+   custom::pair<typename map::iterator, bool> insert_or_assign(K&& k, M&& obj);
+
    template <class Iterator>
    void insert(Iterator first, Iterator last)
    {
        // Iterate from first to last
        for (Iterator it = first; it != last; ++it)
        {
-           // Insert each iterator using the bst.insert method
-           bst.insert(it, true);
+           // Try the end first, so a sorted range appends in O(1) each
+           bst.insert(bst.end(), *it, true);
        }
    }
    void insert(const std::initializer_list <Pairs>& il)
@@ -192,6 +242,28 @@ public:
    iterator erase(iterator it);
    iterator erase(iterator first, iterator last);
 
+   //
+   // Batch
+   //
+   // One change for apply_batch: set key to value, or remove key
+   struct op
+   {
+      K key;
+      V value;         // ignored when erasing
+      bool isErase;
+   };
+   template <class Ops>
+   void apply_batch(const Ops& ops);
+
+   //
+   // Layout
+   //
+   void compact(bst_layout layout = bst_layout::in_order)
+   {
+       // Gather the nodes together after heavy churn; iterators are invalidated
+       bst.compact(layout);
+   }
+
    //
    // Status
    //
@@ -201,8 +273,47 @@ public:
 
 private:
 
+   using BNode = typename BST <Pairs> :: BNode;
+
+   // Compares a key with a pair's key, either way around
+   struct KeyLess
+   {
+      const Compare& compare;
+      bool operator()(const K& k, const Pairs& p) const { return compare(k, p.first); }
+      bool operator()(const Pairs& p, const K& k) const { return compare(p.first, k); }
+   };
+
+   // Walk down to where k belongs comparing keys only, one Compare per level
+   BNode* descend(const K& k, BNode*& pParent, bool& isLeft) const;
+   BNode* findNode(const K& k) const
+   {
+       BNode* pParent;
+       bool isLeft;
+       BNode* pCandidate = descend(k, pParent, isLeft);
+       return (pCandidate && !compare(pCandidate->data.first, k)) ? pCandidate : nullptr;
+   }
+
+   // A node applyBatch() is part way through, waiting on its children
+   struct BatchFrame
+   {
+      BNode* pNode;
+      BNode* pLeft;         // the new left subtree, once done
+      size_t iEqual;        // the ops equal to pNode are [iEqual, iGreater)
+      size_t iGreater;
+      size_t hi;            // the ops for the right side are [iGreater, hi)
+      bool isErase;
+      bool isLeftDone;
+   };
+
+   // Merge ops[lo, hi) into the subtree at pNode, returning its new root
+   template <class Ops>
+   BNode* applyBatch(BNode* pNode, const Ops& ops, size_t lo, size_t hi, BNode*& pRecycle);
+   template <class Ops>
+   BNode* buildBatch(const Ops& ops, size_t lo, size_t hi, BNode*& pRecycle);
+
    // the students DO NOT need to use a nested class
-   BST < pair <K, V >> bst;
+   BST <Pairs> bst;
+   Compare compare;    // orders the keys
 };
 
 
@@ -211,11 +322,11 @@ private:
  * Forward and reverse iterator through a Map, just call
  * through to BSTIterator
  *********************************************************/
-template <typename K, typename V>
-class map <K, V> :: iterator
+template <typename K, typename V, class Compare>
+class map <K, V, Compare> :: iterator
 {
    friend class ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
+   template <class KK, class VV, class CC>
    friend class custom::map;
 public:
    //
@@ -225,7 +336,7 @@ public:
    {
        it = nullptr;
    }
-   iterator(const typename BST < pair <K, V> > :: iterator & rhs)
+   iterator(const typename BST <Pairs> :: iterator & rhs)
    { 
        it = rhs;
    }
@@ -258,41 +369,51 @@ public:
    // 
    // Access
    //
-   const pair <K, V> & operator * () const
+   const Pairs & operator * () const
    {
       return *it;
    }
 
+   // the key cannot change, it would invalidate the BST, but the value can
+   const K & key() const
+   {
+      return it.pNode->data.first;
+   }
+   V & value() const
+   {
+      return it.pNode->data.second;
+   }
+
    //
    // Increment
    //
    iterator & operator ++ ()
    {
-       iterator temp = *this;
        ++(it);
-       return temp;
+       return *this;
    }
    iterator operator ++ (int postfix)
    {
+       iterator temp = *this;
        ++(*this);
-       return *this;
+       return temp;
    }
    iterator & operator -- ()
    {
-       iterator temp = *this;
        --(it);
-       return temp;
+       return *this;
    }
    iterator  operator -- (int postfix)
    {
+       iterator temp = *this;
        --(*this);
-       return *this;
+       return temp;
    }
 
 private:
 
    // Member variable
-   typename BST < pair <K, V >>  :: iterator it;   
+   typename BST <Pairs> :: iterator it;   
 };
 
 
@@ -300,34 +421,31 @@ private:
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> :: operator [] (const K& key)
+template <typename K, typename V, class Compare>
+V& map <K, V, Compare> :: operator [] (const K& key)
 {
-    Pairs temp(key, V());
-    std::pair<iterator, bool> returnPair = bst.insert(temp, true);
-
-    iterator itBST = returnPair.first;
-
-    return itBST.it.pNode->data.second;
+    // Only make a V if the key is not already here
+    return try_emplace(key).first.value();
 }
 
 /*****************************************************
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V> 
-const V& map <K, V> :: operator [] (const K& key) const 
+template <typename K, typename V, class Compare> 
+const V& map <K, V, Compare> :: operator [] (const K& key) const 
 {
-    Pairs temp(key, V());
-    iterator itBST = bst.find(temp);
+    BNode* pNode = findNode(key);
 
-    if (itBST != bst.end())
+    if (pNode)
     {
-        return itBST.it.pNode->data.second;
+        return pNode->data.second;
     }
     else
     {
-        return temp.second;
+        // Nothing to insert into, so every missing key reads as V()
+        static const V vDefault = V();
+        return vDefault;
     }
 }
 
@@ -335,15 +453,14 @@ const V& map <K, V> :: operator [] (const K& key) const
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> ::at(const K& key)
+template <typename K, typename V, class Compare>
+V& map <K, V, Compare> ::at(const K& key)
 {
-    Pairs temp(key, V());
-    iterator itBST = bst.find(temp);
+    BNode* pNode = findNode(key);
 
-    if (itBST != bst.end())
+    if (pNode)
     {
-        return itBST.it.pNode->data.second;
+        return pNode->data.second;
     }
     else
     {
@@ -355,15 +472,14 @@ V& map <K, V> ::at(const K& key)
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V& map <K, V> ::at(const K& key) const
+template <typename K, typename V, class Compare>
+const V& map <K, V, Compare> ::at(const K& key) const
 {
-    Pairs temp(key, V());
-    iterator itBST = bst.find(temp);
+    BNode* pNode = findNode(key);
 
-    if (itBST != bst.end())
+    if (pNode)
     {
-        return itBST.it.pNode->data.second;
+        return pNode->data.second;
     }
     else
     {
@@ -371,23 +487,313 @@ const V& map <K, V> ::at(const K& key) const
     }
 }
 
+/*****************************************************
+ * MAP :: DESCEND
+ * Like BST::descend but on the key alone, so a lookup
+ * never has to build a pair to compare against.
+ * Returns the last node whose key is not greater than k.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+typename map <K, V, Compare> ::BNode* map <K, V, Compare> ::descend(const K& k, BNode*& pParent, bool& isLeft) const
+{
+    BNode* pCandidate = nullptr;
+    pParent = nullptr;
+    isLeft = false;
+
+    for (BNode* current = bst.root; current != nullptr; )
+    {
+        pParent = current;
+        isLeft = compare(k, current->data.first);
+        if (isLeft)
+            current = current->pLeft;
+        else
+        {
+            pCandidate = current;
+            current = current->pRight;
+        }
+    }
+
+    return pCandidate;
+}
+
+/*****************************************************
+ * MAP :: TRY EMPLACE
+ * Insert k with a V made from args, but only if k is
+ * not already here. A hit constructs and allocates nothing.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+template <class... Args>
+custom::pair<typename map <K, V, Compare> ::iterator, bool>
+map <K, V, Compare> ::try_emplace(const K& k, Args&&... args)
+{
+    BNode* pParent;
+    bool isLeft;
+    BNode* pCandidate = descend(k, pParent, isLeft);
+    if (pCandidate && !compare(pCandidate->data.first, k))
+        return custom::pair<iterator, bool>(iterator(pCandidate), false);
+
+    BNode* pNode = new BNode(Pairs(k, V(std::forward<Args>(args)...)));
+    return custom::pair<iterator, bool>(iterator(bst.attach(pNode, pParent, isLeft)), true);
+}
+
+template <typename K, typename V, class Compare>
+template <class... Args>
+custom::pair<typename map <K, V, Compare> ::iterator, bool>
+map <K, V, Compare> ::try_emplace(K&& k, Args&&... args)
+{
+    BNode* pParent;
+    bool isLeft;
+    BNode* pCandidate = descend(k, pParent, isLeft);
+    if (pCandidate && !compare(pCandidate->data.first, k))
+        return custom::pair<iterator, bool>(iterator(pCandidate), false);
+
+    BNode* pNode = new BNode(Pairs(std::move(k), V(std::forward<Args>(args)...)));
+    return custom::pair<iterator, bool>(iterator(bst.attach(pNode, pParent, isLeft)), true);
+}
+
+/*****************************************************
+ * MAP :: INSERT OR ASSIGN
+ * Assign obj to the value at k, inserting k if it is
+ * not already here. Either way there is one descent.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+template <class M>
+custom::pair<typename map <K, V, Compare> ::iterator, bool>
+map <K, V, Compare> ::insert_or_assign(const K& k, M&& obj)
+{
+    BNode* pParent;
+    bool isLeft;
+    BNode* pCandidate = descend(k, pParent, isLeft);
+    if (pCandidate && !compare(pCandidate->data.first, k))
+    {
+        pCandidate->data.second = std::forward<M>(obj);
+        return custom::pair<iterator, bool>(iterator(pCandidate), false);
+    }
+
+    BNode* pNode = new BNode(Pairs(k, V(std::forward<M>(obj))));
+    return custom::pair<iterator, bool>(iterator(bst.attach(pNode, pParent, isLeft)), true);
+}
+
+template <typename K, typename V, class Compare>
+template <class M>
+custom::pair<typename map <K, V, Compare> ::iterator, bool>
+map <K, V, Compare> ::insert_or_assign(K&& k, M&& obj)
+{
+    BNode* pParent;
+    bool isLeft;
+    BNode* pCandidate = descend(k, pParent, isLeft);
+    if (pCandidate && !compare(pCandidate->data.first, k))
+    {
+        pCandidate->data.second = std::forward<M>(obj);
+        return custom::pair<iterator, bool>(iterator(pCandidate), false);
+    }
+
+    BNode* pNode = new BNode(Pairs(std::move(k), V(std::forward<M>(obj))));
+    return custom::pair<iterator, bool>(iterator(bst.attach(pNode, pParent, isLeft)), true);
+}
+
+/*****************************************************
+ * MAP :: APPLY BATCH
+ * Apply a batch of upserts and erasures, sorted by key,
+ * in one walk of the tree. Each op has a key, a value,
+ * and isErase; when a key repeats the last op wins.
+ * Only the subtrees some op falls in are visited, so a
+ * small batch touches little of a large map. Nodes freed
+ * by erasures are reused by the inserts after them.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+template <class Ops>
+void map <K, V, Compare> ::apply_batch(const Ops& ops)
+{
+    BNode* pRecycle = nullptr;
+    bst.root = applyBatch(bst.root, ops, 0, ops.size(), pRecycle);
+    if (bst.root)
+        bst.root->pParent = nullptr;
+    bst.pRightmost = nullptr;
+
+    // Whatever was not reused goes now
+    while (pRecycle)
+    {
+        BNode* pDelete = pRecycle;
+        pRecycle = pRecycle->pRight;
+        bst.freeBNode(pDelete);
+    }
+}
+
+/*****************************************************
+ * MAP :: APPLY BATCH helper
+ * The ops for keys less than a node go left, those
+ * greater go right, and those equal to it change it.
+ * The ops are found with binary searches, so a node
+ * no op falls under costs nothing. The nodes waiting
+ * on their children are kept on a stack of our own
+ * rather than the call stack, so a long chain cannot
+ * overflow it.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+template <class Ops>
+typename map <K, V, Compare> ::BNode* map <K, V, Compare> ::applyBatch(BNode* pNode, const Ops& ops, size_t lo, size_t hi, BNode*& pRecycle)
+{
+    custom::vector<BatchFrame> path;
+    for (;;)
+    {
+        // Go down the left, splitting the ops at each node on the way
+        while (lo != hi && pNode != nullptr)
+        {
+            // [lo, iEqual) is less than this node, [iEqual, iGreater) equal to it
+            size_t iEqual = lo;
+            for (size_t count = hi - lo; count > 0; )
+            {
+                size_t step = count / 2;
+                if (compare(ops[iEqual + step].key, pNode->data.first))
+                {
+                    iEqual += step + 1;
+                    count -= step + 1;
+                }
+                else
+                    count = step;
+            }
+            size_t iGreater = iEqual;
+            for (size_t count = hi - iEqual; count > 0; )
+            {
+                size_t step = count / 2;
+                if (!compare(pNode->data.first, ops[iGreater + step].key))
+                {
+                    iGreater += step + 1;
+                    count -= step + 1;
+                }
+                else
+                    count = step;
+            }
+
+            BatchFrame frame;
+            frame.pNode = pNode;
+            frame.pLeft = nullptr;
+            frame.iEqual = iEqual;
+            frame.iGreater = iGreater;
+            frame.hi = hi;
+            frame.isErase = iEqual != iGreater && ops[iGreater - 1].isErase;
+            frame.isLeftDone = false;
+            path.push_back(frame);
+
+            pNode = pNode->pLeft;
+            hi = iEqual;
+        }
+
+        // Nothing changes here, or we fell off the tree and
+        // everything left to upsert is new
+        BNode* pResult = (lo == hi) ? pNode : buildBatch(ops, lo, hi, pRecycle);
+
+        // Go back up, finishing every node whose right side is done
+        for (;;)
+        {
+            if (path.empty())
+                return pResult;
+
+            BatchFrame& frame = path.back();
+            if (!frame.isLeftDone)
+            {
+                BNode* pRight = frame.pNode->pRight;
+                frame.pLeft = pResult;
+                frame.isLeftDone = true;
+
+                // An erased node goes on the chain before the right side is
+                // visited, so the inserts over there can reuse it
+                if (frame.isErase)
+                {
+                    frame.pNode->pRight = pRecycle;
+                    pRecycle = frame.pNode;
+                    bst.numElements--;
+                }
+
+                pNode = pRight;
+                lo = frame.iGreater;
+                hi = frame.hi;
+                break;
+            }
+
+            if (!frame.isErase)
+            {
+                // Keep this node, perhaps with a new value
+                if (frame.iEqual != frame.iGreater)
+                    frame.pNode->data.second = ops[frame.iGreater - 1].value;
+                frame.pNode->addLeft(frame.pLeft);
+                frame.pNode->addRight(pResult);
+                pResult = frame.pNode;
+            }
+            else
+                // One child, or the smallest on the right, takes the erased node's place
+                pResult = bst.joinBNode(frame.pLeft, pResult);
+            path.pop_back();
+        }
+    }
+}
+
+/*****************************************************
+ * MAP :: BUILD BATCH
+ * A balanced subtree of the upserts in ops[lo, hi), all
+ * of whose keys are new. The middle op becomes the root
+ * unless it, or a later op on the same key, erases.
+ ****************************************************/
+template <typename K, typename V, class Compare>
+template <class Ops>
+typename map <K, V, Compare> ::BNode* map <K, V, Compare> ::buildBatch(const Ops& ops, size_t lo, size_t hi, BNode*& pRecycle)
+{
+    while (lo < hi)
+    {
+        // Widen the middle to every op on its key
+        size_t iFirst = lo + (hi - lo) / 2;
+        size_t iLast = iFirst + 1;
+        while (iFirst > lo && !compare(ops[iFirst - 1].key, ops[iFirst].key))
+            iFirst--;
+        while (iLast < hi && !compare(ops[iFirst].key, ops[iLast].key))
+            iLast++;
+
+        // An erasure of a key that is not here does nothing
+        if (ops[iLast - 1].isErase)
+        {
+            BNode* pLeft = buildBatch(ops, lo, iFirst, pRecycle);
+            if (pLeft == nullptr)
+            {
+                lo = iLast;
+                continue;
+            }
+
+            // Hang the right side off the last node on the left
+            BNode* pLast = pLeft;
+            while (pLast->pRight)
+                pLast = pLast->pRight;
+            pLast->addRight(buildBatch(ops, iLast, hi, pRecycle));
+            return pLeft;
+        }
+
+        BNode* pNode = bst.recycleBNode(Pairs(ops[iLast - 1].key, ops[iLast - 1].value), pRecycle);
+        bst.numElements++;
+        pNode->addLeft(buildBatch(ops, lo, iFirst, pRecycle));
+        pNode->addRight(buildBatch(ops, iLast, hi, pRecycle));
+        return pNode;
+    }
+    return nullptr;
+}
+
 /*****************************************************
  * SWAP
  * Swap two maps
  ****************************************************/
-template <typename K, typename V>
-void swap(map <K, V>& lhs, map <K, V>& rhs)
+template <typename K, typename V, class Compare>
+void swap(map <K, V, Compare>& lhs, map <K, V, Compare>& rhs)
 {
-    // Use std::swap to swap this.bst and rhs.bst
-    std::swap(lhs.bst, rhs.bst); 
+    // Use std::swap to swap this.bst and rhs.bst, and the comparators that order them
+    std::swap(lhs.bst, rhs.bst);
+    std::swap(lhs.compare, rhs.compare);
 }
 
 /*****************************************************
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-size_t map<K, V>::erase(const K& k)
+template <typename K, typename V, class Compare>
+size_t map<K, V, Compare>::erase(const K& k)
 {
     // Find the element in the set
     iterator it = find(k);
@@ -404,31 +810,21 @@ size_t map<K, V>::erase(const K& k)
 
 /*****************************************************
  * ERASE
- * Erase several elements
+ * Erase several elements, cut out of the tree at once
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K, V>::iterator last)
+template <typename K, typename V, class Compare>
+typename map<K, V, Compare>::iterator map<K, V, Compare>::erase(map<K, V, Compare>::iterator first, map<K, V, Compare>::iterator last)
 {
-    //set an iterator to return
-    iterator temp = first; 
-
-    // Iterate from itBegin to itEnd
-    for (iterator it = first; it != last;) 
-    {
-        //erase automatically returns an iterator to the next node
-        it = erase(it); 
-        temp = it; 
-    }
-
-    return temp; 
+    // Use bst.erase on the range, keys are unique so it can cut by key
+    return iterator(bst.erase(first.it, last.it));
 }
 
 /*****************************************************
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
+template <typename K, typename V, class Compare>
+typename map<K, V, Compare>::iterator map<K, V, Compare>::erase(map<K, V, Compare>::iterator it)
 {
     // Use bst.erase method, access the bst iterator within the set iterator
     return bst.erase(it.it); 
@@ -0,0 +1,652 @@
+/***********************************************************************
+ * Header:
+ *    MULTI MAP
+ * Summary:
+ *    A set and a map that keep every copy of a key, on top of BST.
+ *    Each keeps either one node per copy or, in run-length mode, one
+ *    node per distinct key with all of its copies in it.
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the definition of:
+ *        MultiTree           : The BST and the searches both share
+ *        MultiTree::iterator : Every copy of every key, in order
+ *        multiset            : A set that keeps duplicates
+ *        multimap            : A map that keeps duplicate keys
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <functional>       // for std::less
+#include <utility>          // for std::pair, std::move, std::forward
+#include <initializer_list>
+#include "bst.h"            // for BST
+#include "pair.h"           // for custom::pair
+#include "vector.h"         // for custom::vector
+
+class TestMultiMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * MULTI TREE
+     * A BST of elements that hold one or more copies of a key. The
+     * Traits say what an element is:
+     *    key(e)           the key of the element
+     *    length(e)        how many copies it holds
+     *    deref(e, i)      copy i, as the iterator hands it out
+     *    mapped(e, i)     the value of copy i
+     *    runLength        whether copies share an element
+     * and, when they do, how to start one (make), add a copy (append)
+     * and take one out (removeAt). Otherwise each copy is its own
+     * element, inserted with keepUnique false so it goes after the
+     * copies already here.
+     *
+     * A copy is a node and an index into it; the index is always 0
+     * without run-length mode.
+     *****************************************************************/
+    template <class Traits, class Compare>
+    class MultiTree
+    {
+        friend class ::TestMultiMap; // give unit tests access to the privates
+    public:
+        using K = typename Traits::key_type;
+        using E = typename Traits::element_type;
+
+        // Orders the elements by key alone
+        struct ElementLess
+        {
+            bool operator () (const E& lhs, const E& rhs) const
+            {
+                return Compare()(Traits::key(lhs), Traits::key(rhs));
+            }
+        };
+        using Tree = BST <E, ElementLess>;
+        using BNode = typename Tree::BNode;
+
+        class iterator;
+
+        MultiTree() : numElements(0) {}
+        MultiTree(const MultiTree& rhs) : bst(rhs.bst), numElements(rhs.numElements) {}
+        MultiTree(MultiTree&& rhs) : bst(std::move(rhs.bst)), numElements(rhs.numElements)
+        {
+            rhs.numElements = 0;
+        }
+        MultiTree& operator = (const MultiTree& rhs)
+        {
+            bst = rhs.bst;
+            numElements = rhs.numElements;
+            return *this;
+        }
+        MultiTree& operator = (MultiTree&& rhs)
+        {
+            bst = std::move(rhs.bst);
+            numElements = rhs.numElements;
+            rhs.numElements = 0;
+            return *this;
+        }
+        void swap(MultiTree& rhs)
+        {
+            bst.swap(rhs.bst);
+            std::swap(numElements, rhs.numElements);
+        }
+
+        iterator begin() const { return iterator(bst.begin().getNode(), 0); }
+        iterator end()   const { return iterator(nullptr, 0); }
+
+        iterator lower_bound(const K& k) const;
+        iterator upper_bound(const K& k) const;
+        size_t   count(const K& k) const;
+
+        template <class Input>
+        iterator insert(Input&& input);
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        void     clear() noexcept
+        {
+            bst.clear();
+            numElements = 0;
+        }
+
+        size_t size()  const noexcept { return numElements; }
+        size_t nodes() const noexcept { return bst.size();  }  // one per key in run-length mode
+
+    private:
+        Tree    bst;                   // the elements
+        size_t  numElements;           // copies, counting each in a run
+        Compare compare;               // orders the keys
+    };
+
+    /**********************************************************
+     * MULTI TREE ITERATOR
+     * A node and which of its copies. End is a null node.
+     * As with BST, there is no going back from end().
+     *********************************************************/
+    template <class Traits, class Compare>
+    class MultiTree <Traits, Compare> ::iterator
+    {
+        friend class ::TestMultiMap; // give unit tests access to the privates
+        friend class MultiTree;
+    public:
+        iterator() : pNode(nullptr), index(0) {}
+        iterator(BNode* pNode, size_t index) : pNode(pNode), index(index) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode && index == rhs.index; }
+        bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+        typename Traits::reference operator * () const { return Traits::deref(pNode->data, index); }
+        const K& key() const { return Traits::key(pNode->data); }
+        typename Traits::mapped_reference value() const { return Traits::mapped(pNode->data, index); }
+
+        iterator& operator ++ ()
+        {
+            if (++index >= Traits::length(pNode->data))
+            {
+                typename Tree::iterator it(pNode);
+                ++it;
+                pNode = it.getNode();
+                index = 0;
+            }
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+        iterator& operator -- ()
+        {
+            if (index > 0)
+                index--;
+            else
+            {
+                typename Tree::iterator it(pNode);
+                --it;
+                pNode = it.getNode();
+                index = pNode ? Traits::length(pNode->data) - 1 : 0;
+            }
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        BNode* pNode;                  // the element, or nullptr for end()
+        size_t index;                  // which copy in the element
+    };
+
+    /*********************************************
+     * MULTI TREE :: LOWER BOUND
+     * The first copy of k, or of the key after it. Equal
+     * keys can end up on either side of each other once
+     * BST::erase has moved a successor up, so this keeps
+     * going left past every match.
+     ********************************************/
+    template <class Traits, class Compare>
+    typename MultiTree <Traits, Compare> ::iterator MultiTree <Traits, Compare> ::lower_bound(const K& k) const
+    {
+        BNode* pResult = nullptr;
+        for (BNode* pNode = bst.root; pNode; )
+        {
+            if (compare(Traits::key(pNode->data), k))
+                pNode = pNode->pRight;
+            else
+            {
+                pResult = pNode;
+                pNode = pNode->pLeft;
+            }
+        }
+        return iterator(pResult, 0);
+    }
+
+    /*********************************************
+     * MULTI TREE :: UPPER BOUND
+     * The first copy of the key after k
+     ********************************************/
+    template <class Traits, class Compare>
+    typename MultiTree <Traits, Compare> ::iterator MultiTree <Traits, Compare> ::upper_bound(const K& k) const
+    {
+        BNode* pResult = nullptr;
+        for (BNode* pNode = bst.root; pNode; )
+        {
+            if (compare(k, Traits::key(pNode->data)))
+            {
+                pResult = pNode;
+                pNode = pNode->pLeft;
+            }
+            else
+                pNode = pNode->pRight;
+        }
+        return iterator(pResult, 0);
+    }
+
+    /*********************************************
+     * MULTI TREE :: COUNT
+     * How many copies of k there are: one node to look at
+     * in run-length mode, otherwise one per copy
+     ********************************************/
+    template <class Traits, class Compare>
+    size_t MultiTree <Traits, Compare> ::count(const K& k) const
+    {
+        size_t n = 0;
+        typename Tree::iterator it(lower_bound(k).pNode);
+        for (; it != bst.end() && !compare(k, Traits::key(*it)); ++it)
+            n += Traits::length(*it);
+        return n;
+    }
+
+    /*********************************************
+     * MULTI TREE :: INSERT
+     * Add one copy. In run-length mode a key already here
+     * gets the copy added to its node; a new key gets a node,
+     * placed beside the lower bound already found.
+     ********************************************/
+    template <class Traits, class Compare>
+    template <class Input>
+    typename MultiTree <Traits, Compare> ::iterator MultiTree <Traits, Compare> ::insert(Input&& input)
+    {
+        numElements++;
+        if constexpr (Traits::runLength)
+        {
+            const K& k = Traits::keyOf(input);
+            iterator it = lower_bound(k);
+            if (it.pNode && !compare(k, Traits::key(it.pNode->data)))
+            {
+                Traits::append(it.pNode->data, std::forward<Input>(input));
+                return iterator(it.pNode, Traits::length(it.pNode->data) - 1);
+            }
+            typename Tree::iterator itHint = it.pNode ? typename Tree::iterator(it.pNode) : bst.end();
+            return iterator(bst.insert(itHint, Traits::make(std::forward<Input>(input)), true).first.getNode(), 0);
+        }
+        else
+            return iterator(bst.insert(E(std::forward<Input>(input)), false).first.getNode(), 0);
+    }
+
+    /*********************************************
+     * MULTI TREE :: ERASE
+     * Remove every copy of k, cutting them out of the tree
+     * in one pass. Returns how many there were.
+     ********************************************/
+    template <class Traits, class Compare>
+    size_t MultiTree <Traits, Compare> ::erase(const K& k)
+    {
+        size_t n = count(k);
+        if (n)
+        {
+            typename Tree::iterator first(lower_bound(k).pNode);
+            typename Tree::iterator last(upper_bound(k).pNode);
+            bst.erase(first, last);
+            numElements -= n;
+        }
+        return n;
+    }
+
+    /*********************************************
+     * MULTI TREE :: ERASE
+     * Remove one copy and return the one after it. The node
+     * only goes with its last copy.
+     ********************************************/
+    template <class Traits, class Compare>
+    typename MultiTree <Traits, Compare> ::iterator MultiTree <Traits, Compare> ::erase(const iterator& it)
+    {
+        if (it.pNode == nullptr)
+            return end();
+        numElements--;
+        if constexpr (Traits::runLength)
+        {
+            if (Traits::length(it.pNode->data) > 1)
+            {
+                Traits::removeAt(it.pNode->data, it.index);
+                iterator itNext(it.pNode, it.index);
+                if (it.index == Traits::length(it.pNode->data))
+                {
+                    itNext.index--;
+                    ++itNext;
+                }
+                return itNext;
+            }
+        }
+        typename Tree::iterator itErase(it.pNode);
+        return iterator(bst.erase(itErase).getNode(), 0);
+    }
+
+
+    /*****************************************************************
+     * MULTISET TRAITS
+     * One node per copy, or one node per key with a count
+     *****************************************************************/
+    template <typename T, bool RunLength>
+    struct multiset_traits
+    {
+        using key_type = T;
+        using element_type = T;
+        using reference = const T&;
+        using mapped_reference = const T&;
+        static const bool runLength = false;
+
+        static const T& key(const T& t) { return t; }
+        static size_t length(const T&) { return 1; }
+        static const T& deref(const T& t, size_t) { return t; }
+        static const T& mapped(const T& t, size_t) { return t; }
+    };
+
+    template <typename T>
+    struct multiset_traits <T, true>
+    {
+        struct Run
+        {
+            Run(const T& value) : value(value), count(1) {}
+            Run(T&& value) : value(std::move(value)), count(1) {}
+            T      value;
+            size_t count;           // copies of value
+        };
+
+        using key_type = T;
+        using element_type = Run;
+        using reference = const T&;
+        using mapped_reference = const T&;
+        static const bool runLength = true;
+
+        static const T& key(const Run& run) { return run.value; }
+        static size_t length(const Run& run) { return run.count; }
+        static const T& deref(const Run& run, size_t) { return run.value; }
+        static const T& mapped(const Run& run, size_t) { return run.value; }
+
+        static const T& keyOf(const T& t) { return t; }
+        template <class Input>
+        static Run make(Input&& t) { return Run(std::forward<Input>(t)); }
+        template <class Input>
+        static void append(Run& run, Input&&) { run.count++; }
+        static void removeAt(Run& run, size_t) { run.count--; }
+    };
+
+    /*****************************************************************
+     * MULTIMAP TRAITS
+     * One node per pair, or one node per key with its values in
+     * the order they went in
+     *****************************************************************/
+    template <typename K, typename V, bool RunLength>
+    struct multimap_traits
+    {
+        using Pairs = custom::pair<K, V>;
+        using key_type = K;
+        using element_type = Pairs;
+        using reference = const Pairs&;
+        using mapped_reference = V&;
+        static const bool runLength = false;
+
+        static const K& key(const Pairs& p) { return p.first; }
+        static size_t length(const Pairs&) { return 1; }
+        static const Pairs& deref(const Pairs& p, size_t) { return p; }
+        static V& mapped(Pairs& p, size_t) { return p.second; }
+    };
+
+    template <typename K, typename V>
+    struct multimap_traits <K, V, true>
+    {
+        using Pairs = custom::pair<K, V>;
+        using Bucket = custom::pair<K, custom::vector<V>>;
+        using key_type = K;
+        using element_type = Bucket;
+        using reference = Pairs;          // built on the way out
+        using mapped_reference = V&;
+        static const bool runLength = true;
+
+        static const K& key(const Bucket& b) { return b.first; }
+        static size_t length(const Bucket& b) { return b.second.size(); }
+        static Pairs deref(const Bucket& b, size_t index) { return Pairs(b.first, b.second[index]); }
+        static V& mapped(Bucket& b, size_t index) { return b.second[index]; }
+
+        static const K& keyOf(const Pairs& p) { return p.first; }
+        static Bucket make(const Pairs& p)
+        {
+            Bucket b(p.first, custom::vector<V>());
+            b.second.push_back(p.second);
+            return b;
+        }
+        static Bucket make(Pairs&& p)
+        {
+            Bucket b(std::move(p.first), custom::vector<V>());
+            b.second.push_back(std::move(p.second));
+            return b;
+        }
+        static void append(Bucket& b, const Pairs& p) { b.second.push_back(p.second); }
+        static void append(Bucket& b, Pairs&& p) { b.second.push_back(std::move(p.second)); }
+        static void removeAt(Bucket& b, size_t index)
+        {
+            for (size_t i = index + 1; i < b.second.size(); i++)
+                b.second[i - 1] = std::move(b.second[i]);
+            b.second.pop_back();
+        }
+    };
+
+
+    /*****************************************************************
+     * MULTISET
+     * A set that keeps every copy, in the order they went in. With
+     * RunLength, equal elements share one node and a count, so a
+     * copy costs nothing but the count going up; only one of each is
+     * kept, which is all a set of equivalent elements needs when
+     * equivalent means identical.
+     *****************************************************************/
+    template <typename T, class Compare = std::less<T>, bool RunLength = false>
+    class multiset
+    {
+        friend class ::TestMultiMap; // give unit tests access to the privates
+        using Tree = MultiTree <multiset_traits<T, RunLength>, Compare>;
+    public:
+        using iterator = typename Tree::iterator;
+
+        //
+        // Construct
+        //
+        multiset() {}
+        multiset(const multiset& rhs) : tree(rhs.tree) {}
+        multiset(multiset&& rhs) : tree(std::move(rhs.tree)) {}
+        multiset(const std::initializer_list <T>& il) { insert(il); }
+        template <class Iterator>
+        multiset(Iterator first, Iterator last) { insert(first, last); }
+        ~multiset() {}
+
+        //
+        // Assign
+        //
+        multiset& operator = (const multiset& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        multiset& operator = (multiset&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        void swap(multiset& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const { return tree.begin(); }
+        iterator end()   const { return tree.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const
+        {
+            iterator it = tree.lower_bound(t);
+            return it == end() || Compare()(t, *it) ? end() : it;
+        }
+        size_t count(const T& t) const { return tree.count(t); }
+        iterator lower_bound(const T& t) const { return tree.lower_bound(t); }
+        iterator upper_bound(const T& t) const { return tree.upper_bound(t); }
+        std::pair<iterator, iterator> equal_range(const T& t) const
+        {
+            return std::pair<iterator, iterator>(tree.lower_bound(t), tree.upper_bound(t));
+        }
+
+        //
+        // Insert
+        //
+        iterator insert(const T& t) { return tree.insert(t); }
+        iterator insert(T&& t)      { return tree.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il)
+        {
+            for (const T& t : il)
+                tree.insert(t);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        size_t erase(const T& t) { return tree.erase(t); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.size() == 0; }
+        size_t size()  const noexcept { return tree.size(); }
+
+    private:
+        Tree tree;
+    };
+
+
+    /*****************************************************************
+     * MULTIMAP
+     * A map that keeps every pair, with the values for a key in the
+     * order they went in. With RunLength, a key is stored once and
+     * its values sit together in one vector, so iterating over them
+     * does not chase a pointer per value. In that mode *it builds a
+     * pair to hand out; key() and value() reach into the node.
+     *****************************************************************/
+    template <typename K, typename V, class Compare = std::less<K>, bool RunLength = false>
+    class multimap
+    {
+        friend class ::TestMultiMap; // give unit tests access to the privates
+        using Tree = MultiTree <multimap_traits<K, V, RunLength>, Compare>;
+    public:
+        using Pairs = custom::pair<K, V>;
+        using iterator = typename Tree::iterator;
+
+        //
+        // Construct
+        //
+        multimap() {}
+        multimap(const multimap& rhs) : tree(rhs.tree) {}
+        multimap(multimap&& rhs) : tree(std::move(rhs.tree)) {}
+        multimap(const std::initializer_list <Pairs>& il) { insert(il); }
+        template <class Iterator>
+        multimap(Iterator first, Iterator last) { insert(first, last); }
+        ~multimap() {}
+
+        //
+        // Assign
+        //
+        multimap& operator = (const multimap& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        multimap& operator = (multimap&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        void swap(multimap& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const { return tree.begin(); }
+        iterator end()   const { return tree.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const K& k) const
+        {
+            iterator it = tree.lower_bound(k);
+            return it == end() || Compare()(k, it.key()) ? end() : it;
+        }
+        size_t count(const K& k) const { return tree.count(k); }
+        iterator lower_bound(const K& k) const { return tree.lower_bound(k); }
+        iterator upper_bound(const K& k) const { return tree.upper_bound(k); }
+        std::pair<iterator, iterator> equal_range(const K& k) const
+        {
+            return std::pair<iterator, iterator>(tree.lower_bound(k), tree.upper_bound(k));
+        }
+
+        //
+        // Insert
+        //
+        iterator insert(const Pairs& rhs) { return tree.insert(rhs); }
+        iterator insert(Pairs&& rhs)      { return tree.insert(std::move(rhs)); }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                tree.insert(element);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        size_t erase(const K& k) { return tree.erase(k); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.size() == 0; }
+        size_t size()  const noexcept { return tree.size(); }
+
+    private:
+        Tree tree;
+    };
+
+    /*****************************************************
+     * SWAP
+     * Swap two multisets or two multimaps
+     ****************************************************/
+    template <typename T, class Compare, bool RunLength>
+    void swap(multiset <T, Compare, RunLength>& lhs, multiset <T, Compare, RunLength>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V, class Compare, bool RunLength>
+    void swap(multimap <K, V, Compare, RunLength>& lhs, multimap <K, V, Compare, RunLength>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
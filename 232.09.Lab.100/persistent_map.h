@@ -0,0 +1,658 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT MAP
+ * Summary:
+ *    A map whose old versions stay readable: nodes are shared between
+ *    versions and copied only along the path a change touches
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        persistent_map             : A map with O(1) snapshots
+ *        persistent_map::iterator   : An iterator through one version
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>           // for the reference counts
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <stdexcept>        // for std::out_of_range
+#include <utility>          // for std::move, std::forward
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+
+class TestPersistentMap; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * PERSISTENT MAP
+     * An AVL tree of reference-counted nodes. A node may be reachable
+     * from many versions, so it is never changed while anyone else
+     * holds it: a change copies each shared node on its path, O(log n)
+     * of them, and leaves the rest shared. A node only this map holds
+     * is changed in place, so a map with no snapshots out costs no
+     * copies at all.
+     *
+     * snapshot() and the copy constructor share the root, O(1). Each
+     * version may be read from its own thread while another thread
+     * changes a different version.
+     *****************************************************************/
+    template <class K, class V>
+    class persistent_map
+    {
+        friend class ::TestPersistentMap; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+
+        //
+        // Construct
+        //
+        persistent_map() : root(nullptr), numElements(0) {}
+        persistent_map(const persistent_map& rhs) : root(rhs.root), numElements(rhs.numElements)
+        {
+            retain(root);
+        }
+        persistent_map(persistent_map&& rhs) noexcept : root(rhs.root), numElements(rhs.numElements)
+        {
+            rhs.root = nullptr;
+            rhs.numElements = 0;
+        }
+        template <class Iterator>
+        persistent_map(Iterator first, Iterator last) : root(nullptr), numElements(0)
+        {
+            insert(first, last);
+        }
+        persistent_map(const std::initializer_list <Pairs>& il) : root(nullptr), numElements(0)
+        {
+            insert(il);
+        }
+        ~persistent_map() { release(root); }
+
+        //
+        // Assign
+        //
+        persistent_map& operator = (const persistent_map& rhs)
+        {
+            retain(rhs.root);
+            release(root);
+            root = rhs.root;
+            numElements = rhs.numElements;
+            return *this;
+        }
+        persistent_map& operator = (persistent_map&& rhs) noexcept
+        {
+            swap(rhs);
+            return *this;
+        }
+        persistent_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(persistent_map& rhs) noexcept
+        {
+            std::swap(root, rhs.root);
+            std::swap(numElements, rhs.numElements);
+        }
+
+        //
+        // Snapshot
+        //
+        persistent_map snapshot() const { return *this; }
+
+        //
+        // Iterator
+        //
+        class iterator;
+        iterator begin() const;
+        iterator end()   const { return iterator(root, nullptr); }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k);
+        const V& at(const K& k) const;
+        iterator find(const K& k) const;
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs);
+        custom::pair<iterator, bool> insert(Pairs&& rhs);
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                insert(*it);
+        }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                insert(element);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept
+        {
+            release(root);
+            root = nullptr;
+            numElements = 0;
+        }
+        size_t erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(iterator first, const iterator& last);
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return numElements == 0; }
+        size_t size()  const noexcept { return numElements; }
+
+    private:
+
+        struct Node;
+        Node*  root;              // this version's tree, shared with other versions
+        size_t numElements;       // number of elements in this version
+
+        static void  retain(Node* p)  noexcept;
+        static void  release(Node* p) noexcept;
+        static Node* own(Node*& p);
+
+        static int   height(const Node* p) { return p ? p->height : 0; }
+        static void  update(Node* p);
+        static void  rotateLeft(Node*& p);
+        static void  rotateRight(Node*& p);
+        static void  rebalance(Node*& p);
+
+        static const Node* findNode(const Node* p, const K& k);
+        template <class P>
+        static Node* insertNode(Node*& p, P&& element);
+        static V&    ownPath(Node*& p, const K& k);
+        static void  eraseNode(Node*& p, const K& k);
+        static void  eraseMin(Node*& p, Pairs& min);
+    };
+
+    /*****************************************************************
+     * PERSISTENT MAP :: NODE
+     * An element and its children. Each node holds a reference on each
+     * of its children, and refs counts the parents and maps that hold
+     * this one.
+     *****************************************************************/
+    template <class K, class V>
+    struct persistent_map <K, V> ::Node
+    {
+        Node(const Pairs& data) : data(data), pLeft(nullptr), pRight(nullptr), height(1), refs(1) {}
+        Node(Pairs&& data) : data(std::move(data)), pLeft(nullptr), pRight(nullptr), height(1), refs(1) {}
+        Node(const Node& rhs) :
+            data(rhs.data), pLeft(rhs.pLeft), pRight(rhs.pRight), height(rhs.height), refs(1)
+        {
+            retain(pLeft);
+            retain(pRight);
+        }
+
+        Pairs data;
+        Node* pLeft;
+        Node* pRight;
+        int   height;
+        std::atomic<size_t> refs;
+    };
+
+    /**********************************************************
+     * PERSISTENT MAP ITERATOR
+     * In-order through one version. There are no parent pointers,
+     * since a node has a parent in each version that shares it, so
+     * a step looks up the neighbor from the root: O(log n). An
+     * iterator stays good as long as its version is neither changed
+     * nor destroyed; a snapshot's iterators outlive any change to the
+     * map it was taken from.
+     *********************************************************/
+    template <class K, class V>
+    class persistent_map <K, V> ::iterator
+    {
+        friend class ::TestPersistentMap; // give unit tests access to the privates
+        friend class persistent_map;
+    public:
+        iterator() : pRoot(nullptr), pNode(nullptr) {}
+        iterator(const Node* pRoot, const Node* pNode) : pRoot(pRoot), pNode(pNode) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode; }
+        bool operator != (const iterator& rhs) const { return pNode != rhs.pNode; }
+
+        const Pairs& operator * () const { return pNode->data; }
+        const Pairs* operator -> () const { return &pNode->data; }
+
+        // the smallest key above ours
+        iterator& operator ++ ()
+        {
+            const Node* pNext = nullptr;
+            for (const Node* p = pRoot; p; )
+                if (pNode->data.first < p->data.first)
+                {
+                    pNext = p;
+                    p = p->pLeft;
+                }
+                else
+                    p = p->pRight;
+            pNode = pNext;
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+        // the largest key below ours, or the largest of all from the end
+        iterator& operator -- ()
+        {
+            const Node* pPrev = nullptr;
+            for (const Node* p = pRoot; p; )
+                if (!pNode || p->data.first < pNode->data.first)
+                {
+                    pPrev = p;
+                    p = p->pRight;
+                }
+                else
+                    p = p->pLeft;
+            pNode = pPrev;
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        const Node* pRoot;         // the version we are walking
+        const Node* pNode;         // where we are, nullptr at the end
+    };
+
+
+    /*********************************************
+     * PERSISTENT MAP :: RETAIN
+     * One more holder of p
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::retain(Node* p) noexcept
+    {
+        if (p)
+            p->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: RELEASE
+     * One fewer holder of p. The last one out frees it, and lets go
+     * of its children in turn.
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::release(Node* p) noexcept
+    {
+        if (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            release(p->pLeft);
+            release(p->pRight);
+            delete p;
+        }
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: OWN
+     * Make p safe to change. The caller holds the only path to p, so
+     * if nobody else holds p either we may change it in place.
+     * Otherwise p is replaced with a private copy that shares p's
+     * children.
+     ********************************************/
+    template <class K, class V>
+    typename persistent_map <K, V> ::Node* persistent_map <K, V> ::own(Node*& p)
+    {
+        if (p->refs.load(std::memory_order_acquire) != 1)
+        {
+            Node* pCopy = new Node(*p);
+            release(p);
+            p = pCopy;
+        }
+        return p;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: UPDATE
+     * Recompute the height of an owned node from its children
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::update(Node* p)
+    {
+        int hLeft = height(p->pLeft);
+        int hRight = height(p->pRight);
+        p->height = 1 + (hLeft > hRight ? hLeft : hRight);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ROTATE LEFT
+     * The right child of an owned node takes its place
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::rotateLeft(Node*& p)
+    {
+        Node* pRight = own(p->pRight);
+        p->pRight = pRight->pLeft;
+        pRight->pLeft = p;
+        update(p);
+        update(pRight);
+        p = pRight;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ROTATE RIGHT
+     * The left child of an owned node takes its place
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::rotateRight(Node*& p)
+    {
+        Node* pLeft = own(p->pLeft);
+        p->pLeft = pLeft->pRight;
+        pLeft->pRight = p;
+        update(p);
+        update(pLeft);
+        p = pLeft;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: REBALANCE
+     * Restore the AVL property at an owned node whose subtrees
+     * differ in height by at most two
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::rebalance(Node*& p)
+    {
+        update(p);
+        int balance = height(p->pLeft) - height(p->pRight);
+        if (balance > 1)
+        {
+            if (height(p->pLeft->pLeft) < height(p->pLeft->pRight))
+            {
+                own(p->pLeft);
+                rotateLeft(p->pLeft);
+            }
+            rotateRight(p);
+        }
+        else if (balance < -1)
+        {
+            if (height(p->pRight->pRight) < height(p->pRight->pLeft))
+            {
+                own(p->pRight);
+                rotateRight(p->pRight);
+            }
+            rotateLeft(p);
+        }
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: FIND NODE
+     ********************************************/
+    template <class K, class V>
+    const typename persistent_map <K, V> ::Node* persistent_map <K, V> ::findNode(const Node* p, const K& k)
+    {
+        while (p)
+        {
+            if (k < p->data.first)
+                p = p->pLeft;
+            else if (p->data.first < k)
+                p = p->pRight;
+            else
+                return p;
+        }
+        return nullptr;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: BEGIN
+     ********************************************/
+    template <class K, class V>
+    typename persistent_map <K, V> ::iterator persistent_map <K, V> ::begin() const
+    {
+        const Node* p = root;
+        while (p && p->pLeft)
+            p = p->pLeft;
+        return iterator(root, p);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: FIND
+     ********************************************/
+    template <class K, class V>
+    typename persistent_map <K, V> ::iterator persistent_map <K, V> ::find(const K& k) const
+    {
+        return iterator(root, findNode(root, k));
+    }
+
+    /*****************************************************
+     * PERSISTENT MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <class K, class V>
+    const V& persistent_map <K, V> ::at(const K& k) const
+    {
+        const Node* p = findNode(root, k);
+        if (!p)
+            throw std::out_of_range("invalid map<K, T> key");
+        return p->data.second;
+    }
+
+    /*****************************************************
+     * PERSISTENT MAP :: SUBSCRIPT
+     * A value we may change, so every node on the path to it must be
+     * ours. A missing key is inserted with a default value.
+     ****************************************************/
+    template <class K, class V>
+    V& persistent_map <K, V> ::operator [] (const K& k)
+    {
+        if (!findNode(root, k))
+        {
+            numElements++;
+            return insertNode(root, Pairs(k, V()))->data.second;
+        }
+        return ownPath(root, k);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: INSERT
+     * Nothing is copied if the key is already there
+     ********************************************/
+    template <class K, class V>
+    custom::pair<typename persistent_map <K, V> ::iterator, bool> persistent_map <K, V> ::insert(const Pairs& rhs)
+    {
+        const Node* p = findNode(root, rhs.first);
+        if (p)
+            return custom::pair<iterator, bool>(iterator(root, p), false);
+        p = insertNode(root, rhs);
+        numElements++;
+        return custom::pair<iterator, bool>(iterator(root, p), true);
+    }
+    template <class K, class V>
+    custom::pair<typename persistent_map <K, V> ::iterator, bool> persistent_map <K, V> ::insert(Pairs&& rhs)
+    {
+        const Node* p = findNode(root, rhs.first);
+        if (p)
+            return custom::pair<iterator, bool>(iterator(root, p), false);
+        p = insertNode(root, std::move(rhs));
+        numElements++;
+        return custom::pair<iterator, bool>(iterator(root, p), true);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: INSERT NODE
+     * Add an element whose key is not in the subtree, owning every
+     * node on the way down. Returns the new node.
+     ********************************************/
+    template <class K, class V>
+    template <class P>
+    typename persistent_map <K, V> ::Node* persistent_map <K, V> ::insertNode(Node*& p, P&& element)
+    {
+        if (!p)
+            return p = new Node(std::forward<P>(element));
+
+        own(p);
+        Node* pNew = (element.first < p->data.first) ?
+            insertNode(p->pLeft, std::forward<P>(element)) :
+            insertNode(p->pRight, std::forward<P>(element));
+        rebalance(p);
+        return pNew;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: OWN PATH
+     * Own every node from p down to the one with key k, which is
+     * known to be there, and return its value
+     ********************************************/
+    template <class K, class V>
+    V& persistent_map <K, V> ::ownPath(Node*& p, const K& k)
+    {
+        Node** pp = &p;
+        while (true)
+        {
+            Node* pNode = own(*pp);
+            if (k < pNode->data.first)
+                pp = &pNode->pLeft;
+            else if (pNode->data.first < k)
+                pp = &pNode->pRight;
+            else
+                return pNode->data.second;
+        }
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ERASE
+     * Nothing is copied if the key is not there
+     ********************************************/
+    template <class K, class V>
+    size_t persistent_map <K, V> ::erase(const K& k)
+    {
+        if (!findNode(root, k))
+            return 0;
+        eraseNode(root, k);
+        numElements--;
+        return 1;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ERASE
+     * Remove the element at it and return the one after it
+     ********************************************/
+    template <class K, class V>
+    typename persistent_map <K, V> ::iterator persistent_map <K, V> ::erase(const iterator& it)
+    {
+        iterator itNext = it;
+        ++itNext;
+        if (itNext == end())
+        {
+            erase(it->first);
+            return end();
+        }
+
+        // the next element may be copied by the erase, so find it again
+        K kNext(itNext->first);
+        erase(it->first);
+        return find(kNext);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ERASE
+     * Remove [first, last)
+     ********************************************/
+    template <class K, class V>
+    typename persistent_map <K, V> ::iterator persistent_map <K, V> ::erase(iterator first, const iterator& last)
+    {
+        if (last == end())
+        {
+            while (first != end())
+                first = erase(first);
+            return first;
+        }
+
+        K kLast(last->first);
+        while (first != end() && first->first < kLast)
+            first = erase(first);
+        return first;
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ERASE NODE
+     * Remove the key, which is known to be in the subtree, owning
+     * every node on the way down
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::eraseNode(Node*& p, const K& k)
+    {
+        bool found = !(k < p->data.first) && !(p->data.first < k);
+
+        // one child or none: the child takes this one's place, no copy needed
+        if (found && !(p->pLeft && p->pRight))
+        {
+            Node* pChild = p->pLeft ? p->pLeft : p->pRight;
+            retain(pChild);
+            release(p);
+            p = pChild;
+            return;
+        }
+
+        own(p);
+        if (found)
+            // two children: the next element up takes this one's place
+            eraseMin(p->pRight, p->data);
+        else if (k < p->data.first)
+            eraseNode(p->pLeft, k);
+        else
+            eraseNode(p->pRight, k);
+        rebalance(p);
+    }
+
+    /*********************************************
+     * PERSISTENT MAP :: ERASE MIN
+     * Remove the smallest element of a subtree, handing it to min
+     ********************************************/
+    template <class K, class V>
+    void persistent_map <K, V> ::eraseMin(Node*& p, Pairs& min)
+    {
+        own(p);
+        if (p->pLeft)
+        {
+            eraseMin(p->pLeft, min);
+            rebalance(p);
+            return;
+        }
+
+        // ours alone now, so its element may be moved out
+        min = std::move(p->data);
+        Node* pRight = p->pRight;
+        retain(pRight);
+        release(p);
+        p = pRight;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two persistent maps
+     ****************************************************/
+    template <class K, class V>
+    void swap(persistent_map <K, V>& lhs, persistent_map <K, V>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
@@ -0,0 +1,774 @@
+/***********************************************************************
+ * Header:
+ *    SERIALIZE
+ * Summary:
+ *    Save vectors, sets, and maps of trivially copyable elements in a
+ *    binary column format, and load them back from a stream or from
+ *    a memory-mapped file
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the definition of:
+ *        save                : Write a container to a stream
+ *        load                : Read a container from a stream or a mapped file
+ *        mapped_file         : A read-only file mapped into memory
+ *        set_view            : A sorted set read in place from a mapped file
+ *        map_view            : A sorted map read in place from a mapped file
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>        // for std::lower_bound
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint16_t, uint32_t, uint64_t
+#include <cstring>          // for memcpy, memcmp
+#include <istream>
+#include <iterator>         // for std::forward_iterator_tag
+#include <ostream>
+#include <stdexcept>        // for std::runtime_error, std::out_of_range
+#include <string>
+#include <type_traits>      // for std::is_trivially_copyable
+#include "pair.h"           // for custom::pair
+#include "vector.h"         // for custom::vector
+#include "set.h"            // for custom::set
+#include "map.h"            // for custom::map
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>          // for open
+#include <sys/mman.h>       // for mmap
+#include <sys/stat.h>       // for fstat
+#include <unistd.h>         // for close
+#endif
+
+class TestSerialize; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * SERIAL HEADER
+     * The first 40 bytes of every file. After it come the elements
+     * (or keys) packed end to end, padded to 8 bytes. A map file then
+     * has its values, also padded. Each column starts 8-byte aligned,
+     * so a mapped file can be read in place.
+     *
+     * Numbers are in the byte order of the machine that wrote them.
+     * byteOrder tells a reader on another machine to refuse the file.
+     *****************************************************************/
+    struct serial_header
+    {
+        char     magic[4];        // "CSER"
+        uint16_t version;         // 1
+        uint16_t kind;            // which container, a serial_kind
+        uint32_t byteOrder;       // 0x01020304 as the writer saw it
+        uint32_t keySize;         // sizeof an element or a key
+        uint32_t valueSize;       // sizeof a value, 0 if not a map
+        uint32_t reserved;        // 0
+        uint64_t count;           // number of elements
+        uint64_t checksum;        // of the columns, padding excluded
+    };
+    static_assert(sizeof(serial_header) == 40, "serial_header must have no padding");
+
+    enum class serial_kind : uint16_t { vector = 1, set = 2, map = 3 };
+
+    /*****************************************************************
+     * CHECKSUM
+     * FNV-1a over 64-bit words, with an extra shift so the high bits
+     * reach the low ones. It is there to catch a truncated or damaged
+     * file, not a malicious one. Feeding the bytes in pieces gives the
+     * same answer as feeding them all at once.
+     *****************************************************************/
+    class Checksum
+    {
+    public:
+        Checksum() : hash(0xcbf29ce484222325ull), numTail(0), length(0) {}
+
+        void add(const void* p, size_t n)
+        {
+            const unsigned char* pByte = static_cast<const unsigned char*>(p);
+            length += n;
+
+            // finish the word left over from last time
+            while (n && numTail)
+            {
+                tail[numTail++] = *pByte++;
+                n--;
+                if (numTail == 8)
+                {
+                    mixTail();
+                    numTail = 0;
+                }
+            }
+
+            // then whole words
+            for (; n >= 8; n -= 8, pByte += 8)
+            {
+                uint64_t word;
+                memcpy(&word, pByte, 8);
+                mix(word);
+            }
+
+            // and keep the rest for next time; the tail is empty if any is left
+            if (n)
+            {
+                memcpy(tail, pByte, n);
+                numTail = n;
+            }
+        }
+
+        uint64_t value() const
+        {
+            Checksum copy(*this);
+            if (copy.numTail)
+            {
+                memset(copy.tail + copy.numTail, 0, 8 - copy.numTail);
+                copy.mixTail();
+            }
+            copy.mix(length);
+            return copy.hash;
+        }
+
+    private:
+        void mix(uint64_t word)
+        {
+            hash = (hash ^ word) * 0x100000001b3ull;
+            hash ^= hash >> 29;
+        }
+        void mixTail()
+        {
+            uint64_t word;
+            memcpy(&word, tail, 8);
+            mix(word);
+        }
+
+        uint64_t      hash;
+        unsigned char tail[8];     // bytes not yet a whole word
+        size_t        numTail;
+        uint64_t      length;      // bytes seen so far
+    };
+
+    /*****************************************************************
+     * SERIAL
+     * What save and load share
+     *****************************************************************/
+    namespace serial
+    {
+        const uint32_t byteOrder = 0x01020304;
+
+        inline size_t padded(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+        inline uint64_t combine(const Checksum& keys, const Checksum& values)
+        {
+            return keys.value() ^ (values.value() * 0x9E3779B97F4A7C15ull);
+        }
+
+        inline serial_header makeHeader(serial_kind kind, size_t keySize, size_t valueSize,
+                                        size_t count, uint64_t checksum)
+        {
+            serial_header header;
+            memcpy(header.magic, "CSER", 4);
+            header.version = 1;
+            header.kind = static_cast<uint16_t>(kind);
+            header.byteOrder = byteOrder;
+            header.keySize = static_cast<uint32_t>(keySize);
+            header.valueSize = static_cast<uint32_t>(valueSize);
+            header.reserved = 0;
+            header.count = count;
+            header.checksum = checksum;
+            return header;
+        }
+
+        // throw unless the header describes this kind of container
+        inline void check(const serial_header& header, serial_kind kind, size_t keySize, size_t valueSize)
+        {
+            if (memcmp(header.magic, "CSER", 4) != 0 || header.version != 1)
+                throw std::runtime_error("custom::load: not a container file");
+            if (header.byteOrder != byteOrder)
+                throw std::runtime_error("custom::load: file was written with another byte order");
+            if (header.kind != static_cast<uint16_t>(kind))
+                throw std::runtime_error("custom::load: file holds a different kind of container");
+            if (header.keySize != keySize || header.valueSize != valueSize)
+                throw std::runtime_error("custom::load: element sizes do not match");
+        }
+
+        // the bytes a file with this header takes
+        inline uint64_t fileSize(const serial_header& header)
+        {
+            return sizeof(serial_header) +
+                   padded(header.count * header.keySize) +
+                   padded(header.count * header.valueSize);
+        }
+
+        /*************************************************
+         * WRITER
+         * Gathers small writes into 64K ones
+         *************************************************/
+        class Writer
+        {
+        public:
+            Writer(std::ostream& out) : out(out), buffer(65536), used(0) {}
+            ~Writer() { flush(); }
+
+            void write(const void* p, size_t n)
+            {
+                if (used + n > buffer.size())
+                    flush();
+                if (n > buffer.size())
+                    out.write(static_cast<const char*>(p), n);
+                else
+                {
+                    memcpy(&buffer[used], p, n);
+                    used += n;
+                }
+            }
+            void pad(size_t bytes)
+            {
+                static const char zeros[8] = {};
+                write(zeros, padded(bytes) - bytes);
+            }
+            void flush()
+            {
+                if (used)
+                    out.write(&buffer[0], used);
+                used = 0;
+            }
+
+        private:
+            std::ostream& out;
+            custom::vector<char> buffer;
+            size_t used;
+        };
+
+        // read exactly n bytes or throw
+        inline void read(std::istream& in, void* p, size_t n)
+        {
+            if (n && !in.read(static_cast<char*>(p), n))
+                throw std::runtime_error("custom::load: file is truncated");
+        }
+        inline void skip(std::istream& in, size_t bytes)
+        {
+            char pad[8];
+            read(in, pad, padded(bytes) - bytes);
+        }
+    }
+
+
+    /*****************************************************************
+     * MAPPED FILE
+     * A whole file mapped read-only into memory. The operating system
+     * pages it in as it is touched, so opening a large file is nearly
+     * free and a view only pays for what it reads.
+     *****************************************************************/
+    class mapped_file
+    {
+        friend class ::TestSerialize; // give unit tests access to the privates
+    public:
+        explicit mapped_file(const std::string& path);
+        mapped_file(mapped_file&& rhs) noexcept : pData(rhs.pData), numBytes(rhs.numBytes)
+        {
+            rhs.pData = nullptr;
+            rhs.numBytes = 0;
+        }
+        mapped_file(const mapped_file& rhs) = delete;
+        mapped_file& operator = (const mapped_file& rhs) = delete;
+        ~mapped_file();
+
+        const unsigned char* data() const noexcept { return pData; }
+        size_t size() const noexcept { return numBytes; }
+
+        // the header, checked against what the caller expects
+        const serial_header& header(serial_kind kind, size_t keySize, size_t valueSize) const;
+
+    private:
+        const unsigned char* pData;
+        size_t numBytes;
+    };
+
+    /*********************************************
+     * MAPPED FILE :: CONSTRUCTOR
+     ********************************************/
+    inline mapped_file::mapped_file(const std::string& path) : pData(nullptr), numBytes(0)
+    {
+#if defined(_WIN32)
+        HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("custom::mapped_file: cannot open " + path);
+        LARGE_INTEGER size;
+        HANDLE hMapping = nullptr;
+        if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+            hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(hFile);
+        if (!hMapping)
+            throw std::runtime_error("custom::mapped_file: cannot map " + path);
+        pData = static_cast<const unsigned char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(hMapping);    // the view keeps the mapping alive
+        if (!pData)
+            throw std::runtime_error("custom::mapped_file: cannot map " + path);
+        numBytes = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("custom::mapped_file: cannot open " + path);
+        struct stat status;
+        void* p = MAP_FAILED;
+        if (fstat(fd, &status) == 0 && status.st_size > 0)
+            p = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);                // the mapping keeps the file alive
+        if (p == MAP_FAILED)
+            throw std::runtime_error("custom::mapped_file: cannot map " + path);
+        pData = static_cast<const unsigned char*>(p);
+        numBytes = static_cast<size_t>(status.st_size);
+#endif
+    }
+
+    /*********************************************
+     * MAPPED FILE :: DESTRUCTOR
+     ********************************************/
+    inline mapped_file:: ~mapped_file()
+    {
+        if (!pData)
+            return;
+#if defined(_WIN32)
+        UnmapViewOfFile(pData);
+#else
+        munmap(const_cast<unsigned char*>(pData), numBytes);
+#endif
+    }
+
+    /*********************************************
+     * MAPPED FILE :: HEADER
+     ********************************************/
+    inline const serial_header& mapped_file::header(serial_kind kind, size_t keySize, size_t valueSize) const
+    {
+        if (numBytes < sizeof(serial_header))
+            throw std::runtime_error("custom::load: file is truncated");
+        const serial_header& header = *reinterpret_cast<const serial_header*>(pData);
+        serial::check(header, kind, keySize, valueSize);
+        if (numBytes < serial::fileSize(header))
+            throw std::runtime_error("custom::load: file is truncated");
+        return header;
+    }
+
+
+    /*****************************************************************
+     * SET VIEW
+     * The elements of a saved set, sorted, searched where they lie in
+     * the mapped file. Nothing is copied. The file must outlive the
+     * view.
+     *****************************************************************/
+    template <class T>
+    class set_view
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "set_view needs trivially copyable elements");
+        static_assert(alignof(T) <= 8, "set_view reads columns aligned to 8 bytes");
+    public:
+        explicit set_view(const mapped_file& file, bool verify = true);
+
+        const T* begin() const noexcept { return pElements; }
+        const T* end()   const noexcept { return pElements + numElements; }
+        const T& operator [] (size_t i) const { return pElements[i]; }
+
+        const T* lower_bound(const T& t) const { return std::lower_bound(begin(), end(), t); }
+        const T* find(const T& t) const
+        {
+            const T* p = lower_bound(t);
+            return (p != end() && !(t < *p)) ? p : end();
+        }
+        bool contains(const T& t) const { return find(t) != end(); }
+
+        size_t size()  const noexcept { return numElements; }
+        bool   empty() const noexcept { return numElements == 0; }
+
+    private:
+        const T* pElements;
+        size_t   numElements;
+    };
+
+    /*********************************************
+     * SET VIEW :: CONSTRUCTOR
+     * Checking the sum reads the whole file; skip
+     * it to pay only for the pages a search touches
+     ********************************************/
+    template <class T>
+    set_view <T> ::set_view(const mapped_file& file, bool verify)
+    {
+        const serial_header& header = file.header(serial_kind::set, sizeof(T), 0);
+        pElements = reinterpret_cast<const T*>(file.data() + sizeof(serial_header));
+        numElements = static_cast<size_t>(header.count);
+        if (verify)
+        {
+            Checksum keys;
+            Checksum values;
+            keys.add(pElements, numElements * sizeof(T));
+            if (serial::combine(keys, values) != header.checksum)
+                throw std::runtime_error("custom::load: checksum does not match");
+        }
+    }
+
+
+    /*****************************************************************
+     * MAP VIEW
+     * The keys and values of a saved map, in two sorted columns,
+     * searched where they lie in the mapped file. Nothing is copied.
+     * The file must outlive the view.
+     *****************************************************************/
+    template <class K, class V>
+    class map_view
+    {
+        static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                      "map_view needs trivially copyable keys and values");
+        static_assert(alignof(K) <= 8 && alignof(V) <= 8, "map_view reads columns aligned to 8 bytes");
+    public:
+        using Pairs = custom::pair<K, V>;
+        class iterator;
+
+        explicit map_view(const mapped_file& file, bool verify = true);
+
+        iterator begin() const noexcept { return iterator(pKeys, pValues); }
+        iterator end()   const noexcept { return iterator(pKeys + numElements, pValues + numElements); }
+
+        iterator find(const K& k) const;
+        const V& at(const K& k) const
+        {
+            iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("invalid map<K, T> key");
+            return it.value();
+        }
+        bool contains(const K& k) const { return find(k) != end(); }
+
+        const K* keys()   const noexcept { return pKeys; }
+        const V* values() const noexcept { return pValues; }
+        size_t size()  const noexcept { return numElements; }
+        bool   empty() const noexcept { return numElements == 0; }
+
+    private:
+        const K* pKeys;
+        const V* pValues;
+        size_t   numElements;
+    };
+
+    /**********************************************************
+     * MAP VIEW ITERATOR
+     * A key and the value in the same row of the other column.
+     * Dereferencing builds the pair, which is cheap for
+     * trivially copyable types.
+     *********************************************************/
+    template <class K, class V>
+    class map_view <K, V> ::iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Pairs;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Pairs*;
+        using reference = Pairs;
+
+        iterator() : pKey(nullptr), pValue(nullptr) {}
+        iterator(const K* pKey, const V* pValue) : pKey(pKey), pValue(pValue) {}
+
+        bool operator == (const iterator& rhs) const { return pKey == rhs.pKey; }
+        bool operator != (const iterator& rhs) const { return pKey != rhs.pKey; }
+
+        Pairs operator * () const { return Pairs(*pKey, *pValue); }
+        const K& key()   const { return *pKey; }
+        const V& value() const { return *pValue; }
+
+        iterator& operator ++ ()
+        {
+            ++pKey;
+            ++pValue;
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+    private:
+        const K* pKey;
+        const V* pValue;
+    };
+
+    /*********************************************
+     * MAP VIEW :: CONSTRUCTOR
+     ********************************************/
+    template <class K, class V>
+    map_view <K, V> ::map_view(const mapped_file& file, bool verify)
+    {
+        const serial_header& header = file.header(serial_kind::map, sizeof(K), sizeof(V));
+        numElements = static_cast<size_t>(header.count);
+        pKeys = reinterpret_cast<const K*>(file.data() + sizeof(serial_header));
+        pValues = reinterpret_cast<const V*>(file.data() + sizeof(serial_header) +
+                                             serial::padded(numElements * sizeof(K)));
+        if (verify)
+        {
+            Checksum keys;
+            Checksum values;
+            keys.add(pKeys, numElements * sizeof(K));
+            values.add(pValues, numElements * sizeof(V));
+            if (serial::combine(keys, values) != header.checksum)
+                throw std::runtime_error("custom::load: checksum does not match");
+        }
+    }
+
+    /*********************************************
+     * MAP VIEW :: FIND
+     * Binary search of the key column
+     ********************************************/
+    template <class K, class V>
+    typename map_view <K, V> ::iterator map_view <K, V> ::find(const K& k) const
+    {
+        const K* pKey = std::lower_bound(pKeys, pKeys + numElements, k);
+        if (pKey == pKeys + numElements || k < *pKey)
+            return end();
+        return iterator(pKey, pValues + (pKey - pKeys));
+    }
+
+
+    /*****************************************************
+     * SAVE
+     * A vector: its elements, as they are
+     ****************************************************/
+    template <class T, class A>
+    void save(std::ostream& out, const vector <T, A>& v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "save needs trivially copyable elements");
+        size_t bytes = v.size() * sizeof(T);
+        Checksum keys;
+        Checksum values;
+        if (bytes)
+            keys.add(&v[0], bytes);
+
+        serial_header header = serial::makeHeader(serial_kind::vector, sizeof(T), 0, v.size(),
+                                                  serial::combine(keys, values));
+        {
+            serial::Writer writer(out);
+            writer.write(&header, sizeof(header));
+            if (bytes)
+                writer.write(&v[0], bytes);
+            writer.pad(bytes);
+        }
+        if (!out)
+            throw std::runtime_error("custom::save: write failed");
+    }
+
+    /*****************************************************
+     * SAVE
+     * A set: its elements, in order. One pass for the
+     * checksum, which goes in the header, and one to write.
+     ****************************************************/
+    template <class T>
+    void save(std::ostream& out, const set <T>& s)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "save needs trivially copyable elements");
+        Checksum keys;
+        Checksum values;
+        for (typename set <T> ::iterator it = s.begin(); it != s.end(); ++it)
+            keys.add(&*it, sizeof(T));
+
+        serial_header header = serial::makeHeader(serial_kind::set, sizeof(T), 0, s.size(),
+                                                  serial::combine(keys, values));
+        {
+            serial::Writer writer(out);
+            writer.write(&header, sizeof(header));
+            for (typename set <T> ::iterator it = s.begin(); it != s.end(); ++it)
+                writer.write(&*it, sizeof(T));
+            writer.pad(s.size() * sizeof(T));
+        }
+        if (!out)
+            throw std::runtime_error("custom::save: write failed");
+    }
+
+    /*****************************************************
+     * SAVE
+     * A map: the keys in order, then the values in the
+     * same order
+     ****************************************************/
+    template <class K, class V>
+    void save(std::ostream& out, const map <K, V>& m)
+    {
+        static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                      "save needs trivially copyable keys and values");
+        Checksum keys;
+        Checksum values;
+        for (typename map <K, V> ::iterator it = m.begin(); it != m.end(); ++it)
+        {
+            keys.add(&(*it).first, sizeof(K));
+            values.add(&(*it).second, sizeof(V));
+        }
+
+        serial_header header = serial::makeHeader(serial_kind::map, sizeof(K), sizeof(V), m.size(),
+                                                  serial::combine(keys, values));
+        {
+            serial::Writer writer(out);
+            writer.write(&header, sizeof(header));
+            for (typename map <K, V> ::iterator it = m.begin(); it != m.end(); ++it)
+                writer.write(&(*it).first, sizeof(K));
+            writer.pad(m.size() * sizeof(K));
+            for (typename map <K, V> ::iterator it = m.begin(); it != m.end(); ++it)
+                writer.write(&(*it).second, sizeof(V));
+            writer.pad(m.size() * sizeof(V));
+        }
+        if (!out)
+            throw std::runtime_error("custom::save: write failed");
+    }
+
+
+    /*****************************************************
+     * LOAD
+     * A vector from a stream, straight into its buffer.
+     * The vector is only changed if the whole file is good.
+     ****************************************************/
+    template <class T, class A>
+    void load(std::istream& in, vector <T, A>& v)
+    {
+        serial_header header;
+        serial::read(in, &header, sizeof(header));
+        serial::check(header, serial_kind::vector, sizeof(T), 0);
+
+        vector <T, A> elements(static_cast<size_t>(header.count));
+        size_t bytes = elements.size() * sizeof(T);
+        if (bytes)
+            serial::read(in, &elements[0], bytes);
+        serial::skip(in, bytes);
+
+        Checksum keys;
+        Checksum values;
+        if (bytes)
+            keys.add(&elements[0], bytes);
+        if (serial::combine(keys, values) != header.checksum)
+            throw std::runtime_error("custom::load: checksum does not match");
+        v.swap(elements);
+    }
+
+    /*****************************************************
+     * LOAD
+     * A set from a stream: read the column, then build
+     * the tree from it in O(n)
+     ****************************************************/
+    template <class T>
+    void load(std::istream& in, set <T>& s)
+    {
+        vector <T> elements;
+        serial_header header;
+        serial::read(in, &header, sizeof(header));
+        serial::check(header, serial_kind::set, sizeof(T), 0);
+
+        elements.resize(static_cast<size_t>(header.count));
+        size_t bytes = elements.size() * sizeof(T);
+        if (bytes)
+            serial::read(in, &elements[0], bytes);
+        serial::skip(in, bytes);
+
+        Checksum keys;
+        Checksum values;
+        if (bytes)
+            keys.add(&elements[0], bytes);
+        if (serial::combine(keys, values) != header.checksum)
+            throw std::runtime_error("custom::load: checksum does not match");
+        const T* pElements = bytes ? &elements[0] : nullptr;
+        s.assign_sorted(pElements, pElements + elements.size());
+    }
+
+    /*****************************************************
+     * LOAD
+     * A map from a stream: read both columns, then build
+     * the tree from them in O(n)
+     ****************************************************/
+    template <class K, class V>
+    void load(std::istream& in, map <K, V>& m)
+    {
+        serial_header header;
+        serial::read(in, &header, sizeof(header));
+        serial::check(header, serial_kind::map, sizeof(K), sizeof(V));
+
+        size_t count = static_cast<size_t>(header.count);
+        vector <K> keyColumn(count);
+        vector <V> valueColumn(count);
+        if (count)
+        {
+            serial::read(in, &keyColumn[0], count * sizeof(K));
+            serial::skip(in, count * sizeof(K));
+            serial::read(in, &valueColumn[0], count * sizeof(V));
+            serial::skip(in, count * sizeof(V));
+        }
+
+        Checksum keys;
+        Checksum values;
+        if (count)
+        {
+            keys.add(&keyColumn[0], count * sizeof(K));
+            values.add(&valueColumn[0], count * sizeof(V));
+        }
+        if (serial::combine(keys, values) != header.checksum)
+            throw std::runtime_error("custom::load: checksum does not match");
+
+        const K* pKeys = count ? &keyColumn[0] : nullptr;
+        const V* pValues = count ? &valueColumn[0] : nullptr;
+        m.assign_sorted(typename map_view <K, V> ::iterator(pKeys, pValues),
+                        typename map_view <K, V> ::iterator(pKeys + count, pValues + count));
+    }
+
+    /*****************************************************
+     * LOAD
+     * A vector from a mapped file: one copy, no parsing
+     ****************************************************/
+    template <class T, class A>
+    void load(const mapped_file& file, vector <T, A>& v)
+    {
+        const serial_header& header = file.header(serial_kind::vector, sizeof(T), 0);
+        size_t count = static_cast<size_t>(header.count);
+        const unsigned char* pElements = file.data() + sizeof(serial_header);
+
+        Checksum keys;
+        Checksum values;
+        keys.add(pElements, count * sizeof(T));
+        if (serial::combine(keys, values) != header.checksum)
+            throw std::runtime_error("custom::load: checksum does not match");
+
+        vector <T, A> elements(count);
+        if (count)
+            memcpy(&elements[0], pElements, count * sizeof(T));
+        v.swap(elements);
+    }
+
+    /*****************************************************
+     * LOAD
+     * A set from a mapped file, built in O(n) from the
+     * column where it lies
+     ****************************************************/
+    template <class T>
+    void load(const mapped_file& file, set <T>& s)
+    {
+        set_view <T> view(file);
+        s.assign_sorted(view.begin(), view.end());
+    }
+
+    /*****************************************************
+     * LOAD
+     * A map from a mapped file, built in O(n) from the
+     * columns where they lie
+     ****************************************************/
+    template <class K, class V>
+    void load(const mapped_file& file, map <K, V>& m)
+    {
+        map_view <K, V> view(file);
+        m.assign_sorted(view.begin(), view.end());
+    }
+
+}; // namespace custom
@@ -0,0 +1,349 @@
+/***********************************************************************
+* Header:
+*    Set
+* Summary:
+*      __       ____       ____         __
+*     /  |    .'    '.   .'    '.   _  / /
+*     `| |   |  .--.  | |  .--.  | (_)/ /
+*      | |   | |    | | | |    | |   / / _
+*     _| |_  |  `--'  | |  `--'  |  / / (_)
+*    |_____|  '.____.'   '.____.'  /_/
+*
+*    This will contain the class definition of:
+*        set                 : A class that represents a Set
+*        set::iterator       : An iterator through Set
+* Author
+*    Emilio Ordonez Guerrero, Austin Jesperson, Evan Riker
+************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <iostream>
+#include "bst.h"
+#include <memory>     // for std::allocator
+#include <functional> // for std::less
+
+class TestSet;        // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * SET
+ * A class that represents a Set
+ ***********************************************/
+template <typename T, class Compare = std::less<T>>
+class set
+{
+   friend class ::TestSet; // give unit tests access to the privates
+public:
+   
+   // 
+   // Construct
+   //
+   set() 
+   {
+   }
+   set(const set &  rhs)
+   {
+       // Assign rhs bst to this
+       bst = rhs.bst;
+   }
+
+   set(set && rhs) 
+   {
+       // Assign rhs bst to this
+       bst = std::move(rhs.bst);
+   }
+
+   set(const std::initializer_list <T> & il) 
+   {
+       // Use BST intializer list constructor
+       bst = custom::BST <T, Compare>(il);
+   }
+
+   template <class Iterator>
+   set(Iterator first, Iterator last) 
+   {
+       // Iterate from first to last
+       for (Iterator it = first; it != last; ++it)
+       {
+           // Insert each iterator using the bst.insert method
+           bst.insert(*it);
+       }
+   }
+  ~set() { }
+
+   //
+   // Assign
+   //
+
+   set & operator = (const set & rhs)
+   {
+       // Assign rhs.bst to this.bst
+       bst = rhs.bst;
+       return *this;
+   }
+   set & operator = (set && rhs)
+   {
+       // Assign rhs.bst to this.bst using std::move 
+       bst = std::move(rhs.bst);
+       return *this;
+   }
+   set & operator = (const std::initializer_list <T> & il)
+   {
+       // Clear the contents of the bst first
+       bst.clear();
+
+       // Use initializer list constructor from BST class. 
+       bst = custom::BST <T, Compare>(il);
+       return *this;
+   }
+   template <class Iterator>
+   void assign_sorted(Iterator first, Iterator last)
+   {
+       // Must be sorted with no repeats; builds a balanced tree in O(n)
+       bst.assign_sorted(first, last);
+   }
+
+   void swap(set& rhs) noexcept
+   {
+       // Swap the trees, and with them the comparators that order them
+       bst.swap(rhs.bst);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() const noexcept 
+   { 
+       // Return bst.begin() method
+       return bst.begin();
+   }
+   iterator end() const noexcept 
+   { 
+       // Return bst.end() method
+       return bst.end();
+   }
+
+   //
+   // Access
+   //
+   iterator find(const T& t) 
+   { 
+       // Return bst.find() method
+       return bst.find(t);
+   }
+   template <class Iterator, class OutputIterator>
+   OutputIterator find_batch(Iterator first, Iterator last, OutputIterator out)
+   {
+       // Let the bst run the searches side by side, handing back set iterators
+       bst.findBatch(first, last, bst.compare, [&out](typename custom::BST<T, Compare>::BNode* pNode)
+       {
+           *out = iterator(typename custom::BST<T, Compare>::iterator(pNode));
+           ++out;
+       });
+       return out;
+   }
+
+   //
+   // Status
+   //
+   bool   empty() const noexcept 
+   {
+       // Return bst.empty()
+       return bst.empty();
+   }
+   size_t size() const noexcept 
+   { 
+       // Return bst.size()
+       return bst.size();
+   }
+
+   //
+   // Insert
+   //
+   std::pair<iterator, bool> insert(const T& t)
+   {
+       // Use bst.insert, use true because we don't want duplicates
+       return bst.insert(t, true);
+   }
+   std::pair<iterator, bool> insert(T&& t)
+   {
+       // Use bst.insert, use true because we don't want duplicates
+       return bst.insert(std::move(t), true);
+   }
+   iterator insert(iterator hint, const T& t)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, t, true).first);
+   }
+   iterator insert(iterator hint, T&& t)
+   {
+       // Try next to the hint first, use true because we don't want duplicates
+       return iterator(bst.insert(hint.it, std::move(t), true).first);
+   }
+   template <class... Args>
+   iterator emplace_hint(iterator hint, Args&&... args)
+   {
+       return insert(hint, T(std::forward<Args>(args)...));
+   }
+   void insert(const std::initializer_list <T>& il)
+   {
+       // Iterate through each element in the initializer list
+       for (const T& element : il) 
+       {
+           // Insert each element using the bst.insert method, use true because we don't want duplicates
+           bst.insert(element, true);
+       }
+   }
+   template <class Iterator>
+   void insert(Iterator first, Iterator last)
+   {
+       // Iterate from first to last
+       for (Iterator it = first; it != last; ++it) 
+       {
+           // Try the end first, so a sorted range appends in O(1) each
+           bst.insert(bst.end(), *it, true);
+       }
+   }
+
+
+   //
+   // Remove
+   //
+   void clear() noexcept 
+   {
+       // Use bst.clear()
+       bst.clear();
+   }
+   iterator erase(iterator &it)
+   {
+       // Use bst.erase method, access the bst iterator within the set iterator
+       return bst.erase(it.it);
+   }
+   size_t erase(const T & t) 
+   {
+       // Find the element in the set
+       iterator it = find(t);
+
+       // If element is found, erase it and return 1 to indicate one element erased
+       if (it != end()) {
+           erase(it);
+           return 1;
+       }
+
+       // If element is not found, return 0 to indicate no elements were erased
+       return 0;
+   }
+   iterator erase(iterator &itBegin, iterator &itEnd)
+   {
+       // Use bst.erase on the range, elements are unique so it can cut by value
+       return bst.erase(itBegin.it, itEnd.it);
+   }
+
+   //
+   // Layout
+   //
+   void compact(bst_layout layout = bst_layout::in_order)
+   {
+       // Gather the nodes together after heavy churn; iterators are invalidated
+       bst.compact(layout);
+   }
+
+
+private:
+   
+   custom::BST <T, Compare> bst;
+};
+
+
+/**************************************************
+ * SET ITERATOR
+ * An iterator through Set
+ *************************************************/
+template <typename T, class Compare>
+class set <T, Compare> :: iterator
+{
+   friend class ::TestSet; // give unit tests access to the privates
+   friend class custom::set<T, Compare>;
+
+public:
+   // constructors, destructors, and assignment operator
+   iterator() 
+   {
+       it = nullptr;
+   }
+   iterator(const typename custom::BST<T, Compare>::iterator& itRHS) 
+   {
+       it = itRHS;
+   }
+   iterator(const iterator & rhs) 
+   {
+       it = rhs.it;
+   }
+   iterator & operator = (const iterator & rhs)
+   {
+       it = rhs.it;
+       return *this;
+   }
+
+   // equals, not equals operator
+   bool operator != (const iterator & rhs) const 
+   { 
+       return it != rhs.it;
+   }
+   bool operator == (const iterator & rhs) const 
+   { 
+       return it == rhs.it;
+   }
+
+   // dereference operator: by-reference so we can modify the Set
+   const T & operator * () const 
+   { 
+       return *it;
+   }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+       ++(it);
+       return *this;
+   }
+
+   // postfix increment
+   iterator operator++ (int postfix)
+   {
+      iterator temp = *this;
+      ++(*this);
+      return temp;
+   }
+   
+   // prefix decrement
+   iterator & operator -- ()
+   {
+       --(it);
+       return *this;
+   }
+   
+   // postfix decrement
+   iterator operator-- (int postfix)
+   {
+       iterator temp = *this;
+       --(*this);
+       return temp;
+   }
+   
+private:
+
+   typename custom::BST<T, Compare>::iterator it;
+};
+
+
+}; // namespace custom
+
+
+
@@ -0,0 +1,1329 @@
+/***********************************************************************
+ * Header:
+ *    SKIP LIST
+ * Summary:
+ *    Ordered containers kept in skip lists: a set and a map for one
+ *    thread, and a lock-free set for many
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        SkipList                : A skip list with pooled nodes
+ *        SkipList::iterator      : A forward iterator through a SkipList
+ *        skiplist_set            : A set with the interface of custom::set
+ *        skiplist_map            : A map with the interface of custom::map
+ *        concurrent_skiplist_set : A lock-free skip list set
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>           // for the lock-free links
+#include <cassert>
+#include <cstddef>          // for size_t, std::max_align_t
+#include <cstdint>          // for uint64_t, uintptr_t
+#include <functional>       // for std::hash
+#include <new>              // for placement new
+#include <stdexcept>        // for std::out_of_range
+#include <thread>           // for std::this_thread::get_id
+#include <utility>          // for std::pair, std::move, std::swap
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+
+class TestSkipList; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * SKIP LIST
+     * Sorted linked lists stacked on each other. Every element is in
+     * the bottom list, and each list up holds about a quarter of the
+     * one below, so a search drops down the levels in O(log n) steps.
+     *
+     * A node is one allocation: the element, its height, and then its
+     * links, one per level. Nodes come from a pool that carves them
+     * out of large blocks and keeps a free list for each height.
+     *
+     * KeyOf pulls the key out of an element: the element itself for a
+     * set, .first for a map.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf>
+    class SkipList
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+    public:
+        using key_type = K;
+        using value_type = T;
+
+        //
+        // Construct
+        //
+
+        SkipList();
+        SkipList(const SkipList& rhs);
+        SkipList(SkipList&& rhs) noexcept;
+        ~SkipList();
+
+        //
+        // Assign
+        //
+
+        SkipList& operator = (const SkipList& rhs);
+        SkipList& operator = (SkipList&& rhs) noexcept;
+        void swap(SkipList& rhs) noexcept;
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() const noexcept { return iterator(head->next()[0]); }
+        iterator end()   const noexcept { return iterator(nullptr); }
+
+        //
+        // Access
+        //
+
+        iterator find(const K& k) const;
+        iterator lower_bound(const K& k) const { return iterator(search(k, nullptr)); }
+        T& value(const iterator& it) const { return *it.pNode->data(); }
+
+        //
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t) { return emplaceKey(KeyOf()(t), t); }
+        std::pair<iterator, bool> insert(T&& t)
+        {
+            const K& k = KeyOf()(t);
+            return emplaceKey(k, std::move(t));
+        }
+        template <class ... Args>
+        std::pair<iterator, bool> emplaceKey(const K& k, Args&& ... args);
+
+        //
+        // Remove
+        //
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(iterator first, const iterator& last);
+        void     clear() noexcept;
+
+        //
+        // Status
+        //
+
+        bool   empty() const noexcept { return numElements == 0; }
+        size_t size()  const noexcept { return numElements; }
+
+    private:
+
+        struct Node;
+        class  Pool;
+
+        // with a quarter promoted per level, 32 levels covers 2^64 elements
+        static const size_t maxLevel = 32;
+
+        Node*    head;              // links only, no element
+        size_t   level;             // how many levels are in use
+        size_t   numElements;       // number of elements in the bottom list
+        uint64_t seed;              // state of the height generator
+        Pool     pool;              // where the nodes come from
+
+        size_t randomHeight();
+        Node*  search(const K& k, Node** preds) const;
+        void   unlink(Node* pNode, Node** preds);
+    };
+
+    /*****************************************************************
+     * SKIP LIST :: NODE
+     * The element in raw storage, then height links laid out right
+     * after the node in the same allocation. The head is a node whose
+     * element is never constructed.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf>
+    struct SkipList <K, T, KeyOf> ::Node
+    {
+        Node(size_t height) : height(height)
+        {
+            for (size_t i = 0; i < height; i++)
+                next()[i] = nullptr;
+        }
+        T*           data()       { return reinterpret_cast<T*>(storage); }
+        const T*     data() const { return reinterpret_cast<const T*>(storage); }
+        Node**       next()       { return reinterpret_cast<Node**>(this + 1); }
+        Node* const* next() const { return reinterpret_cast<Node* const*>(this + 1); }
+
+        // bytes for a node of a given height, the links included
+        static size_t bytes(size_t height)
+        {
+            size_t size = sizeof(Node) + height * sizeof(Node*);
+            return (size + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        }
+
+        alignas(T) unsigned char storage[sizeof(T)];
+        alignas(Node*) size_t height;
+    };
+
+    /*****************************************************************
+     * SKIP LIST :: POOL
+     * Nodes carved from 16K blocks, with a free list for each height
+     * so a freed node is reused by the next node of its height.
+     * Nothing goes back to the heap until the pool is released.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf>
+    class SkipList <K, T, KeyOf> ::Pool
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+        static_assert(alignof(Node) <= alignof(std::max_align_t),
+                      "a SkipList node must fit the alignment the heap gives");
+    public:
+        Pool() : pBlocks(nullptr), pNext(nullptr), remaining(0)
+        {
+            for (size_t i = 0; i <= maxLevel; i++)
+                freeLists[i] = nullptr;
+        }
+        Pool(const Pool& rhs) = delete;
+        Pool& operator = (const Pool& rhs) = delete;
+        ~Pool() { release(); }
+
+        void* allocate(size_t height);
+        void  deallocate(void* p, size_t height) noexcept
+        {
+            *static_cast<void**>(p) = freeLists[height];
+            freeLists[height] = p;
+        }
+        void  release() noexcept;
+        void  swap(Pool& rhs) noexcept
+        {
+            std::swap(pBlocks, rhs.pBlocks);
+            std::swap(pNext, rhs.pNext);
+            std::swap(remaining, rhs.remaining);
+            for (size_t i = 0; i <= maxLevel; i++)
+                std::swap(freeLists[i], rhs.freeLists[i]);
+        }
+
+    private:
+        // each block starts with a pointer to the one before it
+        static constexpr size_t header = sizeof(std::max_align_t);
+        static size_t blockSize()
+        {
+            size_t size = 16384;
+            return size > header + 8 * Node::bytes(maxLevel) ? size : header + 8 * Node::bytes(maxLevel);
+        }
+
+        void*          pBlocks;                  // the newest block
+        unsigned char* pNext;                    // the unused part of the newest block
+        size_t         remaining;                // how much of it there is
+        void*          freeLists[maxLevel + 1];  // freed nodes by height
+    };
+
+    /**********************************************************
+     * SKIP LIST ITERATOR
+     * A node in the bottom list; the end is nullptr. Only an
+     * erase of this element invalidates it.
+     *********************************************************/
+    template <typename K, typename T, typename KeyOf>
+    class SkipList <K, T, KeyOf> ::iterator
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+        friend class SkipList;
+    public:
+        iterator() : pNode(nullptr) {}
+        iterator(Node* pNode) : pNode(pNode) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode; }
+        bool operator != (const iterator& rhs) const { return pNode != rhs.pNode; }
+
+        const T& operator * () const { return *pNode->data(); }
+        const T* operator -> () const { return pNode->data(); }
+
+        iterator& operator ++ ()
+        {
+            pNode = pNode->next()[0];
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+    private:
+        Node* pNode;
+    };
+
+
+    /*********************************************
+     * SKIP LIST :: POOL :: ALLOCATE
+     * Reuse a node of this height if one was freed,
+     * otherwise cut a new one from the current block
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    void* SkipList <K, T, KeyOf> ::Pool::allocate(size_t height)
+    {
+        if (void* p = freeLists[height])
+        {
+            freeLists[height] = *static_cast<void**>(p);
+            return p;
+        }
+
+        size_t size = Node::bytes(height);
+        if (remaining < size)
+        {
+            void* pBlock = ::operator new(blockSize());
+            *static_cast<void**>(pBlock) = pBlocks;
+            pBlocks = pBlock;
+            pNext = static_cast<unsigned char*>(pBlock) + header;
+            remaining = blockSize() - header;
+        }
+        void* p = pNext;
+        pNext += size;
+        remaining -= size;
+        return p;
+    }
+
+    /*********************************************
+     * SKIP LIST :: POOL :: RELEASE
+     * Give every block back to the heap
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    void SkipList <K, T, KeyOf> ::Pool::release() noexcept
+    {
+        while (pBlocks)
+        {
+            void* pPrev = *static_cast<void**>(pBlocks);
+            ::operator delete(pBlocks);
+            pBlocks = pPrev;
+        }
+        pNext = nullptr;
+        remaining = 0;
+        for (size_t i = 0; i <= maxLevel; i++)
+            freeLists[i] = nullptr;
+    }
+
+    /*********************************************
+     * SKIP LIST :: DEFAULT CONSTRUCTOR
+     * The head is the only node that is not pooled,
+     * so two lists can swap pools and heads together
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf> ::SkipList() :
+        head(nullptr), level(0), numElements(0), seed(0x9E3779B97F4A7C15ull)
+    {
+        head = new (::operator new(Node::bytes(maxLevel))) Node(maxLevel);
+    }
+
+    /*********************************************
+     * SKIP LIST :: COPY CONSTRUCTOR
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf> ::SkipList(const SkipList& rhs) : SkipList()
+    {
+        *this = rhs;
+    }
+
+    /*********************************************
+     * SKIP LIST :: MOVE CONSTRUCTOR
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf> ::SkipList(SkipList&& rhs) noexcept : SkipList()
+    {
+        swap(rhs);
+    }
+
+    /*********************************************
+     * SKIP LIST :: DESTRUCTOR
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf> :: ~SkipList()
+    {
+        clear();
+        head->~Node();
+        ::operator delete(head);
+    }
+
+    /*********************************************
+     * SKIP LIST :: ASSIGNMENT OPERATOR
+     * rhs is already sorted, so each element is
+     * appended to the end of every level it reaches.
+     * The copy is built first so a throwing copy
+     * leaves us unchanged.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf>& SkipList <K, T, KeyOf> :: operator = (const SkipList& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        SkipList copy;
+        Node* tails[maxLevel];
+        for (size_t i = 0; i < maxLevel; i++)
+            tails[i] = copy.head;
+        for (const Node* p = rhs.head->next()[0]; p; p = p->next()[0])
+        {
+            size_t height = p->height;
+            void* pMemory = copy.pool.allocate(height);
+            Node* pNode = new (pMemory) Node(height);
+            try
+            {
+                new (pNode->data()) T(*p->data());
+            }
+            catch (...)
+            {
+                copy.pool.deallocate(pMemory, height);
+                throw;
+            }
+            for (size_t i = 0; i < height; i++)
+            {
+                tails[i]->next()[i] = pNode;
+                tails[i] = pNode;
+            }
+            copy.numElements++;
+        }
+        copy.level = rhs.level;
+        copy.seed = rhs.seed;
+        swap(copy);
+        return *this;
+    }
+
+    /*********************************************
+     * SKIP LIST :: MOVE ASSIGNMENT
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    SkipList <K, T, KeyOf>& SkipList <K, T, KeyOf> :: operator = (SkipList&& rhs) noexcept
+    {
+        clear();
+        swap(rhs);
+        return *this;
+    }
+
+    /*********************************************
+     * SKIP LIST :: SWAP
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    void SkipList <K, T, KeyOf> ::swap(SkipList& rhs) noexcept
+    {
+        std::swap(head, rhs.head);
+        std::swap(level, rhs.level);
+        std::swap(numElements, rhs.numElements);
+        std::swap(seed, rhs.seed);
+        pool.swap(rhs.pool);
+    }
+
+    /*********************************************
+     * SKIP LIST :: RANDOM HEIGHT
+     * One level, then another each time two random
+     * bits come up zero: a quarter reach level 2,
+     * a sixteenth level 3, and so on
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    size_t SkipList <K, T, KeyOf> ::randomHeight()
+    {
+        // xorshift64
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        uint64_t bits = seed;
+        size_t height = 1;
+        while ((bits & 3) == 0 && height < maxLevel)
+        {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    /*********************************************
+     * SKIP LIST :: SEARCH
+     * The first node at or above k. On the way down,
+     * preds (if given) gets the last node below k on
+     * every level in use.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    typename SkipList <K, T, KeyOf> ::Node* SkipList <K, T, KeyOf> ::search(const K& k, Node** preds) const
+    {
+        Node* p = head;
+        for (size_t i = level; i-- > 0; )
+        {
+            Node* pNext;
+            while ((pNext = p->next()[i]) && KeyOf()(*pNext->data()) < k)
+                p = pNext;
+            if (preds)
+                preds[i] = p;
+        }
+        return p->next()[0];
+    }
+
+    /*********************************************
+     * SKIP LIST :: FIND
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    typename SkipList <K, T, KeyOf> ::iterator SkipList <K, T, KeyOf> ::find(const K& k) const
+    {
+        Node* p = search(k, nullptr);
+        if (p && !(k < KeyOf()(*p->data())))
+            return iterator(p);
+        return end();
+    }
+
+    /*********************************************
+     * SKIP LIST :: EMPLACE KEY
+     * Build the element from args if k is not there
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    template <class ... Args>
+    std::pair<typename SkipList <K, T, KeyOf> ::iterator, bool> SkipList <K, T, KeyOf> ::emplaceKey(const K& k, Args&& ... args)
+    {
+        Node* preds[maxLevel];
+        Node* p = search(k, preds);
+        if (p && !(k < KeyOf()(*p->data())))
+            return std::pair<iterator, bool>(iterator(p), false);
+
+        size_t height = randomHeight();
+        void* pMemory = pool.allocate(height);
+        Node* pNode = new (pMemory) Node(height);
+        try
+        {
+            new (pNode->data()) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            pool.deallocate(pMemory, height);
+            throw;
+        }
+
+        // new levels start at the head
+        for (; level < height; level++)
+            preds[level] = head;
+        for (size_t i = 0; i < height; i++)
+        {
+            pNode->next()[i] = preds[i]->next()[i];
+            preds[i]->next()[i] = pNode;
+        }
+        numElements++;
+        return std::pair<iterator, bool>(iterator(pNode), true);
+    }
+
+    /*********************************************
+     * SKIP LIST :: UNLINK
+     * Take a node out of every level it is on, given
+     * the nodes just before it, and free it
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    void SkipList <K, T, KeyOf> ::unlink(Node* pNode, Node** preds)
+    {
+        for (size_t i = 0; i < pNode->height; i++)
+            preds[i]->next()[i] = pNode->next()[i];
+        while (level > 0 && head->next()[level - 1] == nullptr)
+            level--;
+
+        size_t height = pNode->height;
+        pNode->data()->~T();
+        pNode->~Node();
+        pool.deallocate(pNode, height);
+        numElements--;
+    }
+
+    /*********************************************
+     * SKIP LIST :: ERASE
+     * Remove the element with key k, if there is one
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    size_t SkipList <K, T, KeyOf> ::erase(const K& k)
+    {
+        Node* preds[maxLevel];
+        Node* p = search(k, preds);
+        if (!p || k < KeyOf()(*p->data()))
+            return 0;
+        unlink(p, preds);
+        return 1;
+    }
+
+    /*********************************************
+     * SKIP LIST :: ERASE
+     * Remove one element, returning the one after
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    typename SkipList <K, T, KeyOf> ::iterator SkipList <K, T, KeyOf> ::erase(const iterator& it)
+    {
+        iterator itNext(it.pNode->next()[0]);
+        erase(KeyOf()(*it));
+        return itNext;
+    }
+
+    /*********************************************
+     * SKIP LIST :: ERASE
+     * Remove [first, last). One search finds the
+     * nodes before first; they stay just before each
+     * node that follows, so the rest costs O(k).
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    typename SkipList <K, T, KeyOf> ::iterator SkipList <K, T, KeyOf> ::erase(iterator first, const iterator& last)
+    {
+        if (first == last)
+            return last;
+
+        Node* preds[maxLevel];
+        search(KeyOf()(*first), preds);
+        while (first != last)
+        {
+            Node* pNode = first.pNode;
+            ++first;
+            unlink(pNode, preds);
+        }
+        return last;
+    }
+
+    /*********************************************
+     * SKIP LIST :: CLEAR
+     * Destroy every element and hand the blocks back
+     ********************************************/
+    template <typename K, typename T, typename KeyOf>
+    void SkipList <K, T, KeyOf> ::clear() noexcept
+    {
+        for (Node* p = head->next()[0]; p; )
+        {
+            Node* pNext = p->next()[0];
+            p->data()->~T();
+            p->~Node();
+            p = pNext;
+        }
+        for (size_t i = 0; i < maxLevel; i++)
+            head->next()[i] = nullptr;
+        pool.release();
+        level = 0;
+        numElements = 0;
+    }
+
+
+    /*****************************************************************
+     * SKIP LIST SET
+     * A set with the interface of custom::set, kept in a SkipList
+     *****************************************************************/
+    template <typename T>
+    class skiplist_set
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+
+        struct KeyOf
+        {
+            const T& operator () (const T& t) const { return t; }
+        };
+    public:
+        using iterator = typename SkipList <T, T, KeyOf> ::iterator;
+
+        //
+        // Construct
+        //
+        skiplist_set() {}
+        skiplist_set(const skiplist_set& rhs) : list(rhs.list) {}
+        skiplist_set(skiplist_set&& rhs) : list(std::move(rhs.list)) {}
+        skiplist_set(const std::initializer_list <T>& il) { insert(il); }
+        template <class Iterator>
+        skiplist_set(Iterator first, Iterator last) { insert(first, last); }
+        ~skiplist_set() {}
+
+        //
+        // Assign
+        //
+        skiplist_set& operator = (const skiplist_set& rhs)
+        {
+            list = rhs.list;
+            return *this;
+        }
+        skiplist_set& operator = (skiplist_set&& rhs)
+        {
+            list = std::move(rhs.list);
+            return *this;
+        }
+        skiplist_set& operator = (const std::initializer_list <T>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(skiplist_set& rhs) noexcept { list.swap(rhs.list); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return list.begin(); }
+        iterator end()   const noexcept { return list.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const        { return list.find(t); }
+        iterator lower_bound(const T& t) const { return list.lower_bound(t); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return list.empty(); }
+        size_t size()  const noexcept { return list.size();  }
+
+        //
+        // Insert
+        //
+        std::pair<iterator, bool> insert(const T& t) { return list.insert(t); }
+        std::pair<iterator, bool> insert(T&& t)      { return list.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il)
+        {
+            for (const T& t : il)
+                list.insert(t);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                list.insert(*it);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { list.clear(); }
+        iterator erase(const iterator& it) { return list.erase(it); }
+        size_t erase(const T& t) { return list.erase(t); }
+        iterator erase(const iterator& itBegin, const iterator& itEnd) { return list.erase(itBegin, itEnd); }
+
+    private:
+        SkipList <T, T, KeyOf> list;
+    };
+
+
+    /*****************************************************************
+     * SKIP LIST MAP
+     * A map with the interface of custom::map, kept in a SkipList
+     *****************************************************************/
+    template <typename K, typename V>
+    class skiplist_map
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+    private:
+        struct KeyOf
+        {
+            const K& operator () (const Pairs& p) const { return p.first; }
+        };
+    public:
+        using iterator = typename SkipList <K, Pairs, KeyOf> ::iterator;
+
+        //
+        // Construct
+        //
+        skiplist_map() {}
+        skiplist_map(const skiplist_map& rhs) : list(rhs.list) {}
+        skiplist_map(skiplist_map&& rhs) : list(std::move(rhs.list)) {}
+        template <class Iterator>
+        skiplist_map(Iterator first, Iterator last) { insert(first, last); }
+        skiplist_map(const std::initializer_list <Pairs>& il) { insert(il); }
+        ~skiplist_map() {}
+
+        //
+        // Assign
+        //
+        skiplist_map& operator = (const skiplist_map& rhs)
+        {
+            list = rhs.list;
+            return *this;
+        }
+        skiplist_map& operator = (skiplist_map&& rhs)
+        {
+            list = std::move(rhs.list);
+            return *this;
+        }
+        skiplist_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(skiplist_map& rhs) noexcept { list.swap(rhs.list); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return list.begin(); }
+        iterator end()   const noexcept { return list.end();   }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k)
+        {
+            return list.value(list.emplaceKey(k, k, V()).first).second;
+        }
+        const V& at(const K& k) const;
+              V& at(const K& k);
+        iterator find(const K& k) const        { return list.find(k); }
+        iterator lower_bound(const K& k) const { return list.lower_bound(k); }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs)
+        {
+            std::pair<iterator, bool> result = list.insert(rhs);
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        custom::pair<iterator, bool> insert(Pairs&& rhs)
+        {
+            std::pair<iterator, bool> result = list.insert(std::move(rhs));
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                list.insert(*it);
+        }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                list.insert(element);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { list.clear(); }
+        size_t erase(const K& k) { return list.erase(k); }
+        iterator erase(const iterator& it) { return list.erase(it); }
+        iterator erase(const iterator& first, const iterator& last) { return list.erase(first, last); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return list.empty(); }
+        size_t size()  const noexcept { return list.size();  }
+
+    private:
+        SkipList <K, Pairs, KeyOf> list;
+    };
+
+    /*****************************************************
+     * SKIP LIST MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V>
+    V& skiplist_map <K, V> ::at(const K& k)
+    {
+        iterator it = list.find(k);
+        if (it == list.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return list.value(it).second;
+    }
+
+    /*****************************************************
+     * SKIP LIST MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V>
+    const V& skiplist_map <K, V> ::at(const K& k) const
+    {
+        iterator it = list.find(k);
+        if (it == list.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return (*it).second;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two skip list sets or two skip list maps
+     ****************************************************/
+    template <typename T>
+    void swap(skiplist_set <T>& lhs, skiplist_set <T>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V>
+    void swap(skiplist_map <K, V>& lhs, skiplist_map <K, V>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+
+    /*****************************************************************
+     * CONCURRENT SKIP LIST SET
+     * A skip list any number of threads may search, insert into, and
+     * erase from at once, with no locks. Links are atomic and a set low
+     * bit marks a link whose node is being erased.
+     *
+     * An erase marks the node's links top down; marking the bottom one
+     * is the moment it leaves the set. Any search that passes a marked
+     * node cuts it out. An insert links the bottom level first, which
+     * is the moment it joins the set, then the levels above.
+     *
+     * An erased node may still be in another thread's hands, so it is
+     * retired rather than freed. Retired nodes are freed by reclaim(),
+     * which may only be called while no other thread is using the set,
+     * and by the destructor.
+     *****************************************************************/
+    template <typename T>
+    class concurrent_skiplist_set
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+    public:
+
+        //
+        // Construct
+        //
+        concurrent_skiplist_set();
+        concurrent_skiplist_set(const std::initializer_list <T>& il) : concurrent_skiplist_set()
+        {
+            for (const T& t : il)
+                insert(t);
+        }
+        concurrent_skiplist_set(const concurrent_skiplist_set& rhs) = delete;
+        concurrent_skiplist_set& operator = (const concurrent_skiplist_set& rhs) = delete;
+        ~concurrent_skiplist_set();
+
+        //
+        // Iterator: sees every element there for the whole walk,
+        // and may or may not see ones inserted or erased during it
+        //
+        class iterator;
+        iterator begin() const;
+        iterator end()   const { return iterator(nullptr); }
+
+        //
+        // Access
+        //
+        bool     contains(const T& t) const;
+        iterator find(const T& t) const;
+        iterator lower_bound(const T& t) const;
+
+        //
+        // Insert and remove
+        //
+        bool   insert(const T& t);
+        size_t erase(const T& t);
+        void   reclaim();
+
+        //
+        // Status
+        //
+        size_t size()  const noexcept { return numElements.load(std::memory_order_relaxed); }
+        bool   empty() const noexcept { return size() == 0; }
+
+    private:
+
+        struct Node;
+        static const size_t maxLevel = 32;
+
+        Node*               head;          // links only, no element
+        std::atomic<size_t> numElements;   // elements not erased
+        std::atomic<Node*>  pRetired;      // erased, waiting for reclaim()
+
+        static Node* ptr(uintptr_t link)    { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); }
+        static bool  marked(uintptr_t link) { return (link & 1) != 0; }
+        static size_t randomHeight();
+
+        bool findNode(const T& t, Node** preds, Node** succs) const;
+        static Node* newNode(size_t height);
+        static void  deleteNode(Node* pNode, bool hasData);
+    };
+
+    /*****************************************************************
+     * CONCURRENT SKIP LIST SET :: NODE
+     * Like a SkipList node, with atomic links after it. Retired nodes
+     * are chained through pRetired, never through the links, which
+     * other threads may still be following.
+     *****************************************************************/
+    template <typename T>
+    struct concurrent_skiplist_set <T> ::Node
+    {
+        Node(size_t height) : height(height), pRetired(nullptr)
+        {
+            for (size_t i = 0; i < height; i++)
+                new (next() + i) std::atomic<uintptr_t>(0);
+        }
+        ~Node()
+        {
+            for (size_t i = 0; i < height; i++)
+                next()[i].~atomic();
+        }
+        T*       data()       { return reinterpret_cast<T*>(storage); }
+        const T& key()  const { return *reinterpret_cast<const T*>(storage); }
+        std::atomic<uintptr_t>* next() const
+        {
+            return reinterpret_cast<std::atomic<uintptr_t>*>(const_cast<Node*>(this) + 1);
+        }
+
+        static size_t bytes(size_t height)
+        {
+            size_t size = sizeof(Node) + height * sizeof(std::atomic<uintptr_t>);
+            return (size + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+        }
+
+        alignas(T) unsigned char storage[sizeof(T)];
+        size_t height;
+        alignas(std::atomic<uintptr_t>) Node* pRetired;
+    };
+
+    /**********************************************************
+     * CONCURRENT SKIP LIST SET ITERATOR
+     * Walks the bottom level, stepping over marked nodes
+     *********************************************************/
+    template <typename T>
+    class concurrent_skiplist_set <T> ::iterator
+    {
+        friend class ::TestSkipList; // give unit tests access to the privates
+        friend class concurrent_skiplist_set;
+    public:
+        iterator() : pNode(nullptr) {}
+        iterator(const Node* pNode) : pNode(pNode) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode; }
+        bool operator != (const iterator& rhs) const { return pNode != rhs.pNode; }
+
+        const T& operator * () const { return pNode->key(); }
+        const T* operator -> () const { return &pNode->key(); }
+
+        iterator& operator ++ ()
+        {
+            pNode = live(ptr(pNode->next()[0].load(std::memory_order_acquire)));
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+    private:
+        // the first node from p on that is not being erased
+        static const Node* live(const Node* p)
+        {
+            while (p)
+            {
+                uintptr_t link = p->next()[0].load(std::memory_order_acquire);
+                if (!marked(link))
+                    break;
+                p = ptr(link);
+            }
+            return p;
+        }
+
+        const Node* pNode;
+    };
+
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: CONSTRUCTOR
+     ********************************************/
+    template <typename T>
+    concurrent_skiplist_set <T> ::concurrent_skiplist_set() :
+        head(newNode(maxLevel)), numElements(0), pRetired(nullptr)
+    {
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: DESTRUCTOR
+     * No other thread may be using the set
+     ********************************************/
+    template <typename T>
+    concurrent_skiplist_set <T> :: ~concurrent_skiplist_set()
+    {
+        reclaim();
+        for (Node* p = ptr(head->next()[0].load()); p; )
+        {
+            Node* pNext = ptr(p->next()[0].load());
+            deleteNode(p, true);
+            p = pNext;
+        }
+        deleteNode(head, false);
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: NEW NODE
+     * The node and its links in one allocation
+     ********************************************/
+    template <typename T>
+    typename concurrent_skiplist_set <T> ::Node* concurrent_skiplist_set <T> ::newNode(size_t height)
+    {
+        return new (::operator new(Node::bytes(height))) Node(height);
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: DELETE NODE
+     ********************************************/
+    template <typename T>
+    void concurrent_skiplist_set <T> ::deleteNode(Node* pNode, bool hasData)
+    {
+        if (hasData)
+            pNode->data()->~T();
+        pNode->~Node();
+        ::operator delete(pNode);
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: RANDOM HEIGHT
+     * As SkipList, with a generator for each thread
+     ********************************************/
+    template <typename T>
+    size_t concurrent_skiplist_set <T> ::randomHeight()
+    {
+        thread_local uint64_t seed =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        uint64_t bits = seed;
+        size_t height = 1;
+        while ((bits & 3) == 0 && height < maxLevel)
+        {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: FIND NODE
+     * On every level, the last node below t and the
+     * first at or above it, cutting out any marked
+     * node on the way. If a cut fails another thread
+     * changed the level under us: start over.
+     ********************************************/
+    template <typename T>
+    bool concurrent_skiplist_set <T> ::findNode(const T& t, Node** preds, Node** succs) const
+    {
+    retry:
+        Node* pred = head;
+        for (size_t i = maxLevel; i-- > 0; )
+        {
+            Node* curr = ptr(pred->next()[i].load(std::memory_order_acquire));
+            while (curr)
+            {
+                uintptr_t succ = curr->next()[i].load(std::memory_order_acquire);
+                while (marked(succ))
+                {
+                    uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+                    if (!pred->next()[i].compare_exchange_strong(expected, succ & ~uintptr_t(1),
+                                                                std::memory_order_acq_rel))
+                        goto retry;
+                    curr = ptr(succ);
+                    if (!curr)
+                        break;
+                    succ = curr->next()[i].load(std::memory_order_acquire);
+                }
+                if (!curr || !(curr->key() < t))
+                    break;
+                pred = curr;
+                curr = ptr(succ);
+            }
+            preds[i] = pred;
+            succs[i] = curr;
+        }
+        return succs[0] && !(t < succs[0]->key());
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: CONTAINS
+     * Never writes: marked nodes are stepped over
+     ********************************************/
+    template <typename T>
+    bool concurrent_skiplist_set <T> ::contains(const T& t) const
+    {
+        iterator it = lower_bound(t);
+        return it != end() && !(t < *it);
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: LOWER BOUND
+     * Down the levels without cutting anything out
+     ********************************************/
+    template <typename T>
+    typename concurrent_skiplist_set <T> ::iterator concurrent_skiplist_set <T> ::lower_bound(const T& t) const
+    {
+        const Node* pred = head;
+        const Node* curr = nullptr;
+        for (size_t i = maxLevel; i-- > 0; )
+        {
+            curr = ptr(pred->next()[i].load(std::memory_order_acquire));
+            while (curr)
+            {
+                uintptr_t succ = curr->next()[i].load(std::memory_order_acquire);
+                if (marked(succ))
+                    curr = ptr(succ);
+                else if (curr->key() < t)
+                {
+                    pred = curr;
+                    curr = ptr(succ);
+                }
+                else
+                    break;
+            }
+        }
+        return iterator(iterator::live(curr));
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: FIND
+     ********************************************/
+    template <typename T>
+    typename concurrent_skiplist_set <T> ::iterator concurrent_skiplist_set <T> ::find(const T& t) const
+    {
+        iterator it = lower_bound(t);
+        if (it != end() && !(t < *it))
+            return it;
+        return end();
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: BEGIN
+     ********************************************/
+    template <typename T>
+    typename concurrent_skiplist_set <T> ::iterator concurrent_skiplist_set <T> ::begin() const
+    {
+        return iterator(iterator::live(ptr(head->next()[0].load(std::memory_order_acquire))));
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: INSERT
+     * Link the bottom level, then each level up. A
+     * level above stops being linked as soon as the
+     * node is marked for erasure.
+     ********************************************/
+    template <typename T>
+    bool concurrent_skiplist_set <T> ::insert(const T& t)
+    {
+        Node* preds[maxLevel];
+        Node* succs[maxLevel];
+        size_t height = randomHeight();
+        Node* pNode = newNode(height);
+        try
+        {
+            new (pNode->data()) T(t);
+        }
+        catch (...)
+        {
+            deleteNode(pNode, false);
+            throw;
+        }
+
+        // the bottom level: once this lands, t is in the set
+        while (true)
+        {
+            if (findNode(t, preds, succs))
+            {
+                deleteNode(pNode, true);   // never published
+                return false;
+            }
+            for (size_t i = 0; i < height; i++)
+                pNode->next()[i].store(reinterpret_cast<uintptr_t>(succs[i]), std::memory_order_relaxed);
+            uintptr_t expected = reinterpret_cast<uintptr_t>(succs[0]);
+            if (preds[0]->next()[0].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(pNode),
+                                                            std::memory_order_acq_rel))
+                break;
+        }
+        numElements.fetch_add(1, std::memory_order_relaxed);
+
+        // the levels above are only shortcuts
+        for (size_t i = 1; i < height; i++)
+            while (true)
+            {
+                uintptr_t mine = pNode->next()[i].load(std::memory_order_acquire);
+                if (marked(mine))
+                    return true;
+                uintptr_t succ = reinterpret_cast<uintptr_t>(succs[i]);
+                if (mine != succ && !pNode->next()[i].compare_exchange_strong(mine, succ, std::memory_order_acq_rel))
+                    continue;
+                uintptr_t expected = succ;
+                if (preds[i]->next()[i].compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(pNode),
+                                                                std::memory_order_acq_rel))
+                    break;
+                if (!findNode(t, preds, succs) || succs[0] != pNode)
+                    return true;   // erased already
+            }
+        return true;
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: ERASE
+     * Mark the links top down. Whoever marks the
+     * bottom one erased it, cuts it out, and
+     * retires it.
+     ********************************************/
+    template <typename T>
+    size_t concurrent_skiplist_set <T> ::erase(const T& t)
+    {
+        Node* preds[maxLevel];
+        Node* succs[maxLevel];
+        if (!findNode(t, preds, succs))
+            return 0;
+        Node* pVictim = succs[0];
+
+        for (size_t i = pVictim->height; i-- > 1; )
+        {
+            uintptr_t link = pVictim->next()[i].load(std::memory_order_acquire);
+            while (!marked(link) &&
+                   !pVictim->next()[i].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel))
+                ;
+        }
+
+        uintptr_t link = pVictim->next()[0].load(std::memory_order_acquire);
+        while (true)
+        {
+            if (marked(link))
+                return 0;   // another thread erased it first
+            if (pVictim->next()[0].compare_exchange_strong(link, link | 1, std::memory_order_acq_rel))
+                break;
+        }
+        numElements.fetch_sub(1, std::memory_order_relaxed);
+        findNode(t, preds, succs);
+
+        pVictim->pRetired = pRetired.load(std::memory_order_relaxed);
+        while (!pRetired.compare_exchange_weak(pVictim->pRetired, pVictim, std::memory_order_release,
+                                               std::memory_order_relaxed))
+            ;
+        return 1;
+    }
+
+    /*********************************************
+     * CONCURRENT SKIP LIST SET :: RECLAIM
+     * Free the retired nodes. Only safe while no
+     * other thread is using the set. An insert can
+     * link an upper level of a node being erased
+     * after the eraser cut it out, so every level is
+     * swept of marked nodes first.
+     ********************************************/
+    template <typename T>
+    void concurrent_skiplist_set <T> ::reclaim()
+    {
+        for (size_t i = 0; i < maxLevel; i++)
+        {
+            Node* pred = head;
+            for (Node* curr = ptr(pred->next()[i].load()); curr; curr = ptr(pred->next()[i].load()))
+                if (marked(curr->next()[i].load()))
+                    pred->next()[i].store(curr->next()[i].load() & ~uintptr_t(1));
+                else
+                    pred = curr;
+        }
+
+        Node* p = pRetired.exchange(nullptr);
+        while (p)
+        {
+            Node* pNext = p->pRetired;
+            deleteNode(p, true);
+            p = pNext;
+        }
+    }
+
+}; // namespace custom
@@ -0,0 +1,419 @@
+/***********************************************************************
+ * Header:
+ *    soa_vector
+ * Summary:
+ *    A vector of rows that keeps each field in its own buffer
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        soa_vector           : rows of Ts..., stored column by column
+ *        soa_vector::iterator : An iterator through the rows
+ *        soa_vector::view     : one column as a plain array
+ *        pair_vector          : a soa_vector of keys and values
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for size_t
+#include <algorithm>   // for std::stable_sort
+#include <functional>  // for std::less
+#include <memory>      // for std::allocator and std::unique_ptr
+#include <new>         // for placement new
+#include <tuple>       // for std::tuple
+#include <utility>     // for std::index_sequence
+#include "pair.h"      // for pair
+
+class TestSoaVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************************
+ * SOA VECTOR
+ * A growable array of rows, each row holding one of every type in
+ * Ts. Instead of keeping whole rows side by side (an array of
+ * structs, like vector<pair<K, V>>), every field lives in its own
+ * contiguous buffer. A loop that only reads the keys then only
+ * pulls keys through the cache.
+ *
+ * A row is handed out as a tuple of references. A single column
+ * is handed out as a view: a pointer and a size.
+ *****************************************************************/
+template <typename ... Ts>
+class soa_vector
+{
+   friend class ::TestSoaVector; // give unit tests access to the privates
+   static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+   using Indices = std::index_sequence_for<Ts...>;
+public:
+   using reference       = std::tuple<      Ts & ...>;
+   using const_reference = std::tuple<const Ts & ...>;
+   template <size_t I>
+   using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+   static constexpr size_t numColumns = sizeof...(Ts);
+
+   //
+   // Construct
+   //
+   soa_vector() : columns(), numElements(0), numCapacity(0) { }
+   soa_vector(const soa_vector &  rhs);
+   soa_vector(      soa_vector && rhs);
+  ~soa_vector();
+
+   //
+   // Assign
+   //
+   soa_vector & operator = (const soa_vector & rhs)
+   {
+      if (this != &rhs)
+      {
+         soa_vector copy(rhs);
+         swap(copy);
+      }
+      return *this;
+   }
+   soa_vector & operator = (soa_vector && rhs)
+   {
+      soa_vector empty;
+      swap(empty);
+      swap(rhs);
+      return *this;
+   }
+   void swap(soa_vector & rhs)
+   {
+      std::swap(columns,     rhs.columns);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numCapacity, rhs.numCapacity);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() { return iterator(this, 0);           }
+   iterator end()   { return iterator(this, numElements); }
+
+   //
+   // Access
+   //
+   template <class T>
+   class view;
+
+         reference operator [] (size_t index)       { return row(index, Indices()); }
+   const_reference operator [] (size_t index) const { return row(index, Indices()); }
+         reference front()       { return (*this)[0];               }
+   const_reference front() const { return (*this)[0];               }
+         reference back()        { return (*this)[numElements - 1]; }
+   const_reference back()  const { return (*this)[numElements - 1]; }
+
+   // one field of one row
+   template <size_t I>
+         column_type<I> & get(size_t index)
+   {
+      assert(index < numElements);
+      return std::get<I>(columns)[index];
+   }
+   template <size_t I>
+   const column_type<I> & get(size_t index) const
+   {
+      assert(index < numElements);
+      return std::get<I>(columns)[index];
+   }
+
+   // one whole field, every row
+   template <size_t I>
+   view <      column_type<I>> column()       { return view <      column_type<I>>(std::get<I>(columns), numElements); }
+   template <size_t I>
+   view <const column_type<I>> column() const { return view <const column_type<I>>(std::get<I>(columns), numElements); }
+   template <size_t I>
+         column_type<I> * data()       { return std::get<I>(columns); }
+   template <size_t I>
+   const column_type<I> * data() const { return std::get<I>(columns); }
+
+   //
+   // Insert
+   //
+   void push_back(const Ts &  ... values) { emplace_back(values...);            }
+   void push_back(      Ts && ... values) { emplace_back(std::move(values)...); }
+   template <class T1, class T2, class C>
+   void push_back(const custom::pair <T1, T2, C> & rhs) { emplace_back(rhs.first, rhs.second); }
+   template <class ... Us>
+   void emplace_back(Us && ... values);
+   void reserve(size_t newCapacity);
+
+   //
+   // Remove
+   //
+   void pop_back()
+   {
+      if (numElements > 0)
+      {
+         numElements--;
+         destroy(numElements, numElements + 1, Indices());
+      }
+   }
+   void clear()
+   {
+      destroy(0, numElements, Indices());
+      numElements = 0;
+   }
+
+   //
+   // Sort
+   //
+   template <size_t I, class Compare = std::less<column_type<I>>>
+   void sort_by(Compare compare = Compare());
+
+   //
+   // Status
+   //
+   size_t size()     const { return numElements;      }
+   size_t capacity() const { return numCapacity;      }
+   bool   empty()    const { return numElements == 0; }
+
+private:
+
+   // a row as a tuple of references
+   template <size_t ... Is>
+   reference row(size_t index, std::index_sequence<Is...>)
+   {
+      assert(index < numElements);
+      return reference(std::get<Is>(columns)[index]...);
+   }
+   template <size_t ... Is>
+   const_reference row(size_t index, std::index_sequence<Is...>) const
+   {
+      assert(index < numElements);
+      return const_reference(std::get<Is>(columns)[index]...);
+   }
+
+   // build the new last row, one column at a time
+   template <size_t ... Is, class ... Us>
+   void construct(size_t index, std::index_sequence<Is...>, Us && ... values)
+   {
+      (new (std::get<Is>(columns) + index) Ts(std::forward<Us>(values)), ...);
+   }
+
+   // destroy rows [first, last) in every column
+   template <size_t ... Is>
+   void destroy(size_t first, size_t last, std::index_sequence<Is...>)
+   {
+      (destroyColumn(std::get<Is>(columns), first, last), ...);
+   }
+   template <class T>
+   static void destroyColumn(T * p, size_t first, size_t last)
+   {
+      for (size_t i = first; i < last; i++)
+         p[i].~T();
+   }
+
+   // move every column into a buffer of newCapacity, in the order given
+   template <size_t ... Is>
+   void reallocate(size_t newCapacity, const size_t * order, std::index_sequence<Is...>)
+   {
+      (reallocateColumn(std::get<Is>(columns), newCapacity, order), ...);
+      numCapacity = newCapacity;
+   }
+   template <class T>
+   void reallocateColumn(T * & p, size_t newCapacity, const size_t * order)
+   {
+      std::allocator<T> alloc;
+      T * pNew = newCapacity ? alloc.allocate(newCapacity) : nullptr;
+      for (size_t i = 0; i < numElements; i++)
+         new (pNew + i) T(std::move(p[order ? order[i] : i]));
+      destroyColumn(p, 0, numElements);
+      if (p)
+         alloc.deallocate(p, numCapacity);
+      p = pNew;
+   }
+
+   // copy every column of rhs into our empty buffers
+   template <size_t ... Is>
+   void copyFrom(const soa_vector & rhs, std::index_sequence<Is...>)
+   {
+      (copyColumn(std::get<Is>(columns), std::get<Is>(rhs.columns), rhs.numElements), ...);
+   }
+   template <class T>
+   static void copyColumn(T * pDest, const T * pSrc, size_t num)
+   {
+      for (size_t i = 0; i < num; i++)
+         new (pDest + i) T(pSrc[i]);
+   }
+
+   std::tuple<Ts * ...> columns;      // one buffer per field
+   size_t numElements;                // rows in use
+   size_t numCapacity;                // rows each buffer can hold
+};
+
+/*****************************************************************
+ * PAIR VECTOR
+ * The common case: a column of keys and a column of values
+ *****************************************************************/
+template <class K, class V>
+using pair_vector = soa_vector<K, V>;
+
+/**************************************************
+ * SOA VECTOR VIEW
+ * One column as a plain array. It does not own
+ * anything, and growing the soa_vector invalidates it.
+ *************************************************/
+template <typename ... Ts>
+template <class T>
+class soa_vector <Ts...> ::view
+{
+public:
+   view(T * p, size_t num) : p(p), num(num) { }
+
+   T * begin() const { return p;       }
+   T * end()   const { return p + num; }
+   T * data()  const { return p;       }
+
+   T & operator [] (size_t index) const
+   {
+      assert(index < num);
+      return p[index];
+   }
+   T & front() const { return p[0];       }
+   T & back()  const { return p[num - 1]; }
+
+   size_t size()  const { return num;      }
+   bool   empty() const { return num == 0; }
+
+private:
+   T * p;          // first element of the column
+   size_t num;     // number of rows
+};
+
+/**************************************************
+ * SOA VECTOR ITERATOR
+ * A random-access iterator through the rows.
+ * Dereferencing gives a tuple of references.
+ *************************************************/
+template <typename ... Ts>
+class soa_vector <Ts...> ::iterator
+{
+   friend class ::TestSoaVector; // give unit tests access to the privates
+public:
+   iterator()                                : pVector(nullptr), index(0)  { }
+   iterator(soa_vector * pVector, size_t index) : pVector(pVector), index(index) { }
+   iterator(const iterator & rhs)            : pVector(rhs.pVector), index(rhs.index) { }
+   iterator & operator = (const iterator & rhs)
+   {
+      pVector = rhs.pVector;
+      index = rhs.index;
+      return *this;
+   }
+
+   bool operator == (const iterator & rhs) const { return index == rhs.index; }
+   bool operator != (const iterator & rhs) const { return index != rhs.index; }
+   bool operator <  (const iterator & rhs) const { return index <  rhs.index; }
+
+   reference operator * () const { return (*pVector)[index]; }
+
+   iterator & operator ++ ()    { ++index; return *this; }
+   iterator & operator -- ()    { --index; return *this; }
+   iterator   operator ++ (int) { iterator tmp(*this); ++index; return tmp; }
+   iterator   operator -- (int) { iterator tmp(*this); --index; return tmp; }
+   iterator & operator += (ptrdiff_t offset) { index += offset; return *this; }
+   iterator   operator +  (ptrdiff_t offset) const { return iterator(pVector, index + offset); }
+   ptrdiff_t  operator -  (const iterator & rhs) const { return (ptrdiff_t)index - (ptrdiff_t)rhs.index; }
+
+private:
+   soa_vector * pVector;
+   size_t index;
+};
+
+/*****************************************
+ * SOA VECTOR :: COPY CONSTRUCTOR
+ * Each column gets exactly enough room for rhs
+ ****************************************/
+template <typename ... Ts>
+soa_vector <Ts...> ::soa_vector(const soa_vector & rhs) :
+   columns(), numElements(0), numCapacity(0)
+{
+   reserve(rhs.numElements);
+   copyFrom(rhs, Indices());
+   numElements = rhs.numElements;
+}
+
+/*****************************************
+ * SOA VECTOR :: MOVE CONSTRUCTOR
+ * Steal the buffers from rhs
+ ****************************************/
+template <typename ... Ts>
+soa_vector <Ts...> ::soa_vector(soa_vector && rhs) :
+   columns(rhs.columns), numElements(rhs.numElements), numCapacity(rhs.numCapacity)
+{
+   rhs.columns = std::tuple<Ts * ...>();
+   rhs.numElements = 0;
+   rhs.numCapacity = 0;
+}
+
+/*****************************************
+ * SOA VECTOR :: DESTRUCTOR
+ * Destroy the rows, then free every column
+ ****************************************/
+template <typename ... Ts>
+soa_vector <Ts...> :: ~soa_vector()
+{
+   clear();
+   reallocate(0, nullptr, Indices());
+}
+
+/*****************************************
+ * SOA VECTOR :: EMPLACE BACK
+ * Build a new row from one argument per column,
+ * doubling every column when full
+ ****************************************/
+template <typename ... Ts>
+template <class ... Us>
+void soa_vector <Ts...> ::emplace_back(Us && ... values)
+{
+   static_assert(sizeof...(Us) == sizeof...(Ts), "emplace_back needs one value per column");
+   if (numElements == numCapacity)
+      reserve(numCapacity ? numCapacity * 2 : 1);
+   construct(numElements, Indices(), std::forward<Us>(values)...);
+   numElements++;
+}
+
+/*****************************************
+ * SOA VECTOR :: RESERVE
+ * Grow every column to hold newCapacity rows
+ ****************************************/
+template <typename ... Ts>
+void soa_vector <Ts...> ::reserve(size_t newCapacity)
+{
+   if (newCapacity > numCapacity)
+      reallocate(newCapacity, nullptr, Indices());
+}
+
+/*****************************************
+ * SOA VECTOR :: SORT BY
+ * Reorder the rows by column I. Only that column
+ * is read while sorting; the others are moved
+ * into place once at the end.
+ ****************************************/
+template <typename ... Ts>
+template <size_t I, class Compare>
+void soa_vector <Ts...> ::sort_by(Compare compare)
+{
+   std::unique_ptr<size_t[]> order(new size_t[numElements]);
+   for (size_t i = 0; i < numElements; i++)
+      order[i] = i;
+
+   const column_type<I> * key = std::get<I>(columns);
+   std::stable_sort(order.get(), order.get() + numElements,
+      [key, &compare](size_t lhs, size_t rhs) { return compare(key[lhs], key[rhs]); });
+
+   reallocate(numCapacity, order.get(), Indices());
+}
+
+} // namespace custom
@@ -0,0 +1,839 @@
+/***********************************************************************
+ * Header:
+ *    SPLAY TREE
+ * Summary:
+ *    A self-adjusting binary search tree that moves whatever was last
+ *    looked up to the root, and a set and a map built on it
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        SplayTree           : A BST that splays on find, insert, and erase
+ *        SplayTree::iterator : An in-order iterator through a SplayTree
+ *        splay_set           : A set with the same interface as custom::set
+ *        splay_map           : A map with the same interface as custom::map
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>          // for size_t
+#include <functional>       // for std::less
+#include <stdexcept>        // for std::out_of_range
+#include <utility>          // for std::pair, std::move, std::forward
+#include <initializer_list>
+#include "pair.h"           // for custom::pair
+
+class TestSplayTree; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************************************
+     * SPLAY TREE
+     * Every find, insert, and erase splays: it rotates the node it
+     * was looking for, or the last one it passed, up to the root on
+     * the way down (top-down splaying). A key that is looked up often
+     * stays near the top, so a skewed workload pays little for its hot
+     * keys, and any sequence of m operations costs O(m log n) in all.
+     * Any single operation may still walk a long path: inserting in
+     * order leaves a chain, which the next few lookups fold back up.
+     *
+     * Because a lookup changes the shape, find is not const. lookup()
+     * is a plain search that leaves the tree alone. Splaying never
+     * moves an element, so iterators stay valid until their own
+     * element is erased.
+     *
+     * KeyOf pulls the key out of an element: the element itself for a
+     * set, .first for a map.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare = std::less<K>>
+    class SplayTree
+    {
+        friend class ::TestSplayTree; // give unit tests access to the privates
+    public:
+        using key_type = K;
+        using value_type = T;
+
+        //
+        // Construct
+        //
+
+        SplayTree() : pRoot(nullptr), numElements(0) {}
+        SplayTree(const SplayTree& rhs) : pRoot(nullptr), numElements(0), compare(rhs.compare)
+        {
+            insertAll(rhs);
+        }
+        SplayTree(SplayTree&& rhs) : pRoot(rhs.pRoot), numElements(rhs.numElements), compare(rhs.compare)
+        {
+            rhs.pRoot = nullptr;
+            rhs.numElements = 0;
+        }
+        ~SplayTree() { clear(); }
+
+        //
+        // Assign
+        //
+
+        SplayTree& operator = (const SplayTree& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                compare = rhs.compare;
+                insertAll(rhs);
+            }
+            return *this;
+        }
+        SplayTree& operator = (SplayTree&& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                pRoot = rhs.pRoot;
+                numElements = rhs.numElements;
+                compare = rhs.compare;
+                rhs.pRoot = nullptr;
+                rhs.numElements = 0;
+            }
+            return *this;
+        }
+        void swap(SplayTree& rhs)
+        {
+            std::swap(pRoot, rhs.pRoot);
+            std::swap(numElements, rhs.numElements);
+            std::swap(compare, rhs.compare);
+        }
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() const noexcept;
+        iterator end()   const noexcept { return iterator(this, nullptr); }
+
+        //
+        // Access
+        //
+
+        iterator find(const K& k);          // splays
+        iterator lookup(const K& k) const;  // does not
+        T& value(const iterator& it) { return it.pNode->data; }
+
+        //
+        // Insert
+        //
+
+        std::pair<iterator, bool> insert(const T& t) { return emplaceKey(KeyOf()(t), t); }
+        std::pair<iterator, bool> insert(T&& t)
+        {
+            const K& k = KeyOf()(t);
+            return emplaceKey(k, std::move(t));
+        }
+        template <class ... Args>
+        std::pair<iterator, bool> emplaceKey(const K& k, Args&& ... args);
+
+        //
+        // Remove
+        //
+
+        size_t   erase(const K& k);
+        iterator erase(const iterator& it);
+        iterator erase(iterator first, iterator last);
+        void     clear() noexcept;
+
+        //
+        // Status
+        //
+
+        bool   empty() const noexcept { return numElements == 0; }
+        size_t size()  const noexcept { return numElements;      }
+
+    private:
+
+        struct Node;
+
+        Node*   pRoot;                 // the last node splayed, or nullptr
+        size_t  numElements;           // number of elements in the tree
+        Compare compare;               // orders the keys
+
+        Node* splay(Node* pTop, const K& k);
+        void  insertAll(const SplayTree& rhs);
+        static Node* leftmost(Node* pNode);
+    };
+
+    /*****************************************************************
+     * SPLAY TREE :: NODE
+     * An element and its neighbours. The parent link is only there
+     * for the iterator; splaying itself never climbs.
+     *****************************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    struct SplayTree <K, T, KeyOf, Compare> ::Node
+    {
+        template <class ... Args>
+        Node(Args&& ... args) :
+            data(std::forward<Args>(args)...), pLeft(nullptr), pRight(nullptr), pParent(nullptr) {}
+
+        T     data;
+        Node* pLeft;                   // smaller
+        Node* pRight;                  // larger
+        Node* pParent;                 // nullptr at the root
+    };
+
+    /**********************************************************
+     * SPLAY TREE ITERATOR
+     * The tree and a node in it. End is a null node.
+     *********************************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    class SplayTree <K, T, KeyOf, Compare> ::iterator
+    {
+        friend class ::TestSplayTree; // give unit tests access to the privates
+        friend class SplayTree;
+    public:
+        iterator() : pTree(nullptr), pNode(nullptr) {}
+        iterator(const SplayTree* pTree, Node* pNode) : pTree(pTree), pNode(pNode) {}
+
+        bool operator == (const iterator& rhs) const { return pNode == rhs.pNode; }
+        bool operator != (const iterator& rhs) const { return pNode != rhs.pNode; }
+
+        const T& operator * () const { return pNode->data; }
+        const T* operator -> () const { return &pNode->data; }
+
+        iterator& operator ++ ()
+        {
+            if (pNode->pRight)
+                pNode = leftmost(pNode->pRight);
+            else
+            {
+                // climb until we come up from a left child
+                Node* pChild = pNode;
+                pNode = pNode->pParent;
+                while (pNode && pNode->pRight == pChild)
+                {
+                    pChild = pNode;
+                    pNode = pNode->pParent;
+                }
+            }
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator itReturn(*this);
+            ++(*this);
+            return itReturn;
+        }
+
+        // from end() this goes to the last element
+        iterator& operator -- ()
+        {
+            if (pNode == nullptr)
+            {
+                pNode = pTree->pRoot;
+                while (pNode && pNode->pRight)
+                    pNode = pNode->pRight;
+            }
+            else if (pNode->pLeft)
+            {
+                pNode = pNode->pLeft;
+                while (pNode->pRight)
+                    pNode = pNode->pRight;
+            }
+            else
+            {
+                // climb until we come up from a right child
+                Node* pChild = pNode;
+                pNode = pNode->pParent;
+                while (pNode && pNode->pLeft == pChild)
+                {
+                    pChild = pNode;
+                    pNode = pNode->pParent;
+                }
+            }
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator itReturn(*this);
+            --(*this);
+            return itReturn;
+        }
+
+    private:
+        const SplayTree* pTree;        // the tree holding the node
+        Node* pNode;                   // which node, or nullptr for end()
+    };
+
+    /*********************************************
+     * SPLAY TREE :: BEGIN
+     * The left-most node
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::iterator SplayTree <K, T, KeyOf, Compare> ::begin() const noexcept
+    {
+        return iterator(this, pRoot ? leftmost(pRoot) : nullptr);
+    }
+
+    /*********************************************
+     * SPLAY TREE :: LEFTMOST
+     * The smallest node in a subtree
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::Node* SplayTree <K, T, KeyOf, Compare> ::leftmost(Node* pNode)
+    {
+        while (pNode->pLeft)
+            pNode = pNode->pLeft;
+        return pNode;
+    }
+
+    /*********************************************
+     * SPLAY TREE :: SPLAY
+     * Walk down from pTop toward k, splitting off what is
+     * smaller than k into a left tree and what is larger into
+     * a right tree. Two steps the same way rotate first, which
+     * is what halves the depth of the path. The node where the
+     * walk stops, k itself if it is here, becomes the new top
+     * with the left and right trees as its children.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::Node* SplayTree <K, T, KeyOf, Compare> ::splay(Node* pTop, const K& k)
+    {
+        // The left tree grows at its largest node, the right at its smallest
+        Node* pLeftRoot = nullptr;
+        Node* pLeftMax = nullptr;
+        Node* pRightRoot = nullptr;
+        Node* pRightMin = nullptr;
+
+        Node* t = pTop;
+        while (true)
+        {
+            if (compare(k, KeyOf()(t->data)))
+            {
+                if (t->pLeft == nullptr)
+                    break;
+
+                // Left twice: rotate right
+                if (compare(k, KeyOf()(t->pLeft->data)))
+                {
+                    Node* pChild = t->pLeft;
+                    t->pLeft = pChild->pRight;
+                    if (t->pLeft)
+                        t->pLeft->pParent = t;
+                    pChild->pRight = t;
+                    t->pParent = pChild;
+                    t = pChild;
+                    if (t->pLeft == nullptr)
+                        break;
+                }
+
+                // t and everything to its right is larger than k
+                if (pRightMin)
+                {
+                    pRightMin->pLeft = t;
+                    t->pParent = pRightMin;
+                }
+                else
+                    pRightRoot = t;
+                pRightMin = t;
+                t = t->pLeft;
+            }
+            else if (compare(KeyOf()(t->data), k))
+            {
+                if (t->pRight == nullptr)
+                    break;
+
+                // Right twice: rotate left
+                if (compare(KeyOf()(t->pRight->data), k))
+                {
+                    Node* pChild = t->pRight;
+                    t->pRight = pChild->pLeft;
+                    if (t->pRight)
+                        t->pRight->pParent = t;
+                    pChild->pLeft = t;
+                    t->pParent = pChild;
+                    t = pChild;
+                    if (t->pRight == nullptr)
+                        break;
+                }
+
+                // t and everything to its left is smaller than k
+                if (pLeftMax)
+                {
+                    pLeftMax->pRight = t;
+                    t->pParent = pLeftMax;
+                }
+                else
+                    pLeftRoot = t;
+                pLeftMax = t;
+                t = t->pRight;
+            }
+            else
+                break;
+        }
+
+        // Reassemble: t's children go under the left and right trees, which go under t
+        Node* pLeft = t->pLeft;
+        Node* pRight = t->pRight;
+        if (pLeftMax)
+        {
+            pLeftMax->pRight = pLeft;
+            if (pLeft)
+                pLeft->pParent = pLeftMax;
+            pLeft = pLeftRoot;
+        }
+        if (pRightMin)
+        {
+            pRightMin->pLeft = pRight;
+            if (pRight)
+                pRight->pParent = pRightMin;
+            pRight = pRightRoot;
+        }
+        t->pLeft = pLeft;
+        t->pRight = pRight;
+        if (pLeft)
+            pLeft->pParent = t;
+        if (pRight)
+            pRight->pParent = t;
+        t->pParent = nullptr;
+        return t;
+    }
+
+    /*********************************************
+     * SPLAY TREE :: FIND
+     * The node with key k, now at the root, or end()
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::iterator SplayTree <K, T, KeyOf, Compare> ::find(const K& k)
+    {
+        if (pRoot == nullptr)
+            return end();
+        pRoot = splay(pRoot, k);
+        if (compare(k, KeyOf()(pRoot->data)) || compare(KeyOf()(pRoot->data), k))
+            return end();
+        return iterator(this, pRoot);
+    }
+
+    /*********************************************
+     * SPLAY TREE :: LOOKUP
+     * The node with key k, or end(), without splaying
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::iterator SplayTree <K, T, KeyOf, Compare> ::lookup(const K& k) const
+    {
+        Node* pNode = pRoot;
+        while (pNode)
+        {
+            if (compare(k, KeyOf()(pNode->data)))
+                pNode = pNode->pLeft;
+            else if (compare(KeyOf()(pNode->data), k))
+                pNode = pNode->pRight;
+            else
+                break;
+        }
+        return iterator(this, pNode);
+    }
+
+    /*********************************************
+     * SPLAY TREE :: EMPLACE KEY
+     * Splay toward k. Unless k is already at the root, build
+     * an element from args and make it the root, with the old
+     * root on one side and its far child on the other.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    template <class ... Args>
+    std::pair<typename SplayTree <K, T, KeyOf, Compare> ::iterator, bool>
+    SplayTree <K, T, KeyOf, Compare> ::emplaceKey(const K& k, Args&& ... args)
+    {
+        bool isLeft = false;
+        if (pRoot)
+        {
+            pRoot = splay(pRoot, k);
+            isLeft = compare(k, KeyOf()(pRoot->data));
+            if (!isLeft && !compare(KeyOf()(pRoot->data), k))
+                return std::pair<iterator, bool>(iterator(this, pRoot), false);
+        }
+
+        Node* pNode = new Node(std::forward<Args>(args)...);
+        if (pRoot && isLeft)
+        {
+            pNode->pLeft = pRoot->pLeft;
+            pNode->pRight = pRoot;
+            pRoot->pLeft = nullptr;
+        }
+        else if (pRoot)
+        {
+            pNode->pRight = pRoot->pRight;
+            pNode->pLeft = pRoot;
+            pRoot->pRight = nullptr;
+        }
+        if (pNode->pLeft)
+            pNode->pLeft->pParent = pNode;
+        if (pNode->pRight)
+            pNode->pRight->pParent = pNode;
+        pRoot = pNode;
+        numElements++;
+        return std::pair<iterator, bool>(iterator(this, pNode), true);
+    }
+
+    /*********************************************
+     * SPLAY TREE :: INSERT ALL
+     * Copy rhs in order. Each element is larger than the root
+     * so far, so it goes straight on top: O(n) in all.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    void SplayTree <K, T, KeyOf, Compare> ::insertAll(const SplayTree& rhs)
+    {
+        for (iterator it = rhs.begin(); it != rhs.end(); ++it)
+            insert(*it);
+    }
+
+    /*********************************************
+     * SPLAY TREE :: ERASE
+     * Splay k to the root and take it off. Splaying the left
+     * side toward k brings its largest node to the top with
+     * nothing on its right, where the old right side goes.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    size_t SplayTree <K, T, KeyOf, Compare> ::erase(const K& k)
+    {
+        if (pRoot == nullptr)
+            return 0;
+        pRoot = splay(pRoot, k);
+        if (compare(k, KeyOf()(pRoot->data)) || compare(KeyOf()(pRoot->data), k))
+            return 0;
+
+        // k may live in the node, so it goes last
+        Node* pDelete = pRoot;
+        if (pDelete->pLeft == nullptr)
+            pRoot = pDelete->pRight;
+        else
+        {
+            pDelete->pLeft->pParent = nullptr;
+            pRoot = splay(pDelete->pLeft, k);
+            pRoot->pRight = pDelete->pRight;
+            if (pRoot->pRight)
+                pRoot->pRight->pParent = pRoot;
+        }
+        if (pRoot)
+            pRoot->pParent = nullptr;
+        delete pDelete;
+        numElements--;
+        return 1;
+    }
+
+    /*********************************************
+     * SPLAY TREE :: ERASE
+     * Remove the element at it and return the one after it
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::iterator SplayTree <K, T, KeyOf, Compare> ::erase(const iterator& it)
+    {
+        if (it.pNode == nullptr)
+            return end();
+        iterator itNext = it;
+        ++itNext;
+        erase(KeyOf()(it.pNode->data));
+        return itNext;
+    }
+
+    /*********************************************
+     * SPLAY TREE :: ERASE
+     * Remove [first, last)
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    typename SplayTree <K, T, KeyOf, Compare> ::iterator SplayTree <K, T, KeyOf, Compare> ::erase(iterator first, iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return last;
+    }
+
+    /*********************************************
+     * SPLAY TREE :: CLEAR
+     * Delete every node. Like BST::deleteBNode this rotates
+     * left children up instead of recursing, since a splay
+     * tree can be one long chain.
+     ********************************************/
+    template <typename K, typename T, typename KeyOf, class Compare>
+    void SplayTree <K, T, KeyOf, Compare> ::clear() noexcept
+    {
+        Node* pNode = pRoot;
+        while (pNode)
+        {
+            if (pNode->pLeft)
+            {
+                // Rotate right so the left child moves up
+                Node* pLeft = pNode->pLeft;
+                pNode->pLeft = pLeft->pRight;
+                pLeft->pRight = pNode;
+                pNode = pLeft;
+            }
+            else
+            {
+                Node* pRight = pNode->pRight;
+                delete pNode;
+                pNode = pRight;
+            }
+        }
+        pRoot = nullptr;
+        numElements = 0;
+    }
+
+
+    /*****************************************************************
+     * SPLAY SET
+     * A set with the interface of custom::set, kept in a SplayTree.
+     * find() moves what it finds to the root, so it is not const.
+     *****************************************************************/
+    template <typename T, class Compare = std::less<T>>
+    class splay_set
+    {
+        friend class ::TestSplayTree; // give unit tests access to the privates
+
+        struct KeyOf
+        {
+            const T& operator () (const T& t) const { return t; }
+        };
+    public:
+        using iterator = typename SplayTree <T, T, KeyOf, Compare> ::iterator;
+
+        //
+        // Construct
+        //
+        splay_set() {}
+        splay_set(const splay_set& rhs) : tree(rhs.tree) {}
+        splay_set(splay_set&& rhs) : tree(std::move(rhs.tree)) {}
+        splay_set(const std::initializer_list <T>& il) { insert(il); }
+        template <class Iterator>
+        splay_set(Iterator first, Iterator last) { insert(first, last); }
+        ~splay_set() {}
+
+        //
+        // Assign
+        //
+        splay_set& operator = (const splay_set& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        splay_set& operator = (splay_set&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        splay_set& operator = (const std::initializer_list <T>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(splay_set& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        iterator find(const T& t) { return tree.find(t); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+        //
+        // Insert
+        //
+        std::pair<iterator, bool> insert(const T& t) { return tree.insert(t); }
+        std::pair<iterator, bool> insert(T&& t)      { return tree.insert(std::move(t)); }
+        void insert(const std::initializer_list <T>& il)
+        {
+            for (const T& t : il)
+                tree.insert(t);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        size_t erase(const T& t) { return tree.erase(t); }
+        iterator erase(const iterator& itBegin, const iterator& itEnd) { return tree.erase(itBegin, itEnd); }
+
+    private:
+        SplayTree <T, T, KeyOf, Compare> tree;
+    };
+
+
+    /*****************************************************************
+     * SPLAY MAP
+     * A map with the interface of custom::map, kept in a SplayTree.
+     * Every access by key splays except the const at().
+     *****************************************************************/
+    template <typename K, typename V, class Compare = std::less<K>>
+    class splay_map
+    {
+        friend class ::TestSplayTree; // give unit tests access to the privates
+    public:
+        using Pairs = custom::pair<K, V>;
+    private:
+        struct KeyOf
+        {
+            const K& operator () (const Pairs& p) const { return p.first; }
+        };
+    public:
+        using iterator = typename SplayTree <K, Pairs, KeyOf, Compare> ::iterator;
+
+        //
+        // Construct
+        //
+        splay_map() {}
+        splay_map(const splay_map& rhs) : tree(rhs.tree) {}
+        splay_map(splay_map&& rhs) : tree(std::move(rhs.tree)) {}
+        template <class Iterator>
+        splay_map(Iterator first, Iterator last) { insert(first, last); }
+        splay_map(const std::initializer_list <Pairs>& il) { insert(il); }
+        ~splay_map() {}
+
+        //
+        // Assign
+        //
+        splay_map& operator = (const splay_map& rhs)
+        {
+            tree = rhs.tree;
+            return *this;
+        }
+        splay_map& operator = (splay_map&& rhs)
+        {
+            tree = std::move(rhs.tree);
+            return *this;
+        }
+        splay_map& operator = (const std::initializer_list <Pairs>& il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        void swap(splay_map& rhs) { tree.swap(rhs.tree); }
+
+        //
+        // Iterator
+        //
+        iterator begin() const noexcept { return tree.begin(); }
+        iterator end()   const noexcept { return tree.end();   }
+
+        //
+        // Access
+        //
+        const V& operator [] (const K& k) const { return at(k); }
+              V& operator [] (const K& k)
+        {
+            return tree.value(tree.emplaceKey(k, k, V()).first).second;
+        }
+        const V& at(const K& k) const;
+              V& at(const K& k);
+        iterator find(const K& k) { return tree.find(k); }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const Pairs& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(rhs);
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        custom::pair<iterator, bool> insert(Pairs&& rhs)
+        {
+            std::pair<iterator, bool> result = tree.insert(std::move(rhs));
+            return custom::pair<iterator, bool>(result.first, result.second);
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            for (Iterator it = first; it != last; ++it)
+                tree.insert(*it);
+        }
+        void insert(const std::initializer_list <Pairs>& il)
+        {
+            for (const Pairs& element : il)
+                tree.insert(element);
+        }
+
+        //
+        // Remove
+        //
+        void clear() noexcept { tree.clear(); }
+        size_t erase(const K& k) { return tree.erase(k); }
+        iterator erase(const iterator& it) { return tree.erase(it); }
+        iterator erase(const iterator& first, const iterator& last) { return tree.erase(first, last); }
+
+        //
+        // Status
+        //
+        bool   empty() const noexcept { return tree.empty(); }
+        size_t size()  const noexcept { return tree.size();  }
+
+    private:
+        SplayTree <K, Pairs, KeyOf, Compare> tree;
+    };
+
+    /*****************************************************
+     * SPLAY MAP :: AT
+     * Retrieve an element from the map, or throw
+     ****************************************************/
+    template <typename K, typename V, class Compare>
+    V& splay_map <K, V, Compare> ::at(const K& k)
+    {
+        iterator it = tree.find(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return tree.value(it).second;
+    }
+
+    /*****************************************************
+     * SPLAY MAP :: AT
+     * Retrieve an element from the map, or throw. A const
+     * map cannot splay, so this is a plain search.
+     ****************************************************/
+    template <typename K, typename V, class Compare>
+    const V& splay_map <K, V, Compare> ::at(const K& k) const
+    {
+        iterator it = tree.lookup(k);
+        if (it == tree.end())
+            throw std::out_of_range("invalid map<K, T> key");
+        return (*it).second;
+    }
+
+    /*****************************************************
+     * SWAP
+     * Swap two splay sets or two splay maps
+     ****************************************************/
+    template <typename T, class Compare>
+    void swap(splay_set <T, Compare>& lhs, splay_set <T, Compare>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+    template <typename K, typename V, class Compare>
+    void swap(splay_map <K, V, Compare>& lhs, splay_map <K, V, Compare>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+}; // namespace custom
@@ -20,6 +20,8 @@
 #include <iostream>
 #include <string>
 #include <functional> // for std::less and std::greater
+#include <vector>
+#include <iterator>   // for std::back_inserter
 
  /***********************************************
   * TEST BST
@@ -38,6 +40,7 @@ public:
       test_constructCopy_empty();
       test_constructCopy_one();
       test_constructCopy_standard();
+      test_constructCopy_degenerate();
       test_constructMove_empty();
       test_constructMove_one();
       test_constructMove_standard();
@@ -51,6 +54,8 @@ public:
       test_assign_oneToStandard();
       test_assign_standardToOne();
       test_assign_standardToStandard();
+      test_assign_chainToStandard();
+      test_assign_recycledColor();
       test_assignMove_emptyToEmpty();
       test_assignMove_standardToEmpty();
       test_assignMove_emptyToStandard();
@@ -59,6 +64,10 @@ public:
       test_assignMove_standardToStandard();
       test_assignInitializer_oneToStandard();
       test_assignInitializer_standardToEmpty();
+      test_assignSorted_emptyToStandard();
+      test_assignSorted_standardToEmpty();
+      test_assignSorted_standardToStandard();
+      test_assignSorted_large();
       test_swap_emptyToEmpty();
       test_swap_standardToEmpty();
       test_swap_emptyToStandard();
@@ -81,25 +90,56 @@ public:
       test_find_standardBegin();
       test_find_standardLast();
       test_find_standardMissing();
+      test_findBatch_empty();
+      test_findBatch_standard();
+      test_findBatch_manyGroups();
 
       // Insert
       test_insert_oneLeft();
       test_insert_oneRight();
       test_insert_duplicate();
       test_insert_keepUnique();
+      test_insert_keepUniqueNew();
       test_insertMove_oneLeft();
       test_insertMove_oneRight();
       test_insertMove_duplicate();
       test_insertMove_keepUnique();
 
+      // Compare
+      test_compare_greater();
+      test_compare_oneLessthanPerLevel();
+
+      // Hint
+      test_insertHint_empty();
+      test_insertHint_appendEnd();
+      test_insertHint_appendLast();
+      test_insertHint_before();
+      test_insertHint_wrong();
+      test_insertHint_duplicate();
+      test_insertHint_nearlySorted();
+
       // Remove
       test_erase_empty();
       test_erase_standardMissing();
+      test_erase_onlyNode();
       test_erase_noChildren();
       test_erase_oneChild();
       test_erase_twoChildren();
+      test_erase_twoChildrenDeep();
+      test_eraseRange_toEnd();
+      test_eraseRange_window();
+      test_eraseRange_degenerate();
       test_clear_empty();
       test_clear_standard();
+      test_clear_degenerate();
+
+      // Layout
+      test_compact_empty();
+      test_compact_inOrder();
+      test_compact_breadthFirst();
+      test_compact_vanEmdeBoas();
+      test_compact_eraseInsert();
+      test_compact_degenerate();
 
       // Status
       test_empty_empty();
@@ -255,6 +295,29 @@ public:
       teardownStandardFixture(bstDest);
    }
 
+   // copy a tree that is one long chain. This used to overflow the stack
+   void test_constructCopy_degenerate()
+   {  // setup
+      //   (0)
+      //    +-(1)
+      //       +-(2)
+      //          +- ... -(999999)
+      custom::BST <int> bstSrc;
+      setupDegenerateFixture(bstSrc, 1000000);
+      // exercise
+      custom::BST <int> bstDest(bstSrc);
+      // verify
+      assertUnit(bstDest.numElements == 1000000);
+      assertUnit(bstDest.root != bstSrc.root);
+      int count = 0;
+      bool inOrder = true;
+      for (auto it = bstDest.begin(); it != bstDest.end(); ++it)
+         inOrder = inOrder && (*it == count++);
+      assertUnit(count == 1000000);
+      assertUnit(inOrder);
+      // teardown
+   }
+
    /***************************************
     * MOVE CONSTRUCTOR
     ***************************************/
@@ -773,6 +836,108 @@ public:
    }
 
 
+   // assignment operator : standard = chain. Nodes are reused whatever the shape
+   void test_assign_chainToStandard()
+   {  // setup
+      //                (99) = bstSrc
+      //          +-------+
+      //        (88)
+      //     +----+
+      //   (77)
+      custom::BST <Spy> bstSrc;
+      custom::BST <Spy>::BNode* p99 = new custom::BST<Spy>::BNode(Spy(99));
+      custom::BST <Spy>::BNode* p88 = new custom::BST<Spy>::BNode(Spy(88));
+      custom::BST <Spy>::BNode* p77 = new custom::BST<Spy>::BNode(Spy(77));
+      p99->pLeft = p88;
+      p88->pParent = p99;
+      p88->pLeft = p77;
+      p77->pParent = p88;
+      bstSrc.root = p99;
+      bstSrc.numElements = 3;
+      //                (50) = bstDest
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)       (40) (60)       (80)
+      custom::BST <Spy> bstDest;
+      setupStandardFixture(bstDest);
+      Spy::reset();
+      // exercise
+      bstDest = bstSrc;
+      // verify
+      assertUnit(Spy::numAssign() == 3);      // assign   [99][88][77] onto existing nodes
+      assertUnit(Spy::numDestructor() == 4);  // destroy  the four nodes left over
+      assertUnit(Spy::numDelete() == 4);      // delete   the four nodes left over
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(bstDest.numElements == 3);
+      assertUnit(bstDest.root != nullptr);
+      if (bstDest.root)
+      {
+         assertUnit(bstDest.root->data == Spy(99));
+         assertUnit(bstDest.root->pParent == nullptr);
+         assertUnit(bstDest.root->pRight == nullptr);
+         assertUnit(bstDest.root->pLeft != nullptr);
+         if (bstDest.root->pLeft)
+         {
+            assertUnit(bstDest.root->pLeft->data == Spy(88));
+            assertUnit(bstDest.root->pLeft->pParent == bstDest.root);
+            assertUnit(bstDest.root->pLeft->pRight == nullptr);
+            assertUnit(bstDest.root->pLeft->pLeft != nullptr);
+            if (bstDest.root->pLeft->pLeft)
+            {
+               assertUnit(bstDest.root->pLeft->pLeft->data == Spy(77));
+               assertUnit(bstDest.root->pLeft->pLeft->pParent == bstDest.root->pLeft);
+               assertUnit(bstDest.root->pLeft->pLeft->pLeft == nullptr);
+               assertUnit(bstDest.root->pLeft->pLeft->pRight == nullptr);
+            }
+         }
+      }
+      // teardown
+      teardownStandardFixture(bstSrc);
+      teardownStandardFixture(bstDest);
+   }
+
+   // a reused node keeps nothing from its old life, not even its color
+   void test_assign_recycledColor()
+   {  // setup
+      //                (50) = bstSrc
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)       (40) (60)       (80)
+      custom::BST <Spy> bstSrc;
+      setupStandardFixture(bstSrc);
+      //                (50) = bstDest, every node red
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)       (40) (60)       (80)
+      custom::BST <Spy> bstDest;
+      setupStandardFixture(bstDest);
+      for (auto it = bstDest.begin(); it != bstDest.end(); ++it)
+         it.getNode()->isRed = true;
+      Spy::reset();
+      // exercise
+      bstDest = bstSrc;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      bool black = true;
+      for (auto it = bstDest.begin(); it != bstDest.end(); ++it)
+         black = black && !it.getNode()->isRed;
+      assertUnit(black);
+      assertStandardFixture(bstDest);
+      // teardown
+      teardownStandardFixture(bstSrc);
+      teardownStandardFixture(bstDest);
+   }
+
    /***************************************
     * Assignment-Move
     *    BST::operator=(BST &&)
@@ -1053,6 +1218,105 @@ public:
    }
 
 
+   /***************************************
+    * ASSIGN SORTED
+    *    BST::assign_sorted(first, last)
+    ***************************************/
+
+   // sorted input builds the standard fixture, middle first
+   void test_assignSorted_emptyToStandard()
+   {  // setup
+      std::vector<Spy> src{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      custom::BST <Spy> bstDest;
+      Spy::reset();
+      // exercise
+      bstDest.assign_sorted(src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 7);        // copy     [20][30][40][50][60][70][80]
+      assertUnit(Spy::numAlloc() == 7);       // allocate [20][30][40][50][60][70][80]
+      assertUnit(Spy::numLessthan() == 0);    // no comparisons at all
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //                (50)
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)      (40)  (60)      (80)
+      assertStandardFixture(bstDest);
+      // teardown
+      teardownStandardFixture(bstDest);
+   }
+
+   // an empty range empties the tree
+   void test_assignSorted_standardToEmpty()
+   {  // setup
+      std::vector<Spy> src;
+      //                (50) = bstDest
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)      (40)  (60)      (80)
+      custom::BST <Spy> bstDest;
+      setupStandardFixture(bstDest);
+      Spy::reset();
+      // exercise
+      bstDest.assign_sorted(src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numDestructor() == 7);  // destroy  [20][30][40][50][60][70][80]
+      assertUnit(Spy::numDelete() == 7);      // delete   [20][30][40][50][60][70][80]
+      assertUnit(Spy::numAlloc() == 0);
+      assertEmptyFixture(bstDest);
+   }  // teardown
+
+   // the nodes we have are reused, so nothing is allocated
+   void test_assignSorted_standardToStandard()
+   {  // setup
+      std::vector<Spy> src{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      //                (50) = bstDest
+      //          +-------+-------+
+      //        (30)            (70)
+      //     +----+----+     +----+----+
+      //   (20)      (40)  (60)      (80)
+      custom::BST <Spy> bstDest;
+      setupStandardFixture(bstDest);
+      Spy::reset();
+      // exercise
+      bstDest.assign_sorted(src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numAssign() == 7);      // assign   [20][30][40][50][60][70][80]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertStandardFixture(bstDest);
+      // teardown
+      teardownStandardFixture(bstDest);
+   }
+
+   // a million elements in order make a tree 20 deep, not a million
+   void test_assignSorted_large()
+   {  // setup
+      std::vector<int> src;
+      for (int i = 0; i < 1000000; i++)
+         src.push_back(i);
+      custom::BST <int> bst;
+      // exercise
+      bst.assign_sorted(src.begin(), src.end());
+      // verify
+      assertUnit(bst.numElements == 1000000);
+      assertUnit(bst.root->pParent == nullptr);
+      int depth = 0;
+      for (auto p = bst.root; p; p = p->pLeft)
+         depth++;
+      assertUnit(depth == 20);
+      int count = 0;
+      bool inOrder = true;
+      for (auto it = bst.begin(); it != bst.end(); ++it)
+         inOrder = inOrder && (*it == count++);
+      assertUnit(count == 1000000);
+      assertUnit(inOrder);
+   }  // teardown
+
+
    /***************************************
     * Swap
     *    BST::swap(BST &)
@@ -1244,6 +1508,21 @@ public:
       assertEmptyFixture(bst);
    }  // teardown
 
+   // clear a tree that is one long chain. This used to overflow the stack
+   void test_clear_degenerate()
+   {  // setup
+      //   (0)
+      //    +-(1)
+      //       +- ... -(999999)
+      custom::BST <int> bst;
+      setupDegenerateFixture(bst, 1000000);
+      // exercise
+      bst.clear();
+      // verify
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.numElements == 0);
+   }  // teardown
+
    /***************************************
     * Iterator
     *     BST::begin()
@@ -1674,8 +1953,8 @@ public:
       // exercise
       it = bst.find(s);
       // verify
-      assertUnit(Spy::numEquals() == 3);      // check [50][30][20]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][30][20], then [20] back
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -1717,8 +1996,8 @@ public:
       // exercise
       it = bst.find(s);
       // verify
-      assertUnit(Spy::numEquals() == 3);      // check [50][70][80]
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][70]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][70][80], then [80] back
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -1760,8 +2039,8 @@ public:
       // exercise
       it = bst.find(s);
       // verify
-      assertUnit(Spy::numEquals() == 3);      // check [50][30][40]
-      assertUnit(Spy::numLessthan() == 3);    // compare [50][30][40]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][30][40], then [40] back
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -1777,6 +2056,78 @@ public:
       teardownStandardFixture(bst);
    }
 
+   // every key in an empty BST misses, without a comparison
+   void test_findBatch_empty()
+   {  // setup
+      custom::BST <Spy> bst;
+      std::vector<Spy> keys{ Spy(10), Spy(20), Spy(30) };
+      std::vector<custom::BST<Spy>::iterator> found;
+      Spy::reset();
+      // exercise
+      bst.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(found.size() == 3);
+      for (auto it : found)
+         assertUnit(it == bst.end());
+   }  // teardown
+
+   // hits and misses come back in the order asked, with find's comparisons
+   void test_findBatch_standard()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      std::vector<Spy> keys{ Spy(60), Spy(45), Spy(20), Spy(80), Spy(10) };
+      std::vector<custom::BST<Spy>::iterator> found;
+      Spy::reset();
+      // exercise
+      bst.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+      // verify
+      assertUnit(Spy::numLessthan() == 4 + 4 + 4 + 4 + 3);  // [10] never turns right
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(found.size() == 5);
+      if (found.size() == 5)
+      {
+         assertUnit(found[0] != bst.end() && *found[0] == Spy(60));
+         assertUnit(found[1] == bst.end());
+         assertUnit(found[2] != bst.end() && *found[2] == Spy(20));
+         assertUnit(found[3] != bst.end() && *found[3] == Spy(80));
+         assertUnit(found[4] == bst.end());
+      }
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // more keys than fit in one group give the same answers as find
+   void test_findBatch_manyGroups()
+   {  // setup
+      std::vector<int> elements;
+      for (int i = 1; i <= 127; i++)
+         elements.push_back(i * 2);
+      custom::BST <int> bst;
+      bst.assign_sorted(elements.begin(), elements.end());
+      std::vector<int> keys;
+      for (int i = 0; i < 300; i++)
+         keys.push_back((i * 37) % 260);
+      std::vector<custom::BST<int>::iterator> found(keys.size());
+      // exercise
+      auto itEnd = bst.find_batch(keys.begin(), keys.end(), found.begin());
+      // verify
+      assertUnit(itEnd == found.end());
+      bool same = true;
+      for (size_t i = 0; i < keys.size(); i++)
+         same = same && found[i] == bst.find(keys[i]);
+      assertUnit(same);
+   }  // teardown
 
 
    /***************************************
@@ -1981,8 +2332,8 @@ public:
       // exercise
       auto pairBST = bst.insert(s, true /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
-      assertUnit(Spy::numEquals() == 3);      // compare [50][30][40]
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][30][40], then [40] back
+      assertUnit(Spy::numEquals() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDestructor() == 0);
@@ -2006,6 +2357,55 @@ public:
       teardownStandardFixture(bst);
    }
 
+   // insert a new item when duplicates are not allowed
+   void test_insert_keepUniqueNew()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(45);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(s, true /* keepUnique */);
+      // verify
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][30][40], then [40] back
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(pairBST.second == true);
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      //                +--+
+      //                  45
+      assertUnit(bst.numElements == 8);
+      assertUnit(bst.root != nullptr && bst.root->pLeft != nullptr && bst.root->pLeft->pRight != nullptr);
+      if (bst.root && bst.root->pLeft && bst.root->pLeft->pRight)
+      {
+         custom::BST<Spy>::BNode* p40 = bst.root->pLeft->pRight;
+         assertUnit(p40->pRight != nullptr);
+         assertUnit(p40->pLeft == nullptr);
+         if (p40->pRight)
+         {
+            assertUnit(p40->pRight->data == Spy(45));
+            assertUnit(p40->pRight->pParent == p40);
+            assertUnit(pairBST.first.pNode == p40->pRight);
+            delete p40->pRight;
+            p40->pRight = nullptr;
+         }
+      }
+      bst.numElements = 7;
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
 
 
 
@@ -2213,8 +2613,8 @@ public:
       // exercise
       auto pairBST = bst.insert(std::move(s), true /* keepUnique */);
       // verify
-      assertUnit(Spy::numLessthan() == 2);    // compare [50][30]
-      assertUnit(Spy::numEquals() == 3);      // compare [50][30][40]
+      assertUnit(Spy::numLessthan() == 4);    // compare [50][30][40], then [40] back
+      assertUnit(Spy::numEquals() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDestructor() == 0);
@@ -2240,6 +2640,264 @@ public:
    }
 
 
+   /***************************************
+    * Compare
+    *    BST <T, Compare>
+    ***************************************/
+
+   // the comparator decides the order
+   void test_compare_greater()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         70              30  
+      //     +----+----+     +----+----+
+      //    80        60    40        20  
+      custom::BST <int, std::greater<int>> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto pairBST = bst.insert(40, true /* keepUnique */);
+      auto it = bst.find(60);
+      // verify
+      assertUnit(pairBST.second == false);
+      assertUnit(it != bst.end());
+      assertUnit(bst.find(65) == bst.end());
+      assertUnit(bst.root != nullptr && bst.root->pLeft != nullptr);
+      if (bst.root && bst.root->pLeft)
+      {
+         assertUnit(bst.root->data == 50);
+         assertUnit(bst.root->pLeft->data == 70);
+         assertUnit(it.pNode == bst.root->pLeft->pRight);
+      }
+      std::vector<int> order;
+      for (auto itOrder = bst.begin(); itOrder != bst.end(); ++itOrder)
+         order.push_back(*itOrder);
+      assertUnit(order == std::vector<int>({ 80, 70, 60, 50, 40, 30, 20 }));
+   }  // teardown
+
+   // a search makes one comparison per level and one at the bottom, hit or
+   // miss, unless it never turned right and so has nothing to check
+   void test_compare_oneLessthanPerLevel()
+   {  // setup
+      std::vector<Spy> elements;
+      for (int i = 1; i <= 127; i++)
+         elements.push_back(Spy(i * 2));
+      custom::BST <Spy> bst;
+      bst.assign_sorted(elements.begin(), elements.end());   // seven full levels
+      bool eightEach = true;
+      bool noEquals = true;
+      // exercise
+      for (int i = 1; i <= 255; i++)
+      {
+         Spy s(i);
+         Spy::reset();
+         auto it = bst.find(s);
+         eightEach = eightEach && Spy::numLessthan() == (i == 1 ? 7 : 8);
+         noEquals = noEquals && Spy::numEquals() == 0;
+         eightEach = eightEach && ((it != bst.end()) == (i % 2 == 0));
+      }
+      // verify
+      assertUnit(eightEach);
+      assertUnit(noEquals);
+   }  // teardown
+
+
+   /***************************************
+    * Hint
+    *    BST::insert(hint, t)
+    ***************************************/
+
+   // the hint does not matter in an empty BST
+   void test_insertHint_empty()
+   {  // setup
+      custom::BST <Spy> bst;
+      Spy s(50);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(bst.end(), s);
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numAlloc() == 1);
+      assertUnit(pairBST.second == true);
+      assertUnit(bst.numElements == 1);
+      assertUnit(bst.root != nullptr);
+      assertUnit(pairBST.first.pNode == bst.root);
+      assertUnit(bst.pRightmost == bst.root);
+   }  // teardown
+
+   // appending at end() makes one comparison, not one per level
+   void test_insertHint_appendEnd()
+   {  // setup
+      custom::BST <Spy> bst;
+      bool oneEach = true;
+      // exercise
+      for (int i = 1; i <= 100; i++)
+      {
+         Spy s(i);
+         Spy::reset();
+         bst.insert(bst.end(), s);
+         oneEach = oneEach && Spy::numLessthan() == (i == 1 ? 0 : 1);
+      }
+      // verify
+      assertUnit(oneEach);
+      assertUnit(bst.numElements == 100);
+      assertUnit(bst.pRightmost != nullptr);
+      if (bst.pRightmost)
+         assertUnit(bst.pRightmost->data == Spy(100));
+      assertUnit(inOrder(bst, 100));
+   }  // teardown
+
+   // appending after the last insert, duplicates not allowed, makes two
+   void test_insertHint_appendLast()
+   {  // setup
+      custom::BST <Spy> bst;
+      auto it = bst.end();
+      bool twoEach = true;
+      // exercise
+      for (int i = 1; i <= 100; i++)
+      {
+         Spy s(i);
+         Spy::reset();
+         it = bst.insert(it, s, true /* keepUnique */).first;
+         twoEach = twoEach && Spy::numLessthan() == (i == 1 ? 0 : 2);
+      }
+      // verify
+      assertUnit(twoEach);
+      assertUnit(bst.numElements == 100);
+      assertUnit(inOrder(bst, 100));
+   }  // teardown
+
+   // a hint right after the new element is used
+   void test_insertHint_before()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      auto itHint = bst.find(Spy(50));
+      Spy s(45);
+      Spy::reset();
+      // exercise
+      auto pairBST = bst.insert(itHint, s);
+      // verify
+      assertUnit(Spy::numLessthan() == 2);    // compare [50], then [40] before it
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(pairBST.second == true);
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      //                +--+
+      //                  45
+      assertUnit(bst.numElements == 8);
+      assertUnit(bst.root != nullptr && bst.root->pLeft != nullptr && bst.root->pLeft->pRight != nullptr);
+      if (bst.root && bst.root->pLeft && bst.root->pLeft->pRight)
+      {
+         assertUnit(bst.root->pLeft->pRight->pRight != nullptr);
+         assertUnit(pairBST.first.pNode == bst.root->pLeft->pRight->pRight);
+         delete bst.root->pLeft->pRight->pRight;
+         bst.root->pLeft->pRight->pRight = nullptr;
+      }
+      bst.numElements = 7;
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // a hint in the wrong place falls back to the full descent
+   void test_insertHint_wrong()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      auto itHint = bst.begin();
+      Spy s(65);
+      // exercise
+      auto pairBST = bst.insert(itHint, s);
+      // verify
+      assertUnit(pairBST.second == true);
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      //                       +--+
+      //                         65
+      assertUnit(bst.numElements == 8);
+      assertUnit(bst.root != nullptr && bst.root->pRight != nullptr && bst.root->pRight->pLeft != nullptr);
+      if (bst.root && bst.root->pRight && bst.root->pRight->pLeft)
+      {
+         assertUnit(bst.root->pRight->pLeft->pRight != nullptr);
+         assertUnit(pairBST.first.pNode == bst.root->pRight->pLeft->pRight);
+         delete bst.root->pRight->pLeft->pRight;
+         bst.root->pRight->pLeft->pRight = nullptr;
+      }
+      bst.numElements = 7;
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // an element already beside the hint is returned, not added
+   void test_insertHint_duplicate()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      auto it40 = bst.find(Spy(40));
+      auto it50 = bst.find(Spy(50));
+      Spy s(40);
+      Spy::reset();
+      // exercise
+      auto pairAt = bst.insert(it40, s, true /* keepUnique */);
+      auto pairAfter = bst.insert(it50, s, true /* keepUnique */);
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(pairAt.second == false);
+      assertUnit(pairAt.first == it40);
+      assertUnit(pairAfter.second == false);
+      assertUnit(pairAfter.first == it40);
+      assertStandardFixture(bst);
+      // teardown
+      teardownStandardFixture(bst);
+   }
+
+   // nearly sorted input, each hinted with the last insert, stays sorted
+   void test_insertHint_nearlySorted()
+   {  // setup
+      custom::BST <int> bst;
+      auto it = bst.end();
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         int value = (i % 10 == 9) ? i - 5 : (i % 10 >= 4 ? i + 1 : i);
+         it = bst.insert(it, value, true /* keepUnique */).first;
+      }
+      // verify
+      assertUnit(bst.numElements == 200);
+      std::vector<int> order;
+      for (auto itOrder = bst.begin(); itOrder != bst.end(); ++itOrder)
+         order.push_back(*itOrder);
+      bool sorted = order.size() == 200;
+      for (int i = 0; sorted && i < 200; i++)
+         sorted = order[i] == i;
+      assertUnit(sorted);
+   }  // teardown
+
+
    /***************************************
     * Erase
     *    BST::erase(it)
@@ -2301,6 +2959,24 @@ public:
       teardownStandardFixture(bst);
    }  // teardown
 
+   // remove the only node, leaving an empty BST
+   void test_erase_onlyNode()
+   {  // setup
+      //   [[50]]
+      custom::BST <Spy> bst;
+      bst.root = new custom::BST<Spy>::BNode(Spy(50));
+      bst.numElements = 1;
+      auto it = bst.begin();
+      Spy::reset();
+      // exercise
+      auto itReturn = bst.erase(it);
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+      assertUnit(itReturn == bst.end());
+      assertEmptyFixture(bst);
+   }  // teardown
+
    // remove a leaf node from the standard fixture
    void test_erase_noChildren()
    {  // setup
@@ -2475,6 +3151,307 @@ public:
       bst.root = nullptr;
    }
 
+   // the successor is two levels down and has a right child of its own
+   void test_erase_twoChildrenDeep()
+   {  // setup
+      //         [[20]]
+      //     +------+------+
+      //    10            80
+      //              +----+
+      //             50
+      //          +---+
+      //         30
+      //          +-+
+      //            40
+      custom::BST <int> bst;
+      auto p10 = new custom::BST<int>::BNode(10);
+      auto p20 = new custom::BST<int>::BNode(20);
+      auto p30 = new custom::BST<int>::BNode(30);
+      auto p40 = new custom::BST<int>::BNode(40);
+      auto p50 = new custom::BST<int>::BNode(50);
+      auto p80 = new custom::BST<int>::BNode(80);
+      bst.root = p10->pParent = p80->pParent = p20;
+      p20->pLeft = p10;
+      p20->pRight = p50->pParent = p80;
+      p80->pLeft = p30->pParent = p50;
+      p50->pLeft = p40->pParent = p30;
+      p30->pRight = p40;
+      bst.numElements = 6;
+      auto it = custom::BST <int> ::iterator(p20);
+      // exercise
+      auto itReturn = bst.erase(it);
+      // verify
+      //           30
+      //     +------+------+
+      //    10            80
+      //              +----+
+      //             50
+      //          +---+
+      //         40
+      assertUnit(itReturn == custom::BST <int> ::iterator(p30));
+      assertUnit(bst.root == p30);
+      assertUnit(bst.numElements == 5);
+      assertUnit(p30->pParent == nullptr);
+      assertUnit(p30->pLeft == p10);
+      assertUnit(p30->pRight == p80);
+      assertUnit(p10->pParent == p30);
+      assertUnit(p80->pParent == p30);
+      assertUnit(p80->pLeft == p50);
+      assertUnit(p50->pParent == p80);
+      assertUnit(p50->pLeft == p40);
+      assertUnit(p40->pParent == p50);
+      assertUnit(p50->pRight == nullptr);
+      assertUnit(p40->pLeft == nullptr && p40->pRight == nullptr);
+      // teardown
+      delete p10;
+      delete p30;
+      delete p40;
+      delete p50;
+      delete p80;
+      bst.numElements = 0;
+      bst.root = nullptr;
+   }
+
+   // a range that runs to the end takes the last node with it
+   void test_eraseRange_toEnd()
+   {  // setup
+      std::vector<Spy> elements;
+      for (int i = 1; i <= 127; i++)
+         elements.push_back(Spy(i));
+      custom::BST <Spy> bst;
+      bst.assign_sorted(elements.begin(), elements.end());
+      auto itFirst = bst.find(Spy(100));
+      Spy::reset();
+      // exercise
+      auto itReturn = bst.erase(itFirst, bst.end());
+      // verify
+      assertUnit(Spy::numDestructor() == 28);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(itReturn == bst.end());
+      assertUnit(bst.numElements == 99);
+      assertUnit(bst.pRightmost == nullptr);
+      assertUnit(bst.root != nullptr && bst.root->pParent == nullptr);
+      assertUnit(inOrder(bst, 99));
+   }  // teardown
+
+   // a window in the middle costs a few comparisons per level, not per element
+   void test_eraseRange_window()
+   {  // setup
+      std::vector<Spy> elements;
+      for (int i = 1; i <= 1023; i++)
+         elements.push_back(Spy(i));
+      custom::BST <Spy> bst;
+      bst.assign_sorted(elements.begin(), elements.end());   // ten full levels
+      auto itFirst = bst.find(Spy(300));
+      auto itLast = bst.find(Spy(800));
+      Spy::reset();
+      // exercise
+      auto itReturn = bst.erase(itFirst, itLast);
+      // verify
+      assertUnit(Spy::numLessthan() <= 40);
+      assertUnit(Spy::numDestructor() == 500);
+      assertUnit(itReturn == itLast);
+      assertUnit(bst.numElements == 523);
+      int i = 1;
+      bool same = true;
+      for (auto it = bst.begin(); same && it != bst.end(); ++it, i = (i == 299 ? 800 : i + 1))
+         same = *it == Spy(i);
+      assertUnit(same);
+      assertUnit(i == 1024);
+   }  // teardown
+
+   // a long chain does not need a deep recursion
+   void test_eraseRange_degenerate()
+   {  // setup
+      //   (0)
+      //    +-(1)
+      //       +-(2)
+      //          +- ... -(999999)
+      custom::BST <int> bst;
+      setupDegenerateFixture(bst, 1000000);
+      auto itFirst = bst.find(10);
+      auto itLast = bst.find(999990);
+      // exercise
+      auto itReturn = bst.erase(itFirst, itLast);
+      itReturn = bst.erase(bst.find(999995), bst.end());
+      // verify
+      assertUnit(itReturn == bst.end());
+      assertUnit(bst.numElements == 15);
+      assertUnit(bst.root != nullptr && bst.root->pParent == nullptr);
+      int i = 0;
+      bool same = true;
+      for (auto it = bst.begin(); same && it != bst.end(); ++it, i = (i == 9 ? 999990 : i + 1))
+         same = *it == i;
+      assertUnit(same);
+      assertUnit(i == 999995);
+   }  // teardown
+
+   /***************************************
+    * COMPACT
+    ***************************************/
+
+   // nothing to move
+   void test_compact_empty()
+   {  // setup
+      custom::BST <Spy> bst;
+      Spy::reset();
+      // exercise
+      bst.compact();
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(bst.root == nullptr);
+      assertUnit(bst.pSlab == nullptr);
+      assertUnit(bst.numElements == 0);
+   }  // teardown
+
+   // a scattered tree ends up in the slab in order, moved rather than copied
+   void test_compact_inOrder()
+   {  // setup
+      custom::BST <Spy> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert(Spy(i * 37 % 100 + 1));
+      custom::BST<Spy>::BNode* pRoot = bst.root;
+      Spy s(pRoot->data);
+      Spy::reset();
+      // exercise
+      bst.compact(custom::bst_layout::in_order);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 100);
+      assertUnit(Spy::numDestructor() == 100);
+      assertUnit(bst.pSlab != nullptr);
+      assertUnit(bst.slabSize == 100);
+      assertUnit(bst.slabLive == 100);
+      assertUnit(bst.numElements == 100);
+      assertUnit(bst.root->pParent == nullptr);
+      assertUnit(bst.root->data == s);
+      size_t i = 0;
+      bool linked = true;
+      for (auto it = bst.begin(); it != bst.end(); ++it, i++)
+      {
+         custom::BST<Spy>::BNode* p = it.getNode();
+         linked = linked && p == bst.pSlab + i &&
+            (p->pLeft == nullptr || p->pLeft->pParent == p) &&
+            (p->pRight == nullptr || p->pRight->pParent == p);
+      }
+      assertUnit(linked);
+      assertUnit(inOrder(bst, 100));
+   }  // teardown
+
+   // the root comes first, then each level left to right
+   void test_compact_breadthFirst()
+   {  // setup
+      custom::BST <Spy> bst{ Spy(50), Spy(30), Spy(70), Spy(20), Spy(40), Spy(60), Spy(80) };
+      // exercise
+      bst.compact(custom::bst_layout::breadth_first);
+      // verify
+      custom::BST<Spy>::BNode* p = bst.pSlab;
+      assertUnit(bst.root == p);
+      assertUnit(p[0].data == Spy(50));
+      assertUnit(p[1].data == Spy(30));
+      assertUnit(p[2].data == Spy(70));
+      assertUnit(p[3].data == Spy(20));
+      assertUnit(p[6].data == Spy(80));
+      assertUnit(p[0].pLeft == p + 1 && p[0].pRight == p + 2);
+      assertUnit(p[1].pLeft == p + 3 && p[1].pRight == p + 4);
+      assertUnit(p[2].pLeft == p + 5 && p[2].pRight == p + 6);
+      assertUnit(p[6].pParent == p + 2);
+   }  // teardown
+
+   // the top levels, then each little tree below them, all kept together
+   void test_compact_vanEmdeBoas()
+   {  // setup
+      //                          (8)
+      //              +------------+------------+
+      //             (4)                       (12)
+      //        +-----+-----+             +-----+-----+
+      //       (2)         (6)          (10)         (14)
+      //     +--+--+     +--+--+      +--+--+      +--+--+
+      //    (1)   (3)   (5)   (7)    (9)  (11)   (13)  (15)
+      std::vector<Spy> elements;
+      for (int i = 1; i <= 15; i++)
+         elements.push_back(Spy(i));
+      custom::BST <Spy> bst;
+      bst.assign_sorted(elements.begin(), elements.end());
+      // exercise
+      bst.compact(custom::bst_layout::van_emde_boas);
+      // verify
+      custom::BST<Spy>::BNode* p = bst.pSlab;
+      assertUnit(bst.root == p);
+      int expected[] = { 8, 4, 12, 2, 1, 3, 6, 5, 7, 10, 9, 11, 14, 13, 15 };
+      bool same = true;
+      for (int i = 0; i < 15; i++)
+         same = same && p[i].data == Spy(expected[i]);
+      assertUnit(same);
+      assertUnit(p[0].pLeft == p + 1 && p[0].pRight == p + 2);
+      assertUnit(p[1].pLeft == p + 3 && p[3].pLeft == p + 4 && p[3].pRight == p + 5);
+      assertUnit(p[2].pRight == p + 12 && p[12].pParent == p + 2);
+      assertUnit(inOrder(bst, 15));
+   }  // teardown
+
+   // the slab nodes are freed one at a time, and the slab with the last
+   void test_compact_eraseInsert()
+   {  // setup
+      custom::BST <Spy> bst;
+      for (int i = 1; i <= 20; i += 2)
+         bst.insert(Spy(i));
+      bst.compact();
+      // exercise
+      for (int i = 2; i <= 20; i += 2)
+         bst.insert(Spy(i));
+      for (int i = 1; i <= 19; i += 2)
+      {
+         auto it = bst.find(Spy(i));
+         bst.erase(it);
+         // verify
+         assertUnit(bst.slabLive == (size_t)(19 - i) / 2);
+      }
+      assertUnit(bst.pSlab == nullptr);
+      assertUnit(bst.slabSize == 0);
+      assertUnit(bst.numElements == 10);
+      int i = 2;
+      for (auto it = bst.begin(); it != bst.end(); ++it, i += 2)
+         assertUnit(*it == Spy(i));
+      assertUnit(i == 22);
+      // exercise
+      bst.compact();
+      bst.compact(custom::bst_layout::van_emde_boas);
+      // verify
+      assertUnit(bst.slabSize == 10);
+      assertUnit(bst.slabLive == 10);
+   }  // teardown
+
+   // a long chain does not need a deep recursion
+   void test_compact_degenerate()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 20000; i++)
+         bst.insert(bst.end(), i);
+      // exercise
+      bst.compact(custom::bst_layout::van_emde_boas);
+      // verify
+      assertUnit(bst.root == bst.pSlab);
+      bool same = true;
+      int i = 0;
+      for (auto it = bst.begin(); it != bst.end(); ++it, i++)
+         same = same && *it == i && it.getNode() == bst.pSlab + i;
+      assertUnit(same);
+      assertUnit(i == 20000);
+   }  // teardown
+
+   /**************************************************************
+    * IN ORDER
+    * The BST holds exactly 1, 2, ... n, visited in order
+    *************************************************************/
+   bool inOrder(custom::BST <Spy>& bst, int n)
+   {
+      int i = 1;
+      for (auto it = bst.begin(); it != bst.end(); ++it, i++)
+         if (!(*it == Spy(i)))
+            return false;
+      return i == n + 1;
+   }
+
    /**************************************************************
     * SETUP STANDARD FIXTURE
     *                (50) 
@@ -2516,6 +3493,28 @@ public:
       bst.numElements = 7;
    }
 
+   /**************************************************************
+    * SETUP DEGENERATE FIXTURE
+    *   (0)
+    *    +-(1)
+    *       +- ... -(num - 1)
+    * What sorted inserts produce in an unbalanced tree
+    *************************************************************/
+   void setupDegenerateFixture(custom::BST <int>& bst, int num)
+   {
+      custom::BST<int>::BNode* pPrev = nullptr;
+      for (int i = 0; i < num; i++)
+      {
+         custom::BST<int>::BNode* pNode = new custom::BST<int>::BNode(i);
+         if (pPrev)
+            pPrev->addRight(pNode);
+         else
+            bst.root = pNode;
+         pPrev = pNode;
+      }
+      bst.numElements = num;
+   }
+
    /**************************************************************
     * VERIFY EMPTY FIXTURE
     *************************************************************/
@@ -0,0 +1,697 @@
+/***********************************************************************
+ * Header:
+ *    TEST BTREE
+ * Summary:
+ *    Unit tests for BTree, btree_set, and btree_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "btree.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>   // for rand
+#include <set>       // to check against
+#include <map>       // to check against
+#include <string>
+#include <vector>
+
+class TestBTree : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Set: construct
+      test_set_construct_default();
+      test_set_construct_initializerList();
+      test_set_constructCopy_shape();
+      test_set_constructMove_standard();
+      test_set_assign_standard();
+      test_set_destructor_spy();
+
+      // Set: insert
+      test_set_insert_splitRoot();
+      test_set_insert_ascending();
+      test_set_insert_descending();
+      test_set_insert_duplicate();
+      test_set_insert_random();
+
+      // Set: access
+      test_set_find_standard();
+      test_set_lowerBound_gaps();
+      test_set_iterate_forward();
+      test_set_iterate_backward();
+
+      // Set: remove
+      test_set_erase_key();
+      test_set_erase_iteratorNext();
+      test_set_erase_range();
+      test_set_erase_all();
+      test_set_erase_random();
+      test_set_clear_spy();
+
+      // Map
+      test_map_subscript_insert();
+      test_map_subscript_update();
+      test_map_at_found();
+      test_map_at_throw();
+      test_map_insert_pair();
+      test_map_find_standard();
+      test_map_erase_range();
+      test_map_random();
+      test_map_string();
+
+      report("BTree");
+   }
+
+   using Set4 = custom::btree_set<int, 4>;
+   using Map4 = custom::btree_map<int, int, 4>;
+
+   /***************************************
+    * SET : CONSTRUCT
+    ***************************************/
+
+   // nothing is allocated until something is inserted
+   void test_set_construct_default()
+   {  // setup
+      // exercise
+      Set4 s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.tree.root == nullptr);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+   // an initializer list is sorted and made unique
+   void test_set_construct_initializerList()
+   {  // setup
+      // exercise
+      Set4 s{ 50, 30, 70, 30, 20, 40, 60, 80 };
+      // verify
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // the copy is the same shape but shares no nodes
+   void test_set_constructCopy_shape()
+   {  // setup
+      Set4 sSrc;
+      for (int i = 0; i < 100; i++)
+         sSrc.insert(i * 3);
+      // exercise
+      Set4 sDest(sSrc);
+      // verify
+      assertUnit(validate(sDest.tree));
+      assertUnit(sDest.size() == 100);
+      assertUnit(sDest.tree.root != sSrc.tree.root);
+      assertUnit(height(sDest.tree) == height(sSrc.tree));
+      assertUnit(contents(sDest) == contents(sSrc));
+      sDest.erase(0);
+      assertUnit(sSrc.find(0) != sSrc.end());
+   }  // teardown
+
+   // move takes the nodes
+   void test_set_constructMove_standard()
+   {  // setup
+      Set4 sSrc{ 26, 49, 67, 89, 11, 31 };
+      void* pRoot = sSrc.tree.root;
+      // exercise
+      Set4 sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.tree.root == nullptr);
+      assertUnit(sDest.tree.root == pRoot);
+      assertUnit(sDest.size() == 6);
+      assertUnit(validate(sDest.tree));
+   }  // teardown
+
+   // assignment throws out what was there
+   void test_set_assign_standard()
+   {  // setup
+      Set4 sSrc{ 26, 49, 67, 89 };
+      Set4 sDest{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+      // exercise
+      sDest = sSrc;
+      // verify
+      assertUnit(contents(sDest) == std::vector<int>({ 26, 49, 67, 89 }));
+      assertUnit(validate(sDest.tree));
+      assertUnit(validate(sSrc.tree));
+   }  // teardown
+
+   // every element and every separator copy is freed
+   void test_set_destructor_spy()
+   {  // setup
+      Spy::reset();
+      {
+         custom::btree_set<Spy, 4> s;
+         for (int i = 0; i < 50; i++)
+            s.insert(Spy(i));
+      }  // exercise
+      // verify
+      assertUnit(Spy::numAlloc() > 50);    // the inner nodes hold copies of keys
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+   /***************************************
+    * SET : INSERT
+    ***************************************/
+
+   // the fifth element splits the root leaf
+   void test_set_insert_splitRoot()
+   {  // setup
+      Set4 s{ 10, 20, 30, 40 };
+      assertUnit(s.tree.root->isLeaf);
+      // exercise
+      s.insert(25);
+      // verify
+      assertUnit(!s.tree.root->isLeaf);
+      assertUnit(height(s.tree) == 2);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 10, 20, 25, 30, 40 }));
+   }  // teardown
+
+   // the worst case for a naive tree
+   void test_set_insert_ascending()
+   {  // setup
+      Set4 s;
+      bool inserted = true;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         inserted = inserted && s.insert(i).second;
+      // verify
+      assertUnit(inserted);
+      assertUnit(s.size() == 1000);
+      assertUnit(validate(s.tree));
+      assertUnit(height(s.tree) <= 10);
+   }  // teardown
+
+   // and the other way
+   void test_set_insert_descending()
+   {  // setup
+      Set4 s;
+      // exercise
+      for (int i = 999; i >= 0; i--)
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(validate(s.tree));
+      assertUnit(*s.begin() == 0);
+   }  // teardown
+
+   // a duplicate is not inserted, and we get the one already there
+   void test_set_insert_duplicate()
+   {  // setup
+      Set4 s{ 26, 49, 67, 89, 11, 31 };
+      // exercise
+      std::pair<Set4::iterator, bool> result = s.insert(67);
+      // verify
+      assertUnit(result.second == false);
+      assertUnit(*result.first == 67);
+      assertUnit(s.size() == 6);
+   }  // teardown
+
+   // agrees with std::set for many random inserts
+   void test_set_insert_random()
+   {  // setup
+      Set4 s;
+      std::set<int> reference;
+      bool same = true;
+      srand(232);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int value = rand() % 2000;
+         same = same && s.insert(value).second == reference.insert(value).second;
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>(reference.begin(), reference.end()));
+   }  // teardown
+
+   /***************************************
+    * SET : ACCESS
+    ***************************************/
+
+   // every value is found and nothing else is
+   void test_set_find_standard()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 500; i++)
+         s.insert(i * 2);
+      bool found = true;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         found = found && ((s.find(i) != s.end()) == (i % 2 == 0));
+      // verify
+      assertUnit(found);
+      assertUnit(*s.find(998) == 998);
+      assertUnit(s.find(-1) == s.end());
+   }  // teardown
+
+   // lower bound lands on the next element across leaf boundaries
+   void test_set_lowerBound_gaps()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 200; i++)
+         s.insert(i * 10);
+      bool right = true;
+      // exercise
+      for (int i = -5; i <= 1990; i++)
+      {
+         Set4::iterator it = s.tree.lower_bound(i);
+         right = right && *it == (i <= 0 ? 0 : (i + 9) / 10 * 10);
+      }
+      // verify
+      assertUnit(right);
+      assertUnit(s.tree.lower_bound(1991) == s.end());
+   }  // teardown
+
+   // the leaves chain together in order
+   void test_set_iterate_forward()
+   {  // setup
+      Set4 s;
+      for (int i = 99; i >= 0; i--)
+         s.insert(i);
+      int expect = 0;
+      bool inOrder = true;
+      // exercise
+      for (Set4::iterator it = s.begin(); it != s.end(); ++it)
+         inOrder = inOrder && *it == expect++;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 100);
+   }  // teardown
+
+   // and back again from the end
+   void test_set_iterate_backward()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      int expect = 99;
+      bool inOrder = true;
+      Set4::iterator it = s.end();
+      // exercise
+      do
+      {
+         --it;
+         inOrder = inOrder && *it == expect--;
+      } while (it != s.begin());
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == -1);
+   }  // teardown
+
+   /***************************************
+    * SET : REMOVE
+    ***************************************/
+
+   // erase by value reports whether it was there
+   void test_set_erase_key()
+   {  // setup
+      Set4 s{ 26, 49, 67, 89, 11, 31, 71, 99 };
+      // exercise
+      size_t yes = s.erase(67);
+      size_t no = s.erase(68);
+      // verify
+      assertUnit(yes == 1);
+      assertUnit(no == 0);
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+      assertUnit(s.find(67) == s.end());
+   }  // teardown
+
+   // erase by iterator gives back the next element
+   void test_set_erase_iteratorNext()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      Set4::iterator it = s.erase(s.find(40));
+      Set4::iterator itLast = s.erase(s.find(99));
+      // verify
+      assertUnit(*it == 41);
+      assertUnit(itLast == s.end());
+      assertUnit(s.size() == 98);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // erase a range in the middle
+   void test_set_erase_range()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      Set4::iterator it = s.erase(s.find(20), s.find(80));
+      // verify
+      assertUnit(*it == 80);
+      assertUnit(s.size() == 40);
+      assertUnit(validate(s.tree));
+      assertUnit(s.find(19) != s.end());
+      assertUnit(s.find(20) == s.end());
+      assertUnit(s.find(79) == s.end());
+   }  // teardown
+
+   // erase everything, one at a time, and the nodes all go away
+   void test_set_erase_all()
+   {  // setup
+      Set4 s;
+      for (int i = 0; i < 300; i++)
+         s.insert(i);
+      bool valid = true;
+      // exercise
+      for (int i = 0; i < 300; i += 2)
+         valid = valid && s.erase(i) == 1 && validate(s.tree);
+      for (int i = 299; i > 0; i -= 2)
+         valid = valid && s.erase(i) == 1 && validate(s.tree);
+      // verify
+      assertUnit(valid);
+      assertUnit(s.empty());
+      assertUnit(s.tree.root == nullptr);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+   // agrees with std::set for a random mix of inserts and erases
+   void test_set_erase_random()
+   {  // setup
+      Set4 s;
+      std::set<int> reference;
+      bool same = true;
+      bool valid = true;
+      srand(3);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = rand() % 500;
+         if (rand() % 2)
+            same = same && s.insert(value).second == reference.insert(value).second;
+         else
+            same = same && s.erase(value) == reference.erase(value);
+         if (i % 997 == 0)
+            valid = valid && validate(s.tree);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(valid);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>(reference.begin(), reference.end()));
+   }  // teardown
+
+   // clear destroys every element
+   void test_set_clear_spy()
+   {  // setup
+      custom::btree_set<Spy, 4> s;
+      for (int i = 0; i < 50; i++)
+         s.insert(Spy(i));
+      Spy::reset();
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(Spy::numDestructor() > 50); // elements and separators
+      assertUnit(Spy::numDelete() == Spy::numDestructor());
+      assertUnit(s.empty());
+      assertUnit(s.tree.root == nullptr);
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // subscript on a missing key inserts a default value
+   void test_map_subscript_insert()
+   {  // setup
+      Map4 m;
+      // exercise
+      int value = m[26];
+      // verify
+      assertUnit(value == 0);
+      assertUnit(m.size() == 1);
+      assertUnit((*m.begin()).first == 26);
+   }  // teardown
+
+   // subscript on a present key changes the value in place
+   void test_map_subscript_update()
+   {  // setup
+      Map4 m;
+      for (int i = 0; i < 100; i++)
+         m[i] = i;
+      // exercise
+      m[50] = 500;
+      m[50] += 5;
+      // verify
+      assertUnit(m.size() == 100);
+      assertUnit(m[50] == 505);
+      assertUnit(m.at(49) == 49);
+   }  // teardown
+
+   // at finds what is there
+   void test_map_at_found()
+   {  // setup
+      Map4 m{ { 26, 2 }, { 49, 4 }, { 67, 6 }, { 89, 8 }, { 11, 1 } };
+      const Map4& mConst = m;
+      // exercise
+      m.at(67) = 7;
+      // verify
+      assertUnit(mConst.at(67) == 7);
+      assertUnit(mConst[11] == 1);
+   }  // teardown
+
+   // at throws on a missing key
+   void test_map_at_throw()
+   {  // setup
+      Map4 m{ { 26, 2 }, { 49, 4 } };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(50);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   // insert does not replace
+   void test_map_insert_pair()
+   {  // setup
+      Map4 m{ { 26, 2 }, { 49, 4 } };
+      // exercise
+      custom::pair<Map4::iterator, bool> yes = m.insert(custom::pair<int, int>(67, 6));
+      custom::pair<Map4::iterator, bool> no = m.insert(custom::pair<int, int>(26, 99));
+      // verify
+      assertUnit(yes.second);
+      assertUnit((*yes.first).second == 6);
+      assertUnit(!no.second);
+      assertUnit((*no.first).second == 2);
+      assertUnit(m.size() == 3);
+   }  // teardown
+
+   // find by key only
+   void test_map_find_standard()
+   {  // setup
+      Map4 m;
+      for (int i = 0; i < 100; i++)
+         m[i * 2] = -i;
+      // exercise
+      Map4::iterator it = m.find(60);
+      Map4::iterator itMiss = m.find(61);
+      // verify
+      assertUnit(it != m.end());
+      assertUnit(it->second == -30);
+      assertUnit(itMiss == m.end());
+   }  // teardown
+
+   // range erase through to the end
+   void test_map_erase_range()
+   {  // setup
+      Map4 m;
+      for (int i = 0; i < 100; i++)
+         m[i] = i;
+      // exercise
+      Map4::iterator it = m.erase(m.find(90), m.end());
+      // verify
+      assertUnit(it == m.end());
+      assertUnit(m.size() == 90);
+      assertUnit(validate(m.tree));
+      assertUnit((*--m.end()).first == 89);
+   }  // teardown
+
+   // agrees with std::map for a random mix
+   void test_map_random()
+   {  // setup
+      Map4 m;
+      std::map<int, int> reference;
+      bool same = true;
+      srand(13);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int key = rand() % 1000;
+         switch (rand() % 3)
+         {
+            case 0:
+               m[key] = i;
+               reference[key] = i;
+               break;
+            case 1:
+               same = same && m.erase(key) == reference.erase(key);
+               break;
+            default:
+               same = same && (m.find(key) == m.end()) == (reference.find(key) == reference.end());
+         }
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(validate(m.tree));
+      assertUnit(m.size() == reference.size());
+      std::map<int, int>::iterator itRef = reference.begin();
+      for (Map4::iterator it = m.begin(); it != m.end() && same; ++it, ++itRef)
+         same = it->first == itRef->first && it->second == itRef->second;
+      assertUnit(same);
+   }  // teardown
+
+   // keys that are not trivially copied, with the default node size
+   void test_map_string()
+   {  // setup
+      custom::btree_map<std::string, int> m;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         m[std::to_string(i)] = i;
+      for (int i = 0; i < 1000; i += 3)
+         m.erase(std::to_string(i));
+      // verify
+      assertUnit(m.size() == 666);
+      assertUnit(validate(m.tree));
+      assertUnit(m.at("500") == 500);
+      assertUnit(m.find("501") == m.end());
+      assertUnit(m.begin()->first == "1");
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * Everything in a set, in iteration order
+    *************************************************************/
+   template <class Set>
+   std::vector<int> contents(const Set& s)
+   {
+      std::vector<int> v;
+      for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * HEIGHT
+    * Number of levels, a lone leaf being one
+    *************************************************************/
+   template <class Tree>
+   int height(const Tree& tree)
+   {
+      int levels = 0;
+      for (auto p = tree.root; p; levels++)
+         p = p->isLeaf ? nullptr : static_cast<typename Tree::Inner*>(p)->children[0];
+      return levels;
+   }
+
+   /*************************************************************
+    * VALIDATE
+    * Every B+ tree invariant: sorted nodes within their bounds,
+    * the minimum fill below the root, all leaves at one depth,
+    * the leaf chain matching the tree, and the element count.
+    *************************************************************/
+   template <class Tree>
+   bool validate(const Tree& tree)
+   {
+      if (!tree.root)
+         return tree.numElements == 0 && !tree.pFirst && !tree.pLast;
+
+      std::vector<const typename Tree::Leaf*> leaves;
+      int leafDepth = -1;
+      if (!validateNode(tree, tree.root, nullptr, nullptr, 0, leafDepth, leaves))
+         return false;
+
+      size_t total = 0;
+      for (size_t i = 0; i < leaves.size(); i++)
+      {
+         if (leaves[i]->pPrev != (i ? leaves[i - 1] : nullptr))
+            return false;
+         if (leaves[i]->pNext != (i + 1 < leaves.size() ? leaves[i + 1] : nullptr))
+            return false;
+         total += leaves[i]->count;
+      }
+      return tree.pFirst == leaves.front() && tree.pLast == leaves.back() &&
+             total == tree.numElements;
+   }
+
+   template <class Tree>
+   bool validateNode(const Tree& tree, const typename Tree::Node* p,
+                     const typename Tree::key_type* pLow,
+                     const typename Tree::key_type* pHigh, int depth, int& leafDepth,
+                     std::vector<const typename Tree::Leaf*>& leaves)
+   {
+      using K = typename Tree::key_type;
+      bool isRoot = (p == tree.root);
+      if (p->isLeaf)
+      {
+         const typename Tree::Leaf* pLeaf = static_cast<const typename Tree::Leaf*>(p);
+         if (leafDepth == -1)
+            leafDepth = depth;
+         if (depth != leafDepth || pLeaf->count == 0)
+            return false;
+         if (!isRoot && pLeaf->count < Tree::minLeaf)
+            return false;
+         leaves.push_back(pLeaf);
+         for (size_t i = 0; i < pLeaf->count; i++)
+         {
+            const K& k = keyOf(tree, pLeaf->data()[i]);
+            if (i > 0 && !(keyOf(tree, pLeaf->data()[i - 1]) < k))
+               return false;
+            if ((pLow && k < *pLow) || (pHigh && !(k < *pHigh)))
+               return false;
+         }
+         return true;
+      }
+
+      const typename Tree::Inner* pInner = static_cast<const typename Tree::Inner*>(p);
+      if (pInner->count == 0 || (!isRoot && pInner->count < Tree::minInner))
+         return false;
+      const K* keys = pInner->keys();
+      for (size_t i = 0; i < pInner->count; i++)
+      {
+         if (i > 0 && !(keys[i - 1] < keys[i]))
+            return false;
+         if ((pLow && keys[i] < *pLow) || (pHigh && !(keys[i] < *pHigh)))
+            return false;
+      }
+      for (size_t i = 0; i <= pInner->count; i++)
+         if (!validateNode(tree, pInner->children[i],
+                           i == 0 ? pLow : keys + i - 1,
+                           i == pInner->count ? pHigh : keys + i,
+                           depth + 1, leafDepth, leaves))
+            return false;
+      return true;
+   }
+
+   template <class K, class T, class KeyOf, size_t B>
+   const K& keyOf(const custom::BTree<K, T, KeyOf, B>&, const T& t)
+   {
+      return KeyOf()(t);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,490 @@
+/***********************************************************************
+ * Header:
+ *    TEST COMPACT TREE
+ * Summary:
+ *    Unit tests for CompactTree, compact_set, and compact_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "compact_tree.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>   // for rand
+#include <functional> // for std::greater
+#include <set>       // to check against
+#include <map>       // to check against
+#include <string>
+#include <vector>
+
+class TestCompactTree : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_node_size();
+      test_node_colorBit();
+
+      // Set: construct
+      test_set_construct_default();
+      test_set_construct_initializerList();
+      test_set_constructCopy_links();
+      test_set_constructMove_standard();
+      test_set_destructor_spy();
+
+      // Set: insert and access
+      test_set_insert_shape();
+      test_set_insert_duplicate();
+      test_set_insert_compareGreater();
+      test_set_find_standard();
+      test_set_iterate_backward();
+
+      // Set: remove
+      test_set_erase_leaf();
+      test_set_erase_twoChildren();
+      test_set_erase_movesLast();
+      test_set_erase_range();
+      test_set_erase_random();
+
+      // Map
+      test_map_subscript();
+      test_map_at_throw();
+      test_map_erase_range();
+      test_map_string();
+
+      report("CompactTree");
+   }
+
+   using Set = custom::compact_set<int>;
+   using Map = custom::compact_map<int, int>;
+   using Tree = custom::CompactTree<int, int, Set::KeyOf, std::less<int>>;
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // three 32-bit links beside an int, against three pointers and a bool
+   void test_node_size()
+   {  // setup
+      // exercise
+      size_t compact = sizeof(Tree::Node);
+      size_t pointers = sizeof(int) + 3 * sizeof(void*);
+      // verify
+      assertUnit(compact == 16);
+      assertUnit(compact < pointers);
+   }  // teardown
+
+   // the top bit of the parent link does not change the parent
+   void test_node_colorBit()
+   {  // setup
+      Set s{ 50, 30, 70 };
+      uint32_t i30 = s.find(30).index;
+      // exercise
+      s.tree.nodes[i30].parent |= 0x80000000;
+      s.tree.setParent(i30, s.tree.root);
+      // verify
+      assertUnit(s.tree.parentOf(i30) == s.tree.root);
+      assertUnit((s.tree.nodes[i30].parent & 0x80000000) != 0);
+      assertUnit(contents(s) == std::vector<int>({ 30, 50, 70 }));
+   }  // teardown
+
+   /***************************************
+    * SET : CONSTRUCT
+    ***************************************/
+
+   // nothing is allocated until something is inserted
+   void test_set_construct_default()
+   {  // setup
+      // exercise
+      Set s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.tree.root == Tree::nil);
+      assertUnit(s.tree.nodes.capacity() == 0);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+   // an initializer list is sorted and made unique
+   void test_set_construct_initializerList()
+   {  // setup
+      // exercise
+      Set s{ 50, 30, 70, 30, 20, 40, 60, 80 };
+      // verify
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // the links are indices, so a copy of the slab is a copy of the tree
+   void test_set_constructCopy_links()
+   {  // setup
+      Set sSrc;
+      for (int i = 0; i < 100; i++)
+         sSrc.insert((i * 37) % 100);
+      // exercise
+      Set sDest(sSrc);
+      // verify
+      assertUnit(validate(sDest.tree));
+      assertUnit(sDest.tree.root == sSrc.tree.root);
+      assertUnit(&sDest.tree.nodes[0] != &sSrc.tree.nodes[0]);
+      assertUnit(contents(sDest) == contents(sSrc));
+      sDest.erase(0);
+      assertUnit(sSrc.find(0) != sSrc.end());
+      assertUnit(validate(sSrc.tree));
+   }  // teardown
+
+   // a move takes the slab and leaves the source empty
+   void test_set_constructMove_standard()
+   {  // setup
+      Set sSrc{ 50, 30, 70 };
+      // exercise
+      Set sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.tree.root == Tree::nil);
+      assertUnit(sSrc.begin() == sSrc.end());
+      assertUnit(contents(sDest) == std::vector<int>({ 30, 50, 70 }));
+   }  // teardown
+
+   // every element is destroyed with the set
+   void test_set_destructor_spy()
+   {  // setup
+      {
+         custom::compact_set<Spy> s;
+         s.reserve(20);
+         for (int i = 0; i < 20; i++)
+            s.insert(Spy(i));
+         Spy::reset();
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 20);
+   }  // teardown
+
+   /***************************************
+    * SET : INSERT AND ACCESS
+    ***************************************/
+
+   // the same shape as a BST given the same order
+   void test_set_insert_shape()
+   {  // setup
+      //                 50
+      //          +-------+-------+
+      //         30              70
+      //     +----+----+     +----+----+
+      //    20        40    60        80
+      Set s;
+      // exercise
+      for (int i : { 50, 30, 70, 20, 40, 60, 80 })
+         s.insert(i);
+      // verify
+      const auto& nodes = s.tree.nodes;
+      assertUnit(s.tree.root == 0);
+      assertUnit(nodes[0].data == 50);
+      assertUnit(nodes[nodes[0].left].data == 30);
+      assertUnit(nodes[nodes[0].right].data == 70);
+      assertUnit(nodes[nodes[nodes[0].left].right].data == 40);
+      assertUnit(nodes[nodes[nodes[0].right].left].data == 60);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // a duplicate is found, not added
+   void test_set_insert_duplicate()
+   {  // setup
+      Set s{ 50, 30, 70 };
+      // exercise
+      auto result = s.insert(30);
+      // verify
+      assertUnit(result.second == false);
+      assertUnit(result.first == s.find(30));
+      assertUnit(s.size() == 3);
+   }  // teardown
+
+   // the comparator decides the order
+   void test_set_insert_compareGreater()
+   {  // setup
+      custom::compact_set<int, std::greater<int>> s;
+      // exercise
+      s.insert({ 50, 30, 70, 20 });
+      // verify
+      std::vector<int> order;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         order.push_back(*it);
+      assertUnit(order == std::vector<int>({ 70, 50, 30, 20 }));
+      assertUnit(s.find(30) != s.end());
+   }  // teardown
+
+   // hits and misses, with one comparison per level and one at the bottom
+   void test_set_find_standard()
+   {  // setup
+      custom::compact_set<Spy> s;
+      for (int i : { 50, 30, 70, 20, 40, 60, 80 })
+         s.insert(Spy(i));
+      Spy s40(40);
+      Spy s45(45);
+      Spy::reset();
+      // exercise
+      auto it40 = s.find(s40);
+      auto it45 = s.find(s45);
+      // verify
+      assertUnit(Spy::numLessthan() == 8);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(it40 != s.end() && *it40 == Spy(40));
+      assertUnit(it45 == s.end());
+   }  // teardown
+
+   // decrementing from end() walks back to the front
+   void test_set_iterate_backward()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      std::vector<int> order;
+      // exercise
+      for (auto it = s.end(); it != s.begin(); )
+         order.push_back(*--it);
+      // verify
+      assertUnit(order == std::vector<int>({ 80, 70, 60, 50, 40, 30, 20 }));
+   }  // teardown
+
+   /***************************************
+    * SET : REMOVE
+    ***************************************/
+
+   // a leaf comes out and the slab shrinks
+   void test_set_erase_leaf()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto itNext = s.erase(s.find(20));
+      // verify
+      assertUnit(itNext != s.end() && *itNext == 30);
+      assertUnit(s.size() == 6);
+      assertUnit(s.tree.nodes.size() == 6);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // the successor takes the place of a node with two children
+   void test_set_erase_twoChildren()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto itNext = s.erase(s.find(50));
+      // verify
+      assertUnit(itNext != s.end() && *itNext == 60);
+      assertUnit(s.tree.nodes[s.tree.root].data == 60);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 60, 70, 80 }));
+   }  // teardown
+
+   // the last node moves into the hole, and the returned iterator follows it
+   void test_set_erase_movesLast()
+   {  // setup
+      Set s;
+      for (int i : { 50, 30, 70, 60 })
+         s.insert(i);
+      // exercise
+      auto itNext = s.erase(s.find(50));
+      // verify
+      assertUnit(s.tree.nodes.size() == 3);
+      assertUnit(itNext.index == 0);
+      assertUnit(*itNext == 60);
+      assertUnit(s.tree.root == 0);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // a range comes out even as the nodes around it move
+   void test_set_erase_range()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 100; i++)
+         s.insert((i * 37) % 100);
+      // exercise
+      auto itReturn = s.erase(s.find(10), s.find(90));
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 90);
+      assertUnit(s.size() == 20);
+      assertUnit(validate(s.tree));
+      std::vector<int> expected;
+      for (int i = 0; i < 10; i++)
+         expected.push_back(i);
+      for (int i = 90; i < 100; i++)
+         expected.push_back(i);
+      assertUnit(contents(s) == expected);
+   }  // teardown
+
+   // agrees with std::set for a random mix of inserts and erases
+   void test_set_erase_random()
+   {  // setup
+      Set s;
+      std::set<int> reference;
+      bool same = true;
+      bool valid = true;
+      srand(5);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = rand() % 500;
+         if (rand() % 2)
+            same = same && s.insert(value).second == reference.insert(value).second;
+         else
+            same = same && s.erase(value) == reference.erase(value);
+         if (i % 997 == 0)
+            valid = valid && validate(s.tree);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(valid);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>(reference.begin(), reference.end()));
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // subscript inserts a default value, then updates it
+   void test_map_subscript()
+   {  // setup
+      Map m;
+      // exercise
+      int value = m[26];
+      m[26] = 5;
+      m[13] = 1;
+      // verify
+      assertUnit(value == 0);
+      assertUnit(m.size() == 2);
+      assertUnit(m.at(26) == 5);
+      assertUnit((*m.begin()).first == 13);
+   }  // teardown
+
+   // at() on a missing key throws
+   void test_map_at_throw()
+   {  // setup
+      Map m{ custom::pair<int, int>(1, 1) };
+      // exercise
+      try
+      {
+         m.at(2);
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range& error)
+      {
+         assertUnit(std::string(error.what()) == std::string("invalid map<K, T> key"));
+      }
+   }  // teardown
+
+   // a range of pairs comes out
+   void test_map_erase_range()
+   {  // setup
+      Map m;
+      for (int i = 0; i < 50; i++)
+         m[i] = i * 2;
+      // exercise
+      auto itReturn = m.erase(m.find(5), m.find(45));
+      // verify
+      assertUnit(itReturn != m.end() && (*itReturn).first == 45);
+      assertUnit(m.size() == 10);
+      assertUnit(m[4] == 8);
+      assertUnit(m[45] == 90);
+      assertUnit(validate(m.tree));
+   }  // teardown
+
+   // string keys and values move as nodes do
+   void test_map_string()
+   {  // setup
+      custom::compact_map<std::string, std::string> m;
+      std::map<std::string, std::string> reference;
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         std::string key = std::to_string((i * 71) % 200);
+         m[key] = key + "!";
+         reference[key] = key + "!";
+      }
+      for (int i = 0; i < 200; i += 3)
+      {
+         m.erase(std::to_string(i));
+         reference.erase(std::to_string(i));
+      }
+      // verify
+      assertUnit(m.size() == reference.size());
+      bool same = true;
+      auto itReference = reference.begin();
+      for (auto it = m.begin(); same && it != m.end(); ++it, ++itReference)
+         same = (*it).first == itReference->first && (*it).second == itReference->second;
+      assertUnit(same);
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * Everything in a set, in order
+    *************************************************************/
+   template <class Set>
+   std::vector<int> contents(const Set& s)
+   {
+      std::vector<int> v;
+      for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * VALIDATE
+    * Every node in the slab is reached from the root exactly
+    * once, each child's parent link points back, and the keys
+    * are in order.
+    *************************************************************/
+   template <class Tree>
+   bool validate(const Tree& tree)
+   {
+      if (tree.root == Tree::nil)
+         return tree.nodes.size() == 0;
+      if (tree.parentOf(tree.root) != Tree::nil)
+         return false;
+
+      size_t count = 0;
+      std::vector<uint32_t> stack{ tree.root };
+      while (!stack.empty())
+      {
+         uint32_t i = stack.back();
+         stack.pop_back();
+         if (i >= tree.nodes.size() || ++count > tree.nodes.size())
+            return false;
+         for (uint32_t child : { tree.nodes[i].left, tree.nodes[i].right })
+            if (child != Tree::nil)
+            {
+               if (child >= tree.nodes.size() || tree.parentOf(child) != i)
+                  return false;
+               stack.push_back(child);
+            }
+      }
+      if (count != tree.nodes.size())
+         return false;
+
+      // in order means each key is less than the next
+      auto it = tree.begin();
+      if (it == tree.end())
+         return false;
+      for (auto itNext = it; ++itNext != tree.end(); it = itNext)
+         if (!tree.compare(keyOf(tree, *it), keyOf(tree, *itNext)))
+            return false;
+      return true;
+   }
+
+   template <class K, class T, class KeyOf, class Compare>
+   const K& keyOf(const custom::CompactTree<K, T, KeyOf, Compare>&, const T& t)
+   {
+      return KeyOf()(t);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,558 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT MAP
+ * Summary:
+ *    Unit tests for concurrent_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "concurrent_map.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <cmath>     // for log2
+#include <cstdlib>   // for rand
+#include <map>       // to check against
+#include <thread>
+#include <vector>
+
+class TestConcurrentMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_destructor_freesAll();
+
+      // Access
+      test_contains_standard();
+      test_at_copy();
+      test_at_throw();
+      test_reader_iterate();
+      test_reader_find();
+
+      // Insert
+      test_insert_duplicate();
+      test_insert_balanced();
+      test_insert_pathCopy();
+      test_insertOrAssign_newAndOld();
+
+      // Remove
+      test_erase_key();
+      test_erase_missing();
+      test_clear_standard();
+      test_randomAgainstStdMap();
+
+      // Readers
+      test_reader_isolated();
+      test_reader_holdsRetired();
+      test_reader_releaseFrees();
+      test_threads_readMostly();
+      test_threads_readWrite();
+
+      report("ConcurrentMap");
+   }
+
+   using Map = custom::concurrent_map<int, int>;
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // empty has no tree and no readers
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Map m;
+      // verify
+      assertUnit(m.root.load() == nullptr);
+      assertUnit(m.size() == 0);
+      assertUnit(m.empty());
+      assertUnit(m.retired.empty());
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // initializer list, duplicates dropped
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      Map m{ {3, 30}, {1, 10}, {2, 20}, {1, 99} };
+      // verify
+      assertUnit(m.size() == 3);
+      assertUnit(valid(m));
+      assertUnit(m.at(1) == 10);
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // the current version and everything retired go with the map
+   void test_destructor_freesAll()
+   {  // setup
+      Spy::reset();
+      {
+         custom::concurrent_map<int, Spy> m;
+         for (int i = 0; i < 100; i++)
+            m.insert(custom::pair<int, Spy>(i, Spy(i)));
+         custom::concurrent_map<int, Spy>::reader view = m.read();
+         for (int i = 0; i < 100; i += 2)
+            m.erase(i);
+      }  // exercise
+      // verify
+      assertUnit(Spy::numAlloc() > 100);
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // contains, and nothing is left pinned
+   void test_contains_standard()
+   {  // setup
+      Map m;
+      fill(m);
+      // exercise
+      bool yes = m.contains(49);
+      bool no = m.contains(48);
+      // verify
+      assertUnit(yes);
+      assertUnit(!no);
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // at hands back a copy
+   void test_at_copy()
+   {  // setup
+      Map m;
+      fill(m);
+      // exercise
+      int value = m.at(49);
+      m.insert_or_assign(49, -1);
+      // verify
+      assertUnit(value == 8);
+      assertUnit(m.at(49) == -1);
+   }  // teardown
+
+   // at throws on a missing key and unpins on the way out
+   void test_at_throw()
+   {  // setup
+      Map m;
+      fill(m);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(48);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // a reader walks its version in order
+   void test_reader_iterate()
+   {  // setup
+      Map m;
+      fill(m);
+      std::vector<int> keys;
+      // exercise
+      {
+         Map::reader view = m.read();
+         assertUnit(pinned(m) == 1);
+         for (Map::reader::iterator it = view.begin(); it != view.end(); ++it)
+            keys.push_back(it->first);
+      }
+      // verify
+      assertUnit(keys == std::vector<int>({ 8, 21, 25, 29, 34, 49, 50, 52, 54, 66 }));
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // find and at through a reader give references into its version
+   void test_reader_find()
+   {  // setup
+      Map m;
+      fill(m);
+      Map::reader view = m.read();
+      // exercise
+      Map::reader::iterator it = view.find(25);
+      Map::reader::iterator itMissing = view.find(26);
+      // verify
+      assertUnit(it != view.end());
+      assertUnit(it->second == 1);
+      assertUnit(itMissing == view.end());
+      assertUnit(&view.at(25) == &it->second);
+      assertUnit(view.size() == 10);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a duplicate key changes nothing and publishes nothing
+   void test_insert_duplicate()
+   {  // setup
+      Map m;
+      fill(m);
+      auto pRoot = m.root.load();
+      uint64_t epoch = m.epoch.load();
+      // exercise
+      bool inserted = m.insert(custom::pair<int, int>(49, 99));
+      // verify
+      assertUnit(!inserted);
+      assertUnit(m.at(49) == 8);
+      assertUnit(m.root.load() == pRoot);
+      assertUnit(m.epoch.load() == epoch);
+   }  // teardown
+
+   // sorted input still makes a balanced tree
+   void test_insert_balanced()
+   {  // setup
+      Map m;
+      // exercise
+      for (int i = 0; i < 4096; i++)
+         m.insert(custom::pair<int, int>(i, i));
+      // verify
+      assertUnit(valid(m));
+      assertUnit(m.root.load()->height <= 1.45 * std::log2(4096.0 + 2.0));
+   }  // teardown
+
+   // a write copies only the path it changes
+   void test_insert_pathCopy()
+   {  // setup
+      custom::concurrent_map<int, Spy> m;
+      for (int i = 0; i < 1000; i++)
+         m.insert(custom::pair<int, Spy>(i * 2, Spy(i)));
+      int height = m.root.load()->height;
+      Spy::reset();
+      // exercise
+      m.insert(custom::pair<int, Spy>(501, Spy(501)));
+      // verify
+      assertUnit(Spy::numCopy() >= 1);
+      assertUnit(Spy::numCopy() <= height + 3);   // the path, plus rotations
+      assertUnit(Spy::numDelete() >= Spy::numCopy());   // nobody reading, all freed
+      assertUnit(m.retired.empty());
+   }  // teardown
+
+   // insert or assign says whether the key was new
+   void test_insertOrAssign_newAndOld()
+   {  // setup
+      Map m;
+      fill(m);
+      // exercise
+      bool isNew = m.insert_or_assign(51, 100);
+      bool isOld = m.insert_or_assign(8, 800);
+      // verify
+      assertUnit(isNew);
+      assertUnit(!isOld);
+      assertUnit(m.size() == 11);
+      assertUnit(m.at(51) == 100);
+      assertUnit(m.at(8) == 800);
+      assertUnit(valid(m));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase by key
+   void test_erase_key()
+   {  // setup
+      Map m;
+      fill(m);
+      // exercise
+      size_t count = m.erase(50);
+      // verify
+      assertUnit(count == 1);
+      assertUnit(m.size() == 9);
+      assertUnit(!m.contains(50));
+      assertUnit(valid(m));
+   }  // teardown
+
+   // erasing a missing key publishes nothing
+   void test_erase_missing()
+   {  // setup
+      Map m;
+      fill(m);
+      auto pRoot = m.root.load();
+      // exercise
+      size_t count = m.erase(51);
+      // verify
+      assertUnit(count == 0);
+      assertUnit(m.size() == 10);
+      assertUnit(m.root.load() == pRoot);
+   }  // teardown
+
+   // clear retires every node, freed once no one reads
+   void test_clear_standard()
+   {  // setup
+      Spy::reset();
+      custom::concurrent_map<int, Spy> m;
+      for (int i = 0; i < 50; i++)
+         m.insert(custom::pair<int, Spy>(i, Spy(i)));
+      size_t alive = Spy::numAlloc() - Spy::numDelete();
+      // exercise
+      m.clear();
+      // verify
+      assertUnit(alive >= 50);
+      assertUnit(m.empty());
+      assertUnit(m.root.load() == nullptr);
+      assertUnit(m.retired.empty());
+      assertUnit(Spy::numAlloc() == Spy::numDelete());
+   }  // teardown
+
+   // many random inserts, assigns, and erases agree with std::map
+   void test_randomAgainstStdMap()
+   {  // setup
+      Map m;
+      std::map<int, int> check;
+      srand(37);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int k = rand() % 500;
+         switch (rand() % 3)
+         {
+         case 0:
+            m.insert(custom::pair<int, int>(k, i));
+            check.insert(std::make_pair(k, i));
+            break;
+         case 1:
+            m.insert_or_assign(k, i);
+            check[k] = i;
+            break;
+         default:
+            assertUnit(m.erase(k) == check.erase(k));
+         }
+      }
+      // verify
+      assertUnit(valid(m));
+      assertUnit(m.size() == check.size());
+      Map::reader view = m.read();
+      std::map<int, int>::iterator itCheck = check.begin();
+      for (Map::reader::iterator it = view.begin(); it != view.end(); ++it, ++itCheck)
+      {
+         assertUnit(it->first == itCheck->first);
+         assertUnit(it->second == itCheck->second);
+      }
+      assertUnit(itCheck == check.end());
+   }  // teardown
+
+   /***************************************
+    * READERS
+    ***************************************/
+
+   // a reader sees the version it started with
+   void test_reader_isolated()
+   {  // setup
+      Map m;
+      fill(m);
+      Map::reader view = m.read();
+      // exercise
+      m.erase(50);
+      m.insert(custom::pair<int, int>(51, 5));
+      m.insert_or_assign(8, 800);
+      // verify
+      assertUnit(view.size() == 10);
+      assertUnit(view.find(50) != view.end());
+      assertUnit(view.find(51) == view.end());
+      assertUnit(view.at(8) == 3);
+      assertUnit(m.at(8) == 800);
+      assertUnit(m.size() == 10);
+   }  // teardown
+
+   // nodes a reader can see are retired, not freed
+   void test_reader_holdsRetired()
+   {  // setup
+      custom::concurrent_map<int, Spy> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(custom::pair<int, Spy>(i, Spy(i)));
+      Spy::reset();
+      {
+         custom::concurrent_map<int, Spy>::reader view = m.read();
+         // exercise
+         m.erase(50);
+         m.erase(51);
+         // verify
+         assertUnit(!m.retired.empty());
+         assertUnit(Spy::numDelete() == 0);
+         assertUnit(view.at(50) == Spy(50));
+      }
+   }  // teardown
+
+   // once the reader goes, the next write frees what it held up
+   void test_reader_releaseFrees()
+   {  // setup
+      custom::concurrent_map<int, Spy> m;
+      for (int i = 0; i < 100; i++)
+         m.insert(custom::pair<int, Spy>(i, Spy(i)));
+      {
+         custom::concurrent_map<int, Spy>::reader view = m.read();
+         m.erase(50);
+      }
+      Spy::reset();
+      // exercise
+      m.erase(60);
+      // verify
+      assertUnit(m.retired.empty());
+      assertUnit(Spy::numDelete() > Spy::numCopy());
+      assertUnit(valid(m));
+   }  // teardown
+
+   // mostly readers: every value they see is one a writer put there
+   void test_threads_readMostly()
+   {  // setup
+      Map m;
+      for (int i = 0; i < 1000; i++)
+         m.insert(custom::pair<int, int>(i, i * 2));
+      std::atomic<bool> done(false);
+      std::atomic<int> bad(0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 6; t++)
+         threads.push_back(std::thread([&m, &done, &bad, t]()
+            {
+               unsigned seed = t;
+               while (!done.load())
+               {
+                  int k = (int)((seed = seed * 1103515245 + 12345) >> 8) % 1000;
+                  try
+                  {
+                     if (m.at(k) != k * 2)
+                        bad++;
+                  }
+                  catch (const std::out_of_range&)
+                  {
+                     // the writer had it out
+                  }
+               }
+            }));
+      for (int pass = 0; pass < 5; pass++)
+         for (int i = 0; i < 1000; i += 10)
+         {
+            m.erase(i);
+            m.insert(custom::pair<int, int>(i, i * 2));
+         }
+      done = true;
+      for (std::thread& thread : threads)
+         thread.join();
+      // verify
+      assertUnit(bad == 0);
+      assertUnit(m.size() == 1000);
+      assertUnit(valid(m));
+      assertUnit(pinned(m) == 0);
+   }  // teardown
+
+   // readers walk whole versions while two writers share the map
+   void test_threads_readWrite()
+   {  // setup
+      Map m;
+      std::atomic<bool> done(false);
+      std::atomic<int> bad(0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&m, &done, &bad]()
+            {
+               while (!done.load())
+               {
+                  Map::reader view = m.read();
+                  int previous = -1;
+                  size_t count = 0;
+                  for (Map::reader::iterator it = view.begin(); it != view.end(); ++it, ++count)
+                  {
+                     if (it->first <= previous || it->second != it->first + 1)
+                        bad++;
+                     previous = it->first;
+                  }
+                  if (count != view.size())
+                     bad++;
+               }
+            }));
+      for (int w = 0; w < 2; w++)
+         threads.push_back(std::thread([&m, w]()
+            {
+               // each writer owns the keys of its parity
+               for (int i = w; i < 2000; i += 2)
+                  m.insert(custom::pair<int, int>(i, i + 1));
+               for (int i = w; i < 2000; i += 4)
+                  m.erase(i);
+            }));
+      threads[4].join();
+      threads[5].join();
+      done = true;
+      for (int t = 0; t < 4; t++)
+         threads[t].join();
+      m.insert(custom::pair<int, int>(5000, 5001));   // frees what the readers held up
+      m.erase(5000);
+      // verify
+      assertUnit(bad == 0);
+      assertUnit(m.size() == 1000);
+      assertUnit(valid(m));
+      assertUnit(m.retired.empty());
+   }  // teardown
+
+   /*************************************************************
+    * FILL
+    * The same ten elements used throughout the map tests
+    *************************************************************/
+   void fill(Map& m)
+   {
+      int keys[] = { 50, 25, 66, 8, 34, 54, 21, 29, 49, 52 };
+      for (int i = 0; i < 10; i++)
+         m.insert(custom::pair<int, int>(keys[i], i));
+   }
+
+   /*************************************************************
+    * PINNED
+    * How many reader slots are in use
+    *************************************************************/
+   template <class M>
+   size_t pinned(const M& m)
+   {
+      size_t count = 0;
+      for (size_t i = 0; i < M::numSlots; i++)
+         count += (m.slots[i].epoch.load() != 0);
+      return count;
+   }
+
+   /*************************************************************
+    * VALID
+    * Ordered, AVL balanced, heights and counts right, size right
+    *************************************************************/
+   template <class M>
+   bool valid(const M& m)
+   {
+      size_t count = 0;
+      return validNode(m.root.load(), (const int*)nullptr, (const int*)nullptr, count) >= 0 &&
+             count == m.size();
+   }
+   template <class Node>
+   int validNode(const Node* p, const int* pLow, const int* pHigh, size_t& count)
+   {
+      if (!p)
+         return 0;
+      size_t before = count++;
+      if ((pLow && !(*pLow < p->data.first)) || (pHigh && !(p->data.first < *pHigh)))
+         return -1;
+      int hLeft = validNode(p->pLeft, pLow, &p->data.first, count);
+      int hRight = validNode(p->pRight, &p->data.first, pHigh, count);
+      if (hLeft < 0 || hRight < 0 || hLeft - hRight > 1 || hRight - hLeft > 1)
+         return -1;
+      int h = 1 + (hLeft > hRight ? hLeft : hRight);
+      return h == p->height && count - before == p->count ? h : -1;
+   }
+};
+
+#endif // DEBUG
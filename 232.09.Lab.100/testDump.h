@@ -0,0 +1,271 @@
+/***********************************************************************
+ * Header:
+ *    TEST DUMP
+ * Summary:
+ *    Unit tests for dump and dump_buffer
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "dump.h"
+#include "vector.h"
+#include "set.h"
+#include "map.h"
+#include "bst.h"
+#include "unitTest.h"
+
+#include <climits>   // for INT_MIN, LLONG_MAX
+#include <sstream>
+#include <string>
+#include <utility>   // for std::pair
+
+class TestDump : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Numbers
+      test_dump_integers();
+      test_dump_floating();
+      test_dump_charBool();
+
+      // Containers
+      test_dump_vector_empty();
+      test_dump_vector_standard();
+      test_dump_set_sorted();
+      test_dump_map_pairs();
+      test_dump_bst();
+      test_dump_range();
+
+      // Buffer
+      test_dump_string();
+      test_dump_fallback();
+      test_buffer_flushes();
+      test_buffer_longText();
+      test_dump_large();
+
+      report("Dump");
+   }
+
+   /***************************************
+    * NUMBERS
+    ***************************************/
+
+   // integers of every size, at their limits
+   void test_dump_integers()
+   {  // setup
+      custom::vector<long long> v{ 0, -1, INT_MIN, LLONG_MAX, LLONG_MIN };
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s == streamed(v));
+      assertUnit(s == "0 -1 -2147483648 9223372036854775807 -9223372036854775808 ");
+   }  // teardown
+
+   // floating point matches the stream's default six digits
+   void test_dump_floating()
+   {  // setup
+      custom::vector<double> v{ 0.0, 0.1, 1.0 / 3.0, -2.5, 1e20, 1.5e-7, 123456789.0, 100.0 };
+      custom::vector<float> vf{ 0.25f, 3.14159265f };
+      // exercise
+      std::string s = dumped(v);
+      std::string sf = dumped(vf);
+      // verify
+      assertUnit(s == streamed(v));
+      assertUnit(s == "0 0.1 0.333333 -2.5 1e+20 1.5e-07 1.23457e+08 100 ");
+      assertUnit(sf == streamed(vf));
+   }  // teardown
+
+   // a char is a character and a bool is a digit, as in a stream
+   void test_dump_charBool()
+   {  // setup
+      custom::vector<char> vc{ 'a', 'b' };
+      custom::vector<bool> vb{ true, false };
+      // exercise
+      std::string sc = dumped(vc);
+      std::string sb = dumped(vb);
+      // verify
+      assertUnit(sc == "a b ");
+      assertUnit(sb == "1 0 ");
+   }  // teardown
+
+   /***************************************
+    * CONTAINERS
+    ***************************************/
+
+   // nothing to write
+   void test_dump_vector_empty()
+   {  // setup
+      custom::vector<int> v;
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s.empty());
+   }  // teardown
+
+   // in order, each followed by a space
+   void test_dump_vector_standard()
+   {  // setup
+      custom::vector<int> v{ 3, 1, 2 };
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s == "3 1 2 ");
+   }  // teardown
+
+   // a set comes out sorted
+   void test_dump_set_sorted()
+   {  // setup
+      custom::set<int> s{ 50, 30, 70, 20 };
+      std::ostringstream out;
+      // exercise
+      custom::dump(out, s);
+      // verify
+      assertUnit(out.str() == "20 30 50 70 ");
+   }  // teardown
+
+   // a map comes out as pairs, like pair's operator <<
+   void test_dump_map_pairs()
+   {  // setup
+      custom::map<int, double> m;
+      m[2] = 0.5;
+      m[1] = 1.25;
+      std::ostringstream out;
+      std::ostringstream outStream;
+      // exercise
+      custom::dump(out, m);
+      for (auto it = m.begin(); it != m.end(); ++it)
+         outStream << *it << ' ';
+      // verify
+      assertUnit(out.str() == "(1, 1.25) (2, 0.5) ");
+      assertUnit(out.str() == outStream.str());
+   }  // teardown
+
+   // the tree itself, in order
+   void test_dump_bst()
+   {  // setup
+      custom::BST<int> bst{ 40, 20, 60, 10 };
+      std::ostringstream out;
+      // exercise
+      custom::dump(out, bst);
+      // verify
+      assertUnit(out.str() == "10 20 40 60 ");
+   }  // teardown
+
+   // part of a container
+   void test_dump_range()
+   {  // setup
+      custom::vector<int> v{ 1, 2, 3, 4, 5 };
+      auto itFirst = v.begin();
+      auto itLast = v.begin();
+      ++itFirst;
+      for (int i = 0; i < 4; i++)
+         ++itLast;
+      std::ostringstream out;
+      // exercise
+      custom::dump(out, itFirst, itLast);
+      // verify
+      assertUnit(out.str() == "2 3 4 ");
+   }  // teardown
+
+   /***************************************
+    * BUFFER
+    ***************************************/
+
+   // strings are copied as they are
+   void test_dump_string()
+   {  // setup
+      custom::vector<std::string> v{ "one", "", "three" };
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s == "one  three ");
+   }  // teardown
+
+   // std::pair as well as ours, even nested
+   void test_dump_fallback()
+   {  // setup
+      custom::vector<std::pair<std::string, custom::pair<int, int>>> v;
+      v.push_back(std::make_pair(std::string("a"), custom::pair<int, int>(1, 2)));
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s == "(a, (1, 2)) ");
+   }  // teardown
+
+   // nothing reaches the stream until the buffer fills or is flushed
+   void test_buffer_flushes()
+   {  // setup
+      std::ostringstream out;
+      // exercise
+      {
+         custom::dump_buffer buffer(out, 64);
+         buffer << 12345;
+         // verify
+         assertUnit(out.str().empty());
+         assertUnit(buffer.used == 5);
+         for (int i = 0; i < 10; i++)
+            buffer << 1000000 << ' ';
+         assertUnit(!out.str().empty());
+         assertUnit(buffer.used < 64);
+         buffer.flush();
+         assertUnit(buffer.used == 0);
+      }
+      assertUnit(out.str().size() == 5 + 10 * 8);
+   }  // teardown
+
+   // text longer than the buffer goes straight through
+   void test_buffer_longText()
+   {  // setup
+      std::ostringstream out;
+      std::string text(200, 'x');
+      // exercise
+      {
+         custom::dump_buffer buffer(out, 64);
+         buffer << 7 << text << 8;
+      }
+      // verify
+      assertUnit(out.str() == "7" + text + "8");
+   }  // teardown
+
+   // many elements, across many flushes, match the stream
+   void test_dump_large()
+   {  // setup
+      custom::vector<int> v;
+      for (int i = 0; i < 100000; i++)
+         v.push_back(i * 7919 - 400000000);
+      // exercise
+      std::string s = dumped(v);
+      // verify
+      assertUnit(s.size() > 65536 * 10);
+      assertUnit(s == streamed(v));
+   }  // teardown
+
+   /*************************************************************
+    * HELPERS
+    *************************************************************/
+
+   template <class Container>
+   static std::string dumped(Container& c)
+   {
+      std::ostringstream out;
+      custom::dump(out, c);
+      return out.str();
+   }
+
+   template <class Container>
+   static std::string streamed(Container& c)
+   {
+      std::ostringstream out;
+      for (auto it = c.begin(); it != c.end(); ++it)
+         out << *it << ' ';
+      return out.str();
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,522 @@
+/***********************************************************************
+ * Header:
+ *    TEST FLAT MAP
+ * Summary:
+ *    Unit tests for flat_set and flat_map in both layouts
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "flat_map.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>   // for rand
+#include <map>       // to check against
+#include <string>
+#include <vector>
+
+class TestFlatMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+      const custom::flat_layout S = custom::flat_layout::sorted;
+      const custom::flat_layout E = custom::flat_layout::eytzinger;
+
+      // Layout
+      test_layout_sorted();
+      test_layout_eytzingerFull();
+      test_layout_eytzingerPartial();
+
+      // Construct
+      test_set_construct_default<S>();
+      test_set_construct_default<E>();
+      test_set_construct_sortUnique<S>();
+      test_set_construct_sortUnique<E>();
+      test_map_construct_firstWins<S>();
+      test_map_construct_firstWins<E>();
+      test_set_constructCopy_standard<E>();
+
+      // Access
+      test_set_find_everySize<S>();
+      test_set_find_everySize<E>();
+      test_set_find_noCopies<S>();
+      test_set_find_noCopies<E>();
+      test_set_lowerBound_gaps<S>();
+      test_set_lowerBound_gaps<E>();
+      test_set_iterate_forward<S>();
+      test_set_iterate_forward<E>();
+      test_set_iterate_backward<S>();
+      test_set_iterate_backward<E>();
+
+      // Insert
+      test_set_insert_one<S>();
+      test_set_insert_one<E>();
+      test_set_insert_duplicate<S>();
+      test_set_insert_duplicate<E>();
+      test_map_insert_rangeMerge<S>();
+      test_map_insert_rangeMerge<E>();
+
+      // Remove
+      test_set_erase_key<S>();
+      test_set_erase_key<E>();
+      test_set_erase_iteratorNext<S>();
+      test_set_erase_iteratorNext<E>();
+      test_set_erase_range<S>();
+      test_set_erase_range<E>();
+      test_set_erase_rangeToEnd<E>();
+
+      // Map
+      test_map_subscript_standard<S>();
+      test_map_subscript_standard<E>();
+      test_map_at_standard<S>();
+      test_map_at_standard<E>();
+      test_map_random<S>();
+      test_map_random<E>();
+      test_map_string<E>();
+
+      report("FlatMap");
+   }
+
+   template <custom::flat_layout L>
+   using Set = custom::flat_set<int, L>;
+   template <custom::flat_layout L>
+   using Map = custom::flat_map<int, int, L>;
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // sorted is what it says
+   void test_layout_sorted()
+   {  // setup
+      // exercise
+      Set<custom::flat_layout::sorted> s{ 4, 7, 1, 3, 6, 2, 5 };
+      // verify
+      assertUnit(storage(s) == std::vector<int>({ 1, 2, 3, 4, 5, 6, 7 }));
+   }  // teardown
+
+   // a full tree: the median first, then the quartiles, then the rest
+   void test_layout_eytzingerFull()
+   {  // setup
+      // exercise
+      Set<custom::flat_layout::eytzinger> s{ 4, 7, 1, 3, 6, 2, 5 };
+      // verify
+      assertUnit(storage(s) == std::vector<int>({ 4, 2, 6, 1, 3, 5, 7 }));
+   }  // teardown
+
+   // a tree with a partial bottom level
+   //                 7
+   //           4           9
+   //        2     6     8    10
+   //       1 3   5
+   void test_layout_eytzingerPartial()
+   {  // setup
+      // exercise
+      Set<custom::flat_layout::eytzinger> s{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+      // verify
+      assertUnit(storage(s) == std::vector<int>({ 7, 4, 9, 2, 6, 8, 10, 1, 3, 5 }));
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // empty is empty
+   template <custom::flat_layout L>
+   void test_set_construct_default()
+   {  // setup
+      // exercise
+      Set<L> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.begin() == s.end());
+      assertUnit(s.find(26) == s.end());
+   }  // teardown
+
+   // a list in any order, with repeats, is sorted and made unique
+   template <custom::flat_layout L>
+   void test_set_construct_sortUnique()
+   {  // setup
+      // exercise
+      Set<L> s{ 50, 30, 70, 30, 20, 40, 60, 80, 50 };
+      // verify
+      assertUnit(s.size() == 7);
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // as with inserting one at a time, the first of a key is kept
+   template <custom::flat_layout L>
+   void test_map_construct_firstWins()
+   {  // setup
+      // exercise
+      Map<L> m{ { 26, 1 }, { 49, 2 }, { 26, 3 }, { 11, 4 }, { 49, 5 } };
+      // verify
+      assertUnit(m.size() == 3);
+      assertUnit(m.at(26) == 1);
+      assertUnit(m.at(49) == 2);
+      assertUnit(m.at(11) == 4);
+   }  // teardown
+
+   // the copy is independent
+   template <custom::flat_layout L>
+   void test_set_constructCopy_standard()
+   {  // setup
+      Set<L> sSrc{ 26, 49, 67, 89, 11 };
+      // exercise
+      Set<L> sDest(sSrc);
+      sDest.erase(49);
+      // verify
+      assertUnit(contents(sSrc) == std::vector<int>({ 11, 26, 49, 67, 89 }));
+      assertUnit(contents(sDest) == std::vector<int>({ 11, 26, 67, 89 }));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // every size of tree, full or not, finds everything and nothing else
+   template <custom::flat_layout L>
+   void test_set_find_everySize()
+   {  // setup
+      bool found = true;
+      // exercise
+      for (int n = 0; n < 70; n++)
+      {
+         std::vector<int> values;
+         for (int i = 0; i < n; i++)
+            values.push_back(i * 2);
+         Set<L> s(values.begin(), values.end());
+         for (int i = -1; i <= 2 * n; i++)
+         {
+            typename Set<L>::iterator it = s.find(i);
+            found = found && (i >= 0 && i % 2 == 0 && i < 2 * n ?
+                              it != s.end() && *it == i :
+                              it == s.end());
+         }
+      }
+      // verify
+      assertUnit(found);
+   }  // teardown
+
+   // a lookup compares, but never copies
+   template <custom::flat_layout L>
+   void test_set_find_noCopies()
+   {  // setup
+      custom::flat_set<Spy, L> s;
+      std::vector<Spy> values;
+      for (int i = 0; i < 1000; i++)
+         values.push_back(Spy(i));
+      s.insert(values.begin(), values.end());
+      Spy key(500);
+      Spy::reset();
+      // exercise
+      typename custom::flat_set<Spy, L>::iterator it = s.find(key);
+      // verify
+      assertUnit(it != s.end());
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numLessthan() <= 12);   // about log2(1000) + 1
+   }  // teardown
+
+   // lower bound lands on the next element when there is a gap
+   template <custom::flat_layout L>
+   void test_set_lowerBound_gaps()
+   {  // setup
+      Set<L> s;
+      std::vector<int> values;
+      for (int i = 0; i < 100; i++)
+         values.push_back(i * 10);
+      s.insert(values.begin(), values.end());
+      bool right = true;
+      // exercise
+      for (int i = -5; i <= 990; i++)
+         right = right && *s.table.lower_bound(i) == (i <= 0 ? 0 : (i + 9) / 10 * 10);
+      // verify
+      assertUnit(right);
+      assertUnit(s.table.lower_bound(991) == s.end());
+   }  // teardown
+
+   // the iterator visits in key order whatever the layout
+   template <custom::flat_layout L>
+   void test_set_iterate_forward()
+   {  // setup
+      std::vector<int> values;
+      for (int i = 99; i >= 0; i--)
+         values.push_back(i);
+      Set<L> s(values.begin(), values.end());
+      int expect = 0;
+      bool inOrder = true;
+      // exercise
+      for (typename Set<L>::iterator it = s.begin(); it != s.end(); ++it)
+         inOrder = inOrder && *it == expect++;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 100);
+   }  // teardown
+
+   // and back from the end
+   template <custom::flat_layout L>
+   void test_set_iterate_backward()
+   {  // setup
+      Set<L> s{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+      int expect = 12;
+      bool inOrder = true;
+      typename Set<L>::iterator it = s.end();
+      // exercise
+      do
+      {
+         --it;
+         inOrder = inOrder && *it == expect--;
+      } while (it != s.begin());
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 0);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // one at a time goes where it belongs, and we are pointed at it
+   template <custom::flat_layout L>
+   void test_set_insert_one()
+   {  // setup
+      Set<L> s{ 20, 40, 60, 80 };
+      // exercise
+      std::pair<typename Set<L>::iterator, bool> middle = s.insert(50);
+      std::pair<typename Set<L>::iterator, bool> front = s.insert(10);
+      std::pair<typename Set<L>::iterator, bool> back = s.insert(90);
+      // verify
+      assertUnit(middle.second && front.second && back.second);
+      assertUnit(*back.first == 90);
+      assertUnit(*s.find(50) == 50);
+      assertUnit(contents(s) == std::vector<int>({ 10, 20, 40, 50, 60, 80, 90 }));
+   }  // teardown
+
+   // a repeat is not inserted, and we get the one already there
+   template <custom::flat_layout L>
+   void test_set_insert_duplicate()
+   {  // setup
+      Set<L> s{ 26, 49, 67, 89 };
+      // exercise
+      std::pair<typename Set<L>::iterator, bool> result = s.insert(67);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == 67);
+      assertUnit(s.size() == 4);
+   }  // teardown
+
+   // a bulk insert merges, and what was there stays
+   template <custom::flat_layout L>
+   void test_map_insert_rangeMerge()
+   {  // setup
+      Map<L> m{ { 20, 2 }, { 40, 4 } };
+      std::vector<custom::pair<int, int>> more;
+      more.push_back(custom::pair<int, int>(30, 3));
+      more.push_back(custom::pair<int, int>(40, 99));
+      more.push_back(custom::pair<int, int>(10, 1));
+      // exercise
+      m.insert(more.begin(), more.end());
+      // verify
+      assertUnit(m.size() == 4);
+      assertUnit(m.at(10) == 1);
+      assertUnit(m.at(30) == 3);
+      assertUnit(m.at(40) == 4);
+      assertUnit(m.begin()->first == 10);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase by key says whether it was there
+   template <custom::flat_layout L>
+   void test_set_erase_key()
+   {  // setup
+      Set<L> s{ 11, 26, 31, 49, 67, 71, 89 };
+      // exercise
+      size_t yes = s.erase(49);
+      size_t no = s.erase(50);
+      // verify
+      assertUnit(yes == 1);
+      assertUnit(no == 0);
+      assertUnit(contents(s) == std::vector<int>({ 11, 26, 31, 67, 71, 89 }));
+   }  // teardown
+
+   // erase by iterator gives back the next element
+   template <custom::flat_layout L>
+   void test_set_erase_iteratorNext()
+   {  // setup
+      Set<L> s{ 11, 26, 31, 49, 67, 71, 89 };
+      // exercise
+      typename Set<L>::iterator it = s.erase(s.find(31));
+      int next = *it;
+      typename Set<L>::iterator itLast = s.erase(s.find(89));
+      // verify
+      assertUnit(next == 49);
+      assertUnit(itLast == s.end());
+      assertUnit(s.size() == 5);
+   }  // teardown
+
+   // erase a run in the middle
+   template <custom::flat_layout L>
+   void test_set_erase_range()
+   {  // setup
+      std::vector<int> values;
+      for (int i = 0; i < 50; i++)
+         values.push_back(i);
+      Set<L> s(values.begin(), values.end());
+      // exercise
+      typename Set<L>::iterator it = s.erase(s.find(10), s.find(40));
+      // verify
+      assertUnit(*it == 40);
+      assertUnit(s.size() == 20);
+      assertUnit(s.find(9) != s.end());
+      assertUnit(s.find(10) == s.end());
+      assertUnit(s.find(39) == s.end());
+      assertUnit(*--s.find(40) == 9);
+   }  // teardown
+
+   // erase through to the end
+   template <custom::flat_layout L>
+   void test_set_erase_rangeToEnd()
+   {  // setup
+      Set<L> s{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+      // exercise
+      typename Set<L>::iterator it = s.erase(s.find(4), s.end());
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(contents(s) == std::vector<int>({ 1, 2, 3 }));
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // subscript inserts a default, or finds the one there
+   template <custom::flat_layout L>
+   void test_map_subscript_standard()
+   {  // setup
+      Map<L> m;
+      // exercise
+      for (int i = 9; i >= 0; i--)
+         m[i] = i * i;
+      m[5] += 1;
+      int missing = m[100];
+      // verify
+      assertUnit(m.size() == 11);
+      assertUnit(missing == 0);
+      assertUnit(m[5] == 26);
+      assertUnit(m[9] == 81);
+   }  // teardown
+
+   // at finds, or throws
+   template <custom::flat_layout L>
+   void test_map_at_standard()
+   {  // setup
+      Map<L> m{ { 26, 2 }, { 49, 4 }, { 67, 6 } };
+      const Map<L>& mConst = m;
+      bool thrown = false;
+      // exercise
+      m.at(49) = 5;
+      try
+      {
+         mConst.at(50);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(mConst.at(49) == 5);
+      assertUnit(mConst[67] == 6);
+   }  // teardown
+
+   // agrees with std::map for a random mix
+   template <custom::flat_layout L>
+   void test_map_random()
+   {  // setup
+      Map<L> m;
+      std::map<int, int> reference;
+      bool same = true;
+      srand(35);
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         int key = rand() % 300;
+         switch (rand() % 3)
+         {
+            case 0:
+               m[key] = i;
+               reference[key] = i;
+               break;
+            case 1:
+               same = same && m.erase(key) == reference.erase(key);
+               break;
+            default:
+               same = same && (m.find(key) == m.end()) == (reference.find(key) == reference.end());
+         }
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(m.size() == reference.size());
+      std::map<int, int>::iterator itRef = reference.begin();
+      for (typename Map<L>::iterator it = m.begin(); it != m.end() && same; ++it, ++itRef)
+         same = it->first == itRef->first && it->second == itRef->second;
+      assertUnit(same);
+   }  // teardown
+
+   // keys that own memory survive being laid out and relaid
+   template <custom::flat_layout L>
+   void test_map_string()
+   {  // setup
+      custom::flat_map<std::string, int, L> m;
+      // exercise
+      for (int i = 0; i < 200; i++)
+         m[std::to_string(i)] = i;
+      for (int i = 0; i < 200; i += 3)
+         m.erase(std::to_string(i));
+      // verify
+      assertUnit(m.size() == 133);
+      assertUnit(m.at("100") == 100);
+      assertUnit(m.find("99") == m.end());
+      assertUnit(m.begin()->first == "1");
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * Everything in a set, in iteration order
+    *************************************************************/
+   template <class Set>
+   std::vector<int> contents(const Set& s)
+   {
+      std::vector<int> v;
+      for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * STORAGE
+    * Everything in a set, in the order it is laid out in memory
+    *************************************************************/
+   template <class Set>
+   std::vector<int> storage(const Set& s)
+   {
+      std::vector<int> v;
+      for (size_t i = 0; i < s.table.elements.size(); i++)
+         v.push_back(s.table.elements[i]);
+      return v;
+   }
+};
+
+#endif // DEBUG
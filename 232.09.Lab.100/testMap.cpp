@@ -16,6 +16,17 @@
 #include "testPair.h"      // for the pair unit tests
 #include "testBST.h"       // for the BST unit tests
 #include "testMap.h"       // for the map unit tests
+#include "testSoaVector.h" // for the soa_vector unit tests
+#include "testBTree.h"     // for the btree unit tests
+#include "testFlatMap.h"   // for the flat_map unit tests
+#include "testPersistentMap.h" // for the persistent_map unit tests
+#include "testConcurrentMap.h" // for the concurrent_map unit tests
+#include "testSkipList.h"  // for the skip list unit tests
+#include "testSerialize.h" // for the serialization unit tests
+#include "testDump.h"      // for the dump unit tests
+#include "testCompactTree.h" // for the compact tree unit tests
+#include "testSplayTree.h" // for the splay tree unit tests
+#include "testMultiMap.h"  // for the multiset and multimap unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -30,6 +41,17 @@ int main()
    TestPair().run();
    TestBST().run();
    TestMap().run();
+   TestSoaVector().run();
+   TestBTree().run();
+   TestFlatMap().run();
+   TestPersistentMap().run();
+   TestConcurrentMap().run();
+   TestSkipList().run();
+   TestSerialize().run();
+   TestDump().run();
+   TestCompactTree().run();
+   TestSplayTree().run();
+   TestMultiMap().run();
 #endif // DEBUG
    
    return 0;
@@ -12,10 +12,14 @@
 
 #include "map.h"        // class under test
 #include "unitTest.h"   // unit test baseclass
+#include "spy.h"        // for the Spy
 
 
 #include <map>
+#include <set>
 #include <vector>
+#include <functional> // for std::greater
+#include <iterator>   // for std::back_inserter
 
 /***********************************************
  * TEST MAP
@@ -58,10 +62,12 @@ public:
       test_assignInit_standardToEmpty();
       test_assignInit_emptyToStandard();
       test_assignInit_standardToNotempty();
+      test_assignSorted_standardToNotempty();
       test_swap_emptyToEmpty();
       test_swap_standardToEmpty();
       test_swap_emptyToStandard();
       test_swap_standardToStandard();
+      test_swap_comparator();
 
       // Iterator
       test_begin_empty();
@@ -70,6 +76,8 @@ public:
       test_iterator_increment_standardToChild();
       test_iterator_increment_standardToParent();
       test_iterator_dereference_standardRead();
+      test_iterator_value_write();
+      test_iterator_increment_postfix();
 
       // Access
       test_access_standardRootRead();
@@ -101,6 +109,19 @@ public:
       test_insertCopy_standardMiddle();
       test_insertMove_empty();
       test_insertMove_standard();
+      test_insert_compareGreater();
+      test_tryEmplace_hit();
+      test_tryEmplace_miss();
+      test_tryEmplace_moveKey();
+      test_insertOrAssign_hit();
+      test_insertOrAssign_miss();
+      test_emplace_standard();
+      test_insertHint_append();
+      test_emplaceHint_duplicate();
+      test_insert_rangeSorted();
+      test_access_hitSpy();
+      test_find_hitSpy();
+      test_findBatch_hitSpy();
 
       // Remove
       test_clear_empty();
@@ -113,6 +134,17 @@ public:
       test_erase_standardIteratorMissing();
       test_erase_emptyRange();
       test_erase_standardRange();
+      test_erase_window();
+
+      // Batch
+      test_applyBatch_empty();
+      test_applyBatch_standard();
+      test_applyBatch_reuseNodes();
+      test_applyBatch_matchesLoop();
+      test_applyBatch_degenerate();
+
+      // Layout
+      test_compact_churn();
 
       // Status
       test_empty_empty();
@@ -850,6 +882,33 @@ public:
       teardownStandardFixture(m);
    }
 
+   // sorted pairs replace the contents with a balanced tree
+   void test_assignSorted_standardToNotempty()
+   {  // setup
+      //      { ("30",30) ("50",50) ("70",70)}
+      std::vector<custom::pair<std::string, int>> src;
+      src.push_back(custom::pair<std::string, int>(std::string("30"), int(30)));
+      src.push_back(custom::pair<std::string, int>(std::string("50"), int(50)));
+      src.push_back(custom::pair<std::string, int>(std::string("70"), int(70)));
+      //    "40"     "60"  = m
+      //   +----+   +----+ 
+      //   | 40 | - | 60 | 
+      //   +----+   +----+ 
+      custom::map<std::string, int> m;
+      m.insert(custom::pair<std::string, int>(std::string("40"), int(40)));
+      m.insert(custom::pair<std::string, int>(std::string("60"), int(60)));
+      // exercise
+      m.assign_sorted(src.begin(), src.end());
+      // verify
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
    /***************************************
     * SWAP
     *    swap(lhs, rhs)
@@ -978,6 +1037,41 @@ public:
       teardownStandardFixture(mRHS);
    }
 
+   // orders ints either way, as the comparator's own state says
+   struct Direction
+   {
+      bool descending = false;
+      bool operator()(int lhs, int rhs) const { return descending ? rhs < lhs : lhs < rhs; }
+   };
+
+   // a stateful comparator goes along with the tree it ordered
+   void test_swap_comparator()
+   {  // setup
+      custom::map<int, int, Direction> mUp;
+      custom::map<int, int, Direction> mDown;
+      mDown.compare.descending = true;
+      for (int i = 1; i <= 3; i++)
+      {
+         mUp[i] = i;
+         mDown[i] = i;
+      }
+      // exercise
+      swap(mUp, mDown);
+      mUp[4] = 4;
+      mDown[4] = 4;
+      // verify
+      assertUnit(mUp.compare.descending);
+      assertUnit(!mDown.compare.descending);
+      std::vector<int> up;
+      for (auto it = mUp.begin(); it != mUp.end(); ++it)
+         up.push_back(it.key());
+      std::vector<int> down;
+      for (auto it = mDown.begin(); it != mDown.end(); ++it)
+         down.push_back(it.key());
+      assertUnit(up == std::vector<int>({ 4, 3, 2, 1 }));
+      assertUnit(down == std::vector<int>({ 1, 2, 3, 4 }));
+   }  // teardown
+
 
    /***************************************
     * CLEAR
@@ -1556,6 +1650,35 @@ public:
       teardownStandardFixture(m);
    }
 
+   // the comparator orders the keys, and the values go along
+   void test_insert_compareGreater()
+   {  // setup
+      custom::map<std::string, int, std::greater<std::string>> m;
+      // exercise
+      m.insert(custom::pair<std::string, int, std::greater<std::string>>(std::string("50"), 50));
+      m.insert(custom::pair<std::string, int, std::greater<std::string>>(std::string("30"), 30));
+      m["70"] = 70;
+      auto pReturn = m.insert(custom::pair<std::string, int, std::greater<std::string>>(std::string("30"), 99));
+      // verify
+      assertUnit(pReturn.second == false);
+      assertUnit(m.size() == 3);
+      assertUnit(m["30"] == 30);
+      //                  (50)
+      //              +-----+-----+
+      //            (70)        (30)
+      assertUnit(m.bst.root != nullptr);
+      if (m.bst.root)
+      {
+         assertUnit(m.bst.root->data.first == std::string("50"));
+         assertUnit(m.bst.root->pLeft && m.bst.root->pLeft->data.first == std::string("70"));
+         assertUnit(m.bst.root->pRight && m.bst.root->pRight->data.first == std::string("30"));
+      }
+      std::vector<int> values;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         values.push_back((*it).second);
+      assertUnit(values == std::vector<int>({ 70, 50, 30 }));
+   }  // teardown
+
 
    /***************************************
     * SQUARE BRACKET
@@ -2095,6 +2218,295 @@ public:
       teardownStandardFixture(m);
    }
 
+   /***************************************
+    * EMPLACE
+    *    map::try_emplace(k, args...)
+    *    map::insert_or_assign(k, v)
+    *    map::emplace(args...)
+    ***************************************/
+
+   // a key that is already here makes no V and no node
+   void test_tryEmplace_hit()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      auto p50 = m.bst.root;
+      Spy::reset();
+      // exercise
+      auto pReturn = m.try_emplace(50, 99);
+      // verify
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(pReturn.second == false);
+      assertUnit(pReturn.first.it.pNode == p50);
+      assertUnit(m.bst.numElements == 3);
+      assertUnit(m.bst.root->data.second == Spy(50));
+   }  // teardown
+
+   // a new key makes its V once, from the arguments
+   void test_tryEmplace_miss()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      Spy::reset();
+      // exercise
+      auto pReturn = m.try_emplace(60, 66);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(pReturn.second == true);
+      assertUnit(m.bst.numElements == 4);
+      //                  (50)
+      //              +-----+-----+
+      //            (30)        (70)
+      //                       +--+
+      //                     (60)
+      assertUnit(m.bst.root->pRight != nullptr);
+      if (m.bst.root->pRight)
+      {
+         assertUnit(pReturn.first.it.pNode == m.bst.root->pRight->pLeft);
+         assertUnit(m.bst.root->pRight->pLeft != nullptr);
+         if (m.bst.root->pRight->pLeft)
+         {
+            assertUnit(m.bst.root->pRight->pLeft->data.first == 60);
+            assertUnit(m.bst.root->pRight->pLeft->data.second == Spy(66));
+            assertUnit(m.bst.root->pRight->pLeft->pParent == m.bst.root->pRight);
+         }
+      }
+   }  // teardown
+
+   // a moved key is taken, not copied
+   void test_tryEmplace_moveKey()
+   {  // setup
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      std::string key("60");
+      // exercise
+      auto pReturn = m.try_emplace(std::move(key), 60);
+      // verify
+      assertUnit(pReturn.second == true);
+      assertUnit(m.size() == 4);
+      assertUnit(m["60"] == 60);
+      assertUnit(pReturn.first.key() == std::string("60"));
+   }  // teardown
+
+   // a key that is already here gets the new value and no new node
+   void test_insertOrAssign_hit()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      auto p30 = m.bst.root->pLeft;
+      Spy s(33);
+      Spy::reset();
+      // exercise
+      auto pReturn = m.insert_or_assign(30, s);
+      // verify
+      assertUnit(Spy::numAssign() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(pReturn.second == false);
+      assertUnit(pReturn.first.it.pNode == p30);
+      assertUnit(p30->data.second == Spy(33));
+      assertUnit(m.bst.numElements == 3);
+   }  // teardown
+
+   // a new key is inserted with the value
+   void test_insertOrAssign_miss()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      Spy::reset();
+      // exercise
+      auto pReturn = m.insert_or_assign(20, Spy(22));
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(pReturn.second == true);
+      assertUnit(m.bst.numElements == 4);
+      assertUnit(m.bst.root->pLeft->pLeft == pReturn.first.it.pNode);
+      assertUnit(pReturn.first.value() == Spy(22));
+   }  // teardown
+
+   // emplace builds the pair from its arguments
+   void test_emplace_standard()
+   {  // setup
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      // exercise
+      auto pNew = m.emplace(std::string("40"), 40);
+      auto pOld = m.emplace(std::string("50"), 99);
+      // verify
+      assertUnit(pNew.second == true);
+      assertUnit(pOld.second == false);
+      assertUnit(m.size() == 4);
+      assertUnit(m["40"] == 40);
+      assertUnit(m["50"] == 50);
+   }  // teardown
+
+   // appending after the last insert keeps the map in order
+   void test_insertHint_append()
+   {  // setup
+      custom::map<int, int> m;
+      auto it = m.end();
+      // exercise
+      for (int i = 1; i <= 100; i++)
+         it = m.insert(it, custom::pair<int, int>(i, i * 10));
+      // verify
+      assertUnit(m.size() == 100);
+      int i = 1;
+      for (auto itOrder = m.begin(); itOrder != m.end(); ++itOrder, i++)
+      {
+         assertUnit(itOrder.key() == i);
+         assertUnit(itOrder.value() == i * 10);
+      }
+   }  // teardown
+
+   // a key already next to the hint keeps its value
+   void test_emplaceHint_duplicate()
+   {  // setup
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      auto itHint = m.find("70");
+      // exercise
+      auto itOld = m.emplace_hint(itHint, std::string("50"), 99);
+      auto itNew = m.emplace_hint(itHint, std::string("60"), 60);
+      // verify
+      assertUnit(m.size() == 4);
+      assertUnit(itOld == m.find("50"));
+      assertUnit(itNew == m.find("60"));
+      assertUnit(m["50"] == 50);
+      assertUnit(m["60"] == 60);
+   }  // teardown
+
+   // a sorted range goes in through the end
+   void test_insert_rangeSorted()
+   {  // setup
+      std::vector<custom::pair<int, int>> v;
+      for (int i = 1; i <= 5; i++)
+         v.push_back(custom::pair<int, int>(i, i));
+      v.push_back(custom::pair<int, int>(3, 99));
+      custom::map<int, int> m;
+      // exercise
+      m.insert(v.begin(), v.end());
+      // verify
+      assertUnit(m.size() == 5);
+      assertUnit(m[3] == 3);
+      assertUnit(m.begin().key() == 1);
+   }  // teardown
+
+   // the square bracket on a key that is here makes nothing
+   void test_access_hitSpy()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      Spy::reset();
+      // exercise
+      Spy& s = m[70];
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(&s == &m.bst.root->pRight->data.second);
+   }  // teardown
+
+   // find compares keys only, so it makes no V
+   void test_find_hitSpy()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      Spy::reset();
+      // exercise
+      auto it = m.find(30);
+      auto itMissing = m.find(40);
+      const Spy& v = m.at(70);
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(it.it.pNode == m.bst.root->pLeft);
+      assertUnit(itMissing == m.end());
+      assertUnit(&v == &m.bst.root->pRight->data.second);
+   }  // teardown
+
+   // a batch searches by key alone and answers in the order asked
+   void test_findBatch_hitSpy()
+   {  // setup
+      custom::map<int, Spy> m;
+      setupSpyFixture(m);
+      std::vector<int> keys{ 70, 40, 30, 50, 99 };
+      std::vector<custom::map<int, Spy>::iterator> found;
+      Spy::reset();
+      // exercise
+      m.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(found.size() == 5);
+      if (found.size() == 5)
+      {
+         assertUnit(found[0].it.pNode == m.bst.root->pRight);
+         assertUnit(found[1] == m.end());
+         assertUnit(found[2].it.pNode == m.bst.root->pLeft);
+         assertUnit(found[3].it.pNode == m.bst.root);
+         assertUnit(found[4] == m.end());
+      }
+   }  // teardown
+
+   // the value can be changed through the iterator, the key cannot
+   void test_iterator_value_write()
+   {  // setup
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      // exercise
+      for (auto it = m.begin(); it != m.end(); ++it)
+         it.value() += 1;
+      // verify
+      assertUnit(m.bst.root->data.second == 51);
+      assertUnit(m.bst.root->pLeft->data.second == 31);
+      assertUnit(m.bst.root->pRight->data.second == 71);
+      assertUnit(m.begin().key() == std::string("30"));
+      m.bst.root->data.second = 50;
+      m.bst.root->pLeft->data.second = 30;
+      m.bst.root->pRight->data.second = 70;
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   // postfix gives back where it was, prefix where it is
+   void test_iterator_increment_postfix()
+   {  // setup
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      auto it = m.begin();
+      // exercise
+      auto itOld = it++;
+      auto& itRef = ++it;
+      // verify
+      assertUnit(itOld.key() == std::string("30"));
+      assertUnit(it.key() == std::string("70"));
+      assertUnit(&itRef == &it);
+      assertUnit((it--).key() == std::string("70"));
+      assertUnit(it.key() == std::string("50"));
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
    /***************************************
     * ERASE
     *     map::erase()
@@ -2329,6 +2741,209 @@ public:
       // teardown
       teardownStandardFixture(m);
    }
+
+   // expiring a window of keys leaves the rest in order
+   void test_erase_window()
+   {  // setup
+      custom::map<int, int> m;
+      for (int i = 0; i < 1000; i++)
+         m[(i * 389) % 1000] = i;
+      // exercise
+      auto itReturn = m.erase(m.find(100), m.find(900));
+      // verify
+      assertUnit(itReturn == m.find(900));
+      assertUnit(m.size() == 200);
+      int key = 0;
+      bool same = true;
+      for (auto it = m.begin(); same && it != m.end(); ++it, key = (key == 99 ? 900 : key + 1))
+         same = it.key() == key;
+      assertUnit(same);
+      assertUnit(key == 1000);
+      assertUnit(m.bst.root != nullptr && m.bst.root->pParent == nullptr);
+   }  // teardown
+
+   /***************************************
+    * BATCH
+    *  map::apply_batch(ops)
+    ***************************************/
+
+   // a batch on an empty map inserts its upserts, balanced
+   void test_applyBatch_empty()
+   {  // setup
+      custom::map<int, int> m;
+      std::vector<custom::map<int, int>::op> ops{
+         { 10, 1, false }, { 20, 2, false }, { 25, 0, true },
+         { 30, 3, false }, { 30, 33, false }, { 40, 4, false } };
+      // exercise
+      m.apply_batch(ops);
+      // verify
+      //              30
+      //          +----+----+
+      //         20        40
+      //      +--+
+      //     10
+      assertUnit(m.size() == 4);
+      assertUnit(m.bst.root != nullptr);
+      if (m.bst.root)
+      {
+         assertUnit(m.bst.root->data.first == 30);
+         assertUnit(m.bst.root->data.second == 33);
+         assertUnit(m.bst.root->pParent == nullptr);
+      }
+      std::vector<int> order;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         order.push_back(it.key());
+      assertUnit(order == std::vector<int>({ 10, 20, 30, 40 }));
+   }  // teardown
+
+   // upsert, update, and erase in one pass
+   void test_applyBatch_standard()
+   {  // setup
+      //    "30"     "50"     "70"   = m
+      //   +----+   +----+   +----+
+      //   | 30 | - | 50 | - | 70 |
+      //   +----+   +----+   +----+
+      custom::map<std::string, int> m;
+      setupStandardFixture(m);
+      std::vector<custom::map<std::string, int>::op> ops{
+         { "20", 20, false }, { "50", 0, true }, { "60", 60, false },
+         { "70", 77, false }, { "90", 0, true } };
+      // exercise
+      m.apply_batch(ops);
+      // verify
+      //    "20"     "30"     "60"     "70"   = m
+      //   +----+   +----+   +----+   +----+
+      //   | 20 | - | 30 | - | 60 | - | 77 |
+      //   +----+   +----+   +----+   +----+
+      assertUnit(m.size() == 4);
+      assertUnit(m.find("50") == m.end());
+      assertUnit(m["20"] == 20);
+      assertUnit(m["30"] == 30);
+      assertUnit(m["60"] == 60);
+      assertUnit(m["70"] == 77);
+      assertUnit(m.size() == 4);
+      std::vector<std::string> order;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         order.push_back(it.key());
+      assertUnit(order == std::vector<std::string>({ "20", "30", "60", "70" }));
+      assertUnit(m.bst.root != nullptr && m.bst.root->pParent == nullptr);
+   }  // teardown
+
+   // nodes freed by erasures hold the keys inserted after them
+   void test_applyBatch_reuseNodes()
+   {  // setup
+      custom::map<int, int> m;
+      for (int i = 0; i < 100; i += 2)
+         m.insert(m.end(), custom::pair<int, int>(i, i));
+      std::set<void*> freed;
+      std::vector<custom::map<int, int>::op> ops;
+      for (int i = 0; i < 20; i += 2)
+      {
+         freed.insert(m.find(i).it.pNode);
+         ops.push_back({ i, 0, true });
+      }
+      for (int i = 101; i < 120; i += 2)
+         ops.push_back({ i, i, false });
+      // exercise
+      m.apply_batch(ops);
+      // verify
+      assertUnit(m.size() == 50);
+      bool reused = true;
+      for (int i = 101; i < 120; i += 2)
+         reused = reused && freed.count(m.find(i).it.pNode) == 1;
+      assertUnit(reused);
+      assertUnit(m.find(0) == m.end());
+      assertUnit(m.begin().key() == 20);
+   }  // teardown
+
+   // a large batch leaves the same map as one insert or erase at a time
+   void test_applyBatch_matchesLoop()
+   {  // setup
+      custom::map<int, int> m;
+      std::map<int, int> mExpected;
+      unsigned int seed = 7;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int key = (seed >> 8) % 1000;
+         m[key] = i;
+         mExpected[key] = i;
+      }
+      std::vector<custom::map<int, int>::op> ops;
+      for (int key = 0; key < 1000; key += 3)
+      {
+         seed = seed * 1103515245 + 12345;
+         bool isErase = (seed >> 8) % 3 == 0;
+         ops.push_back({ key, -key, isErase });
+         if (key % 2 == 0)
+            ops.push_back({ key, key, !isErase });   // the last op on a key wins
+      }
+      // exercise
+      m.apply_batch(ops);
+      for (size_t i = 0; i < ops.size(); i++)
+         if (ops[i].isErase)
+            mExpected.erase(ops[i].key);
+         else
+            mExpected[ops[i].key] = ops[i].value;
+      // verify
+      assertUnit(m.size() == mExpected.size());
+      bool same = m.size() == mExpected.size();
+      auto itExpected = mExpected.begin();
+      for (auto it = m.begin(); same && it != m.end(); ++it, ++itExpected)
+         same = it.key() == itExpected->first && it.value() == itExpected->second;
+      assertUnit(same);
+   }  // teardown
+
+   // a long chain does not need a deep recursion
+   void test_applyBatch_degenerate()
+   {  // setup
+      //   (0)
+      //    +-(1)
+      //       +- ... -(999999)
+      custom::map<int, int> m;
+      for (int i = 0; i < 1000000; i++)
+         m.insert(m.end(), custom::pair<int, int>(i, i));
+      std::vector<custom::map<int, int>::op> ops{
+         { 999997, 0, true }, { 999999, -1, false }, { 1000000, 1000000, false } };
+      // exercise
+      m.apply_batch(ops);
+      // verify
+      assertUnit(m.size() == 1000000);
+      assertUnit(m.find(999997) == m.end());
+      assertUnit(m[999998] == 999998);
+      assertUnit(m[999999] == -1);
+      assertUnit(m[1000000] == 1000000);
+      assertUnit(m.size() == 1000000);
+      assertUnit(m.bst.root != nullptr && m.bst.root->pParent == nullptr);
+   }  // teardown
+
+   /***************************************
+    * COMPACT
+    *    map::compact(bst_layout layout)
+    ***************************************/
+
+   // after inserts and erases every node is in one block, keys and values intact
+   void test_compact_churn()
+   {  // setup
+      custom::map<int, int> m;
+      for (int i = 0; i < 1000; i++)
+         m[i * 7 % 1000] = -i;
+      for (int i = 1; i < 1000; i += 2)
+         m.erase(i);
+      // exercise
+      m.compact();
+      // verify
+      assertUnit(m.size() == 500);
+      assertUnit(m.bst.slabLive == 500);
+      bool same = true;
+      int key = 0;
+      for (auto it = m.begin(); same && it != m.end(); ++it, key += 2)
+         same = it.it.getNode() == m.bst.pSlab + key / 2 && it.key() == key &&
+            m[key] == -((key * 143) % 1000);
+      assertUnit(same);
+      assertUnit(key == 1000);
+   }  // teardown
+
    /****************************************************************
     * Setup Standard Fixture
     *    "30"     "50"     "70"
@@ -2368,6 +2983,19 @@ public:
       m.bst.numElements = 3;
    }
 
+   /****************************************************************
+    * Setup Spy Fixture
+    *               (50)
+    *           +-----+-----+
+    *         (30)        (70)
+    ****************************************************************/
+   void setupSpyFixture(custom::map<int, Spy>& m)
+   {
+      m.try_emplace(50, 50);
+      m.try_emplace(30, 30);
+      m.try_emplace(70, 70);
+   }
+
    /****************************************************************
     * Verify Empty Fixture
     ****************************************************************/
@@ -0,0 +1,527 @@
+/***********************************************************************
+ * Header:
+ *    TEST MULTI MAP
+ * Summary:
+ *    Unit tests for multiset and multimap, with and without
+ *    run-length mode
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "multi_map.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>   // for rand
+#include <set>       // to check against
+#include <map>       // to check against
+#include <string>
+#include <vector>
+
+class TestMultiMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Multiset
+      test_multiset_construct_default();
+      test_multiset_insert_keepsDuplicates();
+      test_multiset_insert_stableOrder();
+      test_multiset_count_equalRange();
+      test_multiset_erase_key();
+      test_multiset_erase_iterator();
+      test_multiset_erase_random();
+      test_multiset_erase_lastOne();
+
+      // Multiset: run-length
+      test_multisetRun_insert_oneNode();
+      test_multisetRun_insert_noCopies();
+      test_multisetRun_erase_iterator();
+      test_multisetRun_erase_key();
+      test_multisetRun_matchesPlain();
+
+      // Multimap
+      test_multimap_insert_order();
+      test_multimap_equalRange_values();
+      test_multimap_erase_key();
+      test_multimap_erase_lastOne();
+
+      // Multimap: run-length
+      test_multimapRun_insert_bucket();
+      test_multimapRun_value_assign();
+      test_multimapRun_erase_iterator();
+      test_multimapRun_matchesPlain();
+
+      report("MultiMap");
+   }
+
+   using MultiSet = custom::multiset<int>;
+   using RunSet = custom::multiset<int, std::less<int>, true>;
+   using MultiMap = custom::multimap<int, std::string>;
+   using RunMap = custom::multimap<int, std::string, std::less<int>, true>;
+
+   /***************************************
+    * MULTISET
+    ***************************************/
+
+   // nothing is allocated until something is inserted
+   void test_multiset_construct_default()
+   {  // setup
+      // exercise
+      MultiSet s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.tree.nodes() == 0);
+      assertUnit(s.begin() == s.end());
+      assertUnit(s.count(50) == 0);
+   }  // teardown
+
+   // every copy gets its own node
+   void test_multiset_insert_keepsDuplicates()
+   {  // setup
+      MultiSet s;
+      // exercise
+      for (int i : { 50, 30, 50, 70, 50 })
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 5);
+      assertUnit(s.tree.nodes() == 5);
+      assertUnit(contents(s) == std::vector<int>({ 30, 50, 50, 50, 70 }));
+   }  // teardown
+
+   // equivalent elements come out in the order they went in
+   void test_multiset_insert_stableOrder()
+   {  // setup
+      custom::multiset<custom::pair<int, char>> s;
+      // exercise
+      for (auto p : { custom::pair<int, char>(1, 'a'), custom::pair<int, char>(0, 'x'),
+                      custom::pair<int, char>(1, 'b'), custom::pair<int, char>(2, 'y'),
+                      custom::pair<int, char>(1, 'c') })
+         s.insert(p);
+      // verify
+      std::string order;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         order += (*it).second;
+      assertUnit(order == "xabcy");
+   }  // teardown
+
+   // count and equal_range cover every copy and nothing else
+   void test_multiset_count_equalRange()
+   {  // setup
+      MultiSet s{ 50, 30, 50, 70, 50, 20, 60 };
+      // exercise
+      auto range = s.equal_range(50);
+      // verify
+      assertUnit(s.count(50) == 3);
+      assertUnit(s.count(30) == 1);
+      assertUnit(s.count(40) == 0);
+      assertUnit(steps(range.first, range.second) == 3);
+      assertUnit(range.first == s.lower_bound(50));
+      assertUnit(range.first == s.find(50));
+      assertUnit(range.second != s.end() && *range.second == 60);
+      auto missing = s.equal_range(40);
+      assertUnit(missing.first == missing.second);
+      assertUnit(s.find(40) == s.end());
+   }  // teardown
+
+   // erasing a key takes every copy of it
+   void test_multiset_erase_key()
+   {  // setup
+      MultiSet s{ 50, 30, 50, 70, 50 };
+      // exercise
+      size_t count = s.erase(50);
+      // verify
+      assertUnit(count == 3);
+      assertUnit(s.size() == 2);
+      assertUnit(s.tree.nodes() == 2);
+      assertUnit(s.erase(50) == 0);
+      assertUnit(contents(s) == std::vector<int>({ 30, 70 }));
+   }  // teardown
+
+   // erasing through an iterator takes one copy
+   void test_multiset_erase_iterator()
+   {  // setup
+      MultiSet s{ 50, 30, 50, 70, 50 };
+      // exercise
+      auto itReturn = s.erase(s.find(50));
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 50);
+      assertUnit(s.count(50) == 2);
+      assertUnit(s.size() == 4);
+      assertUnit(contents(s) == std::vector<int>({ 30, 50, 50, 70 }));
+   }  // teardown
+
+   // erasing the only element leaves an empty tree, either way and in either mode
+   void test_multiset_erase_lastOne()
+   {  // setup
+      MultiSet s1{ 7 };
+      MultiSet s2{ 7 };
+      RunSet r1{ 7 };
+      RunSet r2{ 7 };
+      // exercise
+      auto it1 = s1.erase(s1.begin());
+      size_t count2 = s2.erase(7);
+      auto itRun1 = r1.erase(r1.begin());
+      size_t countRun2 = r2.erase(7);
+      // verify
+      assertUnit(it1 == s1.end());
+      assertUnit(s1.empty() && s1.tree.nodes() == 0);
+      assertUnit(count2 == 1);
+      assertUnit(s2.empty() && s2.tree.nodes() == 0);
+      assertUnit(itRun1 == r1.end());
+      assertUnit(r1.empty() && r1.tree.nodes() == 0);
+      assertUnit(countRun2 == 1);
+      assertUnit(r2.empty() && r2.tree.nodes() == 0);
+      assertUnit(s1.begin() == s1.end() && r1.begin() == r1.end());
+   }  // teardown
+
+   // agrees with std::multiset when nodes with the same key get moved around
+   void test_multiset_erase_random()
+   {  // setup
+      MultiSet s;
+      std::multiset<int> reference;
+      bool same = true;
+      srand(13);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = rand() % 20;
+         switch (rand() % 4)
+         {
+         case 0:
+         case 1:
+            s.insert(value);
+            reference.insert(value);
+            break;
+         case 2:
+            if (reference.count(value))
+            {
+               s.erase(s.find(value));
+               reference.erase(reference.find(value));
+            }
+            break;
+         default:
+            if (rand() % 8 == 0)
+               same = same && s.erase(value) == reference.erase(value);
+         }
+         same = same && s.count(value) == reference.count(value);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(s.size() == reference.size());
+      assertUnit(contents(s) == std::vector<int>(reference.begin(), reference.end()));
+   }  // teardown
+
+   /***************************************
+    * MULTISET : RUN-LENGTH
+    ***************************************/
+
+   // one node per distinct value, however many copies
+   void test_multisetRun_insert_oneNode()
+   {  // setup
+      RunSet s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert(i % 5 * 10);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.tree.nodes() == 5);
+      assertUnit(s.count(20) == 200);
+      assertUnit(s.count(25) == 0);
+      assertUnit(steps(s.begin(), s.end()) == 1000);
+      auto range = s.equal_range(30);
+      assertUnit(steps(range.first, range.second) == 200);
+      assertUnit(*range.first == 30 && *range.second == 40);
+   }  // teardown
+
+   // a repeat only bumps the count
+   void test_multisetRun_insert_noCopies()
+   {  // setup
+      custom::multiset<Spy, std::less<Spy>, true> s;
+      Spy spy(7);
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 100; i++)
+         s.insert(spy);
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numAlloc() <= 1);
+      assertUnit(s.size() == 100);
+      assertUnit(s.tree.nodes() == 1);
+   }  // teardown
+
+   // the node goes only with its last copy
+   void test_multisetRun_erase_iterator()
+   {  // setup
+      RunSet s{ 30, 50, 50, 70 };
+      // exercise
+      auto itReturn = s.erase(s.find(50));
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 50);
+      assertUnit(s.tree.nodes() == 3);
+      // exercise
+      itReturn = s.erase(itReturn);
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 70);
+      assertUnit(s.tree.nodes() == 2);
+      assertUnit(s.size() == 2);
+      assertUnit(contents(s) == std::vector<int>({ 30, 70 }));
+   }  // teardown
+
+   // erasing a key reports every copy
+   void test_multisetRun_erase_key()
+   {  // setup
+      RunSet s{ 50, 30, 50, 70, 50 };
+      // exercise
+      size_t count = s.erase(50);
+      // verify
+      assertUnit(count == 3);
+      assertUnit(s.size() == 2);
+      assertUnit(s.tree.nodes() == 2);
+      assertUnit(contents(s) == std::vector<int>({ 30, 70 }));
+   }  // teardown
+
+   // the same answers in both modes, from far fewer nodes
+   void test_multisetRun_matchesPlain()
+   {  // setup
+      MultiSet sPlain;
+      RunSet sRun;
+      bool same = true;
+      srand(17);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = rand() % 50;
+         if (rand() % 3)
+         {
+            sPlain.insert(value);
+            sRun.insert(value);
+         }
+         else if (sPlain.count(value))
+         {
+            sPlain.erase(sPlain.find(value));
+            sRun.erase(sRun.find(value));
+         }
+         same = same && sPlain.count(value) == sRun.count(value);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(sPlain.size() == sRun.size());
+      assertUnit(sRun.tree.nodes() <= 50);
+      assertUnit(sPlain.tree.nodes() == sPlain.size());
+      assertUnit(contents(sPlain) == contents(sRun));
+   }  // teardown
+
+   /***************************************
+    * MULTIMAP
+    ***************************************/
+
+   // pairs with the same key stay in the order they went in
+   void test_multimap_insert_order()
+   {  // setup
+      MultiMap m;
+      // exercise
+      m.insert(MultiMap::Pairs(1, "a"));
+      m.insert(MultiMap::Pairs(2, "x"));
+      m.insert(MultiMap::Pairs(1, "b"));
+      m.insert(MultiMap::Pairs(0, "z"));
+      m.insert(MultiMap::Pairs(1, "c"));
+      // verify
+      assertUnit(m.size() == 5);
+      assertUnit(m.tree.nodes() == 5);
+      assertUnit(pairs(m) == "0z 1a 1b 1c 2x ");
+   }  // teardown
+
+   // equal_range walks every value for a key
+   void test_multimap_equalRange_values()
+   {  // setup
+      MultiMap m{ MultiMap::Pairs(1, "a"), MultiMap::Pairs(2, "x"), MultiMap::Pairs(1, "b") };
+      // exercise
+      auto range = m.equal_range(1);
+      // verify
+      std::string values;
+      for (auto it = range.first; it != range.second; ++it)
+         values += it.value();
+      assertUnit(values == "ab");
+      assertUnit(m.count(1) == 2);
+      assertUnit(m.count(3) == 0);
+      assertUnit(m.find(2) != m.end() && m.find(2).value() == "x");
+   }  // teardown
+
+   // erasing a key takes every pair with it
+   void test_multimap_erase_key()
+   {  // setup
+      MultiMap m{ MultiMap::Pairs(1, "a"), MultiMap::Pairs(2, "x"), MultiMap::Pairs(1, "b") };
+      // exercise
+      size_t count = m.erase(1);
+      // verify
+      assertUnit(count == 2);
+      assertUnit(m.size() == 1);
+      assertUnit(pairs(m) == "2x ");
+   }  // teardown
+
+   // erasing the only pair leaves an empty tree, either way and in either mode
+   void test_multimap_erase_lastOne()
+   {  // setup
+      MultiMap m1{ MultiMap::Pairs(1, "a") };
+      MultiMap m2{ MultiMap::Pairs(1, "a") };
+      RunMap r1{ RunMap::Pairs(1, "a") };
+      RunMap r2{ RunMap::Pairs(1, "a") };
+      // exercise
+      auto it1 = m1.erase(m1.begin());
+      size_t count2 = m2.erase(1);
+      auto itRun1 = r1.erase(r1.begin());
+      size_t countRun2 = r2.erase(1);
+      // verify
+      assertUnit(it1 == m1.end());
+      assertUnit(m1.empty() && m1.tree.nodes() == 0);
+      assertUnit(count2 == 1);
+      assertUnit(m2.empty() && m2.tree.nodes() == 0);
+      assertUnit(itRun1 == r1.end());
+      assertUnit(r1.empty() && r1.tree.nodes() == 0);
+      assertUnit(countRun2 == 1);
+      assertUnit(r2.empty() && r2.tree.nodes() == 0);
+      assertUnit(m1.begin() == m1.end() && r1.begin() == r1.end());
+   }  // teardown
+
+   /***************************************
+    * MULTIMAP : RUN-LENGTH
+    ***************************************/
+
+   // one node per key, its values together in the order they went in
+   void test_multimapRun_insert_bucket()
+   {  // setup
+      RunMap m;
+      // exercise
+      m.insert(RunMap::Pairs(1, "a"));
+      m.insert(RunMap::Pairs(2, "x"));
+      m.insert(RunMap::Pairs(1, "b"));
+      m.insert(RunMap::Pairs(0, "z"));
+      m.insert(RunMap::Pairs(1, "c"));
+      // verify
+      assertUnit(m.size() == 5);
+      assertUnit(m.tree.nodes() == 3);
+      assertUnit(m.count(1) == 3);
+      assertUnit(pairs(m) == "0z 1a 1b 1c 2x ");
+      auto it = m.find(1);
+      assertUnit(it.pNode->data.second.size() == 3);
+      assertUnit((*it).first == 1 && (*it).second == "a");
+   }  // teardown
+
+   // a value can be changed in place
+   void test_multimapRun_value_assign()
+   {  // setup
+      RunMap m{ RunMap::Pairs(1, "a"), RunMap::Pairs(1, "b") };
+      auto it = m.find(1);
+      ++it;
+      // exercise
+      it.value() = "B";
+      // verify
+      assertUnit(pairs(m) == "1a 1B ");
+   }  // teardown
+
+   // a value comes out of the middle of its bucket, keeping the order
+   void test_multimapRun_erase_iterator()
+   {  // setup
+      RunMap m{ RunMap::Pairs(1, "a"), RunMap::Pairs(1, "b"), RunMap::Pairs(1, "c"),
+                RunMap::Pairs(2, "x") };
+      auto it = m.find(1);
+      ++it;
+      // exercise
+      auto itReturn = m.erase(it);
+      // verify
+      assertUnit(itReturn != m.end() && itReturn.value() == "c");
+      assertUnit(pairs(m) == "1a 1c 2x ");
+      // exercise
+      itReturn = m.erase(itReturn);
+      // verify
+      assertUnit(itReturn != m.end() && itReturn.key() == 2);
+      assertUnit(pairs(m) == "1a 2x ");
+      assertUnit(m.tree.nodes() == 2);
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   // the same pairs as std::multimap, from far fewer nodes
+   void test_multimapRun_matchesPlain()
+   {  // setup
+      RunMap m;
+      MultiMap mPlain;
+      std::multimap<int, std::string> reference;
+      bool same = true;
+      srand(19);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int key = rand() % 40;
+         std::string value = std::to_string(i);
+         if (rand() % 4)
+         {
+            m.insert(RunMap::Pairs(key, value));
+            mPlain.insert(MultiMap::Pairs(key, value));
+            reference.insert(std::make_pair(key, value));
+         }
+         else if (rand() % 4 == 0)
+         {
+            size_t count = reference.erase(key);
+            same = same && m.erase(key) == count && mPlain.erase(key) == count;
+         }
+         same = same && m.count(key) == reference.count(key);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(m.size() == reference.size());
+      assertUnit(m.tree.nodes() <= 40);
+      std::string expected;
+      for (auto it = reference.begin(); it != reference.end(); ++it)
+         expected += std::to_string(it->first) + it->second + " ";
+      assertUnit(pairs(m) == expected);
+      assertUnit(pairs(mPlain) == expected);
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * Everything in a multiset, in order
+    *************************************************************/
+   template <class Set>
+   std::vector<int> contents(const Set& s)
+   {
+      std::vector<int> v;
+      for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * STEPS
+    * How many times ++ takes first to last
+    *************************************************************/
+   template <class Iterator>
+   size_t steps(Iterator first, Iterator last)
+   {
+      size_t n = 0;
+      for (; first != last; ++first)
+         n++;
+      return n;
+   }
+
+   /*************************************************************
+    * PAIRS
+    * Every key and value in a multimap, in order
+    *************************************************************/
+   template <class Map>
+   std::string pairs(const Map& m)
+   {
+      std::string s;
+      for (typename Map::iterator it = m.begin(); it != m.end(); ++it)
+         s += std::to_string(it.key()) + it.value() + " ";
+      return s;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,591 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT MAP
+ * Summary:
+ *    Unit tests for persistent_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "persistent_map.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cmath>     // for log2
+#include <cstdlib>   // for rand
+#include <map>       // to check against
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestPersistentMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+      test_constructCopy_shares();
+      test_assign_shares();
+      test_destructor_lastVersion();
+
+      // Access
+      test_find_standard();
+      test_at_throw();
+      test_subscript_insert();
+      test_iterate_forward();
+      test_iterate_backward();
+
+      // Insert
+      test_insert_duplicate();
+      test_insert_balanced();
+      test_insert_noSnapshotNoCopies();
+      test_insert_pathCopy();
+
+      // Remove
+      test_erase_key();
+      test_erase_iteratorNext();
+      test_erase_range();
+      test_erase_pathCopy();
+
+      // Snapshot
+      test_snapshot_constant();
+      test_snapshot_isolatedInsert();
+      test_snapshot_isolatedSubscript();
+      test_snapshot_isolatedErase();
+      test_snapshot_iteratorOutlives();
+      test_snapshot_manyVersions();
+      test_snapshot_readerThreads();
+
+      report("PersistentMap");
+   }
+
+   using Map = custom::persistent_map<int, int>;
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // empty has no tree
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Map m;
+      // verify
+      assertUnit(m.empty());
+      assertUnit(m.size() == 0);
+      assertUnit(m.root == nullptr);
+      assertUnit(m.begin() == m.end());
+   }  // teardown
+
+   // built from a list, in order
+   void test_construct_initializerList()
+   {  // setup
+      // exercise
+      Map m{ { 50, 5 }, { 30, 3 }, { 70, 7 }, { 30, 99 } };
+      // verify
+      assertUnit(m.size() == 3);
+      assertUnit(keys(m) == std::vector<int>({ 30, 50, 70 }));
+      assertUnit(m.at(30) == 3);
+      assertUnit(valid(m));
+   }  // teardown
+
+   // a copy is the same tree, not a new one
+   void test_constructCopy_shares()
+   {  // setup
+      Map mSrc = standard();
+      // exercise
+      Map mDest(mSrc);
+      // verify
+      assertUnit(mDest.root == mSrc.root);
+      assertUnit(mSrc.root->refs == 2);
+      assertUnit(mDest.size() == 7);
+   }  // teardown
+
+   // assignment lets go of the old tree and shares the new one
+   void test_assign_shares()
+   {  // setup
+      Map mSrc = standard();
+      Map mDest{ { 1, 1 } };
+      // exercise
+      mDest = mSrc;
+      // verify
+      assertUnit(mDest.root == mSrc.root);
+      assertUnit(mSrc.root->refs == 2);
+      assertUnit(keys(mDest) == keys(mSrc));
+   }  // teardown
+
+   // the nodes go when the last version that uses them goes
+   void test_destructor_lastVersion()
+   {  // setup
+      Spy::reset();
+      {
+         custom::persistent_map<int, Spy> m;
+         for (int i = 0; i < 100; i++)
+            m[i] = Spy(i);
+         custom::persistent_map<int, Spy> mOld = m.snapshot();
+         for (int i = 0; i < 100; i += 2)
+            m.erase(i);
+         m[1000] = Spy(1000);
+         {
+            custom::persistent_map<int, Spy> mOlder = mOld.snapshot();
+            mOld.erase(50);
+         }
+      }  // exercise
+      // verify
+      assertUnit(Spy::numAlloc() > 100);
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // find by key
+   void test_find_standard()
+   {  // setup
+      Map m = standard();
+      // exercise
+      Map::iterator it = m.find(67);
+      Map::iterator itMiss = m.find(68);
+      // verify
+      assertUnit(it != m.end());
+      assertUnit(it->second == 6);
+      assertUnit(itMiss == m.end());
+   }  // teardown
+
+   // at throws on a missing key
+   void test_at_throw()
+   {  // setup
+      const Map m = standard();
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(68);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.at(67) == 6);
+      assertUnit(m[11] == 1);
+   }  // teardown
+
+   // subscript inserts a default or finds what is there
+   void test_subscript_insert()
+   {  // setup
+      Map m;
+      // exercise
+      for (int i = 0; i < 10; i++)
+         m[i] = i * i;
+      m[5] += 1;
+      int missing = m[100];
+      // verify
+      assertUnit(m.size() == 11);
+      assertUnit(missing == 0);
+      assertUnit(m.at(5) == 26);
+      assertUnit(valid(m));
+   }  // teardown
+
+   // forward in key order
+   void test_iterate_forward()
+   {  // setup
+      Map m;
+      for (int i = 99; i >= 0; i--)
+         m[i] = i;
+      int expect = 0;
+      bool inOrder = true;
+      // exercise
+      for (Map::iterator it = m.begin(); it != m.end(); ++it)
+         inOrder = inOrder && it->first == expect++;
+      // verify
+      assertUnit(inOrder);
+      assertUnit(expect == 100);
+   }  // teardown
+
+   // backward from the end
+   void test_iterate_backward()
+   {  // setup
+      Map m = standard();
+      std::vector<int> seen;
+      Map::iterator it = m.end();
+      // exercise
+      do
+      {
+         --it;
+         seen.push_back(it->first);
+      } while (it != m.begin());
+      // verify
+      assertUnit(seen == std::vector<int>({ 89, 71, 67, 49, 31, 26, 11 }));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a repeat is not inserted
+   void test_insert_duplicate()
+   {  // setup
+      Map m = standard();
+      Map mOld = m.snapshot();
+      // exercise
+      custom::pair<Map::iterator, bool> result = m.insert(custom::pair<int, int>(49, 99));
+      // verify
+      assertUnit(!result.second);
+      assertUnit(result.first->second == 4);
+      assertUnit(m.root == mOld.root);   // nothing was copied
+   }  // teardown
+
+   // sorted input still makes a balanced tree
+   void test_insert_balanced()
+   {  // setup
+      Map m;
+      // exercise
+      for (int i = 0; i < 4096; i++)
+         m[i] = i;
+      // verify
+      assertUnit(valid(m));
+      assertUnit(m.root->height <= 1.45 * std::log2(4096.0 + 2.0));
+   }  // teardown
+
+   // with no snapshot out, a change happens in place
+   void test_insert_noSnapshotNoCopies()
+   {  // setup
+      custom::persistent_map<int, Spy> m;
+      for (int i = 0; i < 1000; i++)
+         m[i * 2] = Spy(i);
+      Spy::reset();
+      // exercise
+      m.insert(custom::pair<int, Spy>(501, Spy(501)));
+      m[600] = Spy(6);
+      // verify
+      assertUnit(Spy::numCopy() == 0);   // the new elements are moved in
+      assertUnit(m.size() == 1001);
+   }  // teardown
+
+   // with a snapshot out, only the path to the change is copied
+   void test_insert_pathCopy()
+   {  // setup
+      custom::persistent_map<int, Spy> m;
+      for (int i = 0; i < 1000; i++)
+         m[i * 2] = Spy(i);
+      custom::persistent_map<int, Spy> mOld = m.snapshot();
+      int height = m.root->height;
+      Spy::reset();
+      // exercise
+      m.insert(custom::pair<int, Spy>(501, Spy(501)));
+      // verify
+      assertUnit(Spy::numCopy() >= 1);
+      assertUnit(Spy::numCopy() <= height + 3);   // the path, plus rotations
+      assertUnit(shared(m, mOld) >= (size_t)(1000 - height - 3));
+      assertUnit(mOld.size() == 1000);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase by key says whether it was there
+   void test_erase_key()
+   {  // setup
+      Map m = standard();
+      // exercise
+      size_t yes = m.erase(49);
+      size_t no = m.erase(50);
+      // verify
+      assertUnit(yes == 1);
+      assertUnit(no == 0);
+      assertUnit(keys(m) == std::vector<int>({ 11, 26, 31, 67, 71, 89 }));
+      assertUnit(valid(m));
+   }  // teardown
+
+   // erase by iterator gives back the next element
+   void test_erase_iteratorNext()
+   {  // setup
+      Map m = standard();
+      // exercise
+      Map::iterator it = m.erase(m.find(31));
+      int next = it->first;
+      Map::iterator itLast = m.erase(m.find(89));
+      // verify
+      assertUnit(next == 49);
+      assertUnit(itLast == m.end());
+      assertUnit(m.size() == 5);
+   }  // teardown
+
+   // erase a run
+   void test_erase_range()
+   {  // setup
+      Map m;
+      for (int i = 0; i < 100; i++)
+         m[i] = i;
+      // exercise
+      Map::iterator it = m.erase(m.find(20), m.find(80));
+      // verify
+      assertUnit(it->first == 80);
+      assertUnit(m.size() == 40);
+      assertUnit(valid(m));
+      assertUnit(m.find(19) != m.end());
+      assertUnit(m.find(20) == m.end());
+   }  // teardown
+
+   // erase copies the path too, and no more
+   void test_erase_pathCopy()
+   {  // setup
+      custom::persistent_map<int, Spy> m;
+      for (int i = 0; i < 1000; i++)
+         m[i] = Spy(i);
+      custom::persistent_map<int, Spy> mOld = m.snapshot();
+      int height = m.root->height;
+      Spy::reset();
+      // exercise
+      m.erase(m.root->data.first);   // the worst place: two children, deep successor
+      // verify
+      assertUnit(Spy::numCopy() <= 2 * height + 3);
+      assertUnit(shared(m, mOld) >= (size_t)(999 - 2 * height - 3));
+      assertUnit(mOld.size() == 1000);
+   }  // teardown
+
+   /***************************************
+    * SNAPSHOT
+    ***************************************/
+
+   // a snapshot costs the same however big the map
+   void test_snapshot_constant()
+   {  // setup
+      custom::persistent_map<int, Spy> m;
+      for (int i = 0; i < 1000; i++)
+         m[i] = Spy(i);
+      Spy::reset();
+      // exercise
+      custom::persistent_map<int, Spy> mSnap = m.snapshot();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(mSnap.root == m.root);
+      assertUnit(mSnap.size() == 1000);
+   }  // teardown
+
+   // an insert after a snapshot is not seen by it
+   void test_snapshot_isolatedInsert()
+   {  // setup
+      Map m = standard();
+      Map mSnap = m.snapshot();
+      // exercise
+      m[50] = 5;
+      // verify
+      assertUnit(m.find(50) != m.end());
+      assertUnit(mSnap.find(50) == mSnap.end());
+      assertUnit(keys(mSnap) == std::vector<int>({ 11, 26, 31, 49, 67, 71, 89 }));
+      assertUnit(valid(m) && valid(mSnap));
+   }  // teardown
+
+   // changing a value after a snapshot is not seen by it
+   void test_snapshot_isolatedSubscript()
+   {  // setup
+      Map m = standard();
+      Map mSnap = m.snapshot();
+      // exercise
+      m[49] = 99;
+      // verify
+      assertUnit(m.at(49) == 99);
+      assertUnit(mSnap.at(49) == 4);
+   }  // teardown
+
+   // an erase after a snapshot is not seen by it
+   void test_snapshot_isolatedErase()
+   {  // setup
+      Map m = standard();
+      Map mSnap = m.snapshot();
+      // exercise
+      m.erase(49);
+      m.erase(11);
+      // verify
+      assertUnit(m.size() == 5);
+      assertUnit(mSnap.size() == 7);
+      assertUnit(mSnap.at(49) == 4);
+      assertUnit(keys(mSnap) == std::vector<int>({ 11, 26, 31, 49, 67, 71, 89 }));
+      assertUnit(valid(m) && valid(mSnap));
+   }  // teardown
+
+   // iterators into a snapshot survive changes to the map
+   void test_snapshot_iteratorOutlives()
+   {  // setup
+      Map m = standard();
+      Map mSnap = m.snapshot();
+      Map::iterator it = mSnap.find(49);
+      // exercise
+      for (int i = 0; i < 100; i++)
+         m[i] = -i;
+      m.erase(49);
+      ++it;
+      // verify
+      assertUnit(it->first == 67);
+      assertUnit(it->second == 6);
+   }  // teardown
+
+   // every version agrees with a std::map copy taken at the same time
+   void test_snapshot_manyVersions()
+   {  // setup
+      Map m;
+      std::map<int, int> reference;
+      std::vector<Map> versions;
+      std::vector<std::map<int, int>> references;
+      srand(36);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int key = rand() % 300;
+         if (rand() % 3)
+         {
+            m[key] = i;
+            reference[key] = i;
+         }
+         else
+         {
+            m.erase(key);
+            reference.erase(key);
+         }
+         if (i % 250 == 0)
+         {
+            versions.push_back(m.snapshot());
+            references.push_back(reference);
+         }
+      }
+      // verify
+      bool same = true;
+      for (size_t v = 0; v < versions.size(); v++)
+         same = same && valid(versions[v]) && contents(versions[v]) == references[v];
+      assertUnit(same);
+      assertUnit(contents(m) == reference);
+   }  // teardown
+
+   // readers walk their snapshots while the writer keeps changing the map
+   void test_snapshot_readerThreads()
+   {  // setup
+      Map m;
+      for (int i = 0; i < 2000; i++)
+         m[i] = i;
+      Map mSnap = m.snapshot();
+      bool ok[4] = { false, false, false, false };
+      std::vector<std::thread> readers;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         readers.push_back(std::thread([&mSnap, &ok, t]()
+            {
+               Map mMine = mSnap.snapshot();
+               long long total = 0;
+               for (int pass = 0; pass < 5; pass++)
+                  for (Map::iterator it = mMine.begin(); it != mMine.end(); ++it)
+                     total += it->second;
+               ok[t] = (total == 5LL * 1999 * 2000 / 2);
+            }));
+      for (int i = 0; i < 2000; i++)
+      {
+         m.erase(i);
+         m[i + 5000] = -i;
+      }
+      for (std::thread& reader : readers)
+         reader.join();
+      // verify
+      assertUnit(ok[0] && ok[1] && ok[2] && ok[3]);
+      assertUnit(mSnap.size() == 2000);
+      assertUnit(m.size() == 2000);
+      assertUnit(m.begin()->first == 5000);
+   }  // teardown
+
+   /*************************************************************
+    * STANDARD
+    *    11:1  26:2  31:3  49:4  67:6  71:7  89:8
+    *************************************************************/
+   Map standard()
+   {
+      return Map{ { 49, 4 }, { 26, 2 }, { 71, 7 }, { 11, 1 }, { 31, 3 }, { 67, 6 }, { 89, 8 } };
+   }
+
+   /*************************************************************
+    * KEYS and CONTENTS
+    *************************************************************/
+   template <class M>
+   std::vector<int> keys(const M& m)
+   {
+      std::vector<int> v;
+      for (typename M::iterator it = m.begin(); it != m.end(); ++it)
+         v.push_back(it->first);
+      return v;
+   }
+   std::map<int, int> contents(const Map& m)
+   {
+      std::map<int, int> result;
+      for (Map::iterator it = m.begin(); it != m.end(); ++it)
+         result[it->first] = it->second;
+      return result;
+   }
+
+   /*************************************************************
+    * SHARED
+    * How many nodes two versions have in common
+    *************************************************************/
+   template <class M>
+   size_t shared(const M& lhs, const M& rhs)
+   {
+      std::vector<const void*> mine;
+      collect(lhs.root, mine);
+      std::vector<const void*> theirs;
+      collect(rhs.root, theirs);
+      size_t count = 0;
+      for (const void* p : mine)
+         for (const void* q : theirs)
+            count += (p == q);
+      return count;
+   }
+   template <class Node>
+   void collect(const Node* p, std::vector<const void*>& nodes)
+   {
+      if (!p)
+         return;
+      nodes.push_back(p);
+      collect(p->pLeft, nodes);
+      collect(p->pRight, nodes);
+   }
+
+   /*************************************************************
+    * VALID
+    * Ordered, AVL balanced, heights right, size right
+    *************************************************************/
+   template <class M>
+   bool valid(const M& m)
+   {
+      size_t count = 0;
+      return validNode(m.root, (const int*)nullptr, (const int*)nullptr, count) >= 0 &&
+             count == m.size();
+   }
+   template <class Node>
+   int validNode(const Node* p, const int* pLow, const int* pHigh, size_t& count)
+   {
+      if (!p)
+         return 0;
+      count++;
+      if ((pLow && !(*pLow < p->data.first)) || (pHigh && !(p->data.first < *pHigh)))
+         return -1;
+      if (p->refs == 0)
+         return -1;
+      int hLeft = validNode(p->pLeft, pLow, &p->data.first, count);
+      int hRight = validNode(p->pRight, &p->data.first, pHigh, count);
+      if (hLeft < 0 || hRight < 0 || hLeft - hRight > 1 || hRight - hLeft > 1)
+         return -1;
+      int h = 1 + (hLeft > hRight ? hLeft : hRight);
+      return h == p->height ? h : -1;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,547 @@
+/***********************************************************************
+ * Header:
+ *    TEST SERIALIZE
+ * Summary:
+ *    Unit tests for save, load, mapped_file, set_view, and map_view
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "serialize.h"
+#include "unitTest.h"
+
+#include <cstdio>    // for std::remove
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class TestSerialize : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Checksum
+      test_checksum_split();
+      test_checksum_differs();
+
+      // Stream
+      test_vector_roundTrip();
+      test_vector_empty();
+      test_set_roundTrip();
+      test_set_replaces();
+      test_map_roundTrip();
+      test_map_layout();
+      test_load_wrongKind();
+      test_load_wrongSize();
+      test_load_notContainer();
+      test_load_corrupt();
+      test_load_truncated();
+
+      // Mapped file
+      test_mapped_missing();
+      test_mapped_vector();
+      test_setView_find();
+      test_setView_corrupt();
+      test_mapView_find();
+      test_mapView_at_throw();
+      test_mapView_iterate();
+      test_mapped_loadSet();
+      test_mapped_loadMap();
+
+      report("Serialize");
+   }
+
+   /***************************************
+    * CHECKSUM
+    ***************************************/
+
+   // feeding the bytes in pieces gives the same sum as all at once
+   void test_checksum_split()
+   {  // setup
+      unsigned char bytes[37];
+      for (int i = 0; i < 37; i++)
+         bytes[i] = (unsigned char)(i * 7 + 1);
+      custom::Checksum whole;
+      custom::Checksum pieces;
+      // exercise
+      whole.add(bytes, 37);
+      pieces.add(bytes, 3);
+      pieces.add(bytes + 3, 0);
+      pieces.add(bytes + 3, 9);
+      pieces.add(bytes + 12, 25);
+      // verify
+      assertUnit(whole.value() == pieces.value());
+   }  // teardown
+
+   // one changed byte, or one more zero, changes the sum
+   void test_checksum_differs()
+   {  // setup
+      unsigned char bytes[16] = {};
+      custom::Checksum original;
+      custom::Checksum changed;
+      custom::Checksum longer;
+      // exercise
+      original.add(bytes, 15);
+      longer.add(bytes, 16);
+      bytes[9] = 1;
+      changed.add(bytes, 15);
+      // verify
+      assertUnit(original.value() != changed.value());
+      assertUnit(original.value() != longer.value());
+   }  // teardown
+
+   /***************************************
+    * STREAM
+    ***************************************/
+
+   // a vector comes back the same
+   void test_vector_roundTrip()
+   {  // setup
+      custom::vector<double> vSrc;
+      for (int i = 0; i < 1000; i++)
+         vSrc.push_back(i * 0.5);
+      custom::vector<double> vDest{ 99.0 };
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, vSrc);
+      custom::load(ss, vDest);
+      // verify
+      assertUnit(vDest.size() == 1000);
+      assertUnit(vDest[0] == 0.0);
+      assertUnit(vDest[999] == 499.5);
+      assertUnit(ss.str().size() == sizeof(custom::serial_header) + 8000);
+   }  // teardown
+
+   // an empty vector is just a header
+   void test_vector_empty()
+   {  // setup
+      custom::vector<int> vSrc;
+      custom::vector<int> vDest{ 1, 2, 3 };
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, vSrc);
+      custom::load(ss, vDest);
+      // verify
+      assertUnit(vDest.empty());
+      assertUnit(ss.str().size() == sizeof(custom::serial_header));
+   }  // teardown
+
+   // a set comes back the same, and in order
+   void test_set_roundTrip()
+   {  // setup
+      custom::set<int> sSrc{ 50, 30, 70, 20, 40, 60, 80 };
+      custom::set<int> sDest;
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, sSrc);
+      custom::load(ss, sDest);
+      // verify
+      assertUnit(elements(sDest) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+      assertUnit(sDest.size() == 7);
+   }  // teardown
+
+   // loading replaces what was there
+   void test_set_replaces()
+   {  // setup
+      custom::set<int> sSrc{ 3, 1, 2 };
+      custom::set<int> sDest{ 10, 11, 12, 13, 14 };
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, sSrc);
+      custom::load(ss, sDest);
+      // verify
+      assertUnit(elements(sDest) == std::vector<int>({ 1, 2, 3 }));
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.find(12) == sDest.end());
+   }  // teardown
+
+   // a map comes back the same
+   void test_map_roundTrip()
+   {  // setup
+      custom::map<int, double> mSrc;
+      for (int i = 0; i < 500; i++)
+         mSrc[(i * 37) % 500] = i;
+      custom::map<int, double> mDest;
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, mSrc);
+      custom::load(ss, mDest);
+      // verify
+      assertUnit(mDest.size() == 500);
+      bool same = true;
+      for (int i = 0; i < 500; i++)
+         same = same && mDest[(i * 37) % 500] == i;
+      assertUnit(same);
+   }  // teardown
+
+   // keys then values, each column padded to 8 bytes
+   void test_map_layout()
+   {  // setup
+      custom::map<int, short> m;
+      m[3] = 30;
+      m[1] = 10;
+      m[2] = 20;
+      std::stringstream ss;
+      // exercise
+      custom::save(ss, m);
+      // verify
+      std::string s = ss.str();
+      assertUnit(s.size() == 40 + 16 + 8);
+      custom::serial_header header;
+      memcpy(&header, s.data(), sizeof(header));
+      assertUnit(header.kind == (uint16_t)custom::serial_kind::map);
+      assertUnit(header.keySize == 4);
+      assertUnit(header.valueSize == 2);
+      assertUnit(header.count == 3);
+      int keys[3];
+      short values[3];
+      memcpy(keys, s.data() + 40, sizeof(keys));
+      memcpy(values, s.data() + 56, sizeof(values));
+      assertUnit(keys[0] == 1 && keys[1] == 2 && keys[2] == 3);
+      assertUnit(values[0] == 10 && values[1] == 20 && values[2] == 30);
+   }  // teardown
+
+   // a set file cannot be loaded as a vector
+   void test_load_wrongKind()
+   {  // setup
+      custom::set<int> s{ 1, 2, 3 };
+      custom::vector<int> v{ 7 };
+      std::stringstream ss;
+      custom::save(ss, s);
+      // exercise
+      std::string message = loadError(ss, v);
+      // verify
+      assertUnit(message == "custom::load: file holds a different kind of container");
+      assertUnit(v.size() == 1);
+      assertUnit(v[0] == 7);
+   }  // teardown
+
+   // ints cannot be loaded as doubles
+   void test_load_wrongSize()
+   {  // setup
+      custom::vector<int> vSrc{ 1, 2, 3 };
+      custom::vector<double> vDest;
+      std::stringstream ss;
+      custom::save(ss, vSrc);
+      // exercise
+      std::string message = loadError(ss, vDest);
+      // verify
+      assertUnit(message == "custom::load: element sizes do not match");
+   }  // teardown
+
+   // anything else is refused
+   void test_load_notContainer()
+   {  // setup
+      std::stringstream ss(std::string(64, 'x'));
+      custom::vector<int> v;
+      // exercise
+      std::string message = loadError(ss, v);
+      // verify
+      assertUnit(message == "custom::load: not a container file");
+   }  // teardown
+
+   // one bad byte is caught and the map is left alone
+   void test_load_corrupt()
+   {  // setup
+      custom::map<int, int> mSrc;
+      for (int i = 0; i < 10; i++)
+         mSrc[i] = i * i;
+      custom::map<int, int> mDest;
+      mDest[99] = 1;
+      std::stringstream ssSrc;
+      custom::save(ssSrc, mSrc);
+      std::string s = ssSrc.str();
+      s[40 + 48 + 5] ^= 0x10;    // somewhere in the values
+      std::stringstream ss(s);
+      // exercise
+      std::string message = loadError(ss, mDest);
+      // verify
+      assertUnit(message == "custom::load: checksum does not match");
+      assertUnit(mDest.size() == 1);
+      assertUnit(mDest[99] == 1);
+   }  // teardown
+
+   // a short file is caught
+   void test_load_truncated()
+   {  // setup
+      custom::set<int> sSrc{ 1, 2, 3, 4, 5 };
+      custom::set<int> sDest;
+      std::stringstream ssSrc;
+      custom::save(ssSrc, sSrc);
+      std::string s = ssSrc.str();
+      std::stringstream ss(s.substr(0, s.size() - 12));
+      // exercise
+      std::string message = loadError(ss, sDest);
+      // verify
+      assertUnit(message == "custom::load: file is truncated");
+      assertUnit(sDest.empty());
+   }  // teardown
+
+   /***************************************
+    * MAPPED FILE
+    ***************************************/
+
+   // a file that is not there throws
+   void test_mapped_missing()
+   {  // setup
+      std::string message;
+      // exercise
+      try
+      {
+         custom::mapped_file file("testSerialize.missing");
+      }
+      catch (const std::runtime_error& error)
+      {
+         message = error.what();
+      }
+      // verify
+      assertUnit(message == "custom::mapped_file: cannot open testSerialize.missing");
+   }  // teardown
+
+   // a vector loads from a mapped file
+   void test_mapped_vector()
+   {  // setup
+      custom::vector<int> vSrc;
+      for (int i = 0; i < 100; i++)
+         vSrc.push_back(i * i);
+      write(vSrc);
+      custom::vector<int> vDest;
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::load(file, vDest);
+      }
+      // verify
+      assertUnit(vDest.size() == 100);
+      assertUnit(vDest[0] == 0);
+      assertUnit(vDest[99] == 9801);
+      std::remove(path());
+   }  // teardown
+
+   // a set is searched in place
+   void test_setView_find()
+   {  // setup
+      custom::set<int> s;
+      for (int i = 0; i < 1000; i++)
+         s.insert((i * 7919) % 1000 * 2);
+      write(s);
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::set_view<int> view(file);
+         // verify
+         assertUnit(view.size() == 1000);
+         assertUnit(!view.empty());
+         assertUnit((const void*)view.begin() == file.data() + 40);
+         assertUnit(view[0] == 0);
+         assertUnit(view[999] == 1998);
+         assertUnit(view.contains(1000));
+         assertUnit(!view.contains(1001));
+         assertUnit(view.find(1001) == view.end());
+         assertUnit(*view.lower_bound(1001) == 1002);
+         assertUnit(view.lower_bound(5000) == view.end());
+      }
+      std::remove(path());
+   }  // teardown
+
+   // a damaged file is caught, unless asked not to look
+   void test_setView_corrupt()
+   {  // setup
+      custom::set<int> s{ 1, 2, 3 };
+      std::stringstream ss;
+      custom::save(ss, s);
+      std::string bytes = ss.str();
+      bytes[44] = 9;
+      {
+         std::ofstream fout(path(), std::ios::binary);
+         fout.write(bytes.data(), bytes.size());
+      }
+      std::string message;
+      // exercise
+      {
+         custom::mapped_file file(path());
+         try
+         {
+            custom::set_view<int> view(file);
+         }
+         catch (const std::runtime_error& error)
+         {
+            message = error.what();
+         }
+         custom::set_view<int> unchecked(file, false /*verify*/);
+         // verify
+         assertUnit(unchecked[1] == 9);
+      }
+      assertUnit(message == "custom::load: checksum does not match");
+      std::remove(path());
+   }  // teardown
+
+   // a map is searched in place
+   void test_mapView_find()
+   {  // setup
+      custom::map<int, double> m;
+      for (int i = 0; i < 100; i++)
+         m[i * 10] = i / 4.0;
+      write(m);
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::map_view<int, double> view(file);
+         // verify
+         assertUnit(view.size() == 100);
+         assertUnit(view.contains(420));
+         assertUnit(!view.contains(425));
+         assertUnit(view.at(420) == 10.5);
+         auto it = view.find(990);
+         assertUnit(it != view.end());
+         assertUnit(it.key() == 990);
+         assertUnit(it.value() == 24.75);
+         assertUnit((*it).second == 24.75);
+         assertUnit((const void*)view.keys() == file.data() + 40);
+         assertUnit((const void*)view.values() == file.data() + 440);
+      }
+      std::remove(path());
+   }  // teardown
+
+   // a missing key throws, like map::at
+   void test_mapView_at_throw()
+   {  // setup
+      custom::map<int, int> m;
+      m[1] = 2;
+      write(m);
+      std::string message;
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::map_view<int, int> view(file);
+         try
+         {
+            view.at(2);
+         }
+         catch (const std::out_of_range& error)
+         {
+            message = error.what();
+         }
+      }
+      // verify
+      assertUnit(message == "invalid map<K, T> key");
+      std::remove(path());
+   }  // teardown
+
+   // the pairs come out in key order
+   void test_mapView_iterate()
+   {  // setup
+      custom::map<int, int> m;
+      m[30] = 3;
+      m[10] = 1;
+      m[20] = 2;
+      write(m);
+      std::vector<int> keys;
+      std::vector<int> values;
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::map_view<int, int> view(file);
+         for (auto it = view.begin(); it != view.end(); it++)
+         {
+            keys.push_back((*it).first);
+            values.push_back((*it).second);
+         }
+      }
+      // verify
+      assertUnit(keys == std::vector<int>({ 10, 20, 30 }));
+      assertUnit(values == std::vector<int>({ 1, 2, 3 }));
+      std::remove(path());
+   }  // teardown
+
+   // a large set saved in order loads in O(n)
+   void test_mapped_loadSet()
+   {  // setup
+      custom::vector<int> v;
+      for (int i = 0; i < 100000; i++)
+         v.push_back(i);
+      custom::set<int> sSrc;
+      sSrc.assign_sorted(&v[0], &v[0] + v.size());
+      write(sSrc);
+      custom::set<int> sDest{ -1 };
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::load(file, sDest);
+      }
+      // verify
+      assertUnit(sDest.size() == 100000);
+      assertUnit(sDest.find(-1) == sDest.end());
+      assertUnit(sDest.find(0) != sDest.end());
+      assertUnit(sDest.find(99999) != sDest.end());
+      assertUnit(*sDest.begin() == 0);
+      std::remove(path());
+   }  // teardown
+
+   // a map loads from a mapped file
+   void test_mapped_loadMap()
+   {  // setup
+      custom::map<int, int> mSrc;
+      for (int i = 0; i < 1000; i++)
+         mSrc[(i * 7919) % 1000] = i;
+      write(mSrc);
+      custom::map<int, int> mDest;
+      // exercise
+      {
+         custom::mapped_file file(path());
+         custom::load(file, mDest);
+      }
+      // verify
+      assertUnit(mDest.size() == 1000);
+      bool same = true;
+      for (int i = 0; i < 1000; i++)
+         same = same && mDest[(i * 7919) % 1000] == i;
+      assertUnit(same);
+      std::remove(path());
+   }  // teardown
+
+   /*************************************************************
+    * HELPERS
+    *************************************************************/
+
+   static const char* path() { return "testSerialize.tmp"; }
+
+   template <class Container>
+   static void write(const Container& c)
+   {
+      std::ofstream fout(path(), std::ios::binary);
+      custom::save(fout, c);
+   }
+
+   template <class Container>
+   static std::string loadError(std::istream& in, Container& c)
+   {
+      try
+      {
+         custom::load(in, c);
+      }
+      catch (const std::runtime_error& error)
+      {
+         return error.what();
+      }
+      return "";
+   }
+
+   template <class T>
+   static std::vector<T> elements(const custom::set<T>& s)
+   {
+      std::vector<T> v;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,628 @@
+/***********************************************************************
+ * Header:
+ *    TEST SKIP LIST
+ * Summary:
+ *    Unit tests for skiplist_set, skiplist_map, and
+ *    concurrent_skiplist_set
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "skiplist.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <atomic>
+#include <cstdlib>   // for rand
+#include <map>       // to check against
+#include <set>       // to check against
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestSkipList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Set
+      test_set_construct_default();
+      test_set_construct_initializerList();
+      test_set_constructCopy_independent();
+      test_set_constructMove_standard();
+      test_set_destructor_spy();
+      test_set_insert_duplicate();
+      test_set_insert_random();
+      test_set_find_standard();
+      test_set_lowerBound_gaps();
+      test_set_erase_key();
+      test_set_erase_iteratorNext();
+      test_set_erase_range();
+      test_set_clear_reuse();
+      test_set_pool_reuse();
+
+      // Map
+      test_map_subscript_insert();
+      test_map_at_throw();
+      test_map_insert_pair();
+      test_map_random();
+      test_map_string();
+
+      // Concurrent
+      test_concurrent_standard();
+      test_concurrent_lowerBound();
+      test_concurrent_insertDisjoint();
+      test_concurrent_insertSame();
+      test_concurrent_mixed();
+      test_concurrent_reclaim_spy();
+
+      report("SkipList");
+   }
+
+   using Set = custom::skiplist_set<int>;
+   using Map = custom::skiplist_map<int, int>;
+   using CSet = custom::concurrent_skiplist_set<int>;
+
+   /***************************************
+    * SET
+    ***************************************/
+
+   // empty has only the head
+   void test_set_construct_default()
+   {  // setup
+      // exercise
+      Set s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.list.level == 0);
+      assertUnit(s.list.head != nullptr);
+      assertUnit(s.list.head->next()[0] == nullptr);
+      assertUnit(s.begin() == s.end());
+      assertUnit(s.list.pool.pBlocks == nullptr);
+   }  // teardown
+
+   // initializer list comes out sorted, duplicates dropped
+   void test_set_construct_initializerList()
+   {  // setup
+      // exercise
+      Set s{ 50, 25, 75, 25, 10 };
+      // verify
+      assertUnit(s.size() == 4);
+      assertUnit(elements(s) == std::vector<int>({ 10, 25, 50, 75 }));
+      assertUnit(validate(s.list));
+   }  // teardown
+
+   // a copy has its own nodes
+   void test_set_constructCopy_independent()
+   {  // setup
+      Set sSrc;
+      for (int i = 0; i < 500; i++)
+         sSrc.insert(i * 3);
+      // exercise
+      Set sDest(sSrc);
+      sSrc.erase(3);
+      sDest.insert(1);
+      // verify
+      assertUnit(sDest.size() == 501);
+      assertUnit(sSrc.size() == 499);
+      assertUnit(sDest.find(3) != sDest.end());
+      assertUnit(sSrc.find(1) == sSrc.end());
+      assertUnit(validate(sDest.list));
+      assertUnit(validate(sSrc.list));
+   }  // teardown
+
+   // a move takes the nodes and leaves an empty list
+   void test_set_constructMove_standard()
+   {  // setup
+      Set sSrc{ 1, 2, 3 };
+      auto pFirst = sSrc.list.head->next()[0];
+      // exercise
+      Set sDest(std::move(sSrc));
+      // verify
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.list.head->next()[0] == pFirst);
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.begin() == sSrc.end());
+      sSrc.insert(7);
+      assertUnit(sSrc.size() == 1);
+   }  // teardown
+
+   // every element is destroyed
+   void test_set_destructor_spy()
+   {  // setup
+      Spy::reset();
+      {
+         custom::skiplist_set<Spy> s;
+         for (int i = 0; i < 200; i++)
+            s.insert(Spy(i));
+         for (int i = 0; i < 200; i += 3)
+            s.erase(Spy(i));
+      }  // exercise
+      // verify
+      assertUnit(Spy::numAlloc() >= 200);
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+   // a duplicate changes nothing
+   void test_set_insert_duplicate()
+   {  // setup
+      Set s{ 10, 20, 30 };
+      // exercise
+      std::pair<Set::iterator, bool> result = s.insert(20);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == 20);
+      assertUnit(s.size() == 3);
+   }  // teardown
+
+   // random inserts stay sorted and each level is a sublist of the one below
+   void test_set_insert_random()
+   {  // setup
+      Set s;
+      std::set<int> check;
+      srand(38);
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         int value = rand() % 5000;
+         assertUnit(s.insert(value).second == check.insert(value).second);
+      }
+      // verify
+      assertUnit(s.size() == check.size());
+      assertUnit(elements(s) == std::vector<int>(check.begin(), check.end()));
+      assertUnit(validate(s.list));
+      assertUnit(s.list.level >= 4);   // about log4(3000) levels
+   }  // teardown
+
+   // find a present and a missing value
+   void test_set_find_standard()
+   {  // setup
+      Set s{ 50, 25, 75, 10, 30 };
+      // exercise
+      Set::iterator it = s.find(30);
+      Set::iterator itMissing = s.find(31);
+      // verify
+      assertUnit(it != s.end());
+      assertUnit(*it == 30);
+      assertUnit(itMissing == s.end());
+   }  // teardown
+
+   // lower bound lands on the next value up
+   void test_set_lowerBound_gaps()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 1000; i += 10)
+         s.insert(i);
+      bool ok = true;
+      // exercise
+      for (int i = 0; i <= 990; i++)
+      {
+         Set::iterator it = s.lower_bound(i);
+         ok = ok && it != s.end() && *it == (i + 9) / 10 * 10;
+      }
+      // verify
+      assertUnit(ok);
+      assertUnit(s.lower_bound(991) == s.end());
+   }  // teardown
+
+   // erase by key
+   void test_set_erase_key()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      size_t count = s.erase(50);
+      size_t countMissing = s.erase(50);
+      // verify
+      assertUnit(count == 1);
+      assertUnit(countMissing == 0);
+      assertUnit(s.size() == 99);
+      assertUnit(s.find(50) == s.end());
+      assertUnit(validate(s.list));
+   }  // teardown
+
+   // erase by iterator returns the one after
+   void test_set_erase_iteratorNext()
+   {  // setup
+      Set s{ 10, 20, 30, 40 };
+      // exercise
+      Set::iterator it = s.erase(s.find(20));
+      Set::iterator itEnd = s.erase(s.find(40));
+      // verify
+      assertUnit(*it == 30);
+      assertUnit(itEnd == s.end());
+      assertUnit(elements(s) == std::vector<int>({ 10, 30 }));
+   }  // teardown
+
+   // erase a range with one search
+   void test_set_erase_range()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 1000; i++)
+         s.insert(i);
+      // exercise
+      Set::iterator it = s.erase(s.lower_bound(100), s.lower_bound(900));
+      // verify
+      assertUnit(*it == 900);
+      assertUnit(s.size() == 200);
+      assertUnit(*(++s.lower_bound(99)) == 900);
+      assertUnit(validate(s.list));
+   }  // teardown
+
+   // clear gives the blocks back and the list still works
+   void test_set_clear_reuse()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 5000; i++)
+         s.insert(i);
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.list.level == 0);
+      assertUnit(s.list.pool.pBlocks == nullptr);
+      s.insert(5);
+      assertUnit(elements(s) == std::vector<int>({ 5 }));
+   }  // teardown
+
+   // a freed node goes to the next node of its height
+   void test_set_pool_reuse()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i * 2);
+      Set::iterator it = s.find(50);
+      const void* pFreed = it.pNode;
+      size_t height = it.pNode->height;
+      s.erase(50);
+      // exercise
+      bool reused = false;
+      for (int i = 1; i < 2000 && !reused; i += 2)
+      {
+         Set::iterator itNew = s.insert(i).first;
+         if (itNew.pNode->height == height)
+            reused = (itNew.pNode == pFreed);
+      }
+      // verify
+      assertUnit(reused);
+      assertUnit(validate(s.list));
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // the subscript adds a default value
+   void test_map_subscript_insert()
+   {  // setup
+      Map m;
+      // exercise
+      m[5] = 50;
+      int value = m[6];
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit(m.at(5) == 50);
+      assertUnit(value == 0);
+   }  // teardown
+
+   // at throws on a missing key
+   void test_map_at_throw()
+   {  // setup
+      Map m{ {1, 10}, {2, 20} };
+      const Map& mConst = m;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         mConst.at(3);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(mConst.at(2) == 20);
+   }  // teardown
+
+   // insert returns where the key is and whether it is new
+   void test_map_insert_pair()
+   {  // setup
+      Map m{ {1, 10} };
+      // exercise
+      custom::pair<Map::iterator, bool> result = m.insert(custom::pair<int, int>(2, 20));
+      custom::pair<Map::iterator, bool> resultOld = m.insert(custom::pair<int, int>(1, 99));
+      // verify
+      assertUnit(result.second);
+      assertUnit(result.first->second == 20);
+      assertUnit(!resultOld.second);
+      assertUnit(resultOld.first->second == 10);
+   }  // teardown
+
+   // many random changes agree with std::map
+   void test_map_random()
+   {  // setup
+      Map m;
+      std::map<int, int> check;
+      srand(83);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         int k = rand() % 700;
+         if (rand() % 3)
+         {
+            m[k] = i;
+            check[k] = i;
+         }
+         else
+            assertUnit(m.erase(k) == check.erase(k));
+      }
+      // verify
+      assertUnit(m.size() == check.size());
+      std::map<int, int>::iterator itCheck = check.begin();
+      bool same = true;
+      for (Map::iterator it = m.begin(); it != m.end(); ++it, ++itCheck)
+         same = same && it->first == itCheck->first && it->second == itCheck->second;
+      assertUnit(same);
+      assertUnit(validate(m.list));
+   }  // teardown
+
+   // keys and values that own memory
+   void test_map_string()
+   {  // setup
+      custom::skiplist_map<std::string, std::string> m;
+      // exercise
+      m["banana"] = "yellow";
+      m["apple"] = "red";
+      m["cherry"] = "dark red";
+      m.erase("banana");
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit(m.begin()->first == "apple");
+      assertUnit(m.at("cherry") == "dark red");
+   }  // teardown
+
+   /***************************************
+    * CONCURRENT
+    ***************************************/
+
+   // one thread: insert, find, erase, iterate
+   void test_concurrent_standard()
+   {  // setup
+      CSet s{ 50, 25, 75, 25, 10 };
+      // exercise
+      bool inserted = s.insert(30);
+      bool duplicate = s.insert(50);
+      size_t erased = s.erase(25);
+      size_t missing = s.erase(26);
+      // verify
+      assertUnit(inserted);
+      assertUnit(!duplicate);
+      assertUnit(erased == 1);
+      assertUnit(missing == 0);
+      assertUnit(s.size() == 4);
+      assertUnit(s.contains(30));
+      assertUnit(!s.contains(25));
+      assertUnit(*s.find(75) == 75);
+      assertUnit(elements(s) == std::vector<int>({ 10, 30, 50, 75 }));
+   }  // teardown
+
+   // lower bound steps over erased values
+   void test_concurrent_lowerBound()
+   {  // setup
+      CSet s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      for (int i = 40; i < 60; i++)
+         s.erase(i);
+      // exercise
+      CSet::iterator it = s.lower_bound(45);
+      // verify
+      assertUnit(it != s.end());
+      assertUnit(*it == 60);
+      assertUnit(s.lower_bound(100) == s.end());
+   }  // teardown
+
+   // threads inserting their own values all land, in order
+   void test_concurrent_insertDisjoint()
+   {  // setup
+      CSet s;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&s, t]()
+            {
+               for (int i = t; i < 8000; i += 4)
+                  s.insert(i);
+            }));
+      for (std::thread& thread : threads)
+         thread.join();
+      // verify
+      assertUnit(s.size() == 8000);
+      std::vector<int> values = elements(s);
+      bool sorted = values.size() == 8000;
+      for (size_t i = 0; sorted && i < values.size(); i++)
+         sorted = values[i] == (int)i;
+      assertUnit(sorted);
+      assertUnit(validateConcurrent(s));
+   }  // teardown
+
+   // threads racing on the same values: each goes in exactly once
+   void test_concurrent_insertSame()
+   {  // setup
+      CSet s;
+      std::atomic<int> wins(0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&s, &wins]()
+            {
+               for (int i = 0; i < 2000; i++)
+                  if (s.insert(i))
+                     wins++;
+            }));
+      for (std::thread& thread : threads)
+         thread.join();
+      // verify
+      assertUnit(wins == 2000);
+      assertUnit(s.size() == 2000);
+      assertUnit(validateConcurrent(s));
+   }  // teardown
+
+   // inserts, erases, lookups, and scans all at once
+   void test_concurrent_mixed()
+   {  // setup
+      CSet s;
+      for (int i = 0; i < 4000; i += 2)
+         s.insert(i);     // the evens stay put the whole time
+      std::atomic<bool> done(false);
+      std::atomic<int> bad(0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 2; t++)
+         threads.push_back(std::thread([&s, &done, &bad]()
+            {
+               while (!done.load())
+               {
+                  int previous = -1;
+                  int evens = 0;
+                  for (CSet::iterator it = s.begin(); it != s.end(); ++it)
+                  {
+                     if (*it <= previous)
+                        bad++;
+                     evens += (*it % 2 == 0);
+                     previous = *it;
+                  }
+                  if (evens != 2000 || !s.contains(1000))
+                     bad++;
+               }
+            }));
+      for (int w = 0; w < 3; w++)
+         threads.push_back(std::thread([&s, w]()
+            {
+               for (int pass = 0; pass < 3; pass++)
+               {
+                  for (int i = 1 + 2 * w; i < 4000; i += 6)
+                     s.insert(i);
+                  for (int i = 1 + 2 * w; i < 4000; i += 6)
+                     s.erase(i);
+               }
+               for (int i = 1 + 2 * w; i < 4000; i += 12)
+                  s.insert(i);
+            }));
+      for (int w = 2; w < 5; w++)
+         threads[w].join();
+      done = true;
+      threads[0].join();
+      threads[1].join();
+      // verify
+      assertUnit(bad == 0);
+      int odds = 0;
+      for (int i = 1; i < 4000; i += 2)
+         odds += s.contains(i);
+      assertUnit(odds == 334 + 334 + 333);   // what each writer left behind
+      assertUnit(s.size() == 2000 + 1001);
+      s.reclaim();
+      assertUnit(validateConcurrent(s));
+   }  // teardown
+
+   // erased values wait for reclaim, and nothing leaks
+   void test_concurrent_reclaim_spy()
+   {  // setup
+      Spy::reset();
+      {
+         custom::concurrent_skiplist_set<Spy> s;
+         for (int i = 0; i < 100; i++)
+            s.insert(Spy(i));
+         for (int i = 0; i < 100; i += 2)
+            s.erase(Spy(i));
+         int alive = Spy::numAlloc() - Spy::numDelete();
+         // exercise
+         s.reclaim();
+         // verify
+         assertUnit(alive == 100);
+         assertUnit(Spy::numAlloc() - Spy::numDelete() == 50);
+         assertUnit(s.pRetired.load() == nullptr);
+         assertUnit(s.size() == 50);
+      }
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+   /*************************************************************
+    * ELEMENTS
+    * Everything in a container, in order
+    *************************************************************/
+   template <class S>
+   std::vector<int> elements(const S& s)
+   {
+      std::vector<int> values;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         values.push_back(*it);
+      return values;
+   }
+
+   /*************************************************************
+    * VALIDATE
+    * Every level is sorted and holds exactly the nodes tall enough
+    * for it, and the bottom one holds size() of them
+    *************************************************************/
+   template <class List>
+   bool validate(const List& list)
+   {
+      size_t count = 0;
+      for (auto p = list.head->next()[0]; p; p = p->next()[0])
+      {
+         count++;
+         if (p->next()[0] && !(keyOf(*p->data()) < keyOf(*p->next()[0]->data())))
+            return false;
+      }
+      if (count != list.size())
+         return false;
+      for (size_t i = 1; i < List::maxLevel; i++)
+      {
+         auto pAbove = list.head->next()[i];
+         for (auto p = list.head->next()[0]; p; p = p->next()[0])
+            if (p->height > i)
+            {
+               if (pAbove != p)
+                  return false;
+               pAbove = p->next()[i];
+            }
+         if (pAbove != nullptr || (i >= list.level && list.head->next()[i]))
+            return false;
+      }
+      return true;
+   }
+   static int keyOf(int value) { return value; }
+   template <class K, class V>
+   static const K& keyOf(const custom::pair<K, V>& element) { return element.first; }
+
+   /*************************************************************
+    * VALIDATE CONCURRENT
+    * The bottom level, not counting marked nodes, is sorted and
+    * holds size() of them
+    *************************************************************/
+   template <class S>
+   bool validateConcurrent(const S& s)
+   {
+      size_t count = 0;
+      for (auto p = S::ptr(s.head->next()[0].load()); p; p = S::ptr(p->next()[0].load()))
+      {
+         if (S::marked(p->next()[0].load()))
+            continue;
+         count++;
+         auto pNext = S::ptr(p->next()[0].load());
+         if (pNext && !(p->key() < pNext->key()))
+            return false;
+      }
+      return count == s.size();
+   }
+};
+
+#endif // DEBUG
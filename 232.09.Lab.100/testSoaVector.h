@@ -0,0 +1,429 @@
+/***********************************************************************
+ * Header:
+ *    TEST SOA VECTOR
+ * Summary:
+ *    Unit tests for soa_vector and pair_vector
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "soa_vector.h"
+#include "pair.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <functional>  // for std::greater
+#include <string>      // a third column type
+
+class TestSoaVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_assign_standard();
+      test_destructor_standard();
+
+      // Insert
+      test_pushBack_values();
+      test_pushBack_pair();
+      test_emplaceBack_spy();
+      test_reserve_moves();
+
+      // Access
+      test_subscript_writeThrough();
+      test_get_standard();
+      test_column_separate();
+      test_column_sum();
+      test_iterator_standard();
+
+      // Remove
+      test_popBack_standard();
+      test_clear_standard();
+
+      // Sort
+      test_sortBy_key();
+      test_sortBy_valueGreater();
+      test_sortBy_threeColumns();
+
+      report("SoaVector");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing allocated until the first row
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::pair_vector<int, Spy> v;
+      // verify
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 0);
+      assertUnit(v.empty());
+      assertUnit(v.data<0>() == nullptr);
+      assertUnit(v.data<1>() == nullptr);
+   }  // teardown
+
+   // copy gets its own buffers of exactly the right size
+   void test_constructCopy_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> vSrc;
+      setupStandardFixture(vSrc);
+      Spy::reset();
+      // exercise
+      custom::pair_vector<int, Spy> vDest(vSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 4);    // copy [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);
+      assertUnit(vDest.capacity() == 4);
+      assertUnit(vDest.data<0>() != vSrc.data<0>());
+      assertStandardFixture(vSrc);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   // move steals the buffers
+   void test_constructMove_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> vSrc;
+      setupStandardFixture(vSrc);
+      Spy * p = vSrc.data<1>();
+      Spy::reset();
+      // exercise
+      custom::pair_vector<int, Spy> vDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(vDest.data<1>() == p);
+      assertUnit(vSrc.empty());
+      assertUnit(vSrc.data<1>() == nullptr);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   // assignment replaces every column
+   void test_assign_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> vSrc;
+      setupStandardFixture(vSrc);
+      custom::pair_vector<int, Spy> vDest;
+      vDest.push_back(11, Spy(11));
+      // exercise
+      vDest = vSrc;
+      // verify
+      assertStandardFixture(vSrc);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   // the destructor destroys every row and frees every column
+   void test_destructor_standard()
+   {  // setup
+      {
+         custom::pair_vector<int, Spy> v;
+         setupStandardFixture(v);
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // one value per column
+   void test_pushBack_values()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      Spy s(99);
+      Spy::reset();
+      // exercise
+      v.push_back(99, s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);   // copy [99]
+      assertUnit(v.size() == 1);
+      assertUnit(v.capacity() == 1);
+      assertUnit(v.get<0>(0) == 99);
+      assertUnit(v.get<1>(0) == Spy(99));
+   }  // teardown
+
+   // a custom::pair is split into its two columns
+   void test_pushBack_pair()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      custom::pair<int, Spy> p(26, Spy(49));
+      // exercise
+      v.push_back(p);
+      // verify
+      assertUnit(v.size() == 1);
+      assertUnit(v.get<0>(0) == 26);
+      assertUnit(v.get<1>(0) == Spy(49));
+   }  // teardown
+
+   // emplace builds each field in place
+   void test_emplaceBack_spy()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      Spy::reset();
+      // exercise
+      v.emplace_back(26, 49);
+      // verify
+      assertUnit(Spy::numNondefault() == 1); // create [49]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(v.get<1>(0) == Spy(49));
+   }  // teardown
+
+   // growing moves each column, it does not copy
+   void test_reserve_moves()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.reserve(10);
+      // verify
+      assertUnit(Spy::numCopyMove() == 4);   // move    [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 4); // destroy the empty husks
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(v.capacity() == 10);
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // a row is references into the columns
+   void test_subscript_writeThrough()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      // exercise
+      std::get<0>(v[2]) = 11;
+      std::get<1>(v[2]) = Spy(11);
+      // verify
+      assertUnit(v.get<0>(2) == 11);
+      assertUnit(v.get<1>(2) == Spy(11));
+      assertUnit(std::get<0>(v.front()) == 26);
+      assertUnit(std::get<0>(v.back()) == 89);
+   }  // teardown
+
+   // get reaches one field of one row
+   void test_get_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      // exercise
+      v.get<1>(3) = Spy(11);
+      // verify
+      assertUnit(v.get<0>(3) == 89);
+      assertUnit(v.get<1>(3) == Spy(11));
+   }  // teardown
+
+   // each column is its own contiguous buffer
+   void test_column_separate()
+   {  // setup
+      custom::pair_vector<int, double> v;
+      v.push_back(26, 2.6);
+      v.push_back(49, 4.9);
+      v.push_back(67, 6.7);
+      // exercise
+      auto keys = v.column<0>();
+      auto values = v.column<1>();
+      // verify
+      assertUnit(keys.size() == 3);
+      assertUnit(&keys[1] == &keys[0] + 1);
+      assertUnit(&values[2] == &values[0] + 2);
+      assertUnit((void *)keys.data() != (void *)values.data());
+      assertUnit(keys.data() == v.data<0>());
+   }  // teardown
+
+   // a key-only loop over a column view
+   void test_column_sum()
+   {  // setup
+      custom::pair_vector<int, std::string> v;
+      for (int i = 1; i <= 100; i++)
+         v.push_back(i, std::string("value"));
+      // exercise
+      long total = 0;
+      for (int key : v.column<0>())
+         total += key;
+      // verify
+      assertUnit(total == 5050);
+   }  // teardown
+
+   // the iterator visits the rows in order
+   void test_iterator_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      int keys[4] = { 0 };
+      int i = 0;
+      // exercise
+      for (auto it = v.begin(); it != v.end(); ++it)
+      {
+         keys[i++] = std::get<0>(*it);
+         std::get<1>(*it) = Spy(std::get<0>(*it) + 1);
+      }
+      // verify
+      assertUnit(i == 4);
+      assertUnit(keys[0] == 26);
+      assertUnit(keys[3] == 89);
+      assertUnit(v.get<1>(0) == Spy(27));
+      assertUnit(v.end() - v.begin() == 4);
+      assertUnit(v.begin() + 4 == v.end());
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop destroys the last row in every column
+   void test_popBack_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 1); // destroy [89]
+      assertUnit(v.size() == 3);
+      assertUnit(v.capacity() == 4);
+      assertUnit(std::get<0>(v.back()) == 67);
+   }  // teardown
+
+   // clear keeps the buffers
+   void test_clear_standard()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 4); // destroy [26,49,67,89]
+      assertUnit(v.empty());
+      assertUnit(v.capacity() == 4);
+   }  // teardown
+
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // rows move together when sorted by key
+   void test_sortBy_key()
+   {  // setup
+      custom::pair_vector<int, Spy> v;
+      v.push_back(67, Spy(6));
+      v.push_back(26, Spy(2));
+      v.push_back(89, Spy(8));
+      v.push_back(49, Spy(4));
+      Spy::reset();
+      // exercise
+      v.sort_by<0>();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);   // the Spy column is never compared
+      assertUnit(Spy::numCopy() == 0);
+      assertStandardFixtureValues(v, 2, 4, 6, 8);
+   }  // teardown
+
+   // sort by the second column with a different comparison
+   void test_sortBy_valueGreater()
+   {  // setup
+      custom::pair_vector<int, double> v;
+      v.push_back(1, 2.5);
+      v.push_back(2, 9.0);
+      v.push_back(3, -1.0);
+      // exercise
+      v.sort_by<1>(std::greater<double>());
+      // verify
+      assertUnit(v.get<0>(0) == 2);
+      assertUnit(v.get<0>(1) == 1);
+      assertUnit(v.get<0>(2) == 3);
+      assertUnit(v.get<1>(2) == -1.0);
+   }  // teardown
+
+   // any number of columns
+   void test_sortBy_threeColumns()
+   {  // setup
+      custom::soa_vector<std::string, int, char> v;
+      v.push_back(std::string("pear"), 3, 'p');
+      v.push_back(std::string("apple"), 1, 'a');
+      v.push_back(std::string("fig"), 2, 'f');
+      // exercise
+      v.sort_by<0>();
+      // verify
+      assertUnit(v.get<0>(0) == "apple");
+      assertUnit(v.get<1>(0) == 1);
+      assertUnit(v.get<2>(1) == 'f');
+      assertUnit(v.get<2>(2) == 'p');
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |   keys
+    *    +----+----+----+----+
+    *    | 26 | 49 | 67 | 89 |   values
+    *    +----+----+----+----+
+    *************************************************************/
+   void setupStandardFixture(custom::pair_vector<int, Spy>& v)
+   {
+      v.reserve(4);
+      v.push_back(26, Spy(26));
+      v.push_back(49, Spy(49));
+      v.push_back(67, Spy(67));
+      v.push_back(89, Spy(89));
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::pair_vector<int, Spy>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 4);
+      if (v.size() == 4)
+      {
+         assertIndirect(v.get<0>(0) == 26);
+         assertIndirect(v.get<0>(1) == 49);
+         assertIndirect(v.get<0>(2) == 67);
+         assertIndirect(v.get<0>(3) == 89);
+         assertIndirect(v.get<1>(0) == Spy(26));
+         assertIndirect(v.get<1>(1) == Spy(49));
+         assertIndirect(v.get<1>(2) == Spy(67));
+         assertIndirect(v.get<1>(3) == Spy(89));
+      }
+   }
+
+   // the standard keys with the given values
+   void assertStandardFixtureValues(const custom::pair_vector<int, Spy>& v,
+                                    int v0, int v1, int v2, int v3)
+   {
+      assertUnit(v.size() == 4);
+      if (v.size() == 4)
+      {
+         assertUnit(v.get<0>(0) == 26);
+         assertUnit(v.get<0>(1) == 49);
+         assertUnit(v.get<0>(2) == 67);
+         assertUnit(v.get<0>(3) == 89);
+         assertUnit(v.get<1>(0) == Spy(v0));
+         assertUnit(v.get<1>(1) == Spy(v1));
+         assertUnit(v.get<1>(2) == Spy(v2));
+         assertUnit(v.get<1>(3) == Spy(v3));
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,545 @@
+/***********************************************************************
+ * Header:
+ *    TEST SPLAY TREE
+ * Summary:
+ *    Unit tests for SplayTree, splay_set, and splay_map
+ * Author
+ *    Br. Helfrich
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#include "splay_tree.h"
+#include "set.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cstdlib>   // for rand
+#include <functional> // for std::greater
+#include <set>       // to check against
+#include <map>       // to check against
+#include <string>
+#include <vector>
+
+class TestSplayTree : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Set: construct
+      test_set_construct_default();
+      test_set_construct_initializerList();
+      test_set_constructCopy_independent();
+      test_set_constructMove_standard();
+      test_set_destructor_spy();
+
+      // Set: insert
+      test_set_insert_becomesRoot();
+      test_set_insert_duplicate();
+      test_set_insert_compareGreater();
+      test_set_insert_ascendingChain();
+
+      // Set: access
+      test_set_find_splays();
+      test_set_find_missing();
+      test_set_find_foldsChain();
+      test_set_find_skewed();
+      test_set_iterate_backward();
+
+      // Set: remove
+      test_set_erase_root();
+      test_set_erase_iterator();
+      test_set_erase_range();
+      test_set_erase_random();
+
+      // Map
+      test_map_subscript();
+      test_map_at_throw();
+      test_map_atConst_noSplay();
+      test_map_string();
+
+      report("SplayTree");
+   }
+
+   using Set = custom::splay_set<int>;
+   using Map = custom::splay_map<int, int>;
+
+   /***************************************
+    * SET : CONSTRUCT
+    ***************************************/
+
+   // nothing is allocated until something is inserted
+   void test_set_construct_default()
+   {  // setup
+      // exercise
+      Set s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.tree.pRoot == nullptr);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+   // an initializer list is sorted and made unique
+   void test_set_construct_initializerList()
+   {  // setup
+      // exercise
+      Set s{ 50, 30, 70, 30, 20, 40, 60, 80 };
+      // verify
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // a copy has its own nodes
+   void test_set_constructCopy_independent()
+   {  // setup
+      Set sSrc;
+      for (int i = 0; i < 100; i++)
+         sSrc.insert((i * 37) % 100);
+      // exercise
+      Set sDest(sSrc);
+      // verify
+      assertUnit(validate(sDest.tree));
+      assertUnit(contents(sDest) == contents(sSrc));
+      sDest.erase(0);
+      assertUnit(sSrc.find(0) != sSrc.end());
+      assertUnit(sDest.find(0) == sDest.end());
+      assertUnit(validate(sSrc.tree));
+      assertUnit(sSrc.size() == 100);
+      assertUnit(sDest.size() == 99);
+   }  // teardown
+
+   // a move takes the nodes and leaves the source empty
+   void test_set_constructMove_standard()
+   {  // setup
+      Set sSrc{ 50, 30, 70 };
+      // exercise
+      Set sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.tree.pRoot == nullptr);
+      assertUnit(sSrc.begin() == sSrc.end());
+      assertUnit(contents(sDest) == std::vector<int>({ 30, 50, 70 }));
+   }  // teardown
+
+   // every element is destroyed with the set
+   void test_set_destructor_spy()
+   {  // setup
+      {
+         custom::splay_set<Spy> s;
+         for (int i = 0; i < 20; i++)
+            s.insert(Spy(i * 7 % 20));
+         s.find(Spy(5));
+         Spy::reset();
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 20);
+   }  // teardown
+
+   /***************************************
+    * SET : INSERT
+    ***************************************/
+
+   // whatever goes in last is at the root
+   void test_set_insert_becomesRoot()
+   {  // setup
+      Set s;
+      bool atRoot = true;
+      // exercise
+      for (int i : { 50, 30, 70, 20, 40, 60, 80 })
+      {
+         auto pairReturn = s.insert(i);
+         atRoot = atRoot && pairReturn.second && s.tree.pRoot->data == i &&
+            pairReturn.first.pNode == s.tree.pRoot;
+      }
+      // verify
+      assertUnit(atRoot);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // a duplicate is found and splayed, not added
+   void test_set_insert_duplicate()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto pairReturn = s.insert(40);
+      // verify
+      assertUnit(!pairReturn.second);
+      assertUnit(*pairReturn.first == 40);
+      assertUnit(s.tree.pRoot->data == 40);
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // the comparison decides the order
+   void test_set_insert_compareGreater()
+   {  // setup
+      custom::splay_set<int, std::greater<int>> s;
+      // exercise
+      s.insert({ 50, 30, 70, 20, 40 });
+      // verify
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 70, 50, 40, 30, 20 }));
+   }  // teardown
+
+   // in order, each insert is one step, and the chain is freed without recursion
+   void test_set_insert_ascendingChain()
+   {  // setup
+      custom::splay_set<Spy> s;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 100000; i++)
+         s.insert(Spy(i));
+      // verify
+      assertUnit(Spy::numLessthan() <= 4 * 100000);
+      assertUnit(s.size() == 100000);
+      assertUnit(s.tree.pRoot->data == Spy(99999));
+      assertUnit(s.tree.pRoot->pRight == nullptr);
+   }  // teardown
+
+   /***************************************
+    * SET : ACCESS
+    ***************************************/
+
+   // what is found moves to the root, and the order does not change
+   void test_set_find_splays()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      bool atRoot = true;
+      bool valid = true;
+      // exercise
+      for (int i : { 20, 80, 50, 60, 30, 70, 40 })
+      {
+         auto it = s.find(i);
+         atRoot = atRoot && it != s.end() && *it == i && it.pNode == s.tree.pRoot;
+         valid = valid && validate(s.tree);
+      }
+      // verify
+      assertUnit(atRoot);
+      assertUnit(valid);
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // a missing key brings up a neighbour of where it would be
+   void test_set_find_missing()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto it = s.find(45);
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(s.tree.pRoot->data == 40 || s.tree.pRoot->data == 50);
+      assertUnit(s.size() == 7);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // finding the bottom of a long chain halves its depth
+   void test_set_find_foldsChain()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 1024; i++)
+         s.insert(i);                     // a chain down the left side
+      // exercise
+      s.find(0);
+      // verify
+      assertUnit(s.tree.pRoot->data == 0);
+      assertUnit(depth(s.tree) <= 1024 / 2 + 2);
+      assertUnit(validate(s.tree));
+   }  // teardown
+
+   // with nine lookups in ten on four keys, those keys stay near the top
+   void test_set_find_skewed()
+   {  // setup
+      custom::set<Spy> sPlain;
+      custom::splay_set<Spy> sSplay;
+      for (int i = 0; i < 1023; i++)
+      {
+         sPlain.insert(Spy(i * 389 % 1023));
+         sSplay.insert(Spy(i * 389 % 1023));
+      }
+      std::vector<Spy> lookups;
+      for (int i = 0; i < 10000; i++)
+         lookups.push_back(Spy(i % 10 == 0 ? i * 97 % 1023 : i % 4 * 255 + 1));
+      // exercise
+      Spy::reset();
+      for (const Spy& spy : lookups)
+         sPlain.find(spy);
+      int numPlain = Spy::numLessthan();
+      Spy::reset();
+      for (const Spy& spy : lookups)
+         sSplay.find(spy);
+      int numSplay = Spy::numLessthan();
+      // verify
+      assertUnit(numSplay < numPlain);
+      assertUnit(validate(sSplay.tree));
+   }  // teardown
+
+   // backward from the end, without splaying
+   void test_set_iterate_backward()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      s.find(60);
+      std::vector<int> v;
+      // exercise
+      for (auto it = s.end(); it != s.begin(); )
+         v.push_back(*--it);
+      // verify
+      assertUnit(v == std::vector<int>({ 80, 70, 60, 50, 40, 30, 20 }));
+      assertUnit(s.tree.pRoot->data == 60);
+   }  // teardown
+
+   /***************************************
+    * SET : REMOVE
+    ***************************************/
+
+   // the root comes out and the largest smaller key takes its place
+   void test_set_erase_root()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      s.find(50);
+      // exercise
+      size_t count = s.erase(50);
+      // verify
+      assertUnit(count == 1);
+      assertUnit(s.tree.pRoot->data == 40);
+      assertUnit(s.erase(50) == 0);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 30, 40, 60, 70, 80 }));
+   }  // teardown
+
+   // the iterator after the one erased stays good
+   void test_set_erase_iterator()
+   {  // setup
+      Set s{ 50, 30, 70, 20, 40, 60, 80 };
+      auto it = s.find(30);
+      s.find(70);
+      // exercise
+      auto itReturn = s.erase(it);
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 40);
+      assertUnit(s.size() == 6);
+      assertUnit(validate(s.tree));
+      assertUnit(contents(s) == std::vector<int>({ 20, 40, 50, 60, 70, 80 }));
+   }  // teardown
+
+   // everything from first up to last
+   void test_set_erase_range()
+   {  // setup
+      Set s;
+      for (int i = 0; i < 50; i++)
+         s.insert(i * 13 % 50);
+      // exercise
+      auto itReturn = s.erase(s.find(10), s.find(40));
+      // verify
+      assertUnit(itReturn != s.end() && *itReturn == 40);
+      assertUnit(s.size() == 20);
+      assertUnit(validate(s.tree));
+      std::vector<int> expected;
+      for (int i = 0; i < 50; i = (i == 9 ? 40 : i + 1))
+         expected.push_back(i);
+      assertUnit(contents(s) == expected);
+   }  // teardown
+
+   // agrees with std::set for a random mix of inserts, finds, and erases
+   void test_set_erase_random()
+   {  // setup
+      Set s;
+      std::set<int> reference;
+      bool same = true;
+      bool valid = true;
+      srand(11);
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         int value = rand() % 500;
+         switch (rand() % 3)
+         {
+         case 0:
+            same = same && s.insert(value).second == reference.insert(value).second;
+            break;
+         case 1:
+            same = same && s.erase(value) == reference.erase(value);
+            break;
+         default:
+            same = same && (s.find(value) == s.end()) == (reference.find(value) == reference.end());
+         }
+         if (i % 997 == 0)
+            valid = valid && validate(s.tree);
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(valid);
+      assertUnit(validate(s.tree));
+      assertUnit(s.size() == reference.size());
+      assertUnit(contents(s) == std::vector<int>(reference.begin(), reference.end()));
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // subscript inserts a default value, then updates it
+   void test_map_subscript()
+   {  // setup
+      Map m;
+      // exercise
+      int value = m[26];
+      m[26] = 5;
+      m[13] = 1;
+      // verify
+      assertUnit(value == 0);
+      assertUnit(m.size() == 2);
+      assertUnit(m.at(26) == 5);
+      assertUnit(m.tree.pRoot->data.first == 26);
+      assertUnit((*m.begin()).first == 13);
+   }  // teardown
+
+   // at() on a missing key throws
+   void test_map_at_throw()
+   {  // setup
+      Map m{ custom::pair<int, int>(1, 1) };
+      // exercise
+      try
+      {
+         m.at(2);
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range& error)
+      {
+         assertUnit(std::string(error.what()) == std::string("invalid map<K, T> key"));
+      }
+   }  // teardown
+
+   // a const map is searched, not rearranged
+   void test_map_atConst_noSplay()
+   {  // setup
+      Map m;
+      for (int i = 0; i < 10; i++)
+         m[i] = i * i;
+      const Map& mConst = m;
+      // exercise
+      int value = mConst.at(3);
+      // verify
+      assertUnit(value == 9);
+      assertUnit(m.tree.pRoot->data.first == 9);
+      assertUnit(validate(m.tree));
+   }  // teardown
+
+   // string keys and values
+   void test_map_string()
+   {  // setup
+      custom::splay_map<std::string, std::string> m;
+      std::map<std::string, std::string> reference;
+      // exercise
+      for (int i = 0; i < 200; i++)
+      {
+         std::string key = std::to_string((i * 71) % 200);
+         m[key] = key + "!";
+         reference[key] = key + "!";
+      }
+      for (int i = 0; i < 200; i += 3)
+      {
+         m.erase(std::to_string(i));
+         reference.erase(std::to_string(i));
+      }
+      // verify
+      assertUnit(m.size() == reference.size());
+      bool same = true;
+      auto itReference = reference.begin();
+      for (auto it = m.begin(); same && it != m.end(); ++it, ++itReference)
+         same = (*it).first == itReference->first && (*it).second == itReference->second;
+      assertUnit(same);
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * Everything in a set, in order
+    *************************************************************/
+   template <class Set>
+   std::vector<int> contents(const Set& s)
+   {
+      std::vector<int> v;
+      for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /*************************************************************
+    * DEPTH
+    * How many nodes are on the longest path down from the root
+    *************************************************************/
+   template <class Tree>
+   size_t depth(const Tree& tree)
+   {
+      size_t deepest = 0;
+      std::vector<std::pair<const typename Tree::Node*, size_t>> stack;
+      if (tree.pRoot)
+         stack.push_back({ tree.pRoot, 1 });
+      while (!stack.empty())
+      {
+         auto top = stack.back();
+         stack.pop_back();
+         deepest = top.second > deepest ? top.second : deepest;
+         if (top.first->pLeft)
+            stack.push_back({ top.first->pLeft, top.second + 1 });
+         if (top.first->pRight)
+            stack.push_back({ top.first->pRight, top.second + 1 });
+      }
+      return deepest;
+   }
+
+   /*************************************************************
+    * VALIDATE
+    * Every node is reached from the root exactly once, each
+    * child's parent link points back, and the keys are in order.
+    *************************************************************/
+   template <class Tree>
+   bool validate(const Tree& tree)
+   {
+      if (tree.pRoot == nullptr)
+         return tree.numElements == 0;
+      if (tree.pRoot->pParent != nullptr)
+         return false;
+
+      size_t count = 0;
+      std::vector<const typename Tree::Node*> stack{ tree.pRoot };
+      while (!stack.empty())
+      {
+         const typename Tree::Node* pNode = stack.back();
+         stack.pop_back();
+         if (++count > tree.numElements)
+            return false;
+         for (const typename Tree::Node* pChild : { pNode->pLeft, pNode->pRight })
+            if (pChild)
+            {
+               if (pChild->pParent != pNode)
+                  return false;
+               stack.push_back(pChild);
+            }
+      }
+      if (count != tree.numElements)
+         return false;
+
+      // in order means each key is less than the next
+      auto it = tree.begin();
+      for (auto itNext = it; ++itNext != tree.end(); it = itNext)
+         if (!tree.compare(keyOf(tree, *it), keyOf(tree, *itNext)))
+            return false;
+      return true;
+   }
+
+   template <class K, class T, class KeyOf, class Compare>
+   const K& keyOf(const custom::SplayTree<K, T, KeyOf, Compare>&, const T& t)
+   {
+      return KeyOf()(t);
+   }
+};
+
+#endif // DEBUG
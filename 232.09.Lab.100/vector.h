@@ -0,0 +1,559 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR
+ * Summary:
+ *    Our custom implementation of std::vector
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        vector                 : A class that represents a Vector
+ *        vector::iterator       : An interator through Vector
+ * Author
+ *    Emilio Ordonez, Austin Jesperson, Evan Riker
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <cstddef>  // for size_t
+#include <new>      // std::bad_alloc
+#include <memory>   // for std::allocator
+#include <utility>  // for std::move, std::forward
+#include <initializer_list>
+
+class TestVector; // forward declaration for unit tests
+class TestStack;
+class TestPQueue;
+class TestHash;
+
+namespace custom
+{
+
+/*****************************************
+ * VECTOR
+ * Just like the std :: vector <T> class
+ ****************************************/
+template <typename T, typename A = std::allocator<T>>
+class vector
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+   friend class ::TestHash;
+public:
+   
+   // 
+   // Construct
+   //
+
+   vector(const A & a = A());
+   vector(size_t numElements,                const A & a = A());
+   vector(size_t numElements, const T & t,   const A & a = A());
+   vector(const std::initializer_list<T>& l, const A & a = A());
+   vector(const vector &  rhs);
+   vector(      vector && rhs);
+  ~vector();
+
+   //
+   // Assign
+   //
+
+   void swap(vector& rhs)
+   {
+      std::swap(data,        rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
+   }
+   vector & operator = (const vector & rhs);
+   vector & operator = (vector&& rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator       begin() { return iterator(data);               }
+   iterator       end()   { return iterator(data + numElements); }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index);
+   const T& operator [] (size_t index) const;
+         T& front();
+   const T& front() const;
+         T& back();
+   const T& back() const;
+
+   //
+   // Insert
+   //
+
+   void push_back(const T& t);
+   void push_back(T&& t);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T& t);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      for (size_t i = 0; i < numElements; i++)
+         std::allocator_traits<A>::destroy(alloc, data + i);
+      numElements = 0;
+   }
+   void pop_back()
+   {
+      if (numElements > 0)
+         std::allocator_traits<A>::destroy(alloc, data + --numElements);
+   }
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements;      }
+   size_t  capacity()      const { return numCapacity;      }
+   bool empty()            const { return numElements == 0; }
+   
+private:
+
+   // move everything into a buffer of exactly newCapacity
+   void reallocate(size_t newCapacity);
+   // move everything into newData, which holds newCapacity
+   void adopt(T * newData, size_t newCapacity);
+   
+   A    alloc;                // use allocator for memory allocation
+   T *  data;                 // user data, a dynamically-allocated array
+   size_t  numCapacity;       // the capacity of the array
+   size_t  numElements;       // the number of items currently used
+};
+
+/**************************************************
+ * VECTOR ITERATOR
+ * An iterator through vector.  You only need to
+ * support the following:
+ *   1. Constructors (default and copy)
+ *   2. Not equals operator
+ *   3. Increment (prefix and postfix)
+ *   4. Dereference
+ * This particular iterator is a bi-directional meaning
+ * that ++ and -- both work.  Not all iterators are that way.
+ *************************************************/
+template <typename T, typename A>
+class vector <T, A> ::iterator
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+   friend class ::TestHash;
+public:
+   // constructors, destructors, and assignment operator
+   iterator()                              : p(nullptr)         { }
+   iterator(T* p)                          : p(p)               { }
+   iterator(const iterator& rhs)           : p(rhs.p)           { }
+   iterator(size_t index, vector<T, A>& v) : p(v.data + index)  { }
+   iterator& operator = (const iterator& rhs)
+   {
+      this->p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals operator
+   bool operator != (const iterator& rhs) const { return p != rhs.p; }
+   bool operator == (const iterator& rhs) const { return p == rhs.p; }
+
+   // dereference operator
+   T& operator * ()
+   {
+      return *p;
+   }
+
+   // prefix increment
+   iterator& operator ++ ()
+   {
+      ++p;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int postfix)
+   {
+      iterator tmp(*this);
+      ++p;
+      return tmp;
+   }
+
+   // prefix decrement
+   iterator& operator -- ()
+   {
+      --p;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int postfix)
+   {
+      iterator tmp(*this);
+      --p;
+      return tmp;
+   }
+
+private:
+   T* p;
+};
+
+/*****************************************
+ * VECTOR :: DEFAULT constructors
+ * Nothing is allocated until the first element arrives
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector(const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0)
+{
+}
+
+/*****************************************
+ * VECTOR :: NON-DEFAULT constructors
+ * non-default constructor: set the number of elements,
+ * construct each element, and copy the values over
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector(size_t num, const T & t, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0)
+{
+   resize(num, t);
+}
+
+/*****************************************
+ * VECTOR :: INITIALIZATION LIST constructors
+ * Create a vector with an initialization list.
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector(const std::initializer_list<T> & l, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0)
+{
+   reserve(l.size());
+   for (const T & t : l)
+      std::allocator_traits<A>::construct(alloc, data + numElements++, t);
+}
+
+/*****************************************
+ * VECTOR :: NON-DEFAULT constructors
+ * non-default constructor: set the number of elements,
+ * construct each element with the default constructor
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector(size_t num, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0)
+{
+   resize(num);
+}
+
+/*****************************************
+ * VECTOR :: COPY CONSTRUCTOR
+ * Allocate the space for numElements and
+ * call the copy constructor on each element
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector (const vector & rhs) :
+   alloc(rhs.alloc), data(nullptr), numCapacity(0), numElements(0)
+{
+   reserve(rhs.numElements);
+   for (size_t i = 0; i < rhs.numElements; i++)
+      std::allocator_traits<A>::construct(alloc, data + numElements++, rhs.data[i]);
+}
+
+/*****************************************
+ * VECTOR :: MOVE CONSTRUCTOR
+ * Steal the values from the RHS and set it to zero.
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: vector (vector && rhs) :
+   alloc(std::move(rhs.alloc)), data(rhs.data),
+   numCapacity(rhs.numCapacity), numElements(rhs.numElements)
+{
+   rhs.data = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * VECTOR :: DESTRUCTOR
+ * Call the destructor for each element from 0..numElements
+ * and then free the memory
+ ****************************************/
+template <typename T, typename A>
+vector <T, A> :: ~vector()
+{
+   clear();
+   if (data)
+      std::allocator_traits<A>::deallocate(alloc, data, numCapacity);
+}
+
+/***************************************
+ * VECTOR :: RESIZE
+ * This method will adjust the size to newElements.
+ * This will either grow or shrink newElements.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: resize(size_t newElements)
+{
+   while (numElements > newElements)
+      pop_back();
+   reserve(newElements);
+   while (numElements < newElements)
+      std::allocator_traits<A>::construct(alloc, data + numElements++);
+}
+
+template <typename T, typename A>
+void vector <T, A> :: resize(size_t newElements, const T & t)
+{
+   while (numElements > newElements)
+      pop_back();
+   reserve(newElements);
+   while (numElements < newElements)
+      std::allocator_traits<A>::construct(alloc, data + numElements++, t);
+}
+
+/***************************************
+ * VECTOR :: RESERVE
+ * This method will grow the current buffer
+ * to newCapacity.  It will also move all
+ * the data from the old buffer into the new
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: reserve(size_t newCapacity)
+{
+   if (newCapacity > numCapacity)
+      reallocate(newCapacity);
+}
+
+/***************************************
+ * VECTOR :: SHRINK TO FIT
+ * Get rid of any extra capacity
+ *     INPUT  :
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: shrink_to_fit()
+{
+   if (numElements < numCapacity)
+      reallocate(numElements);
+}
+
+/***************************************
+ * VECTOR :: REALLOCATE
+ * Move the elements into a buffer of exactly
+ * newCapacity and release the old one. Elements
+ * are moved, not copied, so growing a vector of
+ * heavy objects does not duplicate them.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: reallocate(size_t newCapacity)
+{
+   assert(newCapacity >= numElements);
+   T * newData = newCapacity ?
+      std::allocator_traits<A>::allocate(alloc, newCapacity) : nullptr;
+   adopt(newData, newCapacity);
+}
+
+/***************************************
+ * VECTOR :: ADOPT
+ * Move the elements into newData, a buffer of
+ * newCapacity already allocated, and release the
+ * old one
+ *     INPUT  : newData     the new buffer
+ *              newCapacity its size
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: adopt(T * newData, size_t newCapacity)
+{
+   for (size_t i = 0; i < numElements; i++)
+   {
+      std::allocator_traits<A>::construct(alloc, newData + i, std::move(data[i]));
+      std::allocator_traits<A>::destroy(alloc, data + i);
+   }
+   if (data)
+      std::allocator_traits<A>::deallocate(alloc, data, numCapacity);
+   data = newData;
+   numCapacity = newCapacity;
+}
+
+/*****************************************
+ * VECTOR :: SUBSCRIPT
+ * Read-Write access
+ ****************************************/
+template <typename T, typename A>
+T & vector <T, A> :: operator [] (size_t index)
+{
+   assert(index < numElements);
+   return data[index];
+}
+
+/******************************************
+ * VECTOR :: SUBSCRIPT
+ * Read-Write access
+ *****************************************/
+template <typename T, typename A>
+const T & vector <T, A> :: operator [] (size_t index) const
+{
+   assert(index < numElements);
+   return data[index];
+}
+
+/*****************************************
+ * VECTOR :: FRONT
+ * Read-Write access
+ ****************************************/
+template <typename T, typename A>
+T & vector <T, A> :: front ()
+{
+   assert(numElements > 0);
+   return data[0];
+}
+
+/******************************************
+ * VECTOR :: FRONT
+ * Read-Write access
+ *****************************************/
+template <typename T, typename A>
+const T & vector <T, A> :: front () const
+{
+   assert(numElements > 0);
+   return data[0];
+}
+
+/*****************************************
+ * VECTOR :: BACK
+ * Read-Write access
+ ****************************************/
+template <typename T, typename A>
+T & vector <T, A> :: back()
+{
+   assert(numElements > 0);
+   return data[numElements - 1];
+}
+
+/******************************************
+ * VECTOR :: BACK
+ * Read-Write access
+ *****************************************/
+template <typename T, typename A>
+const T & vector <T, A> :: back() const
+{
+   assert(numElements > 0);
+   return data[numElements - 1];
+}
+
+/***************************************
+ * VECTOR :: PUSH BACK
+ * This method will add the element 't' to the
+ * end of the current buffer.  It will also grow
+ * the buffer as needed to accomodate the new element
+ *     INPUT  : 't' the new element to be added
+ *     OUTPUT : *this
+ **************************************/
+template <typename T, typename A>
+void vector <T, A> :: push_back (const T & t)
+{
+   emplace_back(t);
+}
+
+template <typename T, typename A>
+void vector <T, A> ::push_back(T && t)
+{
+   emplace_back(std::move(t));
+}
+
+/***************************************
+ * VECTOR :: EMPLACE BACK
+ * Construct a new element directly in the slot
+ * past the end, doubling the buffer when full.
+ * The arguments may refer to an element already
+ * in the vector, as in v.push_back(v[0]), so when
+ * the buffer grows the new element is built in
+ * the new buffer before the old ones move out.
+ *     INPUT  : args the constructor parameters
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, typename A>
+template <class ... Args>
+T & vector <T, A> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+   {
+      size_t newCapacity = numCapacity ? numCapacity * 2 : 1;
+      T * newData = std::allocator_traits<A>::allocate(alloc, newCapacity);
+      std::allocator_traits<A>::construct(alloc, newData + numElements,
+                                          std::forward<Args>(args)...);
+      adopt(newData, newCapacity);
+   }
+   else
+      std::allocator_traits<A>::construct(alloc, data + numElements,
+                                          std::forward<Args>(args)...);
+   return data[numElements++];
+}
+
+/***************************************
+ * VECTOR :: ASSIGNMENT
+ * This operator will copy the contents of the
+ * rhs onto *this, growing the buffer as needed
+ *     INPUT  : rhs the vector to copy from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T, typename A>
+vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   // not enough room: start over with a buffer the size of rhs
+   if (rhs.numElements > numCapacity)
+   {
+      clear();
+      reallocate(rhs.numElements);
+   }
+
+   // assign over what we have, then construct or destroy the difference
+   size_t i = 0;
+   for (; i < numElements && i < rhs.numElements; i++)
+      data[i] = rhs.data[i];
+   for (; i < rhs.numElements; i++)
+      std::allocator_traits<A>::construct(alloc, data + i, rhs.data[i]);
+   while (numElements > rhs.numElements)
+      pop_back();
+   numElements = rhs.numElements;
+   return *this;
+}
+template <typename T, typename A>
+vector <T, A>& vector <T, A> :: operator = (vector&& rhs)
+{
+   clear();
+   shrink_to_fit();
+   swap(rhs);
+   return *this;
+}
+
+} // namespace custom